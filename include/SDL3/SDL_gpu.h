@@ -2307,6 +2307,21 @@ extern SDL_DECLSPEC SDL_GPUDevice * SDLCALL SDL_CreateGPUDevice(
  *   either supports Tier 2 Resource Binding or does not support D3D12 in any
  *   capacity. Defaults to false.
  *
+ * With the Vulkan renderer:
+ *
+ * - `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER`: pipeline
+ *   cache data from a previous run, used to speed up pipeline creation. Data
+ *   saved by a different device or driver version is ignored.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_SIZE_NUMBER`: the size
+ *   in bytes of the pipeline cache data.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_FILE_STRING`: the path
+ *   to a file holding pipeline cache data. If the file exists, it's used to
+ *   seed the pipeline cache, unless
+ *   `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER` is also set.
+ *   The pipeline cache is written back to the file when the device is
+ *   destroyed. SDL_GetGPUPipelineCacheData() can be used to save it at other
+ *   times or to a different place.
+ *
  * \param props the properties to use.
  * \returns a GPU context on success or NULL on failure; call SDL_GetError()
  *          for more information.
@@ -2337,6 +2352,9 @@ extern SDL_DECLSPEC SDL_GPUDevice * SDLCALL SDL_CreateGPUDeviceWithProperties(
 #define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_METALLIB_BOOLEAN                     "SDL.gpu.device.create.shaders.metallib"
 #define SDL_PROP_GPU_DEVICE_CREATE_D3D12_ALLOW_FEWER_RESOURCE_SLOTS_BOOLEAN     "SDL.gpu.device.create.d3d12.allowtier1resourcebinding"
 #define SDL_PROP_GPU_DEVICE_CREATE_D3D12_SEMANTIC_NAME_STRING                   "SDL.gpu.device.create.d3d12.semantic"
+#define SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER                "SDL.gpu.device.create.vulkan.pipeline_cache"
+#define SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_SIZE_NUMBER            "SDL.gpu.device.create.vulkan.pipeline_cache.size"
+#define SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_FILE_STRING            "SDL.gpu.device.create.vulkan.pipeline_cache.file"
 
 /**
  * Destroys a GPU context previously returned by SDL_CreateGPUDevice.
@@ -2509,6 +2527,28 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetGPUDeviceProperties(SDL_GPUD
 #define SDL_PROP_GPU_DEVICE_DRIVER_VERSION_STRING     "SDL.gpu.device.driver_version"
 #define SDL_PROP_GPU_DEVICE_DRIVER_INFO_STRING        "SDL.gpu.device.driver_info"
 
+/**
+ * Get the current contents of a GPU device's pipeline cache.
+ *
+ * The data includes the pipelines created so far, and can be passed to
+ * `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER` when creating a
+ * device later, for example on the next run of the application.
+ *
+ * Only the Vulkan driver has a pipeline cache.
+ *
+ * \param device a GPU context to query.
+ * \param size a pointer filled in with the size of the data in bytes.
+ * \returns the pipeline cache data, which should be freed with SDL_free(),
+ *          or NULL on failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUDeviceWithProperties
+ */
+extern SDL_DECLSPEC void * SDLCALL SDL_GetGPUPipelineCacheData(SDL_GPUDevice *device, size_t *size);
+
 
 /* State Creation */
 
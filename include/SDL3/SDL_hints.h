@@ -586,6 +586,31 @@ extern "C" {
  */
 #define SDL_HINT_AUTO_UPDATE_SENSORS "SDL_AUTO_UPDATE_SENSORS"
 
+/**
+ * A variable controlling whether SDL_LoadBMP_IO() maps the pixels of BMP
+ * files directly instead of reading them into a new allocation.
+ *
+ * When this is enabled, uncompressed top-down BMP files loaded from a file
+ * on disk get a surface whose pixels point into a private, copy-on-write
+ * mapping of the file. The pixels are paged in as they are used, which avoids
+ * copying large images at load time. Writing to the surface does not modify
+ * the file, and the mapping is released when the surface is destroyed.
+ *
+ * The file must not be truncated while any such surface exists. Compressed
+ * or bottom-up BMP files, and BMP files loaded from streams that aren't
+ * backed by a file, are read normally.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": BMP pixels are always read into a new allocation. (default)
+ * - "1": BMP pixels are mapped from the file when possible.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_BMP_LOAD_MEMORY_MAPPED "SDL_BMP_LOAD_MEMORY_MAPPED"
+
 /**
  * Prevent SDL from using version 4 of the bitmap header when saving BMPs.
  *
@@ -3250,6 +3275,67 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_METAL_PREFER_LOW_POWER_DEVICE "SDL_RENDER_METAL_PREFER_LOW_POWER_DEVICE"
 
+/**
+ * A variable controlling how many threads the software renderer draws with.
+ *
+ * With more than one thread, the target is split into tiles that are drawn
+ * in parallel when the render commands are flushed. The result is the same
+ * as drawing on one thread.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Use one thread per logical CPU core.
+ * - "1": Draw on the thread that flushes the render commands. (default)
+ * - "N": Draw with N threads, including the thread that flushes the render
+ *   commands.
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS "SDL_RENDER_SOFTWARE_THREADS"
+
+/**
+ * A variable controlling whether the software renderer only presents the
+ * areas of the window that changed.
+ *
+ * When this is enabled, the software renderer turns on damage tracking for
+ * its window surface with SDL_SetWindowSurfaceDamageTracking(), and records
+ * the area each clear, fill, copy and geometry draw touches. Only those areas
+ * are copied to the window by SDL_RenderPresent(). The areas changed so far
+ * in the current frame can be queried by calling SDL_FlushRenderer() and then
+ * SDL_GetWindowSurfaceDamage().
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": The whole window is presented. (default)
+ * - "1": Only the changed areas of the window are presented.
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_DAMAGE_TRACKING "SDL_RENDER_SOFTWARE_DAMAGE_TRACKING"
+
+/**
+ * A variable controlling whether renderers draw their frame statistics.
+ *
+ * When enabled, the statistics of the previous frame are drawn in the top
+ * left corner of the window with SDL_RenderDebugText() just before it is
+ * presented. The same values are available as renderer properties, see
+ * SDL_GetRendererProperties().
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Don't draw the frame statistics. (default)
+ * - "1": Draw the frame statistics.
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_RENDER_STATS_OVERLAY "SDL_RENDER_STATS_OVERLAY"
+
 /**
  * A variable controlling whether updates to the SDL screen surface should be
  * synchronized with the vertical refresh, to avoid tearing.
@@ -3435,6 +3521,70 @@ extern "C" {
  */
 #define SDL_HINT_STORAGE_USER_DRIVER "SDL_STORAGE_USER_DRIVER"
 
+/**
+ * A variable controlling whether SDL_DuplicateSurface() shares pixels with
+ * the original surface until one of them is modified.
+ *
+ * When enabled, duplicating a surface is nearly free: both surfaces reference
+ * the same pixel buffer, and a private copy is made the first time either
+ * surface is written through SDL (locking, blitting to it, filling, flipping,
+ * clearing, writing pixels, or rendering to it with a software renderer).
+ *
+ * Applications that enable this must call SDL_LockSurface() before writing
+ * to the `pixels` of either surface directly.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": SDL_DuplicateSurface() always copies the pixels. (default)
+ * - "1": SDL_DuplicateSurface() shares the pixels copy-on-write, where
+ *   possible.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_SURFACE_DUPLICATE_COPY_ON_WRITE "SDL_SURFACE_DUPLICATE_COPY_ON_WRITE"
+
+/**
+ * A variable controlling whether large surfaces use huge pages.
+ *
+ * When enabled, pixel buffers of 2 MB or more allocated by SDL_CreateSurface()
+ * are backed by transparent huge pages where available, which reduces TLB
+ * pressure when processing very large images. This is currently only
+ * implemented on Linux.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Surfaces use regular heap memory. (default)
+ * - "1": Large surfaces use huge pages where available.
+ *
+ * This hint can be set anytime, and affects surfaces created afterwards.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_SURFACE_POOL_HUGEPAGES "SDL_SURFACE_POOL_HUGEPAGES"
+
+/**
+ * A variable controlling the maximum number of bytes kept in the surface
+ * pixel pool.
+ *
+ * When a surface created with SDL_CreateSurface() is destroyed, its pixel
+ * buffer is kept in a pool, up to this many bytes in total, and reused by the
+ * next surface that needs a buffer of the same size. This avoids heap traffic
+ * for applications that create and destroy same-size surfaces every frame.
+ *
+ * The variable is a number of bytes, and defaults to "0", which disables the
+ * pool.
+ *
+ * This hint can be set anytime. Lowering it releases cached buffers
+ * immediately.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSurfacePoolStats
+ */
+#define SDL_HINT_SURFACE_POOL_SIZE "SDL_SURFACE_POOL_SIZE"
+
 /**
  * Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as
  * realtime.
@@ -3784,12 +3934,84 @@ extern "C" {
  * - "1": Video frames are saved to files in the format "SDL_windowX-Y.bmp",
  *   where X is the window ID, and Y is the frame number.
  *
+ * The file format can be changed with
+ * SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_FORMAT, and frames can be saved on a
+ * background thread by setting SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_BUFFERS.
+ *
  * This hint can be set anytime.
  *
  * \since This hint is available since SDL 3.2.0.
  */
 #define SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES "SDL_VIDEO_OFFSCREEN_SAVE_FRAMES"
 
+/**
+ * A variable controlling how many frames the offscreen video driver can
+ * queue for saving on a background thread.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Frames are saved as they are presented. (default)
+ * - N: Frames are copied into a ring of N buffers and saved on a background
+ *   thread, up to a maximum of 64.
+ *
+ * The number of frames saved and dropped are available in the window
+ * properties as `SDL_PROP_WINDOW_OFFSCREEN_SAVED_FRAMES_NUMBER` and
+ * `SDL_PROP_WINDOW_OFFSCREEN_DROPPED_FRAMES_NUMBER`.
+ *
+ * This hint should be set before the first frame of a window is saved.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_BUFFERS "SDL_VIDEO_OFFSCREEN_SAVE_FRAMES_BUFFERS"
+
+/**
+ * A variable controlling whether the offscreen video driver drops frames
+ * when all the buffers for saving frames are full.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Presenting a frame waits until there is a free buffer. (default)
+ * - "1": The frame is not saved, and is counted in
+ *   `SDL_PROP_WINDOW_OFFSCREEN_DROPPED_FRAMES_NUMBER`.
+ *
+ * This hint only has an effect when
+ * SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_BUFFERS is greater than 0, and should
+ * be set before the first frame of a window is saved.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_DROP "SDL_VIDEO_OFFSCREEN_SAVE_FRAMES_DROP"
+
+/**
+ * A variable controlling the file format of frames saved by the offscreen
+ * video driver.
+ *
+ * X is the window ID and Y is the frame number in the file names below.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "bmp": Each frame is saved as "SDL_windowX-Y.bmp". (default)
+ * - "png": Each frame is saved as "SDL_windowX-Y.png".
+ * - "raw": Frames are appended to "SDL_windowX-Y-WxH.raw" as tightly packed
+ *   SDL_PIXELFORMAT_XRGB8888 pixels, where Y is the first frame in the file
+ *   and WxH is the frame size.
+ * - "y4m": Frames are appended to "SDL_windowX-Y.y4m" as a 4:2:0 YUV4MPEG2
+ *   stream at 60 frames per second, where Y is the first frame in the file.
+ *   The frames are full range BT.601 (SDL_COLORSPACE_JPEG).
+ *
+ * A new "raw" or "y4m" file is started whenever the window size changes.
+ *
+ * Errors converting or writing frames are logged and don't affect
+ * SDL_UpdateWindowSurface(). When frames are saved on a background thread
+ * (see SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_BUFFERS), SDL_UpdateWindowSurface()
+ * fails if a frame can't be queued.
+ *
+ * This hint should be set before the first frame of a window is saved.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_FORMAT "SDL_VIDEO_OFFSCREEN_SAVE_FRAMES_FORMAT"
+
 /**
  * A variable controlling whether all window operations will block until
  * complete.
@@ -4032,6 +4254,27 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_X11_SCALING_FACTOR "SDL_VIDEO_X11_SCALING_FACTOR"
 
+/**
+ * A variable controlling how many shared memory buffers are used to present
+ * X11 window surfaces.
+ *
+ * With a single buffer, SDL_UpdateWindowSurface() waits for the X server to
+ * finish copying the window surface before returning. With more buffers, the
+ * updated area is copied to a free buffer and SDL_UpdateWindowSurface()
+ * returns immediately, so drawing the next frame overlaps the server copy.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "1": Use a single buffer. (default)
+ * - "2": Use double buffering.
+ * - "3": Use triple buffering.
+ *
+ * This hint should be set before creating a window surface.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_VIDEO_X11_SHM_BUFFERS "SDL_VIDEO_X11_SHM_BUFFERS"
+
 /**
  * A variable forcing the visual ID used for X11 display modes.
  *
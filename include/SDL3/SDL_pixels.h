@@ -1367,6 +1367,7 @@ extern SDL_DECLSPEC Uint32 SDLCALL SDL_MapRGB(const SDL_PixelFormatDetails *form
  * \sa SDL_GetPixelFormatDetails
  * \sa SDL_GetRGBA
  * \sa SDL_MapRGB
+ * \sa SDL_MapRGBAArray
  * \sa SDL_MapSurfaceRGBA
  */
 extern SDL_DECLSPEC Uint32 SDLCALL SDL_MapRGBA(const SDL_PixelFormatDetails *format, const SDL_Palette *palette, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
@@ -1426,11 +1427,69 @@ extern SDL_DECLSPEC void SDLCALL SDL_GetRGB(Uint32 pixelvalue, const SDL_PixelFo
  *
  * \sa SDL_GetPixelFormatDetails
  * \sa SDL_GetRGB
+ * \sa SDL_GetRGBAArray
  * \sa SDL_MapRGB
  * \sa SDL_MapRGBA
  */
 extern SDL_DECLSPEC void SDLCALL SDL_GetRGBA(Uint32 pixelvalue, const SDL_PixelFormatDetails *format, const SDL_Palette *palette, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a);
 
+/**
+ * Map an array of RGBA colors to pixel values for a given pixel format.
+ *
+ * This produces the same pixel values as calling SDL_MapRGBA() on each color,
+ * but is much faster for large arrays, e.g. when generating textures or
+ * particle colors every frame.
+ *
+ * If the format has a palette, the index of the closest matching color in the
+ * palette is stored for each color.
+ *
+ * \param format a pointer to SDL_PixelFormatDetails describing the pixel
+ *               format.
+ * \param palette an optional palette for indexed formats, may be NULL.
+ * \param colors an array of `count` colors to map.
+ * \param pixels an array of `count` pixel values filled in with the mapped
+ *               colors.
+ * \param count the number of colors to map.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the palette is not modified.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetRGBAArray
+ * \sa SDL_MapRGBA
+ * \sa SDL_MapSurfaceRGBAArray
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_MapRGBAArray(const SDL_PixelFormatDetails *format, const SDL_Palette *palette, const SDL_Color *colors, Uint32 *pixels, int count);
+
+/**
+ * Get RGBA values from an array of pixels in the specified format.
+ *
+ * This produces the same colors as calling SDL_GetRGBA() on each pixel, but
+ * is much faster for large arrays.
+ *
+ * \param pixels an array of `count` pixel values.
+ * \param format a pointer to SDL_PixelFormatDetails describing the pixel
+ *               format.
+ * \param palette an optional palette for indexed formats, may be NULL.
+ * \param colors an array of `count` colors filled in with the components of
+ *               each pixel.
+ * \param count the number of pixels to convert.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the palette is not modified.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetRGBA
+ * \sa SDL_MapRGBAArray
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetRGBAArray(const Uint32 *pixels, const SDL_PixelFormatDetails *format, const SDL_Palette *palette, SDL_Color *colors, int count);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -501,6 +501,276 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetRectEnclosingPointsFloat(const SDL_FPoin
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_GetRectAndLineIntersectionFloat(const SDL_FRect *rect, float *X1, float *Y1, float *X2, float *Y2);
 
+/**
+ * An opaque structure representing an area made up of any number of
+ * rectangles.
+ *
+ * A region is stored as a sorted list of non-overlapping rectangles, grouped
+ * into horizontal bands, which allows unions, intersections and differences
+ * of regions to be calculated in a single pass over both regions.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateRegion
+ */
+typedef struct SDL_Region SDL_Region;
+
+/**
+ * Create a new empty region.
+ *
+ * \returns a new region or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroyRegion
+ */
+extern SDL_DECLSPEC SDL_Region * SDLCALL SDL_CreateRegion(void);
+
+/**
+ * Destroy a region created with SDL_CreateRegion().
+ *
+ * \param region the region to destroy, may be NULL.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the region is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateRegion
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyRegion(SDL_Region *region);
+
+/**
+ * Copy the area of one region to another.
+ *
+ * \param dst the region to be replaced.
+ * \param src the region to copy.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               `dst` is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_CopyRegion(SDL_Region *dst, const SDL_Region *src);
+
+/**
+ * Remove all rectangles from a region.
+ *
+ * \param region the region to clear.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the region is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ClearRegion(SDL_Region *region);
+
+/**
+ * Determine whether a region has no area.
+ *
+ * \param region the region to query, may be NULL.
+ * \returns true if the region is NULL or empty, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RegionEmpty(const SDL_Region *region);
+
+/**
+ * Get the smallest rectangle enclosing a region.
+ *
+ * \param region the region to query.
+ * \param rect an SDL_Rect structure filled in with the bounds of the region,
+ *             or an empty rectangle if the region is empty.
+ * \returns true if the region is not empty or false if it is empty or on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetRegionBounds(const SDL_Region *region, SDL_Rect *rect);
+
+/**
+ * Get the rectangles that make up a region.
+ *
+ * The rectangles don't overlap, and are sorted from top to bottom and then
+ * from left to right.
+ *
+ * \param region the region to query.
+ * \param count a pointer filled in with the number of rectangles returned,
+ *              may be NULL.
+ * \returns an array of rectangles or NULL on failure; call SDL_GetError() for
+ *          more information. This array is owned by the region and is valid
+ *          until the region is modified or destroyed.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the region is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC const SDL_Rect * SDLCALL SDL_GetRegionRects(SDL_Region *region, int *count);
+
+/**
+ * Determine whether a point is inside a region.
+ *
+ * \param p the point to test.
+ * \param region the region to test.
+ * \returns true if `p` is inside `region`, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_PointInRegion(const SDL_Point *p, const SDL_Region *region);
+
+/**
+ * Move a region by an offset.
+ *
+ * \param region the region to move.
+ * \param dx the horizontal offset.
+ * \param dy the vertical offset.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the region is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_TranslateRegion(SDL_Region *region, int dx, int dy);
+
+/**
+ * Add the area of another region to a region.
+ *
+ * \param region the region to modify.
+ * \param other the region to add.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               `region` is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_UnionRegionRect
+ * \sa SDL_UnionRegionRects
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_UnionRegion(SDL_Region *region, const SDL_Region *other);
+
+/**
+ * Reduce a region to the area it shares with another region.
+ *
+ * \param region the region to modify.
+ * \param other the region to intersect with.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               `region` is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_IntersectRegionRect
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_IntersectRegion(SDL_Region *region, const SDL_Region *other);
+
+/**
+ * Remove the area of another region from a region.
+ *
+ * \param region the region to modify.
+ * \param other the region to remove.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               `region` is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SubtractRegionRect
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SubtractRegion(SDL_Region *region, const SDL_Region *other);
+
+/**
+ * Add a rectangle to a region.
+ *
+ * Empty rectangles are ignored.
+ *
+ * \param region the region to modify.
+ * \param rect the rectangle to add.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the region is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_UnionRegionRects
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_UnionRegionRect(SDL_Region *region, const SDL_Rect *rect);
+
+/**
+ * Reduce a region to the area inside a rectangle.
+ *
+ * \param region the region to modify.
+ * \param rect the rectangle to intersect with.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the region is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_IntersectRegionRect(SDL_Region *region, const SDL_Rect *rect);
+
+/**
+ * Remove a rectangle from a region.
+ *
+ * \param region the region to modify.
+ * \param rect the rectangle to remove.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the region is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SubtractRegionRect(SDL_Region *region, const SDL_Rect *rect);
+
+/**
+ * Add an array of rectangles to a region.
+ *
+ * This is much faster than adding the rectangles one at a time with
+ * SDL_UnionRegionRect() when there are many of them. Empty rectangles are
+ * ignored.
+ *
+ * \param region the region to modify.
+ * \param rects an array of SDL_Rect structures to add.
+ * \param count the number of rectangles in `rects`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the region is not being used by another thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_UnionRegionRect
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_UnionRegionRects(SDL_Region *region, const SDL_Rect *rects, int count);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
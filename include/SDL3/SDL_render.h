@@ -495,6 +495,38 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  *   that can be displayed, in terms of the SDR white point. When HDR is not
  *   enabled, this will be 1.0. This property can change dynamically when
  *   SDL_EVENT_WINDOW_HDR_STATE_CHANGED is sent.
+ * - `SDL_PROP_RENDERER_COMMAND_COUNT_NUMBER`: the number of render commands
+ *   sent to the rendering backend the last time queued rendering was
+ *   flushed. Consecutive draws with the same texture and render state are
+ *   merged into a single command, so this can be much lower than the number
+ *   of draw calls made. This property is updated every time the renderer
+ *   flushes its command queue, e.g. in SDL_RenderPresent() and
+ *   SDL_FlushRenderer().
+ * - `SDL_PROP_RENDERER_FRAME_COMMAND_COUNT_NUMBER`: the number of render
+ *   commands sent to the rendering backend during the last presented frame.
+ * - `SDL_PROP_RENDERER_FRAME_FLUSH_COUNT_NUMBER`: the number of times queued
+ *   rendering was flushed during the last presented frame. Besides
+ *   SDL_RenderPresent(), changing a texture that queued rendering depends on,
+ *   changing the render target and calling SDL_FlushRenderer() all flush
+ *   queued rendering.
+ * - `SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER`: the number of bytes of
+ *   vertex data sent to the rendering backend during the last presented
+ *   frame.
+ * - `SDL_PROP_RENDERER_FRAME_TEXTURE_UPDATE_COUNT_NUMBER`: the number of
+ *   times texture pixels were sent to the rendering backend during the last
+ *   presented frame. This includes SDL_UpdateTexture(),
+ *   SDL_UpdateYUVTexture() and SDL_UpdateNVTexture(), as well as textures
+ *   that SDL converts to a format the backend supports.
+ * - `SDL_PROP_RENDERER_FRAME_TEXTURE_LOCK_COUNT_NUMBER`: the number of times
+ *   the rendering backend locked a texture during the last presented frame.
+ * - `SDL_PROP_RENDERER_FRAME_UPLOAD_BYTES_NUMBER`: the number of bytes of
+ *   texture data staged for upload to the GPU during the last presented
+ *   frame. This is only reported by the "gpu" renderer, and is 0 for other
+ *   renderers.
+ *
+ * The frame statistics are updated by SDL_RenderPresent(), and cover
+ * everything since the previous call to SDL_RenderPresent(). They can be
+ * drawn on screen with SDL_HINT_RENDER_STATS_OVERLAY.
  *
  * With the direct3d renderer:
  *
@@ -561,6 +593,13 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_HDR_ENABLED_BOOLEAN                       "SDL.renderer.HDR_enabled"
 #define SDL_PROP_RENDERER_SDR_WHITE_POINT_FLOAT                     "SDL.renderer.SDR_white_point"
 #define SDL_PROP_RENDERER_HDR_HEADROOM_FLOAT                        "SDL.renderer.HDR_headroom"
+#define SDL_PROP_RENDERER_COMMAND_COUNT_NUMBER                      "SDL.renderer.command_count"
+#define SDL_PROP_RENDERER_FRAME_COMMAND_COUNT_NUMBER                "SDL.renderer.frame.command_count"
+#define SDL_PROP_RENDERER_FRAME_FLUSH_COUNT_NUMBER                  "SDL.renderer.frame.flush_count"
+#define SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER                 "SDL.renderer.frame.vertex_bytes"
+#define SDL_PROP_RENDERER_FRAME_TEXTURE_UPDATE_COUNT_NUMBER         "SDL.renderer.frame.texture_update_count"
+#define SDL_PROP_RENDERER_FRAME_TEXTURE_LOCK_COUNT_NUMBER           "SDL.renderer.frame.texture_lock_count"
+#define SDL_PROP_RENDERER_FRAME_UPLOAD_BYTES_NUMBER                 "SDL.renderer.frame.upload_bytes"
 #define SDL_PROP_RENDERER_D3D9_DEVICE_POINTER                       "SDL.renderer.d3d9.device"
 #define SDL_PROP_RENDERER_D3D11_DEVICE_POINTER                      "SDL.renderer.d3d11.device"
 #define SDL_PROP_RENDERER_D3D11_SWAPCHAIN_POINTER                   "SDL.renderer.d3d11.swap_chain"
@@ -2496,6 +2535,49 @@ extern SDL_DECLSPEC bool SDLCALL SDL_RenderGeometryRaw(SDL_Renderer *renderer,
                                                int num_vertices,
                                                const void *indices, int num_indices, int size_indices);
 
+/**
+ * A textured quad submitted with SDL_RenderSprites().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderSprites
+ */
+typedef struct SDL_RenderSprite
+{
+    SDL_FRect srcrect;  /**< The area of the texture to draw, in pixels */
+    SDL_FRect dstrect;  /**< The area of the rendering target to draw to */
+    float angle;        /**< An angle in degrees to rotate dstrect around its center, clockwise */
+    SDL_FColor color;   /**< The color and alpha to modulate the texture with */
+} SDL_RenderSprite;
+
+/**
+ * Render many portions of a texture to the current rendering target in one
+ * call.
+ *
+ * This is equivalent to calling SDL_RenderTextureRotated() for each sprite,
+ * but the vertices for all of them are generated in a single pass and
+ * submitted as indexed geometry, which is much faster for large batches.
+ *
+ * Color and alpha modulation is done per sprite (SDL_SetTextureColorMod and
+ * SDL_SetTextureAlphaMod are ignored), and sprites use the texture address
+ * mode set with SDL_SetRenderTextureAddressMode().
+ *
+ * \param renderer the rendering context.
+ * \param texture the source texture.
+ * \param sprites an array of SDL_RenderSprite structures.
+ * \param count the number of sprites in the array.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderGeometryRaw
+ * \sa SDL_RenderTextureRotated
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RenderSprites(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_RenderSprite *sprites, int count);
+
 /**
  * Set the texture addressing mode used in SDL_RenderGeometry().
  *
@@ -2561,6 +2643,60 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetRenderTextureAddressMode(SDL_Renderer *r
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect);
 
+/**
+ * A callback that receives the pixels read by SDL_RenderReadPixelsAsync().
+ *
+ * The surface is owned by SDL and is destroyed when the callback returns, so
+ * the callback should copy any pixels it needs to keep. It may be converted
+ * or blitted, and its pixels may be modified.
+ *
+ * \param userdata an app-defined pointer passed to
+ *                 SDL_RenderReadPixelsAsync().
+ * \param renderer the rendering context the pixels were read from.
+ * \param surface the pixels that were read, or NULL if they couldn't be read;
+ *                call SDL_GetError() for more information.
+ *
+ * \threadsafety This callback is called on the thread that calls
+ *               SDL_RenderPresent() or SDL_DestroyRenderer().
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ */
+typedef void (SDLCALL *SDL_RenderReadPixelsCallback)(void *userdata, SDL_Renderer *renderer, SDL_Surface *surface);
+
+/**
+ * Read pixels from the current rendering target without waiting for them.
+ *
+ * This reads the same pixels as SDL_RenderReadPixels(), as they are at this
+ * point in the rendering, but instead of stalling until the rendering
+ * backend has finished drawing, the copy is queued and the pixels are passed
+ * to the callback later, from a call to SDL_RenderPresent(). This is usually
+ * one or two frames later, and callbacks are called in the order the reads
+ * were started. Any reads still pending when the renderer is destroyed are
+ * completed by SDL_DestroyRenderer().
+ *
+ * This is intended for capturing rendered frames continuously, e.g. for
+ * video recording. The "gpu" renderer reads the pixels asynchronously on the
+ * GPU, other renderers read them right away and only defer the callback.
+ *
+ * \param renderer the rendering context.
+ * \param rect an SDL_Rect structure representing the area to read, which will
+ *             be clipped to the current viewport, or NULL for the entire
+ *             viewport.
+ * \param callback the function to call with the pixels that were read.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information. The callback is only called if this returns true.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderReadPixels
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect, SDL_RenderReadPixelsCallback callback, void *userdata);
+
 /**
  * Update the screen with any rendering performed since the previous call.
  *
@@ -3015,6 +3151,302 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetGPURenderState(SDL_Renderer *renderer, S
  */
 extern SDL_DECLSPEC void SDLCALL SDL_DestroyGPURenderState(SDL_GPURenderState *state);
 
+/**
+ * A set of textures that many small images are packed into.
+ *
+ * Draws can only be merged into a single render command when they use the
+ * same texture, so packing sprites, glyphs and icons into a few large
+ * textures lets the renderer draw them with a handful of commands.
+ *
+ * Images are added with SDL_AddSurfaceToTextureAtlas(), which copies them
+ * into free space of one of the atlas textures, adding another texture when
+ * they are full. Each image is referred to by an entry ID, and
+ * SDL_GetTextureAtlasEntry() returns the texture and the source rectangle to
+ * pass to SDL_RenderTexture() and friends. Removing an entry with
+ * SDL_RemoveFromTextureAtlas() makes its space available to new images.
+ *
+ * By default the atlas adds as many textures as it needs. If a limit is set
+ * with SDL_SetTextureAtlasMaxTextures(), the least recently added or looked
+ * up images are evicted to make room for new ones once the limit is reached.
+ * An atlas texture is destroyed when its last image is removed or evicted.
+ * SDL_GetTextureAtlasUsage() can be used to decide when to rebuild a
+ * fragmented atlas.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateTextureAtlas
+ */
+typedef struct SDL_TextureAtlas SDL_TextureAtlas;
+
+/**
+ * The ID of an image in a texture atlas.
+ *
+ * The value 0 is an invalid ID. An ID is no longer valid once its entry has
+ * been removed or evicted, even if the space or the entry is reused by a new
+ * image, which gets a different ID. Looking up an evicted entry fails, and
+ * the image needs to be added again.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddSurfaceToTextureAtlas
+ */
+typedef Uint32 SDL_TextureAtlasEntryID;
+
+/**
+ * Create a texture atlas.
+ *
+ * The atlas textures are static textures of the given size and format,
+ * created as they are needed. Their blend mode, scale mode and other texture
+ * state can be changed with the usual texture functions.
+ *
+ * Each image is surrounded by a one pixel border copied from its edges, so
+ * that linear filtering doesn't blend in the neighboring images.
+ *
+ * The atlas must be destroyed before the renderer it was created with.
+ *
+ * \param renderer the rendering context.
+ * \param format the pixel format of the atlas textures, one of the packed or
+ *               array formats, such as SDL_PIXELFORMAT_ARGB8888.
+ * \param w the width of each atlas texture in pixels.
+ * \param h the height of each atlas texture in pixels.
+ * \returns the new texture atlas or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddSurfaceToTextureAtlas
+ * \sa SDL_DestroyTextureAtlas
+ */
+extern SDL_DECLSPEC SDL_TextureAtlas * SDLCALL SDL_CreateTextureAtlas(SDL_Renderer *renderer, SDL_PixelFormat format, int w, int h);
+
+/**
+ * Limit the number of textures a texture atlas can use.
+ *
+ * When an image doesn't fit and the atlas already has this many textures,
+ * SDL_AddSurfaceToTextureAtlas() evicts the images that were least recently
+ * added or looked up with SDL_GetTextureAtlasEntry() until it fits. The IDs
+ * of evicted images are no longer valid.
+ *
+ * If the atlas already has more textures, it shrinks as images are evicted
+ * to make room for new ones.
+ *
+ * \param atlas the texture atlas to modify.
+ * \param max_textures the maximum number of atlas textures, or 0 for no
+ *                     limit, the default.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddSurfaceToTextureAtlas
+ * \sa SDL_GetTextureAtlasEntry
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetTextureAtlasMaxTextures(SDL_TextureAtlas *atlas, int max_textures);
+
+/**
+ * Copy an image into a texture atlas.
+ *
+ * The image is converted to the format of the atlas. The atlas textures
+ * aren't updated until the entry is looked up with
+ * SDL_GetTextureAtlasEntry(), so adding many images at once only updates
+ * each texture once.
+ *
+ * If the atlas has reached the limit set with
+ * SDL_SetTextureAtlasMaxTextures(), the least recently used images are
+ * evicted to make room.
+ *
+ * \param atlas the texture atlas to add the image to.
+ * \param surface the image to add.
+ * \returns the ID of the new entry or 0 on failure, e.g. if the image is
+ *          larger than the atlas textures; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetTextureAtlasEntry
+ * \sa SDL_RemoveFromTextureAtlas
+ */
+extern SDL_DECLSPEC SDL_TextureAtlasEntryID SDLCALL SDL_AddSurfaceToTextureAtlas(SDL_TextureAtlas *atlas, SDL_Surface *surface);
+
+/**
+ * Get the texture and source rectangle of an image in a texture atlas.
+ *
+ * If images were added to the texture since it was last looked up, the
+ * changed area is uploaded with SDL_UpdateTexture() before returning.
+ *
+ * Looking up an image makes it the most recently used, so it's the last to
+ * be evicted when the atlas is full. This fails if the image has been
+ * evicted.
+ *
+ * \param atlas the texture atlas to query.
+ * \param entry the ID of the image.
+ * \param texture a pointer filled in with the atlas texture containing the
+ *                image, may be NULL.
+ * \param srcrect a pointer filled in with the area of the texture containing
+ *                the image, may be NULL.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddSurfaceToTextureAtlas
+ * \sa SDL_RenderTexture
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetTextureAtlasEntry(SDL_TextureAtlas *atlas, SDL_TextureAtlasEntryID entry, SDL_Texture **texture, SDL_FRect *srcrect);
+
+/**
+ * Remove an image from a texture atlas.
+ *
+ * The space used by the image can be reused by images added later, so the
+ * image shouldn't be drawn after it has been removed. If it was the last
+ * image on its atlas texture, the texture is destroyed.
+ *
+ * \param atlas the texture atlas to modify.
+ * \param entry the ID of the image.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddSurfaceToTextureAtlas
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RemoveFromTextureAtlas(SDL_TextureAtlas *atlas, SDL_TextureAtlasEntryID entry);
+
+/**
+ * Get how much of a texture atlas is in use.
+ *
+ * \param atlas the texture atlas to query.
+ * \param num_textures a pointer filled in with the number of atlas textures,
+ *                     may be NULL.
+ * \param occupancy a pointer filled in with the fraction of the texture area
+ *                  covered by images, from 0.0 to 1.0, may be NULL.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetTextureAtlasUsage(SDL_TextureAtlas *atlas, int *num_textures, float *occupancy);
+
+/**
+ * Destroy a texture atlas and its textures.
+ *
+ * \param atlas the texture atlas to destroy.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateTextureAtlas
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyTextureAtlas(SDL_TextureAtlas *atlas);
+
+/**
+ * A recorded sequence of rendering commands.
+ *
+ * A render list holds the commands and vertex data generated by a sequence
+ * of rendering calls, already converted to the renderer's internal format,
+ * so it can be submitted again with SDL_ReplayRenderList() without repeating
+ * the work done by the individual calls. This is useful for static content,
+ * like a background or a user interface, that is drawn every frame.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_StartRenderRecording
+ */
+typedef struct SDL_RenderList SDL_RenderList;
+
+/**
+ * Start recording rendering commands into a render list.
+ *
+ * Any rendering already queued is flushed first. The rendering calls made
+ * until SDL_EndRenderRecording() are still drawn as usual, and are also
+ * added to the render list.
+ *
+ * The vertex data is recorded after it has been transformed by the current
+ * viewport, scale and logical presentation, so changing those doesn't affect
+ * the recorded commands. Changing the render target while recording makes
+ * the render list invalid.
+ *
+ * \param renderer the rendering context.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_EndRenderRecording
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_StartRenderRecording(SDL_Renderer *renderer);
+
+/**
+ * Stop recording rendering commands and return the recorded render list.
+ *
+ * \param renderer the rendering context.
+ * \returns the recorded render list or NULL on failure; call SDL_GetError()
+ *          for more information. This should be freed with
+ *          SDL_DestroyRenderList() when it is no longer needed.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReplayRenderList
+ * \sa SDL_StartRenderRecording
+ */
+extern SDL_DECLSPEC SDL_RenderList * SDLCALL SDL_EndRenderRecording(SDL_Renderer *renderer);
+
+/**
+ * Queue the commands in a render list for drawing.
+ *
+ * The commands are drawn with the state they were recorded with, and the
+ * current draw color, blend mode and other rendering state is not changed.
+ *
+ * A render list becomes invalid when a texture or GPU render state used by
+ * its commands is destroyed, or when its renderer is destroyed, and this
+ * function fails for an invalid render list.
+ *
+ * \param renderer the rendering context the render list was recorded with.
+ * \param list the render list to draw.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_EndRenderRecording
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReplayRenderList(SDL_Renderer *renderer, SDL_RenderList *list);
+
+/**
+ * Destroy a render list.
+ *
+ * This may be called after the renderer the list was recorded with has been
+ * destroyed.
+ *
+ * \param list the render list to destroy.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_EndRenderRecording
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyRenderList(SDL_RenderList *list);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
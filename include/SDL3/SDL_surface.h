@@ -202,6 +202,66 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurface(int width, int heigh
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurfaceFrom(int width, int height, SDL_PixelFormat format, void *pixels, int pitch);
 
+/**
+ * Create a surface that refers to a rectangle of another surface's pixels.
+ *
+ * No copy is made of the pixel data. The new surface points into the pixels
+ * of `surface` with the same pitch, so drawing to either surface is visible
+ * in the other. The view holds a reference on `surface`, which stays alive
+ * until the view is destroyed, even if the application destroys it first.
+ *
+ * The view starts with the palette, colorspace, color key, color and alpha
+ * modulation and blend mode of `surface`, and can be used anywhere a surface
+ * is accepted, including as the source or destination of a blit or as the
+ * input to SDL_ConvertSurface().
+ *
+ * While views exist, `surface` won't be RLE encoded and SDL_DuplicateSurface()
+ * will always copy its pixels.
+ *
+ * Views can't be created on surfaces with FOURCC formats, and for formats
+ * with less than 8 bits per pixel the rectangle must start on a byte
+ * boundary.
+ *
+ * \param surface the SDL_Surface structure to create a view into.
+ * \param rect the SDL_Rect structure representing the area of `surface` to
+ *             refer to, or NULL to refer to the entire surface. The rectangle
+ *             must be entirely within the surface.
+ * \returns the new SDL_Surface structure that is created or NULL on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety This function can be called on different threads with
+ *               different surfaces.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateSurfaceFrom
+ * \sa SDL_DestroySurface
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurfaceView(SDL_Surface *surface, const SDL_Rect *rect);
+
+/**
+ * Get statistics for the surface pixel pool.
+ *
+ * The pool is enabled with SDL_HINT_SURFACE_POOL_SIZE. A hit is a surface
+ * that reused a cached pixel buffer, a miss is a surface that had to allocate
+ * a new one while the pool was in use.
+ *
+ * \param hits a pointer filled in with the number of pool hits, may be NULL.
+ * \param misses a pointer filled in with the number of pool misses, may be
+ *               NULL.
+ * \param cached_bytes a pointer filled in with the number of bytes currently
+ *                     held by the pool, may be NULL.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_HINT_SURFACE_POOL_SIZE
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetSurfacePoolStats(Uint64 *hits, Uint64 *misses, Uint64 *cached_bytes);
+
 /**
  * Free a surface.
  *
@@ -502,6 +562,54 @@ extern SDL_DECLSPEC bool SDLCALL SDL_LockSurface(SDL_Surface *surface);
  */
 extern SDL_DECLSPEC void SDLCALL SDL_UnlockSurface(SDL_Surface *surface);
 
+/**
+ * Load a BMP or PNG image from a seekable SDL data stream.
+ *
+ * The image format is detected from the data in the stream.
+ *
+ * The new surface should be freed with SDL_DestroySurface(). Not doing so
+ * will result in a memory leak.
+ *
+ * \param src the data stream for the surface.
+ * \param closeio if true, calls SDL_CloseIO() on `src` before returning, even
+ *                in the case of an error.
+ * \returns a pointer to a new SDL_Surface structure or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroySurface
+ * \sa SDL_LoadBMP_IO
+ * \sa SDL_LoadPNG_IO
+ * \sa SDL_LoadSurface
+ * \sa SDL_LoadSurfaceAsync_IO
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_LoadSurface_IO(SDL_IOStream *src, bool closeio);
+
+/**
+ * Load a BMP or PNG image from a file.
+ *
+ * The image format is detected from the contents of the file.
+ *
+ * The new surface should be freed with SDL_DestroySurface(). Not doing so
+ * will result in a memory leak.
+ *
+ * \param file the BMP or PNG file to load.
+ * \returns a pointer to a new SDL_Surface structure or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroySurface
+ * \sa SDL_LoadSurface_IO
+ * \sa SDL_LoadSurfaceAsync
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_LoadSurface(const char *file);
+
 /**
  * Load a BMP image from a seekable SDL data stream.
  *
@@ -664,6 +772,46 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_LoadPNG(const char *file);
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio);
 
+/**
+ * Save a surface to a seekable SDL data stream in PNG format, with options.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_PNG_SAVE_COMPRESSION_LEVEL_NUMBER`: the compression level, from
+ *   0 to 10. 0 stores the image data without compressing it, 1 is the
+ *   fastest, and 10 is the slowest with the best compression. Defaults to 6,
+ *   which is what SDL_SavePNG_IO() uses.
+ * - `SDL_PROP_PNG_SAVE_FILTER_STRING`: the filter applied to each row before
+ *   compression, "none", "sub", "up", "paeth", or "adaptive" to choose the
+ *   filter for each row that is likely to compress best. Filtering usually
+ *   makes photographic and gradient images much smaller. Defaults to "none".
+ * - `SDL_PROP_PNG_SAVE_THREADS_NUMBER`: the number of threads to compress
+ *   the image with, or 0 to use one per logical CPU core. Large images are
+ *   split into horizontal bands that are compressed separately, which makes
+ *   the file slightly larger. Defaults to 1.
+ *
+ * \param surface the SDL_Surface structure containing the image to be saved.
+ * \param dst a data stream to save to.
+ * \param closeio if true, calls SDL_CloseIO() on `dst` before returning, even
+ *                in the case of an error.
+ * \param props the properties to use, may be 0 to use the defaults.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function can be called on different threads with
+ *               different surfaces.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_LoadPNG_IO
+ * \sa SDL_SavePNG_IO
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SavePNG_IOWithProperties(SDL_Surface *surface, SDL_IOStream *dst, bool closeio, SDL_PropertiesID props);
+
+#define SDL_PROP_PNG_SAVE_COMPRESSION_LEVEL_NUMBER  "SDL.png.save.compression_level"
+#define SDL_PROP_PNG_SAVE_FILTER_STRING             "SDL.png.save.filter"
+#define SDL_PROP_PNG_SAVE_THREADS_NUMBER            "SDL.png.save.threads"
+
 /**
  * Save a surface to a file in PNG format.
  *
@@ -682,6 +830,231 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStre
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SavePNG(SDL_Surface *surface, const char *file);
 
+/**
+ * A queue of images being loaded on background threads.
+ *
+ * Images added to the queue are read and decoded concurrently on a pool of
+ * worker threads. Files are read with SDL_LoadFileAsync(), so the reads
+ * overlap with decoding. Completed surfaces are collected with
+ * SDL_GetSurfaceLoadResult() or SDL_WaitSurfaceLoadResult(), in the order
+ * they finish.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateSurfaceLoadQueue
+ * \sa SDL_LoadSurfaceAsync
+ * \sa SDL_LoadSurfacesAsync
+ * \sa SDL_GetSurfaceLoadResult
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+typedef struct SDL_SurfaceLoadQueue SDL_SurfaceLoadQueue;
+
+/**
+ * Information about an image that has finished loading.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ */
+typedef struct SDL_SurfaceLoadOutcome
+{
+    SDL_Surface *surface;   /**< the loaded image, which the app must free with SDL_DestroySurface(), or NULL if loading failed; check SDL_GetError()! */
+    int index;              /**< the position of the image in the list given to SDL_LoadSurfacesAsync() or SDL_LoadSurfacesAsync_IO(), or 0 for a single image. */
+    void *userdata;         /**< pointer provided by the app when starting the load. */
+} SDL_SurfaceLoadOutcome;
+
+/**
+ * Create a queue for loading images on background threads.
+ *
+ * \param num_threads the number of threads used to decode images, or 0 to
+ *                    use one thread per logical CPU core.
+ * \returns a new queue or NULL if there was an error; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroySurfaceLoadQueue
+ * \sa SDL_LoadSurfaceAsync
+ * \sa SDL_LoadSurfacesAsync
+ */
+extern SDL_DECLSPEC SDL_SurfaceLoadQueue * SDLCALL SDL_CreateSurfaceLoadQueue(int num_threads);
+
+/**
+ * Load a BMP or PNG image from a file, asynchronously.
+ *
+ * This function returns as quickly as possible; it does not wait for the
+ * image to load. If the work begins, even failure is asynchronous: a failing
+ * return value from this function only means the work couldn't start at all.
+ *
+ * \param file the BMP or PNG file to load.
+ * \param queue the queue that will receive the loaded image.
+ * \param userdata an app-defined pointer that will be provided with the
+ *                 loaded image.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSurfaceLoadResult
+ * \sa SDL_LoadSurface
+ * \sa SDL_LoadSurfacesAsync
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_LoadSurfaceAsync(const char *file, SDL_SurfaceLoadQueue *queue, void *userdata);
+
+/**
+ * Load a BMP or PNG image from a seekable SDL data stream, asynchronously.
+ *
+ * The stream is read on a worker thread, so the app must not use it until
+ * the image has been loaded.
+ *
+ * \param src the data stream for the image.
+ * \param closeio if true, calls SDL_CloseIO() on `src` once the image has
+ *                been loaded, even in the case of an error.
+ * \param queue the queue that will receive the loaded image.
+ * \param userdata an app-defined pointer that will be provided with the
+ *                 loaded image.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSurfaceLoadResult
+ * \sa SDL_LoadSurface_IO
+ * \sa SDL_LoadSurfacesAsync_IO
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_LoadSurfaceAsync_IO(SDL_IOStream *src, bool closeio, SDL_SurfaceLoadQueue *queue, void *userdata);
+
+/**
+ * Load a list of BMP or PNG images from files, asynchronously.
+ *
+ * Each file produces exactly one outcome, with `index` set to its position
+ * in `files`. Files that can't be opened are reported as failed outcomes
+ * rather than failing the whole call.
+ *
+ * \param files an array of BMP or PNG files to load.
+ * \param num_files the number of files in `files`.
+ * \param queue the queue that will receive the loaded images.
+ * \param userdata an app-defined pointer that will be provided with each
+ *                 loaded image.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSurfaceLoadResult
+ * \sa SDL_LoadSurfaceAsync
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_LoadSurfacesAsync(const char * const *files, int num_files, SDL_SurfaceLoadQueue *queue, void *userdata);
+
+/**
+ * Load a list of BMP or PNG images from seekable SDL data streams,
+ * asynchronously.
+ *
+ * Each stream produces exactly one outcome, with `index` set to its position
+ * in `streams`. The streams are read on worker threads, so the app must not
+ * use them until their images have been loaded.
+ *
+ * \param streams an array of data streams to load images from.
+ * \param num_streams the number of streams in `streams`.
+ * \param closeio if true, calls SDL_CloseIO() on each stream once its image
+ *                has been loaded, even in the case of an error.
+ * \param queue the queue that will receive the loaded images.
+ * \param userdata an app-defined pointer that will be provided with each
+ *                 loaded image.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSurfaceLoadResult
+ * \sa SDL_LoadSurfaceAsync_IO
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_LoadSurfacesAsync_IO(SDL_IOStream * const *streams, int num_streams, bool closeio, SDL_SurfaceLoadQueue *queue, void *userdata);
+
+/**
+ * Query a surface load queue for a loaded image.
+ *
+ * If an image has finished loading, this will return true and fill in
+ * `outcome` with the details. If no image has finished loading, this
+ * function will return false. This function does not block.
+ *
+ * If the image failed to load, `outcome->surface` is NULL and SDL_GetError()
+ * will describe the failure.
+ *
+ * It is safe for multiple threads to call this function on the same queue at
+ * once; a loaded image will only go to one of the threads.
+ *
+ * \param queue the surface load queue to query.
+ * \param outcome details of a loaded image will be written here. May not be
+ *                NULL.
+ * \returns true if an image has finished loading, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_WaitSurfaceLoadResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome);
+
+/**
+ * Block until a surface load queue has a loaded image.
+ *
+ * If an image has finished loading, this will return true and fill in
+ * `outcome` with the details. If no image finishes loading before the
+ * timeout, this function will return false.
+ *
+ * If the image failed to load, `outcome->surface` is NULL and SDL_GetError()
+ * will describe the failure.
+ *
+ * Waiting indefinitely on a queue with no images being loaded will never
+ * return.
+ *
+ * \param queue the surface load queue to wait on.
+ * \param outcome details of a loaded image will be written here. May not be
+ *                NULL.
+ * \param timeoutMS the maximum time to wait, in milliseconds, or -1 to wait
+ *                  indefinitely.
+ * \returns true if an image has finished loading, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSurfaceLoadResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_WaitSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome, Sint32 timeoutMS);
+
+/**
+ * Destroy a surface load queue.
+ *
+ * Images that are still being read or decoded are waited for, and any
+ * images that haven't been collected are freed. Streams that were passed
+ * with `closeio` set to true are closed.
+ *
+ * \param queue the surface load queue to destroy.
+ *
+ * \threadsafety It is safe to call this function from any thread, so long as
+ *               no other thread is using the queue.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateSurfaceLoadQueue
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroySurfaceLoadQueue(SDL_SurfaceLoadQueue *queue);
+
 /**
  * Set the RLE acceleration hint for a surface.
  *
@@ -998,6 +1371,9 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_RotateSurface(SDL_Surface *surface
  * If the original surface has alternate images, the new surface will have a
  * reference to them as well.
  *
+ * If SDL_HINT_SURFACE_DUPLICATE_COPY_ON_WRITE is enabled, the new surface
+ * shares the pixels of the original until either surface is modified.
+ *
  * The returned surface should be freed with SDL_DestroySurface().
  *
  * \param surface the surface to duplicate.
@@ -1194,6 +1570,58 @@ extern SDL_DECLSPEC bool SDLCALL SDL_PremultiplyAlpha(int width, int height, SDL
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PremultiplySurfaceAlpha(SDL_Surface *surface, bool linear);
 
+/**
+ * Unpremultiply the alpha on a block of pixels.
+ *
+ * This is the inverse of SDL_PremultiplyAlpha(), useful for pixels read back
+ * from a renderer or other source that produces premultiplied alpha. Pixels
+ * with an alpha of 0 have their color components set to 0.
+ *
+ * This is safe to use with src == dst, but not for other overlapping areas.
+ *
+ * \param width the width of the block to convert, in pixels.
+ * \param height the height of the block to convert, in pixels.
+ * \param src_format an SDL_PixelFormat value of the `src` pixels format.
+ * \param src a pointer to the source pixels.
+ * \param src_pitch the pitch of the source pixels, in bytes.
+ * \param dst_format an SDL_PixelFormat value of the `dst` pixels format.
+ * \param dst a pointer to be filled in with unpremultiplied pixel data.
+ * \param dst_pitch the pitch of the destination pixels, in bytes.
+ * \param linear true to convert from sRGB to linear space for the alpha
+ *               division, false to do division in sRGB space. This should
+ *               match the value used when the alpha was premultiplied.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety The same destination pixels should not be used from two
+ *               threads at once. It is safe to use the same source pixels
+ *               from multiple threads.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_PremultiplyAlpha
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_UnpremultiplyAlpha(int width, int height, SDL_PixelFormat src_format, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch, bool linear);
+
+/**
+ * Unpremultiply the alpha in a surface.
+ *
+ * \param surface the surface to modify.
+ * \param linear true to convert from sRGB to linear space for the alpha
+ *               division, false to do division in sRGB space. This should
+ *               match the value used when the alpha was premultiplied.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function can be called on different threads with
+ *               different surfaces.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_PremultiplySurfaceAlpha
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_UnpremultiplySurfaceAlpha(SDL_Surface *surface, bool linear);
+
 /**
  * Clear a surface with a specific color, with floating point precision.
  *
@@ -1596,9 +2024,34 @@ extern SDL_DECLSPEC Uint32 SDLCALL SDL_MapSurfaceRGB(SDL_Surface *surface, Uint8
  * \since This function is available since SDL 3.2.0.
  *
  * \sa SDL_MapSurfaceRGB
+ * \sa SDL_MapSurfaceRGBAArray
  */
 extern SDL_DECLSPEC Uint32 SDLCALL SDL_MapSurfaceRGBA(SDL_Surface *surface, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 
+/**
+ * Map an array of RGBA colors to pixel values for a surface.
+ *
+ * This produces the same pixel values as calling SDL_MapSurfaceRGBA() on each
+ * color, but is much faster for large arrays.
+ *
+ * \param surface the surface to use for the pixel format and palette.
+ * \param colors an array of `count` colors to map.
+ * \param pixels an array of `count` pixel values filled in with the mapped
+ *               colors.
+ * \param count the number of colors to map.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function can be called on different threads with
+ *               different surfaces.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_MapRGBAArray
+ * \sa SDL_MapSurfaceRGBA
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_MapSurfaceRGBAArray(SDL_Surface *surface, const SDL_Color *colors, Uint32 *pixels, int count);
+
 /**
  * Retrieves a single pixel from a surface.
  *
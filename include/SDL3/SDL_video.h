@@ -1554,6 +1554,15 @@ extern SDL_DECLSPEC SDL_Window * SDLCALL SDL_GetWindowParent(SDL_Window *window)
  * - `SDL_PROP_WINDOW_OPENVR_OVERLAY_ID_NUMBER`: the OpenVR Overlay Handle ID
  *   for the associated overlay window.
  *
+ * On the offscreen driver:
+ *
+ * - `SDL_PROP_WINDOW_OFFSCREEN_SAVED_FRAMES_NUMBER`: the number of frames
+ *   saved or queued for saving, if SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES is
+ *   enabled
+ * - `SDL_PROP_WINDOW_OFFSCREEN_DROPPED_FRAMES_NUMBER`: the number of frames
+ *   that weren't saved because all the buffers were full, see
+ *   SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_DROP
+ *
  * On Vivante:
  *
  * - `SDL_PROP_WINDOW_VIVANTE_DISPLAY_POINTER`: the EGLNativeDisplayType
@@ -1641,6 +1650,8 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetWindowProperties(SDL_Window
 #define SDL_PROP_WINDOW_COCOA_WINDOW_POINTER                        "SDL.window.cocoa.window"
 #define SDL_PROP_WINDOW_COCOA_METAL_VIEW_TAG_NUMBER                 "SDL.window.cocoa.metal_view_tag"
 #define SDL_PROP_WINDOW_OPENVR_OVERLAY_ID_NUMBER                    "SDL.window.openvr.overlay_id"
+#define SDL_PROP_WINDOW_OFFSCREEN_SAVED_FRAMES_NUMBER               "SDL.window.offscreen.saved_frames"
+#define SDL_PROP_WINDOW_OFFSCREEN_DROPPED_FRAMES_NUMBER             "SDL.window.offscreen.dropped_frames"
 #define SDL_PROP_WINDOW_VIVANTE_DISPLAY_POINTER                     "SDL.window.vivante.display"
 #define SDL_PROP_WINDOW_VIVANTE_WINDOW_POINTER                      "SDL.window.vivante.window"
 #define SDL_PROP_WINDOW_VIVANTE_SURFACE_POINTER                     "SDL.window.vivante.surface"
@@ -2453,6 +2464,10 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetWindowSurfaceVSync(SDL_Window *window, i
  *
  * This function is equivalent to the SDL 1.2 API SDL_Flip().
  *
+ * If damage tracking is enabled with SDL_SetWindowSurfaceDamageTracking(),
+ * only the areas of the surface that have changed since the last update are
+ * copied.
+ *
  * \param window the window to update.
  * \returns true on success or false on failure; call SDL_GetError() for more
  *          information.
@@ -2462,6 +2477,7 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetWindowSurfaceVSync(SDL_Window *window, i
  * \since This function is available since SDL 3.2.0.
  *
  * \sa SDL_GetWindowSurface
+ * \sa SDL_SetWindowSurfaceDamageTracking
  * \sa SDL_UpdateWindowSurfaceRects
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_UpdateWindowSurface(SDL_Window *window);
@@ -2495,6 +2511,80 @@ extern SDL_DECLSPEC bool SDLCALL SDL_UpdateWindowSurface(SDL_Window *window);
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_UpdateWindowSurfaceRects(SDL_Window *window, const SDL_Rect *rects, int numrects);
 
+/**
+ * Set whether changes to the window surface are tracked.
+ *
+ * When damage tracking is enabled, SDL records the areas of the window
+ * surface written by blits, fills, SDL_ClearSurface(), SDL_WriteSurfacePixel()
+ * and other SDL surface functions, and SDL_UpdateWindowSurface() only copies
+ * those areas to the screen. Overlapping areas are merged together.
+ *
+ * Changes made by writing to the surface pixels directly aren't tracked, you
+ * should report them with SDL_AddWindowSurfaceDamage().
+ *
+ * The whole surface is considered changed when tracking is enabled and when
+ * the window surface is recreated.
+ *
+ * Damage tracking is disabled by default.
+ *
+ * \param window the window to change.
+ * \param enabled true to track changes to the window surface, false to copy
+ *                the whole surface in SDL_UpdateWindowSurface().
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddWindowSurfaceDamage
+ * \sa SDL_GetWindowSurfaceDamage
+ * \sa SDL_UpdateWindowSurface
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetWindowSurfaceDamageTracking(SDL_Window *window, bool enabled);
+
+/**
+ * Mark an area of the window surface as changed.
+ *
+ * This is used to report changes made by writing to the surface pixels
+ * directly when damage tracking is enabled.
+ *
+ * \param window the window to change.
+ * \param rect the SDL_Rect structure representing the area that changed, in
+ *             pixels, or NULL for the entire surface.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetWindowSurfaceDamageTracking
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_AddWindowSurfaceDamage(SDL_Window *window, const SDL_Rect *rect);
+
+/**
+ * Get the areas of the window surface that have changed since the last
+ * update.
+ *
+ * The areas are cleared by SDL_UpdateWindowSurface(), but not by
+ * SDL_UpdateWindowSurfaceRects().
+ *
+ * \param window the window to query.
+ * \param count a pointer filled in with the number of rectangles returned,
+ *              may be NULL.
+ * \returns an array of non-overlapping rectangles, which should be freed
+ *          with SDL_free(), or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetWindowSurfaceDamageTracking
+ */
+extern SDL_DECLSPEC SDL_Rect * SDLCALL SDL_GetWindowSurfaceDamage(SDL_Window *window, int *count);
+
 /**
  * Destroy the surface associated with the window.
  *
@@ -679,6 +679,7 @@ void SDL_Quit(void)
     SDL_SetObjectsInvalid();
     SDL_AssertionsQuit();
 
+    SDL_QuitSurfacePool();
     SDL_QuitPixelFormatDetails();
 
     SDL_QuitCPUInfo();
@@ -1294,3 +1294,54 @@
 #define SDL_GetPenDeviceType SDL_GetPenDeviceType_REAL
 #define SDL_CreateAnimatedCursor SDL_CreateAnimatedCursor_REAL
 #define SDL_RotateSurface SDL_RotateSurface_REAL
+#define SDL_UnpremultiplyAlpha SDL_UnpremultiplyAlpha_REAL
+#define SDL_UnpremultiplySurfaceAlpha SDL_UnpremultiplySurfaceAlpha_REAL
+#define SDL_GetSurfacePoolStats SDL_GetSurfacePoolStats_REAL
+#define SDL_CreateSurfaceView SDL_CreateSurfaceView_REAL
+#define SDL_SetWindowSurfaceDamageTracking SDL_SetWindowSurfaceDamageTracking_REAL
+#define SDL_AddWindowSurfaceDamage SDL_AddWindowSurfaceDamage_REAL
+#define SDL_GetWindowSurfaceDamage SDL_GetWindowSurfaceDamage_REAL
+#define SDL_CreateRegion SDL_CreateRegion_REAL
+#define SDL_DestroyRegion SDL_DestroyRegion_REAL
+#define SDL_CopyRegion SDL_CopyRegion_REAL
+#define SDL_ClearRegion SDL_ClearRegion_REAL
+#define SDL_RegionEmpty SDL_RegionEmpty_REAL
+#define SDL_GetRegionBounds SDL_GetRegionBounds_REAL
+#define SDL_GetRegionRects SDL_GetRegionRects_REAL
+#define SDL_PointInRegion SDL_PointInRegion_REAL
+#define SDL_TranslateRegion SDL_TranslateRegion_REAL
+#define SDL_UnionRegion SDL_UnionRegion_REAL
+#define SDL_IntersectRegion SDL_IntersectRegion_REAL
+#define SDL_SubtractRegion SDL_SubtractRegion_REAL
+#define SDL_UnionRegionRect SDL_UnionRegionRect_REAL
+#define SDL_IntersectRegionRect SDL_IntersectRegionRect_REAL
+#define SDL_SubtractRegionRect SDL_SubtractRegionRect_REAL
+#define SDL_UnionRegionRects SDL_UnionRegionRects_REAL
+#define SDL_SavePNG_IOWithProperties SDL_SavePNG_IOWithProperties_REAL
+#define SDL_LoadSurface_IO SDL_LoadSurface_IO_REAL
+#define SDL_LoadSurface SDL_LoadSurface_REAL
+#define SDL_CreateSurfaceLoadQueue SDL_CreateSurfaceLoadQueue_REAL
+#define SDL_LoadSurfaceAsync SDL_LoadSurfaceAsync_REAL
+#define SDL_LoadSurfaceAsync_IO SDL_LoadSurfaceAsync_IO_REAL
+#define SDL_LoadSurfacesAsync SDL_LoadSurfacesAsync_REAL
+#define SDL_LoadSurfacesAsync_IO SDL_LoadSurfacesAsync_IO_REAL
+#define SDL_GetSurfaceLoadResult SDL_GetSurfaceLoadResult_REAL
+#define SDL_WaitSurfaceLoadResult SDL_WaitSurfaceLoadResult_REAL
+#define SDL_DestroySurfaceLoadQueue SDL_DestroySurfaceLoadQueue_REAL
+#define SDL_MapRGBAArray SDL_MapRGBAArray_REAL
+#define SDL_GetRGBAArray SDL_GetRGBAArray_REAL
+#define SDL_MapSurfaceRGBAArray SDL_MapSurfaceRGBAArray_REAL
+#define SDL_CreateTextureAtlas SDL_CreateTextureAtlas_REAL
+#define SDL_AddSurfaceToTextureAtlas SDL_AddSurfaceToTextureAtlas_REAL
+#define SDL_GetTextureAtlasEntry SDL_GetTextureAtlasEntry_REAL
+#define SDL_RemoveFromTextureAtlas SDL_RemoveFromTextureAtlas_REAL
+#define SDL_GetTextureAtlasUsage SDL_GetTextureAtlasUsage_REAL
+#define SDL_DestroyTextureAtlas SDL_DestroyTextureAtlas_REAL
+#define SDL_StartRenderRecording SDL_StartRenderRecording_REAL
+#define SDL_EndRenderRecording SDL_EndRenderRecording_REAL
+#define SDL_ReplayRenderList SDL_ReplayRenderList_REAL
+#define SDL_DestroyRenderList SDL_DestroyRenderList_REAL
+#define SDL_RenderReadPixelsAsync SDL_RenderReadPixelsAsync_REAL
+#define SDL_RenderSprites SDL_RenderSprites_REAL
+#define SDL_GetGPUPipelineCacheData SDL_GetGPUPipelineCacheData_REAL
+#define SDL_SetTextureAtlasMaxTextures SDL_SetTextureAtlasMaxTextures_REAL
@@ -1302,3 +1302,54 @@ SDL_DYNAPI_PROC(int,SDL_GetSystemPageSize,(void),(),return)
 SDL_DYNAPI_PROC(SDL_PenDeviceType,SDL_GetPenDeviceType,(SDL_PenID a),(a),return)
 SDL_DYNAPI_PROC(SDL_Cursor*,SDL_CreateAnimatedCursor,(SDL_CursorFrameInfo *a,int b,int c,int d),(a,b,c,d),return)
 SDL_DYNAPI_PROC(SDL_Surface*,SDL_RotateSurface,(SDL_Surface *a,float b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_UnpremultiplyAlpha,(int a,int b,SDL_PixelFormat c,const void *d,int e,SDL_PixelFormat f,void *g,int h,bool i),(a,b,c,d,e,f,g,h,i),return)
+SDL_DYNAPI_PROC(bool,SDL_UnpremultiplySurfaceAlpha,(SDL_Surface *a,bool b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetSurfacePoolStats,(Uint64 *a,Uint64 *b,Uint64 *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_CreateSurfaceView,(SDL_Surface *a,const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_SetWindowSurfaceDamageTracking,(SDL_Window *a,bool b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_AddWindowSurfaceDamage,(SDL_Window *a,const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Rect*,SDL_GetWindowSurfaceDamage,(SDL_Window *a,int *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Region*,SDL_CreateRegion,(void),(),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyRegion,(SDL_Region *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_CopyRegion,(SDL_Region *a,const SDL_Region *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_ClearRegion,(SDL_Region *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_RegionEmpty,(const SDL_Region *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_GetRegionBounds,(const SDL_Region *a,SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(const SDL_Rect*,SDL_GetRegionRects,(SDL_Region *a,int *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_PointInRegion,(const SDL_Point *a,const SDL_Region *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_TranslateRegion,(SDL_Region *a,int b,int c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_UnionRegion,(SDL_Region *a,const SDL_Region *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_IntersectRegion,(SDL_Region *a,const SDL_Region *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_SubtractRegion,(SDL_Region *a,const SDL_Region *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_UnionRegionRect,(SDL_Region *a,const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_IntersectRegionRect,(SDL_Region *a,const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_SubtractRegionRect,(SDL_Region *a,const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_UnionRegionRects,(SDL_Region *a,const SDL_Rect *b,int c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_SavePNG_IOWithProperties,(SDL_Surface *a,SDL_IOStream *b,bool c,SDL_PropertiesID d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_LoadSurface_IO,(SDL_IOStream *a,bool b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_LoadSurface,(const char *a),(a),return)
+SDL_DYNAPI_PROC(SDL_SurfaceLoadQueue*,SDL_CreateSurfaceLoadQueue,(int a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_LoadSurfaceAsync,(const char *a,SDL_SurfaceLoadQueue *b,void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_LoadSurfaceAsync_IO,(SDL_IOStream *a,bool b,SDL_SurfaceLoadQueue *c,void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_LoadSurfacesAsync,(const char * const*a,int b,SDL_SurfaceLoadQueue *c,void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_LoadSurfacesAsync_IO,(SDL_IOStream * const*a,int b,bool c,SDL_SurfaceLoadQueue *d,void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(bool,SDL_GetSurfaceLoadResult,(SDL_SurfaceLoadQueue *a,SDL_SurfaceLoadOutcome *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_WaitSurfaceLoadResult,(SDL_SurfaceLoadQueue *a,SDL_SurfaceLoadOutcome *b,Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_DestroySurfaceLoadQueue,(SDL_SurfaceLoadQueue *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_MapRGBAArray,(const SDL_PixelFormatDetails *a,const SDL_Palette *b,const SDL_Color *c,Uint32 *d,int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(bool,SDL_GetRGBAArray,(const Uint32 *a,const SDL_PixelFormatDetails *b,const SDL_Palette *c,SDL_Color *d,int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(bool,SDL_MapSurfaceRGBAArray,(SDL_Surface *a,const SDL_Color *b,Uint32 *c,int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_TextureAtlas*,SDL_CreateTextureAtlas,(SDL_Renderer *a,SDL_PixelFormat b,int c,int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_TextureAtlasEntryID,SDL_AddSurfaceToTextureAtlas,(SDL_TextureAtlas *a,SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetTextureAtlasEntry,(SDL_TextureAtlas *a,SDL_TextureAtlasEntryID b,SDL_Texture **c,SDL_FRect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_RemoveFromTextureAtlas,(SDL_TextureAtlas *a,SDL_TextureAtlasEntryID b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetTextureAtlasUsage,(SDL_TextureAtlas *a,int *b,float *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyTextureAtlas,(SDL_TextureAtlas *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_StartRenderRecording,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(SDL_RenderList*,SDL_EndRenderRecording,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_ReplayRenderList,(SDL_Renderer *a,SDL_RenderList *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyRenderList,(SDL_RenderList *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_RenderReadPixelsAsync,(SDL_Renderer *a,const SDL_Rect *b,SDL_RenderReadPixelsCallback c,void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_RenderSprites,(SDL_Renderer *a,SDL_Texture *b,const SDL_RenderSprite *c,int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void*,SDL_GetGPUPipelineCacheData,(SDL_GPUDevice *a,size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_SetTextureAtlasMaxTextures,(SDL_TextureAtlas *a,int b),(a,b),return)
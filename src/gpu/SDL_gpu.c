@@ -792,6 +792,26 @@ SDL_PropertiesID SDL_GetGPUDeviceProperties(SDL_GPUDevice *device)
     return device->GetDeviceProperties(device);
 }
 
+void *SDL_GetGPUPipelineCacheData(SDL_GPUDevice *device, size_t *size)
+{
+    if (size) {
+        *size = 0;
+    }
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    CHECK_PARAM(size == NULL) {
+        SDL_InvalidParamError("size");
+        return NULL;
+    }
+
+    if (!device->GetPipelineCacheData) {
+        SDL_Unsupported();
+        return NULL;
+    }
+    return device->GetPipelineCacheData(device, size);
+}
+
 Uint32 SDL_GPUTextureFormatTexelBlockSize(
     SDL_GPUTextureFormat format)
 {
@@ -671,6 +671,9 @@ struct SDL_GPUDevice
 
     SDL_PropertiesID (*GetDeviceProperties)(SDL_GPUDevice *device);
 
+    // Optional, NULL if the driver has no pipeline cache
+    void *(*GetPipelineCacheData)(SDL_GPUDevice *device, size_t *size);
+
     // State Creation
 
     SDL_GPUComputePipeline *(*CreateComputePipeline)(
@@ -1103,6 +1103,8 @@ struct VulkanRenderer
     VkPhysicalDeviceDriverPropertiesKHR physicalDeviceDriverProperties;
     VkPhysicalDeviceFeatures desiredDeviceFeatures;
     VkDevice logicalDevice;
+    VkPipelineCache pipelineCache;
+    char *pipelineCacheFile;
     Uint8 integratedMemoryNotification;
     Uint8 outOfDeviceLocalMemoryWarning;
     Uint8 outofBARMemoryWarning;
@@ -4890,6 +4892,161 @@ static bool VULKAN_INTERNAL_EndCommandBuffer(
     return true;
 }
 
+// Pipeline cache
+
+static bool VULKAN_INTERNAL_IsPipelineCacheCompatible(
+    VulkanRenderer *renderer,
+    const void *data,
+    size_t size)
+{
+    const VkPhysicalDeviceProperties *properties = &renderer->physicalDeviceProperties.properties;
+    VkPipelineCacheHeaderVersionOne header;
+
+    if (size < sizeof(header)) {
+        return false;
+    }
+    SDL_memcpy(&header, data, sizeof(header));
+
+    // The cache UUID changes whenever the driver can't reuse the data, e.g. after a driver update
+    return header.headerSize >= sizeof(header) &&
+           header.headerSize <= size &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == properties->vendorID &&
+           header.deviceID == properties->deviceID &&
+           SDL_memcmp(header.pipelineCacheUUID, properties->pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+static void VULKAN_INTERNAL_CreatePipelineCache(
+    VulkanRenderer *renderer,
+    SDL_PropertiesID props)
+{
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo;
+    const void *initialData = SDL_GetPointerProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER, NULL);
+    size_t initialDataSize = (size_t)SDL_GetNumberProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_SIZE_NUMBER, 0);
+    const char *file = SDL_GetStringProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_FILE_STRING, NULL);
+    void *fileData = NULL;
+    VkResult vulkanResult;
+
+    if (file) {
+        renderer->pipelineCacheFile = SDL_strdup(file);
+        if (!initialData) {
+            // The file doesn't exist the first time around, that's fine
+            fileData = SDL_LoadFile(file, &initialDataSize);
+            initialData = fileData;
+        }
+    }
+
+    if (initialData && !VULKAN_INTERNAL_IsPipelineCacheCompatible(renderer, initialData, initialDataSize)) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_GPU, "Ignoring pipeline cache data from a different device or driver");
+        initialData = NULL;
+    }
+    if (!initialData) {
+        initialDataSize = 0;
+    }
+
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.pNext = NULL;
+    pipelineCacheCreateInfo.flags = 0;
+    pipelineCacheCreateInfo.initialDataSize = initialDataSize;
+    pipelineCacheCreateInfo.pInitialData = initialData;
+
+    vulkanResult = renderer->vkCreatePipelineCache(
+        renderer->logicalDevice,
+        &pipelineCacheCreateInfo,
+        NULL,
+        &renderer->pipelineCache);
+
+    if (vulkanResult != VK_SUCCESS && initialData) {
+        // Some drivers reject data they don't like outright, start over with an empty cache
+        pipelineCacheCreateInfo.initialDataSize = 0;
+        pipelineCacheCreateInfo.pInitialData = NULL;
+        vulkanResult = renderer->vkCreatePipelineCache(
+            renderer->logicalDevice,
+            &pipelineCacheCreateInfo,
+            NULL,
+            &renderer->pipelineCache);
+    }
+
+    if (vulkanResult != VK_SUCCESS) {
+        // Pipelines can still be created without a cache, they're just slower
+        renderer->pipelineCache = VK_NULL_HANDLE;
+    }
+
+    SDL_free(fileData);
+}
+
+static void *VULKAN_INTERNAL_GetPipelineCacheData(
+    VulkanRenderer *renderer,
+    size_t *size)
+{
+    void *data;
+    VkResult vulkanResult;
+
+    *size = 0;
+
+    if (renderer->pipelineCache == VK_NULL_HANDLE) {
+        SDL_SetError("The pipeline cache couldn't be created");
+        return NULL;
+    }
+
+    vulkanResult = renderer->vkGetPipelineCacheData(
+        renderer->logicalDevice,
+        renderer->pipelineCache,
+        size,
+        NULL);
+    CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkGetPipelineCacheData, NULL);
+
+    data = SDL_malloc(*size ? *size : 1);
+    if (!data) {
+        *size = 0;
+        return NULL;
+    }
+
+    // If pipelines were added in the meantime, VK_INCOMPLETE still returns a valid cache without them
+    vulkanResult = renderer->vkGetPipelineCacheData(
+        renderer->logicalDevice,
+        renderer->pipelineCache,
+        size,
+        data);
+    if (vulkanResult != VK_SUCCESS && vulkanResult != VK_INCOMPLETE) {
+        SDL_free(data);
+        *size = 0;
+        CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkGetPipelineCacheData, NULL);
+    }
+    return data;
+}
+
+static void VULKAN_INTERNAL_SavePipelineCache(
+    VulkanRenderer *renderer)
+{
+    size_t size;
+    void *data = VULKAN_INTERNAL_GetPipelineCacheData(renderer, &size);
+
+    if (data) {
+        if (!SDL_SaveFile(renderer->pipelineCacheFile, data, size)) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_GPU, "Couldn't save pipeline cache: %s", SDL_GetError());
+        }
+        SDL_free(data);
+    }
+}
+
+static void VULKAN_INTERNAL_DestroyPipelineCache(
+    VulkanRenderer *renderer)
+{
+    if (renderer->pipelineCache != VK_NULL_HANDLE) {
+        if (renderer->pipelineCacheFile) {
+            VULKAN_INTERNAL_SavePipelineCache(renderer);
+        }
+        renderer->vkDestroyPipelineCache(
+            renderer->logicalDevice,
+            renderer->pipelineCache,
+            NULL);
+        renderer->pipelineCache = VK_NULL_HANDLE;
+    }
+    SDL_free(renderer->pipelineCacheFile);
+    renderer->pipelineCacheFile = NULL;
+}
+
 static void VULKAN_DestroyDevice(
     SDL_GPUDevice *device)
 {
@@ -4986,6 +5143,8 @@ static void VULKAN_DestroyDevice(
     SDL_DestroyMutex(renderer->descriptorSetLayoutFetchLock);
     SDL_DestroyMutex(renderer->windowLock);
 
+    VULKAN_INTERNAL_DestroyPipelineCache(renderer);
+
     renderer->vkDestroyDevice(renderer->logicalDevice, NULL);
     renderer->vkDestroyInstance(renderer->instance, NULL);
 
@@ -5003,6 +5162,14 @@ static SDL_PropertiesID VULKAN_GetDeviceProperties(
     return renderer->props;
 }
 
+static void *VULKAN_GetPipelineCacheData(
+    SDL_GPUDevice *device,
+    size_t *size)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)device->driverData;
+    return VULKAN_INTERNAL_GetPipelineCacheData(renderer, size);
+}
+
 static DescriptorSetCache *VULKAN_INTERNAL_AcquireDescriptorSetCache(
     VulkanRenderer *renderer)
 {
@@ -6546,10 +6713,9 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
     vkPipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
     vkPipelineCreateInfo.basePipelineIndex = 0;
 
-    // TODO: enable pipeline caching
     vulkanResult = renderer->vkCreateGraphicsPipelines(
         renderer->logicalDevice,
-        VK_NULL_HANDLE,
+        renderer->pipelineCache,
         1,
         &vkPipelineCreateInfo,
         NULL,
@@ -6684,7 +6850,7 @@ static SDL_GPUComputePipeline *VULKAN_CreateComputePipeline(
 
     vulkanResult = renderer->vkCreateComputePipelines(
         renderer->logicalDevice,
-        (VkPipelineCache)VK_NULL_HANDLE,
+        renderer->pipelineCache,
         1,
         &vkShaderCreateInfo,
         NULL,
@@ -11954,6 +12120,7 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
     // FIXME: just move this into this function
     result = (SDL_GPUDevice *)SDL_calloc(1, sizeof(SDL_GPUDevice));
     ASSIGN_DRIVER(VULKAN)
+    result->GetPipelineCacheData = VULKAN_GetPipelineCacheData;
 
     result->driverData = (SDL_GPURenderer *)renderer;
     result->shader_formats = SDL_GPU_SHADERFORMAT_SPIRV;
@@ -12077,6 +12244,8 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
         VULKAN_INTERNAL_DescriptorSetLayoutHashDestroy,
         (void *)renderer);
 
+    VULKAN_INTERNAL_CreatePipelineCache(renderer, props);
+
     // Initialize fence pool
 
     renderer->fencePool.lock = SDL_CreateMutex();
@@ -307,6 +307,152 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+// Recorded vertex data is appended at this alignment, which is the strictest alignment any backend asks for
+#define RENDER_LIST_ALIGNMENT 256
+
+struct SDL_RenderList
+{
+    SDL_Renderer *renderer;
+    bool valid;
+    SDL_RenderCommand *commands;
+    int num_commands;
+    int max_commands;
+    Uint8 *vertex_data;
+    size_t vertex_data_used;
+    size_t vertex_data_allocation;
+    const void **objects; // the textures and GPU render states used by the commands
+    int num_objects;
+    int max_objects;
+    SDL_RenderList *next;
+};
+
+static bool AddRenderListObject(SDL_RenderList *list, const void *object)
+{
+    for (int i = 0; i < list->num_objects; ++i) {
+        if (list->objects[i] == object) {
+            return true;
+        }
+    }
+    if (list->num_objects == list->max_objects) {
+        int max_objects = list->max_objects ? list->max_objects * 2 : 8;
+        const void **objects = (const void **)SDL_realloc(list->objects, max_objects * sizeof(*objects));
+        if (!objects) {
+            return false;
+        }
+        list->objects = objects;
+        list->max_objects = max_objects;
+    }
+    list->objects[list->num_objects++] = object;
+    return true;
+}
+
+static void RebaseRenderCommand(SDL_RenderCommand *cmd, size_t offset)
+{
+    switch (cmd->command) {
+    case SDL_RENDERCMD_SETVIEWPORT:
+        cmd->data.viewport.first += offset;
+        break;
+    case SDL_RENDERCMD_SETDRAWCOLOR:
+    case SDL_RENDERCMD_CLEAR:
+        cmd->data.color.first += offset;
+        break;
+    case SDL_RENDERCMD_DRAW_POINTS:
+    case SDL_RENDERCMD_DRAW_LINES:
+    case SDL_RENDERCMD_FILL_RECTS:
+    case SDL_RENDERCMD_COPY:
+    case SDL_RENDERCMD_COPY_EX:
+    case SDL_RENDERCMD_GEOMETRY:
+        cmd->data.draw.first += offset;
+        break;
+    default:
+        break;
+    }
+}
+
+static bool IsRenderDrawCommand(const SDL_RenderCommand *cmd)
+{
+    return cmd->command >= SDL_RENDERCMD_DRAW_POINTS;
+}
+
+// Copy the queued commands into the list, before the backend gets a chance to modify them
+static bool AppendToRenderList(SDL_RenderList *list, SDL_Renderer *renderer)
+{
+    const size_t aligner = (list->vertex_data_used % RENDER_LIST_ALIGNMENT) ? (RENDER_LIST_ALIGNMENT - (list->vertex_data_used % RENDER_LIST_ALIGNMENT)) : 0;
+    const size_t offset = list->vertex_data_used + aligner;
+    const size_t needed = offset + renderer->vertex_data_used;
+
+    if (!list->valid) {
+        return true;
+    }
+
+    if (needed > list->vertex_data_allocation) {
+        size_t allocation = list->vertex_data_allocation ? list->vertex_data_allocation : 1024;
+        Uint8 *vertex_data;
+        while (allocation < needed) {
+            allocation *= 2;
+        }
+        vertex_data = (Uint8 *)SDL_realloc(list->vertex_data, allocation);
+        if (!vertex_data) {
+            list->valid = false;
+            return false;
+        }
+        list->vertex_data = vertex_data;
+        list->vertex_data_allocation = allocation;
+    }
+    if (renderer->vertex_data_used > 0) {
+        SDL_memset(list->vertex_data + list->vertex_data_used, 0, aligner);
+        SDL_memcpy(list->vertex_data + offset, renderer->vertex_data, renderer->vertex_data_used);
+        list->vertex_data_used = needed;
+    }
+
+    for (SDL_RenderCommand *cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        SDL_RenderCommand *copy;
+
+        if (cmd->command == SDL_RENDERCMD_NO_OP) {
+            continue;
+        }
+        if (list->num_commands == list->max_commands) {
+            int max_commands = list->max_commands ? list->max_commands * 2 : 32;
+            SDL_RenderCommand *commands = (SDL_RenderCommand *)SDL_realloc(list->commands, max_commands * sizeof(*commands));
+            if (!commands) {
+                list->valid = false;
+                return false;
+            }
+            list->commands = commands;
+            list->max_commands = max_commands;
+        }
+        copy = &list->commands[list->num_commands++];
+        SDL_copyp(copy, cmd);
+        copy->next = NULL;
+        RebaseRenderCommand(copy, offset);
+
+        if (IsRenderDrawCommand(cmd)) {
+            if ((cmd->data.draw.texture && !AddRenderListObject(list, cmd->data.draw.texture)) ||
+                (cmd->data.draw.gpu_render_state && !AddRenderListObject(list, cmd->data.draw.gpu_render_state))) {
+                list->valid = false;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Called when an object used by render lists is destroyed
+static void InvalidateRenderLists(SDL_Renderer *renderer, const void *object)
+{
+    for (SDL_RenderList *list = renderer->render_lists; list; list = list->next) {
+        if (!list->valid) {
+            continue;
+        }
+        for (int i = 0; i < list->num_objects; ++i) {
+            if (list->objects[i] == object) {
+                list->valid = false;
+                break;
+            }
+        }
+    }
+}
+
 static bool FlushRenderCommands(SDL_Renderer *renderer)
 {
     bool result;
@@ -320,8 +466,17 @@ static bool FlushRenderCommands(SDL_Renderer *renderer)
 
     DebugLogRenderCommands(renderer->render_commands);
 
+    if (renderer->recording) {
+        AppendToRenderList(renderer->recording, renderer);
+    }
+
     result = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
 
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_COMMAND_COUNT_NUMBER, renderer->render_command_count);
+    renderer->frame_stats.command_count += renderer->render_command_count;
+    renderer->frame_stats.flush_count++;
+    renderer->frame_stats.vertex_bytes += renderer->vertex_data_used;
+
     // Move the whole render command queue to the unused pool so we can reuse them next time.
     if (renderer->render_commands_tail) {
         renderer->render_commands_tail->next = renderer->render_commands_pool;
@@ -329,6 +484,8 @@ static bool FlushRenderCommands(SDL_Renderer *renderer)
         renderer->render_commands_tail = NULL;
         renderer->render_commands = NULL;
     }
+    renderer->last_queued_draw = NULL;
+    renderer->render_command_count = 0;
     renderer->vertex_data_used = 0;
     renderer->render_command_generation++;
     renderer->color_queued = false;
@@ -409,6 +566,94 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, size_t numbytes, size_t
     return ((Uint8 *)renderer->vertex_data) + aligned;
 }
 
+static int GetRenderGeometryIndex(const void *indices, int size_indices, int i)
+{
+    if (size_indices == 4) {
+        return ((const Uint32 *)indices)[i];
+    } else if (size_indices == 2) {
+        return ((const Uint16 *)indices)[i];
+    } else if (size_indices == 1) {
+        return ((const Uint8 *)indices)[i];
+    } else {
+        return i;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") SDL_CopyRenderGeometrySSE2(float *verts,
+                                                             const float *xy, int xy_stride,
+                                                             const SDL_FColor *color, int color_stride,
+                                                             const float *uv, int uv_stride,
+                                                             const void *indices, int size_indices, int count,
+                                                             float scale_x, float scale_y, float color_scale,
+                                                             float u_scale, float v_scale)
+{
+    const __m128 xy_scale = _mm_setr_ps(scale_x, scale_y, 0.0f, 0.0f);
+    const __m128 col_scale = _mm_setr_ps(color_scale, color_scale, color_scale, 1.0f);
+    const __m128 uv_scale = _mm_setr_ps(u_scale, v_scale, 0.0f, 0.0f);
+    int i;
+
+    for (i = 0; i < count; i++) {
+        const int j = GetRenderGeometryIndex(indices, size_indices, i);
+        const float *xy_ = (const float *)((const char *)xy + j * xy_stride);
+        const SDL_FColor *col_ = (const SDL_FColor *)((const char *)color + j * color_stride);
+
+        _mm_storel_pi((__m64 *)verts, _mm_mul_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)xy_), xy_scale));
+        _mm_storeu_ps(verts + 2, _mm_mul_ps(_mm_loadu_ps(&col_->r), col_scale));
+        verts += 6;
+
+        if (uv) {
+            const float *uv_ = (const float *)((const char *)uv + j * uv_stride);
+            _mm_storel_pi((__m64 *)verts, _mm_mul_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)uv_), uv_scale));
+            verts += 2;
+        }
+    }
+}
+#endif // SDL_SSE2_INTRINSICS
+
+void SDL_CopyRenderGeometry(float *verts,
+                            const float *xy, int xy_stride,
+                            const SDL_FColor *color, int color_stride,
+                            const float *uv, int uv_stride,
+                            const void *indices, int size_indices, int count,
+                            float scale_x, float scale_y, float color_scale,
+                            float u_scale, float v_scale)
+{
+    int i;
+
+    if (!indices) {
+        size_indices = 0;
+    }
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SDL_CopyRenderGeometrySSE2(verts, xy, xy_stride, color, color_stride, uv, uv_stride,
+                                   indices, size_indices, count, scale_x, scale_y, color_scale, u_scale, v_scale);
+        return;
+    }
+#endif
+
+    for (i = 0; i < count; i++) {
+        const int j = GetRenderGeometryIndex(indices, size_indices, i);
+        const float *xy_ = (const float *)((const char *)xy + j * xy_stride);
+        const SDL_FColor *col_ = (const SDL_FColor *)((const char *)color + j * color_stride);
+
+        *(verts++) = xy_[0] * scale_x;
+        *(verts++) = xy_[1] * scale_y;
+
+        *(verts++) = col_->r * color_scale;
+        *(verts++) = col_->g * color_scale;
+        *(verts++) = col_->b * color_scale;
+        *(verts++) = col_->a;
+
+        if (uv) {
+            const float *uv_ = (const float *)((const char *)uv + j * uv_stride);
+            *(verts++) = uv_[0] * u_scale;
+            *(verts++) = uv_[1] * v_scale;
+        }
+    }
+}
+
 static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
 {
     SDL_RenderCommand *result = NULL;
@@ -431,6 +676,7 @@ static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
         renderer->render_commands = result;
     }
     renderer->render_commands_tail = result;
+    renderer->render_command_count++;
 
     return result;
 }
@@ -607,6 +853,46 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
     return cmd;
 }
 
+/* Merge a draw that was just queued into the draw before it, if nothing
+ * between them changes how they're drawn. Backends draw these commands as
+ * `count` primitives starting at `first` in the vertex data, so two draws
+ * with contiguous vertex data can be drawn as one. */
+static void CoalesceQueueCmdDraw(SDL_Renderer *renderer, SDL_RenderCommand *cmd, size_t vertex_data_start)
+{
+    SDL_RenderCommand *prev = renderer->last_queued_draw;
+
+    SDL_assert(cmd == renderer->render_commands_tail);
+
+    if (prev && prev->next == cmd &&
+        prev->command == cmd->command &&
+        renderer->last_queued_draw_end == cmd->data.draw.first &&
+        cmd->data.draw.first >= vertex_data_start &&
+        renderer->vertex_data_used > vertex_data_start &&
+        prev->data.draw.texture == cmd->data.draw.texture &&
+        prev->data.draw.blend == cmd->data.draw.blend &&
+        prev->data.draw.color_scale == cmd->data.draw.color_scale &&
+        SDL_memcmp(&prev->data.draw.color, &cmd->data.draw.color, sizeof(cmd->data.draw.color)) == 0 &&
+        (!cmd->data.draw.texture || prev->data.draw.texture_scale_mode == cmd->data.draw.texture_scale_mode) &&
+        prev->data.draw.texture_address_mode_u == cmd->data.draw.texture_address_mode_u &&
+        prev->data.draw.texture_address_mode_v == cmd->data.draw.texture_address_mode_v &&
+        prev->data.draw.gpu_render_state == cmd->data.draw.gpu_render_state) {
+        prev->data.draw.count += cmd->data.draw.count;
+
+        // Return the merged command to the pool
+        prev->next = NULL;
+        renderer->render_commands_tail = prev;
+        cmd->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = cmd;
+        renderer->render_command_count--;
+    } else if (renderer->vertex_data_used > vertex_data_start) {
+        renderer->last_queued_draw = cmd;
+    } else {
+        // This backend doesn't keep its vertices in the shared vertex data
+        renderer->last_queued_draw = NULL;
+    }
+    renderer->last_queued_draw_end = renderer->vertex_data_used;
+}
+
 static bool QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, const int count)
 {
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_POINTS, NULL);
@@ -642,6 +928,8 @@ static bool QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, co
     cmd = PrepQueueCmdDraw(renderer, (use_rendergeometry ? SDL_RENDERCMD_GEOMETRY : SDL_RENDERCMD_FILL_RECTS), NULL);
 
     if (cmd) {
+        const size_t vertex_data_start = renderer->vertex_data_used;
+
         if (use_rendergeometry) {
             bool isstack1;
             bool isstack2;
@@ -702,6 +990,10 @@ static bool QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, co
                 cmd->command = SDL_RENDERCMD_NO_OP;
             }
         }
+
+        if (result) {
+            CoalesceQueueCmdDraw(renderer, cmd, vertex_data_start);
+        }
     }
     return result;
 }
@@ -801,6 +1093,8 @@ static bool QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
     bool result = false;
     cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_GEOMETRY, texture);
     if (cmd) {
+        const size_t vertex_data_start = renderer->vertex_data_used;
+
         cmd->data.draw.texture_address_mode_u = texture_address_mode_u;
         cmd->data.draw.texture_address_mode_v = texture_address_mode_v;
         result = renderer->QueueGeometry(renderer, cmd, texture,
@@ -808,7 +1102,9 @@ static bool QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                                          color, color_stride, uv, uv_stride,
                                          num_vertices, indices, num_indices, size_indices,
                                          scale_x, scale_y);
-        if (!result) {
+        if (result) {
+            CoalesceQueueCmdDraw(renderer, cmd, vertex_data_start);
+        } else {
             cmd->command = SDL_RENDERCMD_NO_OP;
         }
     }
@@ -1195,6 +1491,8 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
 
     renderer->scale_mode = SDL_SCALEMODE_LINEAR;
 
+    renderer->stats_overlay = SDL_GetHintBoolean(SDL_HINT_RENDER_STATS_OVERLAY, false);
+
     renderer->SDR_white_point = 1.0f;
     renderer->HDR_headroom = 1.0f;
     renderer->desired_color_scale = 1.0f;
@@ -1703,7 +2001,7 @@ static bool SDL_UpdateTextureFromSurface(SDL_Texture *texture, SDL_Rect *rect, S
 
     if (direct_update) {
         if (SDL_MUSTLOCK(surface)) {
-            if (SDL_LockSurface(surface)) {
+            if (SDL_LockSurfaceReadOnly(surface)) {
                 SDL_UpdateTexture(texture, rect, surface->pixels, surface->pitch);
                 SDL_UnlockSurface(surface);
             }
@@ -2351,6 +2649,7 @@ bool SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *p
         if (!FlushRenderCommandsIfTextureNeeded(texture)) {
             return false;
         }
+        renderer->frame_stats.texture_update_count++;
         return renderer->UpdateTexture(renderer, texture, &real_rect, pixels, pitch);
     }
 }
@@ -2518,6 +2817,7 @@ bool SDL_UpdateYUVTexture(SDL_Texture *texture, const SDL_Rect *rect,
             if (!FlushRenderCommandsIfTextureNeeded(texture)) {
                 return false;
             }
+            renderer->frame_stats.texture_update_count++;
             return renderer->UpdateTextureYUV(renderer, texture, &real_rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
         } else {
             return SDL_Unsupported();
@@ -2579,6 +2879,7 @@ bool SDL_UpdateNVTexture(SDL_Texture *texture, const SDL_Rect *rect,
             if (!FlushRenderCommandsIfTextureNeeded(texture)) {
                 return false;
             }
+            renderer->frame_stats.texture_update_count++;
             return renderer->UpdateTextureNV(renderer, texture, &real_rect, Yplane, Ypitch, UVplane, UVpitch);
         } else {
             return SDL_Unsupported();
@@ -2652,6 +2953,7 @@ bool SDL_LockTexture(SDL_Texture *texture, const SDL_Rect *rect, void **pixels,
         if (!FlushRenderCommandsIfTextureNeeded(texture)) {
             return false;
         }
+        renderer->frame_stats.texture_lock_count++;
         return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -2796,6 +3098,11 @@ bool SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
 
     FlushRenderCommands(renderer); // time to send everything to the GPU!
 
+    if (renderer->recording) {
+        // The recorded vertex data is only valid for the target it was recorded with
+        renderer->recording->valid = false;
+    }
+
     SDL_LockMutex(renderer->target_mutex);
 
     renderer->target = texture;
@@ -5281,6 +5588,21 @@ end:
 }
 #endif // SDL_VIDEO_RENDER_SW
 
+// Get the address modes to use with a texture, which may be SDL_TEXTURE_ADDRESS_AUTO
+static void GetTextureAddressModes(SDL_Renderer *renderer, SDL_Texture *texture, SDL_TextureAddressMode *u_mode, SDL_TextureAddressMode *v_mode)
+{
+    if (renderer->npot_texture_wrap_unsupported && IsNPOT(texture->w)) {
+        *u_mode = SDL_TEXTURE_ADDRESS_CLAMP;
+    } else {
+        *u_mode = renderer->texture_address_mode_u;
+    }
+    if (renderer->npot_texture_wrap_unsupported && IsNPOT(texture->h)) {
+        *v_mode = SDL_TEXTURE_ADDRESS_CLAMP;
+    } else {
+        *v_mode = renderer->texture_address_mode_v;
+    }
+}
+
 bool SDL_RenderGeometryRaw(SDL_Renderer *renderer,
                           SDL_Texture *texture,
                           const float *xy, int xy_stride,
@@ -5355,16 +5677,7 @@ bool SDL_RenderGeometryRaw(SDL_Renderer *renderer,
             texture = texture->native;
         }
 
-        if (renderer->npot_texture_wrap_unsupported && IsNPOT(texture->w)) {
-            texture_address_mode_u = SDL_TEXTURE_ADDRESS_CLAMP;
-        } else {
-            texture_address_mode_u = renderer->texture_address_mode_u;
-        }
-        if (renderer->npot_texture_wrap_unsupported && IsNPOT(texture->h)) {
-            texture_address_mode_v = SDL_TEXTURE_ADDRESS_CLAMP;
-        } else {
-            texture_address_mode_v = renderer->texture_address_mode_v;
-        }
+        GetTextureAddressModes(renderer, texture, &texture_address_mode_u, &texture_address_mode_v);
 
         if (texture_address_mode_u == SDL_TEXTURE_ADDRESS_AUTO ||
             texture_address_mode_v == SDL_TEXTURE_ADDRESS_AUTO) {
@@ -5437,6 +5750,267 @@ bool SDL_RenderGeometryRaw(SDL_Renderer *renderer,
                             texture_address_mode_u, texture_address_mode_v);
 }
 
+// The number of sprites converted to geometry at a time by SDL_RenderSprites()
+#define SPRITE_BATCH_SIZE 64
+
+static void GetSpriteRotation(const SDL_RenderSprite *sprite, float *s, float *c)
+{
+    if (sprite->angle == 0.0f) {
+        *s = 0.0f;
+        *c = 1.0f;
+    } else {
+        const float radian_angle = (float)((SDL_PI_D * sprite->angle) / 180.0);
+        *s = SDL_sinf(radian_angle);
+        *c = SDL_cosf(radian_angle);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") GenerateSpriteVerticesSSE2(SDL_Vertex *verts, const SDL_RenderSprite *sprites, int count, float texw, float texh)
+{
+    const __m128 tex_size = _mm_setr_ps(texw, texh, texw, texh);
+    int i;
+
+    for (i = 0; i < count; i++, verts += 4) {
+        const SDL_RenderSprite *sprite = &sprites[i];
+        const __m128 src = _mm_setr_ps(sprite->srcrect.x, sprite->srcrect.y, sprite->srcrect.x + sprite->srcrect.w, sprite->srcrect.y + sprite->srcrect.h);
+        const __m128 dst = _mm_setr_ps(sprite->dstrect.x, sprite->dstrect.y, sprite->dstrect.x + sprite->dstrect.w, sprite->dstrect.y + sprite->dstrect.h);
+        const __m128 uv = _mm_div_ps(src, tex_size);
+        // Corners in the order (minx, miny), (maxx, miny), (maxx, maxy), (minx, maxy)
+        const __m128 u = _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(0, 2, 2, 0));
+        const __m128 v = _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(3, 3, 1, 1));
+        const __m128 color = _mm_loadu_ps(&sprite->color.r);
+        __m128 x = _mm_shuffle_ps(dst, dst, _MM_SHUFFLE(0, 2, 2, 0));
+        __m128 y = _mm_shuffle_ps(dst, dst, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 xy, uv01, uv23;
+        float s, c;
+
+        GetSpriteRotation(sprite, &s, &c);
+        if (s != 0.0f || c != 1.0f) {
+            const __m128 cx = _mm_set1_ps(sprite->dstrect.w / 2.0f + sprite->dstrect.x);
+            const __m128 cy = _mm_set1_ps(sprite->dstrect.h / 2.0f + sprite->dstrect.y);
+            const __m128 vs = _mm_set1_ps(s);
+            const __m128 vc = _mm_set1_ps(c);
+            const __m128 dx = _mm_sub_ps(x, cx);
+            const __m128 dy = _mm_sub_ps(y, cy);
+
+            x = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vc, dx), _mm_mul_ps(vs, dy)), cx);
+            y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vs, dx), _mm_mul_ps(vc, dy)), cy);
+        }
+
+        xy = _mm_unpacklo_ps(x, y);
+        _mm_storel_pi((__m64 *)&verts[0].position, xy);
+        _mm_storeh_pi((__m64 *)&verts[1].position, xy);
+        xy = _mm_unpackhi_ps(x, y);
+        _mm_storel_pi((__m64 *)&verts[2].position, xy);
+        _mm_storeh_pi((__m64 *)&verts[3].position, xy);
+
+        _mm_storeu_ps(&verts[0].color.r, color);
+        _mm_storeu_ps(&verts[1].color.r, color);
+        _mm_storeu_ps(&verts[2].color.r, color);
+        _mm_storeu_ps(&verts[3].color.r, color);
+
+        uv01 = _mm_unpacklo_ps(u, v);
+        uv23 = _mm_unpackhi_ps(u, v);
+        _mm_storel_pi((__m64 *)&verts[0].tex_coord, uv01);
+        _mm_storeh_pi((__m64 *)&verts[1].tex_coord, uv01);
+        _mm_storel_pi((__m64 *)&verts[2].tex_coord, uv23);
+        _mm_storeh_pi((__m64 *)&verts[3].tex_coord, uv23);
+    }
+}
+#endif // SDL_SSE2_INTRINSICS
+
+static void GenerateSpriteVertices(SDL_Vertex *verts, const SDL_RenderSprite *sprites, int count, float texw, float texh)
+{
+    int i, k;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        GenerateSpriteVerticesSSE2(verts, sprites, count, texw, texh);
+        return;
+    }
+#endif
+
+    for (i = 0; i < count; i++, verts += 4) {
+        const SDL_RenderSprite *sprite = &sprites[i];
+        const float minu = sprite->srcrect.x / texw;
+        const float minv = sprite->srcrect.y / texh;
+        const float maxu = (sprite->srcrect.x + sprite->srcrect.w) / texw;
+        const float maxv = (sprite->srcrect.y + sprite->srcrect.h) / texh;
+        const float minx = sprite->dstrect.x;
+        const float miny = sprite->dstrect.y;
+        const float maxx = sprite->dstrect.x + sprite->dstrect.w;
+        const float maxy = sprite->dstrect.y + sprite->dstrect.h;
+        float s, c;
+
+        verts[0].position.x = minx;
+        verts[0].position.y = miny;
+        verts[1].position.x = maxx;
+        verts[1].position.y = miny;
+        verts[2].position.x = maxx;
+        verts[2].position.y = maxy;
+        verts[3].position.x = minx;
+        verts[3].position.y = maxy;
+
+        GetSpriteRotation(sprite, &s, &c);
+        if (s != 0.0f || c != 1.0f) {
+            const float centerx = sprite->dstrect.w / 2.0f + sprite->dstrect.x;
+            const float centery = sprite->dstrect.h / 2.0f + sprite->dstrect.y;
+
+            // apply rotation with 2x2 matrix ( c -s )
+            //                                ( s  c )
+            for (k = 0; k < 4; k++) {
+                const float dx = verts[k].position.x - centerx;
+                const float dy = verts[k].position.y - centery;
+                verts[k].position.x = (c * dx - s * dy) + centerx;
+                verts[k].position.y = (s * dx + c * dy) + centery;
+            }
+        }
+
+        verts[0].tex_coord.x = minu;
+        verts[0].tex_coord.y = minv;
+        verts[1].tex_coord.x = maxu;
+        verts[1].tex_coord.y = minv;
+        verts[2].tex_coord.x = maxu;
+        verts[2].tex_coord.y = maxv;
+        verts[3].tex_coord.x = minu;
+        verts[3].tex_coord.y = maxv;
+
+        for (k = 0; k < 4; k++) {
+            verts[k].color = sprite->color;
+        }
+    }
+}
+
+// Resolve SDL_TEXTURE_ADDRESS_AUTO from the source rectangles, which is the same as checking the texture coordinates
+static void GetSpriteAddressModes(const SDL_RenderSprite *sprites, int count, float texw, float texh, SDL_TextureAddressMode *u_mode, SDL_TextureAddressMode *v_mode)
+{
+    int i;
+
+    for (i = 0; i < count && (*u_mode == SDL_TEXTURE_ADDRESS_AUTO || *v_mode == SDL_TEXTURE_ADDRESS_AUTO); ++i) {
+        const SDL_FRect *srcrect = &sprites[i].srcrect;
+
+        if (*u_mode == SDL_TEXTURE_ADDRESS_AUTO) {
+            const float x0 = SDL_min(srcrect->x, srcrect->x + srcrect->w);
+            const float x1 = SDL_max(srcrect->x, srcrect->x + srcrect->w);
+            if (x0 < 0.0f || x1 > texw) {
+                *u_mode = SDL_TEXTURE_ADDRESS_WRAP;
+            }
+        }
+        if (*v_mode == SDL_TEXTURE_ADDRESS_AUTO) {
+            const float y0 = SDL_min(srcrect->y, srcrect->y + srcrect->h);
+            const float y1 = SDL_max(srcrect->y, srcrect->y + srcrect->h);
+            if (y0 < 0.0f || y1 > texh) {
+                *v_mode = SDL_TEXTURE_ADDRESS_WRAP;
+            }
+        }
+    }
+    if (*u_mode == SDL_TEXTURE_ADDRESS_AUTO) {
+        *u_mode = SDL_TEXTURE_ADDRESS_CLAMP;
+    }
+    if (*v_mode == SDL_TEXTURE_ADDRESS_AUTO) {
+        *v_mode = SDL_TEXTURE_ADDRESS_CLAMP;
+    }
+}
+
+bool SDL_RenderSprites(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_RenderSprite *sprites, int count)
+{
+    SDL_Vertex verts[SPRITE_BATCH_SIZE * 4];
+    int indices[SPRITE_BATCH_SIZE * 6];
+    SDL_TextureAddressMode texture_address_mode_u, texture_address_mode_v;
+    float texw, texh;
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, false);
+    CHECK_TEXTURE_MAGIC(texture, false);
+
+    CHECK_PARAM(renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+
+    CHECK_PARAM(!sprites && count > 0) {
+        return SDL_InvalidParamError("sprites");
+    }
+
+    CHECK_PARAM(count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    if (!renderer->QueueGeometry) {
+        return SDL_Unsupported();
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    // Don't draw while we're hidden
+    if (renderer->hidden) {
+        return true;
+    }
+#endif
+
+    if (count == 0) {
+        return true;
+    }
+
+    /* This does what SDL_RenderGeometryRaw() would do for each batch, once.
+     * The indices are generated here, so they don't need to be checked.
+     */
+    if (!UpdateTexturePalette(texture)) {
+        return false;
+    }
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+    texw = (float)texture->w;
+    texh = (float)texture->h;
+
+    GetTextureAddressModes(renderer, texture, &texture_address_mode_u, &texture_address_mode_v);
+    GetSpriteAddressModes(sprites, count, texw, texh, &texture_address_mode_u, &texture_address_mode_v);
+
+    texture->last_command_generation = renderer->render_command_generation;
+
+    for (i = 0; i < SPRITE_BATCH_SIZE * 6; i++) {
+        indices[i] = (i / 6) * 4 + rect_index_order[i % 6];
+    }
+
+    while (count > 0) {
+        const int batch = SDL_min(count, SPRITE_BATCH_SIZE);
+        bool result;
+
+        GenerateSpriteVertices(verts, sprites, batch, texw, texh);
+
+#ifdef SDL_VIDEO_RENDER_SW
+        // The software renderer turns unrotated quads back into copies
+        if (renderer->software &&
+            texture_address_mode_u == SDL_TEXTURE_ADDRESS_CLAMP &&
+            texture_address_mode_v == SDL_TEXTURE_ADDRESS_CLAMP) {
+            result = SDL_SW_RenderGeometryRaw(renderer, texture,
+                                              &verts[0].position.x, sizeof(*verts),
+                                              &verts[0].color, sizeof(*verts),
+                                              &verts[0].tex_coord.x, sizeof(*verts),
+                                              batch * 4, indices, batch * 6, sizeof(*indices));
+        } else
+#endif
+        {
+            const SDL_RenderViewState *view = renderer->view;
+            result = QueueCmdGeometry(renderer, texture,
+                                      &verts[0].position.x, sizeof(*verts),
+                                      &verts[0].color, sizeof(*verts),
+                                      &verts[0].tex_coord.x, sizeof(*verts),
+                                      batch * 4, indices, batch * 6, sizeof(*indices),
+                                      view->current_scale.x, view->current_scale.y,
+                                      texture_address_mode_u, texture_address_mode_v);
+        }
+        if (!result) {
+            return false;
+        }
+
+        sprites += batch;
+        count -= batch;
+    }
+    return true;
+}
+
 bool SDL_SetRenderTextureAddressMode(SDL_Renderer *renderer, SDL_TextureAddressMode u_mode, SDL_TextureAddressMode v_mode)
 {
     CHECK_RENDERER_MAGIC(renderer, false);
@@ -5466,6 +6040,51 @@ bool SDL_GetRenderTextureAddressMode(SDL_Renderer *renderer, SDL_TextureAddressM
     return true;
 }
 
+static bool GetReadPixelsRect(SDL_Renderer *renderer, const SDL_Rect *rect, SDL_Rect *real_rect)
+{
+    *real_rect = renderer->view->pixel_viewport;
+
+    if (rect) {
+        if (!SDL_GetRectIntersection(rect, real_rect, real_rect)) {
+            return SDL_SetError("Can't read outside the current viewport");
+        }
+    }
+    return true;
+}
+
+static void GetReadPixelsTargetInfo(SDL_Renderer *renderer, SDL_PixelFormat *expected_format, float *SDR_white_point, float *HDR_headroom)
+{
+    if (renderer->target) {
+        SDL_Texture *target = renderer->target;
+        SDL_Texture *parent = SDL_GetPointerProperty(SDL_GetTextureProperties(target), SDL_PROP_TEXTURE_PARENT_POINTER, NULL);
+
+        *expected_format = (parent ? parent->format : target->format);
+        *SDR_white_point = target->SDR_white_point;
+        *HDR_headroom = target->HDR_headroom;
+    } else {
+        *expected_format = SDL_PIXELFORMAT_UNKNOWN;
+        *SDR_white_point = renderer->SDR_white_point;
+        *HDR_headroom = renderer->HDR_headroom;
+    }
+}
+
+static void SetReadPixelsSurfaceInfo(SDL_Surface *surface, SDL_PixelFormat expected_format, float SDR_white_point, float HDR_headroom)
+{
+    SDL_PropertiesID props = SDL_GetSurfaceProperties(surface);
+
+    SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, SDR_white_point);
+    SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, HDR_headroom);
+
+    // Set the expected surface format
+    if ((surface->format == SDL_PIXELFORMAT_ARGB8888 && expected_format == SDL_PIXELFORMAT_XRGB8888) ||
+        (surface->format == SDL_PIXELFORMAT_RGBA8888 && expected_format == SDL_PIXELFORMAT_RGBX8888) ||
+        (surface->format == SDL_PIXELFORMAT_ABGR8888 && expected_format == SDL_PIXELFORMAT_XBGR8888) ||
+        (surface->format == SDL_PIXELFORMAT_BGRA8888 && expected_format == SDL_PIXELFORMAT_BGRX8888)) {
+        surface->format = expected_format;
+        surface->fmt = SDL_GetPixelFormatDetails(expected_format);
+    }
+}
+
 SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
 {
     CHECK_RENDERER_MAGIC(renderer, NULL);
@@ -5477,41 +6096,99 @@ SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
 
     FlushRenderCommands(renderer); // we need to render before we read the results.
 
-    SDL_Rect real_rect = renderer->view->pixel_viewport;
-
-    if (rect) {
-        if (!SDL_GetRectIntersection(rect, &real_rect, &real_rect)) {
-            SDL_SetError("Can't read outside the current viewport");
-            return NULL;
-        }
+    SDL_Rect real_rect;
+    if (!GetReadPixelsRect(renderer, rect, &real_rect)) {
+        return NULL;
     }
 
     SDL_Surface *surface = renderer->RenderReadPixels(renderer, &real_rect);
     if (surface) {
-        SDL_PropertiesID props = SDL_GetSurfaceProperties(surface);
-
-        if (renderer->target) {
-            SDL_Texture *target = renderer->target;
-            SDL_Texture *parent = SDL_GetPointerProperty(SDL_GetTextureProperties(target), SDL_PROP_TEXTURE_PARENT_POINTER, NULL);
-            SDL_PixelFormat expected_format = (parent ? parent->format : target->format);
-
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, target->SDR_white_point);
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, target->HDR_headroom);
-
-            // Set the expected surface format
-            if ((surface->format == SDL_PIXELFORMAT_ARGB8888 && expected_format == SDL_PIXELFORMAT_XRGB8888) ||
-                (surface->format == SDL_PIXELFORMAT_RGBA8888 && expected_format == SDL_PIXELFORMAT_RGBX8888) ||
-                (surface->format == SDL_PIXELFORMAT_ABGR8888 && expected_format == SDL_PIXELFORMAT_XBGR8888) ||
-                (surface->format == SDL_PIXELFORMAT_BGRA8888 && expected_format == SDL_PIXELFORMAT_BGRX8888)) {
-                surface->format = expected_format;
-                surface->fmt = SDL_GetPixelFormatDetails(expected_format);
+        SDL_PixelFormat expected_format;
+        float SDR_white_point, HDR_headroom;
+
+        GetReadPixelsTargetInfo(renderer, &expected_format, &SDR_white_point, &HDR_headroom);
+        SetReadPixelsSurfaceInfo(surface, expected_format, SDR_white_point, HDR_headroom);
+    }
+    return surface;
+}
+
+bool SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect, SDL_RenderReadPixelsCallback callback, void *userdata)
+{
+    SDL_RenderReadback *readback;
+
+    CHECK_RENDERER_MAGIC(renderer, false);
+
+    CHECK_PARAM(!callback) {
+        return SDL_InvalidParamError("callback");
+    }
+
+    if (!renderer->RenderReadPixels) {
+        return SDL_Unsupported();
+    }
+
+    readback = (SDL_RenderReadback *)SDL_calloc(1, sizeof(*readback));
+    if (!readback) {
+        return false;
+    }
+    readback->callback = callback;
+    readback->userdata = userdata;
+    GetReadPixelsTargetInfo(renderer, &readback->expected_format, &readback->SDR_white_point, &readback->HDR_headroom);
+
+    // The queued rendering is sent to the backend, but we don't wait for it to finish
+    FlushRenderCommands(renderer);
+
+    if (!GetReadPixelsRect(renderer, rect, &readback->rect)) {
+        SDL_free(readback);
+        return false;
+    }
+
+    if (renderer->RenderReadPixelsAsync) {
+        if (!renderer->RenderReadPixelsAsync(renderer, readback)) {
+            SDL_free(readback);
+            return false;
+        }
+    } else {
+        // Read the pixels now and only defer the callback
+        readback->surface = renderer->RenderReadPixels(renderer, &readback->rect);
+        if (!readback->surface) {
+            SDL_free(readback);
+            return false;
+        }
+    }
+
+    if (renderer->readbacks) {
+        SDL_RenderReadback *tail = renderer->readbacks;
+        while (tail->next) {
+            tail = tail->next;
+        }
+        tail->next = readback;
+    } else {
+        renderer->readbacks = readback;
+    }
+    return true;
+}
+
+// Call the callbacks for the finished reads, in the order they were started
+static void SDL_FinishRenderReadbacks(SDL_Renderer *renderer, bool wait)
+{
+    while (renderer->readbacks) {
+        SDL_RenderReadback *readback = renderer->readbacks;
+
+        if (readback->internal) {
+            if (!renderer->FinishReadPixelsAsync(renderer, readback, wait)) {
+                break; // Not ready yet
             }
-        } else {
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, renderer->SDR_white_point);
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, renderer->HDR_headroom);
+            SDL_assert(readback->internal == NULL);
+        }
+        renderer->readbacks = readback->next;
+
+        if (readback->surface) {
+            SetReadPixelsSurfaceInfo(readback->surface, readback->expected_format, readback->SDR_white_point, readback->HDR_headroom);
         }
+        readback->callback(readback->userdata, renderer, readback->surface);
+        SDL_DestroySurface(readback->surface);
+        SDL_free(readback);
     }
-    return surface;
 }
 
 static void SDL_RenderApplyWindowShape(SDL_Renderer *renderer)
@@ -5540,6 +6217,60 @@ static void SDL_RenderApplyWindowShape(SDL_Renderer *renderer)
     }
 }
 
+static void SDL_RenderStatsOverlay(SDL_Renderer *renderer)
+{
+    const SDL_RenderStats *stats = &renderer->last_frame_stats;
+    const float size = (float)SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    SDL_RenderViewState view;
+    SDL_FRect rect;
+    SDL_BlendMode blend_mode;
+    Uint8 r, g, b, a;
+
+    // Draw in the top left corner of the output, regardless of the current view state
+    SDL_copyp(&view, renderer->view);
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blend_mode);
+    SDL_SetRenderViewport(renderer, NULL);
+    SDL_SetRenderClipRect(renderer, NULL);
+    SDL_SetRenderScale(renderer, 1.0f, 1.0f);
+
+    rect.x = 0.0f;
+    rect.y = 0.0f;
+    rect.w = 30.0f * size;
+    rect.h = 7.0f * size;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(renderer, &rect);
+
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderDebugTextFormat(renderer, size, size * 0.5f, "commands:        %" SDL_PRIs64, stats->command_count);
+    SDL_RenderDebugTextFormat(renderer, size, size * 1.5f, "flushes:         %" SDL_PRIs64, stats->flush_count);
+    SDL_RenderDebugTextFormat(renderer, size, size * 2.5f, "vertex bytes:    %" SDL_PRIs64, stats->vertex_bytes);
+    SDL_RenderDebugTextFormat(renderer, size, size * 3.5f, "texture updates: %" SDL_PRIs64, stats->texture_update_count);
+    SDL_RenderDebugTextFormat(renderer, size, size * 4.5f, "texture locks:   %" SDL_PRIs64, stats->texture_lock_count);
+    SDL_RenderDebugTextFormat(renderer, size, size * 5.5f, "upload bytes:    %" SDL_PRIs64, stats->upload_bytes);
+
+    SDL_copyp(renderer->view, &view);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetRenderDrawBlendMode(renderer, blend_mode);
+}
+
+static void SDL_UpdateRenderStats(SDL_Renderer *renderer)
+{
+    const SDL_RenderStats *stats = &renderer->frame_stats;
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_COMMAND_COUNT_NUMBER, stats->command_count);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_FLUSH_COUNT_NUMBER, stats->flush_count);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER, stats->vertex_bytes);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_TEXTURE_UPDATE_COUNT_NUMBER, stats->texture_update_count);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_TEXTURE_LOCK_COUNT_NUMBER, stats->texture_lock_count);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_UPLOAD_BYTES_NUMBER, stats->upload_bytes);
+
+    SDL_copyp(&renderer->last_frame_stats, stats);
+    SDL_zerop(&renderer->frame_stats);
+}
+
 static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
 {
     Uint64 now, elapsed;
@@ -5585,7 +6316,12 @@ bool SDL_RenderPresent(SDL_Renderer *renderer)
         SDL_RenderApplyWindowShape(renderer);
     }
 
+    if (renderer->stats_overlay && !renderer->target) {
+        SDL_RenderStatsOverlay(renderer);
+    }
+
     FlushRenderCommands(renderer); // time to send everything to the GPU!
+    SDL_UpdateRenderStats(renderer);
 
 #if DONT_DRAW_WHILE_HIDDEN
     // Don't present while we're hidden
@@ -5597,6 +6333,8 @@ bool SDL_RenderPresent(SDL_Renderer *renderer)
         presented = false;
     }
 
+    SDL_FinishRenderReadbacks(renderer, false);
+
     if (renderer->simulate_vsync ||
         (!presented && renderer->wanted_vsync)) {
         SDL_SimulateRenderVSync(renderer);
@@ -5627,6 +6365,8 @@ static void SDL_DestroyTextureInternal(SDL_Texture *texture, bool is_destroying)
 
     SDL_SetObjectValid(texture, SDL_OBJECT_TYPE_TEXTURE, false);
 
+    InvalidateRenderLists(renderer, texture);
+
     if (texture->next) {
         texture->next->prev = texture->prev;
     }
@@ -5685,6 +6425,8 @@ static void SDL_DiscardAllCommands(SDL_Renderer *renderer)
     renderer->render_commands_pool = NULL;
     renderer->render_commands_tail = NULL;
     renderer->render_commands = NULL;
+    renderer->last_queued_draw = NULL;
+    renderer->render_command_count = 0;
     renderer->vertex_data_used = 0;
 
     while (cmd) {
@@ -5717,6 +6459,23 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
     }
     SDL_DiscardAllCommands(renderer);
 
+    // Deliver any pixels that are still being read
+    SDL_FinishRenderReadbacks(renderer, true);
+
+    // Render lists may outlive the renderer, but can't be replayed anymore
+    if (renderer->recording) {
+        SDL_RenderList *recording = renderer->recording;
+        renderer->recording = NULL;
+        SDL_DestroyRenderList(recording);
+    }
+    while (renderer->render_lists) {
+        SDL_RenderList *list = renderer->render_lists;
+        renderer->render_lists = list->next;
+        list->renderer = NULL;
+        list->valid = false;
+        list->next = NULL;
+    }
+
     if (renderer->debug_char_texture_atlas) {
         SDL_DestroyTexture(renderer->debug_char_texture_atlas);
         renderer->debug_char_texture_atlas = NULL;
@@ -6264,6 +7023,8 @@ void SDL_DestroyGPURenderState(SDL_GPURenderState *state)
 
     FlushRenderCommandsIfGPURenderStateNeeded(state);
 
+    InvalidateRenderLists(state->renderer, state);
+
     if (state->num_uniform_buffers > 0) {
         for (int i = 0; i < state->num_uniform_buffers; i++) {
             SDL_free(state->uniform_buffers[i].data);
@@ -6275,3 +7036,138 @@ void SDL_DestroyGPURenderState(SDL_GPURenderState *state)
     SDL_free(state->storage_buffers);
     SDL_free(state);
 }
+
+bool SDL_StartRenderRecording(SDL_Renderer *renderer)
+{
+    SDL_RenderList *list;
+
+    CHECK_RENDERER_MAGIC(renderer, false);
+
+    if (renderer->recording) {
+        return SDL_SetError("Already recording render commands");
+    }
+
+    // Start with an empty command queue, so only the new commands are recorded
+    if (!FlushRenderCommands(renderer)) {
+        return false;
+    }
+
+    list = (SDL_RenderList *)SDL_calloc(1, sizeof(*list));
+    if (!list) {
+        return false;
+    }
+    list->renderer = renderer;
+    list->valid = true;
+    list->next = renderer->render_lists;
+    renderer->render_lists = list;
+    renderer->recording = list;
+    return true;
+}
+
+SDL_RenderList *SDL_EndRenderRecording(SDL_Renderer *renderer)
+{
+    SDL_RenderList *list;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    list = renderer->recording;
+    if (!list) {
+        SDL_SetError("Not recording render commands");
+        return NULL;
+    }
+    renderer->recording = NULL;
+
+    // The commands queued since the last flush are recorded without flushing them
+    if (!AppendToRenderList(list, renderer)) {
+        SDL_DestroyRenderList(list);
+        return NULL;
+    }
+    return list;
+}
+
+bool SDL_ReplayRenderList(SDL_Renderer *renderer, SDL_RenderList *list)
+{
+    size_t offset = 0;
+    Uint8 *vertices = NULL;
+
+    CHECK_RENDERER_MAGIC(renderer, false);
+
+    CHECK_PARAM(!list) {
+        return SDL_InvalidParamError("list");
+    }
+    CHECK_PARAM(list->renderer != renderer) {
+        return SDL_SetError("Render list was not recorded with this renderer");
+    }
+    if (!list->valid) {
+        return SDL_SetError("Render list is no longer valid");
+    }
+
+    if (list->vertex_data_used > 0) {
+        vertices = (Uint8 *)SDL_AllocateRenderVertices(renderer, list->vertex_data_used, RENDER_LIST_ALIGNMENT, &offset);
+        if (!vertices) {
+            return false;
+        }
+        SDL_memcpy(vertices, list->vertex_data, list->vertex_data_used);
+    }
+
+    for (int i = 0; i < list->num_commands; ++i) {
+        const SDL_RenderCommand *recorded = &list->commands[i];
+        SDL_RenderCommand *cmd = AllocateRenderCommand(renderer);
+        if (!cmd) {
+            return false;
+        }
+        SDL_copyp(cmd, recorded);
+        cmd->next = NULL;
+        RebaseRenderCommand(cmd, offset);
+
+        if (IsRenderDrawCommand(cmd)) {
+            SDL_Texture *texture = cmd->data.draw.texture;
+            if (texture) {
+                texture->last_command_generation = renderer->render_command_generation;
+                if (texture->palette) {
+                    texture->palette->last_command_generation = renderer->render_command_generation;
+                }
+            }
+            if (cmd->data.draw.gpu_render_state) {
+                cmd->data.draw.gpu_render_state->last_command_generation = renderer->render_command_generation;
+            }
+        }
+    }
+
+    // The recorded commands changed the backend state, queue it again before the next draw
+    renderer->last_queued_draw = NULL;
+    renderer->color_queued = false;
+    renderer->viewport_queued = false;
+    renderer->cliprect_queued = false;
+    return true;
+}
+
+void SDL_DestroyRenderList(SDL_RenderList *list)
+{
+    if (!list) {
+        return;
+    }
+
+    if (list->renderer) {
+        SDL_Renderer *renderer = list->renderer;
+        SDL_RenderList *prev = NULL;
+
+        if (renderer->recording == list) {
+            renderer->recording = NULL;
+        }
+        for (SDL_RenderList *it = renderer->render_lists; it; prev = it, it = it->next) {
+            if (it == list) {
+                if (prev) {
+                    prev->next = list->next;
+                } else {
+                    renderer->render_lists = list->next;
+                }
+                break;
+            }
+        }
+    }
+    SDL_free(list->commands);
+    SDL_free(list->vertex_data);
+    SDL_free(list->objects);
+    SDL_free(list);
+}
@@ -0,0 +1,676 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "../video/SDL_surface_c.h"
+
+/* Texture atlases
+ *
+ * Each atlas texture is packed with shelves: rows of images whose height is
+ * set by the first image placed on them. New images go on the shelf with the
+ * smallest height they fit on, and a new shelf is started below the last one
+ * when none fits. Removing an image leaves a gap on its shelf that later
+ * images of the same height or less can reuse, and a shelf with no images
+ * left is emptied entirely.
+ *
+ * The pixels are kept in a surface for each texture, and the area changed
+ * since the last upload is sent with SDL_UpdateTexture() when an entry on
+ * that texture is looked up.
+ *
+ * The entries in use are kept in a list ordered by when they were last
+ * added or looked up. If an image doesn't fit and the atlas already has as
+ * many textures as SDL_SetTextureAtlasMaxTextures() allows, the least
+ * recently used entries are evicted until it fits, either in the space they
+ * leave or on a new texture once a texture is emptied. A texture whose last
+ * image is removed or evicted is destroyed, leaving its page free for the
+ * next texture that's needed.
+ *
+ * An entry ID holds the index of the entry plus one in the low bits, and the
+ * generation of the entry in the high bits. The generation changes each time
+ * the entry is removed or evicted, so an old ID doesn't refer to the image
+ * that reuses the entry.
+ */
+
+// Each image has a border of this many pixels, copied from its edges
+#define ATLAS_PADDING 1
+
+#define ATLAS_ENTRY_INDEX_BITS  20
+#define ATLAS_ENTRY_INDEX_MASK  ((1u << ATLAS_ENTRY_INDEX_BITS) - 1)
+#define ATLAS_MAX_ENTRIES       (int)(ATLAS_ENTRY_INDEX_MASK - 1)
+#define ATLAS_ENTRY_ID(index, generation) ((SDL_TextureAtlasEntryID)(((generation) << ATLAS_ENTRY_INDEX_BITS) | ((Uint32)(index) + 1)))
+
+typedef struct SDL_AtlasGap
+{
+    int x;
+    int w;
+} SDL_AtlasGap;
+
+typedef struct SDL_AtlasShelf
+{
+    int y;
+    int h;
+    int used_w;   // the gaps and images on the shelf end here
+    int count;    // the number of images on the shelf
+    SDL_AtlasGap *gaps;
+    int num_gaps;
+    int max_gaps;
+} SDL_AtlasShelf;
+
+typedef struct SDL_AtlasPage
+{
+    SDL_Texture *texture; // NULL if this page is free
+    SDL_Surface *surface;
+    SDL_AtlasShelf *shelves;
+    int num_shelves;
+    int max_shelves;
+    SDL_Rect dirty;
+    Sint64 used_pixels;
+} SDL_AtlasPage;
+
+typedef struct SDL_AtlasEntry
+{
+    int page;   // -1 if this entry isn't in use
+    int shelf;
+    SDL_Rect slot; // the image and its border
+    Uint32 generation; // wraps within the bits above ATLAS_ENTRY_INDEX_BITS
+    int lru_prev;   // the next more recently used entry, or -1
+    int lru_next;   // the next less recently used entry, or -1
+} SDL_AtlasEntry;
+
+struct SDL_TextureAtlas
+{
+    SDL_Renderer *renderer;
+    SDL_PixelFormat format;
+    int w;
+    int h;
+    SDL_AtlasPage *pages;
+    int num_pages;
+    int num_textures;   // the number of pages that aren't free
+    int max_textures;   // 0 if there's no limit
+    SDL_AtlasEntry *entries;
+    int num_entries;
+    int max_entries;
+    int lru_head;   // the most recently used entry, or -1
+    int lru_tail;   // the least recently used entry, or -1
+};
+
+static void SDL_RemoveAtlasEntry(SDL_TextureAtlas *atlas, int index);
+
+static bool SDL_GrowAtlasArray(void **array, int *max, int needed, size_t size)
+{
+    if (needed > *max) {
+        int new_max = SDL_max(*max * 2, 8);
+        void *new_array;
+
+        while (new_max < needed) {
+            new_max *= 2;
+        }
+        new_array = SDL_realloc(*array, new_max * size);
+        if (!new_array) {
+            return false;
+        }
+        *array = new_array;
+        *max = new_max;
+    }
+    return true;
+}
+
+SDL_TextureAtlas *SDL_CreateTextureAtlas(SDL_Renderer *renderer, SDL_PixelFormat format, int w, int h)
+{
+    SDL_TextureAtlas *atlas;
+
+    CHECK_PARAM(!renderer) {
+        SDL_InvalidParamError("renderer");
+        return NULL;
+    }
+    CHECK_PARAM(SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format) || SDL_BYTESPERPIXEL(format) == 0) {
+        SDL_InvalidParamError("format");
+        return NULL;
+    }
+    CHECK_PARAM(w <= 2 * ATLAS_PADDING || h <= 2 * ATLAS_PADDING) {
+        SDL_InvalidParamError("w");
+        return NULL;
+    }
+
+    atlas = (SDL_TextureAtlas *)SDL_calloc(1, sizeof(*atlas));
+    if (!atlas) {
+        return NULL;
+    }
+    atlas->renderer = renderer;
+    atlas->format = format;
+    atlas->w = w;
+    atlas->h = h;
+    atlas->lru_head = -1;
+    atlas->lru_tail = -1;
+    return atlas;
+}
+
+bool SDL_SetTextureAtlasMaxTextures(SDL_TextureAtlas *atlas, int max_textures)
+{
+    CHECK_PARAM(!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+    CHECK_PARAM(max_textures < 0) {
+        return SDL_InvalidParamError("max_textures");
+    }
+
+    atlas->max_textures = max_textures;
+    return true;
+}
+
+static void SDL_UnlinkAtlasEntry(SDL_TextureAtlas *atlas, int index)
+{
+    SDL_AtlasEntry *entry = &atlas->entries[index];
+
+    if (entry->lru_prev >= 0) {
+        atlas->entries[entry->lru_prev].lru_next = entry->lru_next;
+    } else {
+        atlas->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next >= 0) {
+        atlas->entries[entry->lru_next].lru_prev = entry->lru_prev;
+    } else {
+        atlas->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = -1;
+    entry->lru_next = -1;
+}
+
+// Make an entry the most recently used, it must not be in the list already
+static void SDL_LinkAtlasEntry(SDL_TextureAtlas *atlas, int index)
+{
+    SDL_AtlasEntry *entry = &atlas->entries[index];
+
+    entry->lru_prev = -1;
+    entry->lru_next = atlas->lru_head;
+    if (atlas->lru_head >= 0) {
+        atlas->entries[atlas->lru_head].lru_prev = index;
+    } else {
+        atlas->lru_tail = index;
+    }
+    atlas->lru_head = index;
+}
+
+static int SDL_AddAtlasPage(SDL_TextureAtlas *atlas)
+{
+    SDL_AtlasPage *page;
+    int i;
+
+    // Reuse a page freed when its texture was emptied
+    for (i = 0; i < atlas->num_pages; ++i) {
+        if (!atlas->pages[i].texture) {
+            break;
+        }
+    }
+    if (i == atlas->num_pages) {
+        SDL_AtlasPage *pages = (SDL_AtlasPage *)SDL_realloc(atlas->pages, (atlas->num_pages + 1) * sizeof(*pages));
+        if (!pages) {
+            return -1;
+        }
+        atlas->pages = pages;
+        SDL_zero(pages[atlas->num_pages]);
+        ++atlas->num_pages;
+    }
+
+    page = &atlas->pages[i];
+    page->surface = SDL_CreateSurface(atlas->w, atlas->h, atlas->format);
+    if (!page->surface) {
+        return -1;
+    }
+    page->texture = SDL_CreateTexture(atlas->renderer, atlas->format, SDL_TEXTUREACCESS_STATIC, atlas->w, atlas->h);
+    if (!page->texture) {
+        SDL_DestroySurface(page->surface);
+        page->surface = NULL;
+        return -1;
+    }
+    SDL_zero(page->dirty);
+    page->used_pixels = 0;
+    ++atlas->num_textures;
+    return i;
+}
+
+static void SDL_FreeAtlasPage(SDL_TextureAtlas *atlas, SDL_AtlasPage *page)
+{
+    int i;
+
+    for (i = 0; i < page->num_shelves; ++i) {
+        SDL_free(page->shelves[i].gaps);
+    }
+    SDL_free(page->shelves);
+    page->shelves = NULL;
+    page->num_shelves = 0;
+    page->max_shelves = 0;
+    SDL_DestroyTexture(page->texture);
+    page->texture = NULL;
+    SDL_DestroySurface(page->surface);
+    page->surface = NULL;
+    --atlas->num_textures;
+}
+
+// Find a place for a w x h slot on a page, returning the shelf or -1 if there's no room
+static int SDL_FindAtlasSlot(SDL_TextureAtlas *atlas, SDL_AtlasPage *page, int w, int h, SDL_Rect *slot)
+{
+    SDL_AtlasShelf *best = NULL;
+    int best_gap = -1;
+    int i, j, top;
+
+    // Use the lowest shelf that the slot fits on
+    for (i = 0; i < page->num_shelves; ++i) {
+        SDL_AtlasShelf *shelf = &page->shelves[i];
+        int gap = -1;
+
+        if (shelf->h < h || (best && shelf->h >= best->h)) {
+            continue;
+        }
+        for (j = 0; j < shelf->num_gaps; ++j) {
+            if (shelf->gaps[j].w >= w) {
+                gap = j;
+                break;
+            }
+        }
+        if (gap >= 0 || atlas->w - shelf->used_w >= w) {
+            best = shelf;
+            best_gap = gap;
+        }
+    }
+
+    if (best) {
+        slot->y = best->y;
+        if (best_gap >= 0) {
+            SDL_AtlasGap *gap = &best->gaps[best_gap];
+            slot->x = gap->x;
+            gap->x += w;
+            gap->w -= w;
+            if (gap->w == 0) {
+                SDL_memmove(gap, gap + 1, (best->num_gaps - best_gap - 1) * sizeof(*gap));
+                --best->num_gaps;
+            }
+        } else {
+            slot->x = best->used_w;
+            best->used_w += w;
+        }
+        slot->w = w;
+        slot->h = h;
+        ++best->count;
+        return (int)(best - page->shelves);
+    }
+
+    // Start a new shelf below the others
+    if (page->num_shelves > 0) {
+        const SDL_AtlasShelf *last = &page->shelves[page->num_shelves - 1];
+        top = last->y + last->h;
+    } else {
+        top = 0;
+    }
+    if (atlas->h - top < h || atlas->w < w) {
+        return -1;
+    }
+    if (!SDL_GrowAtlasArray((void **)&page->shelves, &page->max_shelves, page->num_shelves + 1, sizeof(*page->shelves))) {
+        return -1;
+    }
+    best = &page->shelves[page->num_shelves];
+    SDL_zerop(best);
+    best->y = top;
+    best->h = h;
+    best->used_w = w;
+    best->count = 1;
+    slot->x = 0;
+    slot->y = top;
+    slot->w = w;
+    slot->h = h;
+    return page->num_shelves++;
+}
+
+// Copy the outermost pixels of the image into its border
+static void SDL_ExtrudeAtlasSlot(SDL_Surface *surface, const SDL_Rect *slot)
+{
+    const int bpp = SDL_BYTESPERPIXEL(surface->format);
+    Uint8 *first = (Uint8 *)surface->pixels + slot->y * surface->pitch + slot->x * bpp;
+    int x, y;
+
+    for (y = ATLAS_PADDING; y < slot->h - ATLAS_PADDING; ++y) {
+        Uint8 *row = first + y * surface->pitch;
+        for (x = 0; x < ATLAS_PADDING; ++x) {
+            SDL_memcpy(row + x * bpp, row + ATLAS_PADDING * bpp, bpp);
+            SDL_memcpy(row + (slot->w - 1 - x) * bpp, row + (slot->w - 1 - ATLAS_PADDING) * bpp, bpp);
+        }
+    }
+    for (y = 0; y < ATLAS_PADDING; ++y) {
+        SDL_memcpy(first + y * surface->pitch, first + ATLAS_PADDING * surface->pitch, (size_t)slot->w * bpp);
+        SDL_memcpy(first + (slot->h - 1 - y) * surface->pitch, first + (slot->h - 1 - ATLAS_PADDING) * surface->pitch, (size_t)slot->w * bpp);
+    }
+}
+
+SDL_TextureAtlasEntryID SDL_AddSurfaceToTextureAtlas(SDL_TextureAtlas *atlas, SDL_Surface *surface)
+{
+    SDL_Surface *converted;
+    SDL_AtlasEntry *entry;
+    SDL_AtlasPage *page;
+    SDL_Rect slot;
+    int w, h, i, p, shelf = -1;
+    bool copied;
+
+    CHECK_PARAM(!atlas) {
+        SDL_InvalidParamError("atlas");
+        return 0;
+    }
+    CHECK_PARAM(!SDL_SurfaceValid(surface)) {
+        SDL_InvalidParamError("surface");
+        return 0;
+    }
+
+    w = surface->w + 2 * ATLAS_PADDING;
+    h = surface->h + 2 * ATLAS_PADDING;
+    if (w > atlas->w || h > atlas->h) {
+        SDL_SetError("Surface is larger than the texture atlas");
+        return 0;
+    }
+
+    // Find a free entry, or add one
+    for (i = 0; i < atlas->num_entries; ++i) {
+        if (atlas->entries[i].page < 0) {
+            break;
+        }
+    }
+    if (i == atlas->num_entries) {
+        if (atlas->num_entries == ATLAS_MAX_ENTRIES) {
+            SDL_SetError("Too many texture atlas entries");
+            return 0;
+        }
+        if (!SDL_GrowAtlasArray((void **)&atlas->entries, &atlas->max_entries, atlas->num_entries + 1, sizeof(*atlas->entries))) {
+            return 0;
+        }
+        atlas->entries[atlas->num_entries].page = -1;
+        atlas->entries[atlas->num_entries].generation = 0;
+        atlas->entries[atlas->num_entries].lru_prev = -1;
+        atlas->entries[atlas->num_entries].lru_next = -1;
+        ++atlas->num_entries;
+    }
+    entry = &atlas->entries[i];
+
+    if (surface->format == atlas->format) {
+        converted = surface;
+    } else {
+        converted = SDL_ConvertSurface(surface, atlas->format);
+        if (!converted) {
+            return 0;
+        }
+    }
+
+    for (p = 0; p < atlas->num_pages; ++p) {
+        if (atlas->pages[p].texture) {
+            shelf = SDL_FindAtlasSlot(atlas, &atlas->pages[p], w, h, &slot);
+            if (shelf >= 0) {
+                break;
+            }
+        }
+    }
+    while (shelf < 0) {
+        if (atlas->max_textures == 0 || atlas->num_textures < atlas->max_textures) {
+            p = SDL_AddAtlasPage(atlas);
+            if (p >= 0) {
+                shelf = SDL_FindAtlasSlot(atlas, &atlas->pages[p], w, h, &slot);
+            }
+            break;
+        }
+
+        // Evict the least recently used entry and see if the image fits in its place
+        if (atlas->lru_tail < 0) {
+            SDL_SetError("Texture atlas is full");
+            break;
+        }
+        p = atlas->entries[atlas->lru_tail].page;
+        SDL_RemoveAtlasEntry(atlas, atlas->lru_tail);
+        if (atlas->pages[p].texture) {
+            shelf = SDL_FindAtlasSlot(atlas, &atlas->pages[p], w, h, &slot);
+        }
+    }
+    if (shelf < 0) {
+        if (converted != surface) {
+            SDL_DestroySurface(converted);
+        }
+        return 0;
+    }
+    entry->page = p;
+    entry->shelf = shelf;
+    entry->slot = slot;
+    SDL_LinkAtlasEntry(atlas, i);
+
+    page = &atlas->pages[p];
+    page->used_pixels += (Sint64)surface->w * surface->h;
+    copied = SDL_LockSurface(converted);
+    if (copied) {
+        const int bpp = SDL_BYTESPERPIXEL(atlas->format);
+        Uint8 *dst = (Uint8 *)page->surface->pixels + (slot.y + ATLAS_PADDING) * page->surface->pitch + (slot.x + ATLAS_PADDING) * bpp;
+
+        copied = SDL_ConvertPixels(converted->w, converted->h, atlas->format, converted->pixels, converted->pitch, atlas->format, dst, page->surface->pitch);
+        SDL_UnlockSurface(converted);
+    }
+    if (converted != surface) {
+        SDL_DestroySurface(converted);
+    }
+    if (!copied) {
+        SDL_RemoveAtlasEntry(atlas, i);
+        return 0;
+    }
+    SDL_ExtrudeAtlasSlot(page->surface, &slot);
+
+    if (SDL_RectEmpty(&page->dirty)) {
+        page->dirty = slot;
+    } else {
+        SDL_GetRectUnion(&page->dirty, &slot, &page->dirty);
+    }
+    return ATLAS_ENTRY_ID(i, entry->generation);
+}
+
+static SDL_AtlasEntry *SDL_GetAtlasEntry(SDL_TextureAtlas *atlas, SDL_TextureAtlasEntryID id)
+{
+    const Uint32 index = (id & ATLAS_ENTRY_INDEX_MASK);
+    SDL_AtlasEntry *entry;
+
+    if (index == 0 || index > (Uint32)atlas->num_entries) {
+        SDL_SetError("Invalid texture atlas entry");
+        return NULL;
+    }
+    entry = &atlas->entries[index - 1];
+    if (entry->page < 0 || ATLAS_ENTRY_ID(index - 1, entry->generation) != id) {
+        SDL_SetError("Invalid texture atlas entry");
+        return NULL;
+    }
+    return entry;
+}
+
+bool SDL_GetTextureAtlasEntry(SDL_TextureAtlas *atlas, SDL_TextureAtlasEntryID id, SDL_Texture **texture, SDL_FRect *srcrect)
+{
+    SDL_AtlasEntry *entry;
+    SDL_AtlasPage *page;
+
+    if (texture) {
+        *texture = NULL;
+    }
+    if (srcrect) {
+        SDL_zerop(srcrect);
+    }
+
+    CHECK_PARAM(!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+
+    entry = SDL_GetAtlasEntry(atlas, id);
+    if (!entry) {
+        return false;
+    }
+
+    page = &atlas->pages[entry->page];
+    if (!SDL_RectEmpty(&page->dirty)) {
+        const SDL_Rect *dirty = &page->dirty;
+        const Uint8 *pixels = (const Uint8 *)page->surface->pixels + dirty->y * page->surface->pitch + dirty->x * SDL_BYTESPERPIXEL(atlas->format);
+
+        if (!SDL_UpdateTexture(page->texture, dirty, pixels, page->surface->pitch)) {
+            return false;
+        }
+        SDL_zero(page->dirty);
+    }
+
+    if (atlas->lru_head != (int)(entry - atlas->entries)) {
+        SDL_UnlinkAtlasEntry(atlas, (int)(entry - atlas->entries));
+        SDL_LinkAtlasEntry(atlas, (int)(entry - atlas->entries));
+    }
+
+    if (texture) {
+        *texture = page->texture;
+    }
+    if (srcrect) {
+        srcrect->x = (float)(entry->slot.x + ATLAS_PADDING);
+        srcrect->y = (float)(entry->slot.y + ATLAS_PADDING);
+        srcrect->w = (float)(entry->slot.w - 2 * ATLAS_PADDING);
+        srcrect->h = (float)(entry->slot.h - 2 * ATLAS_PADDING);
+    }
+    return true;
+}
+
+static void SDL_RemoveAtlasEntry(SDL_TextureAtlas *atlas, int index)
+{
+    SDL_AtlasEntry *entry = &atlas->entries[index];
+    SDL_AtlasPage *page;
+    SDL_AtlasShelf *shelf;
+    SDL_AtlasGap *gaps;
+    int i, x, w;
+
+    page = &atlas->pages[entry->page];
+    shelf = &page->shelves[entry->shelf];
+    page->used_pixels -= (Sint64)(entry->slot.w - 2 * ATLAS_PADDING) * (entry->slot.h - 2 * ATLAS_PADDING);
+    entry->page = -1;
+    entry->generation = (entry->generation + 1) & (0xFFFFFFFFu >> ATLAS_ENTRY_INDEX_BITS);
+    SDL_UnlinkAtlasEntry(atlas, index);
+
+    if (--shelf->count == 0) {
+        // The shelf is empty, it can take images of any height again if it's the last one
+        shelf->used_w = 0;
+        shelf->num_gaps = 0;
+        while (page->num_shelves > 0 && page->shelves[page->num_shelves - 1].count == 0) {
+            SDL_free(page->shelves[page->num_shelves - 1].gaps);
+            --page->num_shelves;
+        }
+        if (page->num_shelves == 0) {
+            // The texture is empty, free it until another one is needed
+            SDL_FreeAtlasPage(atlas, page);
+        }
+        return;
+    }
+
+    // Merge the space with the neighboring gaps, which are sorted by position
+    x = entry->slot.x;
+    w = entry->slot.w;
+    gaps = shelf->gaps;
+    for (i = 0; i < shelf->num_gaps && gaps[i].x < x; ++i) {
+    }
+    if (i > 0 && gaps[i - 1].x + gaps[i - 1].w == x) {
+        --i;
+        x = gaps[i].x;
+        w += gaps[i].w;
+        SDL_memmove(&gaps[i], &gaps[i + 1], (shelf->num_gaps - i - 1) * sizeof(*gaps));
+        --shelf->num_gaps;
+    }
+    if (i < shelf->num_gaps && x + w == gaps[i].x) {
+        w += gaps[i].w;
+        SDL_memmove(&gaps[i], &gaps[i + 1], (shelf->num_gaps - i - 1) * sizeof(*gaps));
+        --shelf->num_gaps;
+    }
+
+    if (x + w == shelf->used_w) {
+        shelf->used_w = x;
+        return;
+    }
+
+    if (!SDL_GrowAtlasArray((void **)&shelf->gaps, &shelf->max_gaps, shelf->num_gaps + 1, sizeof(*shelf->gaps))) {
+        // The space is lost until the shelf is emptied
+        return;
+    }
+    gaps = shelf->gaps;
+    SDL_memmove(&gaps[i + 1], &gaps[i], (shelf->num_gaps - i) * sizeof(*gaps));
+    gaps[i].x = x;
+    gaps[i].w = w;
+    ++shelf->num_gaps;
+}
+
+bool SDL_RemoveFromTextureAtlas(SDL_TextureAtlas *atlas, SDL_TextureAtlasEntryID id)
+{
+    SDL_AtlasEntry *entry;
+
+    CHECK_PARAM(!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+
+    entry = SDL_GetAtlasEntry(atlas, id);
+    if (!entry) {
+        return false;
+    }
+
+    SDL_RemoveAtlasEntry(atlas, (int)(entry - atlas->entries));
+    return true;
+}
+
+bool SDL_GetTextureAtlasUsage(SDL_TextureAtlas *atlas, int *num_textures, float *occupancy)
+{
+    Sint64 used = 0;
+    int i;
+
+    if (num_textures) {
+        *num_textures = 0;
+    }
+    if (occupancy) {
+        *occupancy = 0.0f;
+    }
+
+    CHECK_PARAM(!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+
+    for (i = 0; i < atlas->num_pages; ++i) {
+        used += atlas->pages[i].used_pixels;
+    }
+    if (num_textures) {
+        *num_textures = atlas->num_textures;
+    }
+    if (occupancy && atlas->num_textures > 0) {
+        *occupancy = (float)((double)used / ((double)atlas->w * atlas->h * atlas->num_textures));
+    }
+    return true;
+}
+
+void SDL_DestroyTextureAtlas(SDL_TextureAtlas *atlas)
+{
+    int i;
+
+    if (!atlas) {
+        return;
+    }
+
+    for (i = 0; i < atlas->num_pages; ++i) {
+        if (atlas->pages[i].texture) {
+            SDL_FreeAtlasPage(atlas, &atlas->pages[i]);
+        }
+    }
+    SDL_free(atlas->pages);
+    SDL_free(atlas->entries);
+    SDL_free(atlas);
+}
@@ -47,6 +47,17 @@ typedef struct SDL_DRect
 
 typedef struct SDL_RenderDriver SDL_RenderDriver;
 
+// Statistics gathered over a frame
+typedef struct SDL_RenderStats
+{
+    Sint64 command_count;
+    Sint64 flush_count;
+    Sint64 vertex_bytes;
+    Sint64 texture_update_count;
+    Sint64 texture_lock_count;
+    Sint64 upload_bytes;
+} SDL_RenderStats;
+
 // Rendering view state
 typedef struct SDL_RenderViewState
 {
@@ -218,6 +229,20 @@ typedef enum
     SDL_RENDERLINEMETHOD_GEOMETRY,
 } SDL_RenderLineMethod;
 
+// A pending asynchronous read of the render target
+typedef struct SDL_RenderReadback
+{
+    SDL_Rect rect;
+    SDL_PixelFormat expected_format; // the format of the render target, if there is one
+    float SDR_white_point;
+    float HDR_headroom;
+    SDL_RenderReadPixelsCallback callback;
+    void *userdata;
+    SDL_Surface *surface; // the result, once the read has finished
+    void *internal;       // Driver specific readback representation
+    struct SDL_RenderReadback *next;
+} SDL_RenderReadback;
+
 // Define the SDL renderer structure
 struct SDL_Renderer
 {
@@ -268,6 +293,8 @@ struct SDL_Renderer
     void (*UnlockTexture)(SDL_Renderer *renderer, SDL_Texture *texture);
     bool (*SetRenderTarget)(SDL_Renderer *renderer, SDL_Texture *texture);
     SDL_Surface *(*RenderReadPixels)(SDL_Renderer *renderer, const SDL_Rect *rect);
+    bool (*RenderReadPixelsAsync)(SDL_Renderer *renderer, SDL_RenderReadback *readback);
+    bool (*FinishReadPixelsAsync)(SDL_Renderer *renderer, SDL_RenderReadback *readback, bool wait);
     bool (*RenderPresent)(SDL_Renderer *renderer);
     void (*DestroyTexture)(SDL_Renderer *renderer, SDL_Texture *texture);
 
@@ -332,6 +359,15 @@ struct SDL_Renderer
     SDL_RenderCommand *render_commands;
     SDL_RenderCommand *render_commands_tail;
     SDL_RenderCommand *render_commands_pool;
+    SDL_RenderCommand *last_queued_draw; // a draw that the next draw can be merged into
+    size_t last_queued_draw_end;         // the end of its vertex data
+    int render_command_count;
+    SDL_RenderStats frame_stats;      // statistics for the frame being drawn
+    SDL_RenderStats last_frame_stats; // statistics for the last presented frame
+    bool stats_overlay;
+    SDL_RenderList *recording;   // the render list being recorded, if any
+    SDL_RenderList *render_lists; // the render lists recorded with this renderer
+    SDL_RenderReadback *readbacks; // pending asynchronous reads, oldest first
     Uint32 render_command_generation;
     SDL_FColor last_queued_color;
     float last_queued_color_scale;
@@ -418,6 +454,18 @@ extern SDL_BlendOperation SDL_GetBlendModeAlphaOperation(SDL_BlendMode blendMode
    the next call, because it might be in an array that gets realloc()'d. */
 extern void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, size_t numbytes, size_t alignment, size_t *offset);
 
+/* drivers can call this during QueueGeometry() to gather indexed, strided geometry into
+   interleaved x, y, r, g, b, a[, u, v] floats. Positions are multiplied by scale_x/scale_y,
+   colors by color_scale (alpha is left alone), and texture coordinates by u_scale/v_scale.
+   If uv is NULL, texture coordinates are not written. */
+extern void SDL_CopyRenderGeometry(float *verts,
+                                   const float *xy, int xy_stride,
+                                   const SDL_FColor *color, int color_stride,
+                                   const float *uv, int uv_stride,
+                                   const void *indices, int size_indices, int count,
+                                   float scale_x, float scale_y, float color_scale,
+                                   float u_scale, float v_scale);
+
 // Let the video subsystem destroy a renderer without making its pointer invalid.
 extern void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer);
 
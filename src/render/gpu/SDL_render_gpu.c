@@ -82,6 +82,9 @@ static const float INPUTTYPE_SRGB = 1;
 static const float INPUTTYPE_SCRGB = 2;
 static const float INPUTTYPE_HDR10 = 3;
 
+// The number of idle readback transfer buffers kept for reuse
+#define GPU_READBACK_POOL_SIZE 4
+
 typedef struct GPU_RenderData
 {
     bool external_device;
@@ -110,6 +113,21 @@ typedef struct GPU_RenderData
         Uint32 buffer_size;
     } vertices;
 
+    struct
+    {
+        SDL_GPUTransferBuffer *transfer_buf;
+        Uint32 size;
+        Uint32 used;
+    } uploads;
+
+    // Download buffers that aren't in use, kept for the next read
+    struct
+    {
+        SDL_GPUTransferBuffer *transfer_bufs[GPU_READBACK_POOL_SIZE];
+        Uint32 sizes[GPU_READBACK_POOL_SIZE];
+        int count;
+    } readback_pool;
+
     struct
     {
         SDL_GPURenderPass *render_pass;
@@ -155,6 +173,146 @@ typedef struct GPU_TextureData
 #endif
 } GPU_TextureData;
 
+// Texture data is staged at this alignment, which satisfies the texture copy requirements of all GPU drivers
+#define UPLOAD_BUFFER_ALIGNMENT 512
+#define UPLOAD_BUFFER_MIN_SIZE  (4 * 1024 * 1024)
+
+/* Texture uploads are staged in a single transfer buffer that is used as a ring.
+ * Each upload is written after the previous one, so the copies that the GPU hasn't
+ * executed yet keep their data, and when the buffer is full it is cycled, which
+ * gives us a fresh buffer without waiting for the GPU to finish with the old one.
+ *
+ * The returned memory is mapped, and must be unmapped with UnmapUploadBuffer().
+ */
+static Uint8 *MapUploadBuffer(SDL_Renderer *renderer, size_t size, Uint32 *offset)
+{
+    GPU_RenderData *data = (GPU_RenderData *)renderer->internal;
+    Uint32 start = (data->uploads.used + (UPLOAD_BUFFER_ALIGNMENT - 1)) & ~(UPLOAD_BUFFER_ALIGNMENT - 1);
+    bool cycle = false;
+
+    if (size > SDL_MAX_UINT32 / 2) {
+        SDL_SetError("upload size overflow");
+        return NULL;
+    }
+
+    if (size > data->uploads.size) {
+        Uint32 new_size = data->uploads.size ? data->uploads.size * 2 : UPLOAD_BUFFER_MIN_SIZE;
+        while (new_size < size) {
+            new_size *= 2;
+        }
+
+        SDL_GPUTransferBufferCreateInfo tbci;
+        SDL_zero(tbci);
+        tbci.size = new_size;
+        tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+
+        SDL_GPUTransferBuffer *tbuf = SDL_CreateGPUTransferBuffer(data->device, &tbci);
+        if (!tbuf) {
+            return NULL;
+        }
+
+        // Pending copies from the old buffer still complete, it's released when they're done
+        if (data->uploads.transfer_buf) {
+            SDL_ReleaseGPUTransferBuffer(data->device, data->uploads.transfer_buf);
+        }
+        data->uploads.transfer_buf = tbuf;
+        data->uploads.size = new_size;
+        start = 0;
+    } else if (start > data->uploads.size - size) {
+        // Wrap around to a buffer that isn't in use
+        cycle = true;
+        start = 0;
+    }
+
+    Uint8 *mapped = (Uint8 *)SDL_MapGPUTransferBuffer(data->device, data->uploads.transfer_buf, cycle);
+    if (!mapped) {
+        return NULL;
+    }
+    data->uploads.used = start + (Uint32)size;
+    renderer->frame_stats.upload_bytes += size;
+
+    *offset = start;
+    return mapped + start;
+}
+
+static void UnmapUploadBuffer(GPU_RenderData *data)
+{
+    SDL_UnmapGPUTransferBuffer(data->device, data->uploads.transfer_buf);
+}
+
+static void ReleaseUploadBuffer(GPU_RenderData *data)
+{
+    if (data->uploads.transfer_buf) {
+        SDL_ReleaseGPUTransferBuffer(data->device, data->uploads.transfer_buf);
+        data->uploads.transfer_buf = NULL;
+    }
+    data->uploads.size = 0;
+    data->uploads.used = 0;
+}
+
+// Take the smallest pooled download buffer that fits, or create a new one
+static SDL_GPUTransferBuffer *AcquireReadbackBuffer(GPU_RenderData *data, Uint32 size, Uint32 *buffer_size)
+{
+    int best = -1;
+
+    for (int i = 0; i < data->readback_pool.count; ++i) {
+        if (data->readback_pool.sizes[i] >= size &&
+            (best < 0 || data->readback_pool.sizes[i] < data->readback_pool.sizes[best])) {
+            best = i;
+        }
+    }
+
+    if (best >= 0) {
+        SDL_GPUTransferBuffer *tbuf = data->readback_pool.transfer_bufs[best];
+        const int last = --data->readback_pool.count;
+
+        *buffer_size = data->readback_pool.sizes[best];
+        data->readback_pool.transfer_bufs[best] = data->readback_pool.transfer_bufs[last];
+        data->readback_pool.sizes[best] = data->readback_pool.sizes[last];
+        return tbuf;
+    }
+
+    SDL_GPUTransferBufferCreateInfo tbci;
+    SDL_zero(tbci);
+    tbci.size = size;
+    tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+
+    *buffer_size = size;
+    return SDL_CreateGPUTransferBuffer(data->device, &tbci);
+}
+
+// Return a download buffer to the pool, replacing the smallest one if the pool is full
+static void ReleaseReadbackBuffer(GPU_RenderData *data, SDL_GPUTransferBuffer *tbuf, Uint32 buffer_size)
+{
+    int slot = data->readback_pool.count;
+
+    if (slot == GPU_READBACK_POOL_SIZE) {
+        slot = 0;
+        for (int i = 1; i < data->readback_pool.count; ++i) {
+            if (data->readback_pool.sizes[i] < data->readback_pool.sizes[slot]) {
+                slot = i;
+            }
+        }
+        if (data->readback_pool.sizes[slot] >= buffer_size) {
+            SDL_ReleaseGPUTransferBuffer(data->device, tbuf);
+            return;
+        }
+        SDL_ReleaseGPUTransferBuffer(data->device, data->readback_pool.transfer_bufs[slot]);
+    } else {
+        ++data->readback_pool.count;
+    }
+    data->readback_pool.transfer_bufs[slot] = tbuf;
+    data->readback_pool.sizes[slot] = buffer_size;
+}
+
+static void ReleaseReadbackBuffers(GPU_RenderData *data)
+{
+    for (int i = 0; i < data->readback_pool.count; ++i) {
+        SDL_ReleaseGPUTransferBuffer(data->device, data->readback_pool.transfer_bufs[i]);
+    }
+    data->readback_pool.count = 0;
+}
+
 static bool GPU_SupportsBlendMode(SDL_Renderer *renderer, SDL_BlendMode blendMode)
 {
     SDL_BlendFactor srcColorFactor = SDL_GetBlendModeSrcColorFactor(blendMode);
@@ -207,27 +365,22 @@ static bool GPU_UpdatePalette(SDL_Renderer *renderer, SDL_TexturePalette *palett
     GPU_RenderData *data = (GPU_RenderData *)renderer->internal;
     GPU_PaletteData *palettedata = (GPU_PaletteData *)palette->internal;
     const Uint32 data_size = ncolors * sizeof(*colors);
+    Uint32 offset;
 
-    SDL_GPUTransferBufferCreateInfo tbci;
-    SDL_zero(tbci);
-    tbci.size = data_size;
-    tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-
-    SDL_GPUTransferBuffer *tbuf = SDL_CreateGPUTransferBuffer(data->device, &tbci);
-    if (tbuf == NULL) {
+    Uint8 *output = MapUploadBuffer(renderer, data_size, &offset);
+    if (!output) {
         return false;
     }
-
-    Uint8 *output = SDL_MapGPUTransferBuffer(data->device, tbuf, false);
     SDL_memcpy(output, colors, data_size);
-    SDL_UnmapGPUTransferBuffer(data->device, tbuf);
+    UnmapUploadBuffer(data);
 
     SDL_GPUCommandBuffer *cbuf = data->state.command_buffer;
     SDL_GPUCopyPass *cpass = SDL_BeginGPUCopyPass(cbuf);
 
     SDL_GPUTextureTransferInfo tex_src;
     SDL_zero(tex_src);
-    tex_src.transfer_buffer = tbuf;
+    tex_src.transfer_buffer = data->uploads.transfer_buf;
+    tex_src.offset = offset;
     tex_src.rows_per_layer = 1;
     tex_src.pixels_per_row = ncolors;
 
@@ -242,7 +395,6 @@ static bool GPU_UpdatePalette(SDL_Renderer *renderer, SDL_TexturePalette *palett
 
     SDL_UploadToGPUTexture(cpass, &tex_src, &tex_dst, false);
     SDL_EndGPUCopyPass(cpass);
-    SDL_ReleaseGPUTransferBuffer(data->device, tbuf);
 
     return true;
 }
@@ -324,8 +476,6 @@ static bool GPU_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_
             SDL_free(data);
             return false;
         }
-
-        // TODO allocate a persistent transfer buffer
     }
 
     if (texture->access == SDL_TEXTUREACCESS_TARGET) {
@@ -434,7 +584,7 @@ static bool GPU_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_
     return true;
 }
 
-static bool GPU_UpdateTextureInternal(GPU_RenderData *renderdata, SDL_GPUCopyPass *cpass, SDL_GPUTexture *texture, int bpp, int x, int y, int w, int h, const void *pixels, int pitch)
+static bool GPU_UpdateTextureInternal(SDL_Renderer *renderer, SDL_GPUCopyPass *cpass, SDL_GPUTexture *texture, int bpp, int x, int y, int w, int h, const void *pixels, int pitch)
 {
     size_t row_size, data_size;
     if (!SDL_size_mul_check_overflow(w, bpp, &row_size) ||
@@ -442,17 +592,9 @@ static bool GPU_UpdateTextureInternal(GPU_RenderData *renderdata, SDL_GPUCopyPas
         return SDL_SetError("update size overflow");
     }
 
-    SDL_GPUTransferBufferCreateInfo tbci;
-    SDL_zero(tbci);
-    tbci.size = (Uint32)data_size;
-    tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-
-    SDL_GPUTransferBuffer *tbuf = SDL_CreateGPUTransferBuffer(renderdata->device, &tbci);
-    if (tbuf == NULL) {
-        return false;
-    }
-
-    Uint8 *output = SDL_MapGPUTransferBuffer(renderdata->device, tbuf, false);
+    GPU_RenderData *renderdata = (GPU_RenderData *)renderer->internal;
+    Uint32 offset;
+    Uint8 *output = MapUploadBuffer(renderer, data_size, &offset);
     if (!output) {
         return false;
     }
@@ -466,11 +608,12 @@ static bool GPU_UpdateTextureInternal(GPU_RenderData *renderdata, SDL_GPUCopyPas
             input += pitch;
         }
     }
-    SDL_UnmapGPUTransferBuffer(renderdata->device, tbuf);
+    UnmapUploadBuffer(renderdata);
 
     SDL_GPUTextureTransferInfo tex_src;
     SDL_zero(tex_src);
-    tex_src.transfer_buffer = tbuf;
+    tex_src.transfer_buffer = renderdata->uploads.transfer_buf;
+    tex_src.offset = offset;
     tex_src.rows_per_layer = h;
     tex_src.pixels_per_row = w;
 
@@ -484,7 +627,6 @@ static bool GPU_UpdateTextureInternal(GPU_RenderData *renderdata, SDL_GPUCopyPas
     tex_dst.d = 1;
 
     SDL_UploadToGPUTexture(cpass, &tex_src, &tex_dst, false);
-    SDL_ReleaseGPUTransferBuffer(renderdata->device, tbuf);
 
     return true;
 }
@@ -512,7 +654,7 @@ static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, cons
     SDL_GPUCopyPass *cpass = SDL_BeginGPUCopyPass(cbuf);
     int bpp = SDL_BYTESPERPIXEL(texture->format);
 
-    retval = GPU_UpdateTextureInternal(renderdata, cpass, data->texture, bpp, rect->x, rect->y, rect->w, rect->h, pixels, pitch);
+    retval = GPU_UpdateTextureInternal(renderer, cpass, data->texture, bpp, rect->x, rect->y, rect->w, rect->h, pixels, pitch);
 
 #ifdef SDL_HAVE_YUV
     if (data->nv12) {
@@ -527,7 +669,7 @@ static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, cons
             bpp = 1;
             UVpitch = (pitch + 1) & ~1;
         }
-        retval &= GPU_UpdateTextureInternal(renderdata, cpass, data->textureNV, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, UVplane, UVpitch);
+        retval &= GPU_UpdateTextureInternal(renderer, cpass, data->textureNV, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, UVplane, UVpitch);
 
     } else if (data->yuv) {
         int Ypitch = pitch;
@@ -536,8 +678,8 @@ static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, cons
         const Uint8 *Uplane = Yplane + rect->h * Ypitch;
         const Uint8 *Vplane = Uplane + ((rect->h + 1) / 2) * UVpitch;
 
-        retval &= GPU_UpdateTextureInternal(renderdata, cpass, data->textureU, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, Uplane, UVpitch);
-        retval &= GPU_UpdateTextureInternal(renderdata, cpass, data->textureV, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, Vplane, UVpitch);
+        retval &= GPU_UpdateTextureInternal(renderer, cpass, data->textureU, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, Uplane, UVpitch);
+        retval &= GPU_UpdateTextureInternal(renderer, cpass, data->textureV, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, Vplane, UVpitch);
     }
 #endif
 
@@ -559,9 +701,9 @@ static bool GPU_UpdateTextureYUV(SDL_Renderer *renderer, SDL_Texture *texture,
     bool retval = true;
     SDL_GPUCommandBuffer *cbuf = renderdata->state.command_buffer;
     SDL_GPUCopyPass *cpass = SDL_BeginGPUCopyPass(cbuf);
-    retval &= GPU_UpdateTextureInternal(renderdata, cpass, data->texture, bpp, rect->x, rect->y, rect->w, rect->h, Yplane, Ypitch);
-    retval &= GPU_UpdateTextureInternal(renderdata, cpass, data->textureU, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, Uplane, Upitch);
-    retval &= GPU_UpdateTextureInternal(renderdata, cpass, data->textureV, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, Vplane, Vpitch);
+    retval &= GPU_UpdateTextureInternal(renderer, cpass, data->texture, bpp, rect->x, rect->y, rect->w, rect->h, Yplane, Ypitch);
+    retval &= GPU_UpdateTextureInternal(renderer, cpass, data->textureU, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, Uplane, Upitch);
+    retval &= GPU_UpdateTextureInternal(renderer, cpass, data->textureV, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, Vplane, Vpitch);
     SDL_EndGPUCopyPass(cpass);
     return retval;
 }
@@ -578,9 +720,9 @@ static bool GPU_UpdateTextureNV(SDL_Renderer *renderer, SDL_Texture *texture,
     bool retval = true;
     SDL_GPUCommandBuffer *cbuf = renderdata->state.command_buffer;
     SDL_GPUCopyPass *cpass = SDL_BeginGPUCopyPass(cbuf);
-    retval &= GPU_UpdateTextureInternal(renderdata, cpass, data->texture, bpp, rect->x, rect->y, rect->w, rect->h, Yplane, Ypitch);
+    retval &= GPU_UpdateTextureInternal(renderer, cpass, data->texture, bpp, rect->x, rect->y, rect->w, rect->h, Yplane, Ypitch);
     bpp *= 2;
-    retval &= GPU_UpdateTextureInternal(renderdata, cpass, data->textureNV, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, UVplane, UVpitch);
+    retval &= GPU_UpdateTextureInternal(renderer, cpass, data->textureNV, bpp, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, UVplane, UVpitch);
     SDL_EndGPUCopyPass(cpass);
     return retval;
 }
@@ -666,50 +808,22 @@ static bool GPU_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SD
     int i;
     int count = indices ? num_indices : num_vertices;
     float *verts;
-    size_t sz = 2 * sizeof(float) + 4 * sizeof(float) + (texture ? 2 : 0) * sizeof(float);
+    size_t num_floats = 2 + 4 + (texture ? 2 : 0);
     bool convert_color = SDL_RenderingLinearSpace(renderer);
 
-    verts = (float *)SDL_AllocateRenderVertices(renderer, count * sz, 0, &cmd->data.draw.first);
+    verts = (float *)SDL_AllocateRenderVertices(renderer, count * num_floats * sizeof(float), 0, &cmd->data.draw.first);
     if (!verts) {
         return false;
     }
 
     cmd->data.draw.count = count;
-    size_indices = indices ? size_indices : 0;
-
-    for (i = 0; i < count; i++) {
-        int j;
-        float *xy_;
-        SDL_FColor col_;
-        if (size_indices == 4) {
-            j = ((const Uint32 *)indices)[i];
-        } else if (size_indices == 2) {
-            j = ((const Uint16 *)indices)[i];
-        } else if (size_indices == 1) {
-            j = ((const Uint8 *)indices)[i];
-        } else {
-            j = i;
-        }
-
-        xy_ = (float *)((char *)xy + j * xy_stride);
 
-        *(verts++) = xy_[0] * scale_x;
-        *(verts++) = xy_[1] * scale_y;
+    SDL_CopyRenderGeometry(verts, xy, xy_stride, color, color_stride, texture ? uv : NULL, uv_stride,
+                           indices, size_indices, count, scale_x, scale_y, 1.0f, 1.0f, 1.0f);
 
-        col_ = *(SDL_FColor *)((char *)color + j * color_stride);
-        if (convert_color) {
-            SDL_ConvertToLinear(&col_);
-        }
-
-        *(verts++) = col_.r;
-        *(verts++) = col_.g;
-        *(verts++) = col_.b;
-        *(verts++) = col_.a;
-
-        if (texture) {
-            float *uv_ = (float *)((char *)uv + j * uv_stride);
-            *(verts++) = uv_[0];
-            *(verts++) = uv_[1];
+    if (convert_color) {
+        for (i = 0; i < count; i++) {
+            SDL_ConvertToLinear((SDL_FColor *)(verts + i * num_floats + 2));
         }
     }
     return true;
@@ -1334,7 +1448,16 @@ static bool GPU_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     return true;
 }
 
-static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+typedef struct GPU_ReadbackData
+{
+    SDL_GPUTransferBuffer *transfer_buf;
+    Uint32 transfer_buf_size;
+    SDL_GPUFence *fence;
+    SDL_PixelFormat format;
+} GPU_ReadbackData;
+
+// Queue a copy of the render target into a pooled transfer buffer, and submit the rendering up to this point
+static SDL_GPUTransferBuffer *StartReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect, SDL_PixelFormat *format, Uint32 *tbuf_size, SDL_GPUFence **fence)
 {
     GPU_RenderData *data = (GPU_RenderData *)renderer->internal;
     SDL_GPUTexture *gpu_tex;
@@ -1359,23 +1482,13 @@ static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect
     size_t row_size, image_size;
 
     if (!SDL_size_mul_check_overflow(rect->w, bpp, &row_size) ||
-        !SDL_size_mul_check_overflow(rect->h, row_size, &image_size)) {
+        !SDL_size_mul_check_overflow(rect->h, row_size, &image_size) ||
+        image_size > SDL_MAX_UINT32) {
         SDL_SetError("read size overflow");
         return NULL;
     }
 
-    SDL_Surface *surface = SDL_CreateSurface(rect->w, rect->h, pixfmt);
-
-    if (!surface) {
-        return NULL;
-    }
-
-    SDL_GPUTransferBufferCreateInfo tbci;
-    SDL_zero(tbci);
-    tbci.size = (Uint32)image_size;
-    tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
-
-    SDL_GPUTransferBuffer *tbuf = SDL_CreateGPUTransferBuffer(data->device, &tbci);
+    SDL_GPUTransferBuffer *tbuf = AcquireReadbackBuffer(data, (Uint32)image_size, tbuf_size);
 
     if (!tbuf) {
         return NULL;
@@ -1401,32 +1514,100 @@ static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect
     SDL_DownloadFromGPUTexture(pass, &src, &dst);
     SDL_EndGPUCopyPass(pass);
 
-    SDL_GPUFence *fence = SDL_SubmitGPUCommandBufferAndAcquireFence(data->state.command_buffer);
+    *fence = SDL_SubmitGPUCommandBufferAndAcquireFence(data->state.command_buffer);
+    data->state.command_buffer = SDL_AcquireGPUCommandBuffer(data->device);
+
+    if (!*fence) {
+        ReleaseReadbackBuffer(data, tbuf, *tbuf_size);
+        return NULL;
+    }
+    *format = pixfmt;
+    return tbuf;
+}
+
+// Wait for a copy started by StartReadPixels() and return the pixels, returning the transfer buffer to the pool and releasing the fence
+static SDL_Surface *FinishReadPixels(SDL_Renderer *renderer, int w, int h, SDL_PixelFormat format, SDL_GPUTransferBuffer *tbuf, Uint32 tbuf_size, SDL_GPUFence *fence)
+{
+    GPU_RenderData *data = (GPU_RenderData *)renderer->internal;
+    const size_t row_size = (size_t)w * SDL_BYTESPERPIXEL(format);
+
     SDL_WaitForGPUFences(data->device, true, &fence, 1);
     SDL_ReleaseGPUFence(data->device, fence);
-    data->state.command_buffer = SDL_AcquireGPUCommandBuffer(data->device);
 
-    void *mapped_tbuf = SDL_MapGPUTransferBuffer(data->device, tbuf, false);
+    SDL_Surface *surface = SDL_CreateSurface(w, h, format);
 
-    if ((size_t)surface->pitch == row_size) {
-        SDL_memcpy(surface->pixels, mapped_tbuf, image_size);
-    } else {
-        Uint8 *input = mapped_tbuf;
-        Uint8 *output = surface->pixels;
+    if (surface) {
+        void *mapped_tbuf = SDL_MapGPUTransferBuffer(data->device, tbuf, false);
 
-        for (int row = 0; row < rect->h; ++row) {
-            SDL_memcpy(output, input, row_size);
-            output += surface->pitch;
-            input += row_size;
+        if (!mapped_tbuf) {
+            SDL_DestroySurface(surface);
+            surface = NULL;
+        } else {
+            if ((size_t)surface->pitch == row_size) {
+                SDL_memcpy(surface->pixels, mapped_tbuf, row_size * h);
+            } else {
+                Uint8 *input = mapped_tbuf;
+                Uint8 *output = surface->pixels;
+
+                for (int row = 0; row < h; ++row) {
+                    SDL_memcpy(output, input, row_size);
+                    output += surface->pitch;
+                    input += row_size;
+                }
+            }
+            SDL_UnmapGPUTransferBuffer(data->device, tbuf);
         }
     }
 
-    SDL_UnmapGPUTransferBuffer(data->device, tbuf);
-    SDL_ReleaseGPUTransferBuffer(data->device, tbuf);
+    ReleaseReadbackBuffer(data, tbuf, tbuf_size);
 
     return surface;
 }
 
+static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    SDL_PixelFormat format;
+    Uint32 tbuf_size;
+    SDL_GPUFence *fence;
+
+    SDL_GPUTransferBuffer *tbuf = StartReadPixels(renderer, rect, &format, &tbuf_size, &fence);
+    if (!tbuf) {
+        return NULL;
+    }
+    return FinishReadPixels(renderer, rect->w, rect->h, format, tbuf, tbuf_size, fence);
+}
+
+static bool GPU_RenderReadPixelsAsync(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    GPU_ReadbackData *readbackdata = (GPU_ReadbackData *)SDL_calloc(1, sizeof(*readbackdata));
+    if (!readbackdata) {
+        return false;
+    }
+
+    readbackdata->transfer_buf = StartReadPixels(renderer, &readback->rect, &readbackdata->format, &readbackdata->transfer_buf_size, &readbackdata->fence);
+    if (!readbackdata->transfer_buf) {
+        SDL_free(readbackdata);
+        return false;
+    }
+    readback->internal = readbackdata;
+    return true;
+}
+
+static bool GPU_FinishReadPixelsAsync(SDL_Renderer *renderer, SDL_RenderReadback *readback, bool wait)
+{
+    GPU_RenderData *data = (GPU_RenderData *)renderer->internal;
+    GPU_ReadbackData *readbackdata = (GPU_ReadbackData *)readback->internal;
+
+    if (!wait && !SDL_QueryGPUFence(data->device, readbackdata->fence)) {
+        return false;
+    }
+
+    readback->surface = FinishReadPixels(renderer, readback->rect.w, readback->rect.h, readbackdata->format, readbackdata->transfer_buf, readbackdata->transfer_buf_size, readbackdata->fence);
+    SDL_free(readbackdata);
+    readback->internal = NULL;
+    return true;
+}
+
 static bool CreateBackbuffer(GPU_RenderData *data, Uint32 w, Uint32 h, SDL_GPUTextureFormat fmt)
 {
     SDL_GPUTextureCreateInfo tci;
@@ -1556,6 +1737,8 @@ static void GPU_DestroyRenderer(SDL_Renderer *renderer)
     }
 
     ReleaseVertexBuffer(data);
+    ReleaseUploadBuffer(data);
+    ReleaseReadbackBuffers(data);
     GPU_DestroyPipelineCache(&data->pipeline_cache);
 
     if (data->device) {
@@ -1667,6 +1850,8 @@ static bool GPU_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_P
     renderer->InvalidateCachedState = GPU_InvalidateCachedState;
     renderer->RunCommandQueue = GPU_RunCommandQueue;
     renderer->RenderReadPixels = GPU_RenderReadPixels;
+    renderer->RenderReadPixelsAsync = GPU_RenderReadPixelsAsync;
+    renderer->FinishReadPixelsAsync = GPU_FinishReadPixelsAsync;
     renderer->RenderPresent = GPU_RenderPresent;
     renderer->DestroyTexture = GPU_DestroyTexture;
     renderer->DestroyRenderer = GPU_DestroyRenderer;
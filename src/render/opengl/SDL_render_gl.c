@@ -85,6 +85,9 @@ typedef struct
     SDL_FColor clear_color;
 } GL_DrawStateCache;
 
+// The number of idle pixel buffers kept for asynchronous reads
+#define GL_READBACK_POOL_SIZE 4
+
 typedef struct
 {
     SDL_GLContext context;
@@ -120,6 +123,25 @@ typedef struct
     PFNGLBINDFRAMEBUFFEREXTPROC glBindFramebufferEXT;
     PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC glCheckFramebufferStatusEXT;
 
+    // Asynchronous readback support
+    bool GL_ARB_sync_supported;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+
+    bool GL_ARB_pixel_buffer_object_supported;
+    PFNGLGENBUFFERSARBPROC glGenBuffersARB;
+    PFNGLDELETEBUFFERSARBPROC glDeleteBuffersARB;
+    PFNGLBINDBUFFERARBPROC glBindBufferARB;
+    PFNGLBUFFERDATAARBPROC glBufferDataARB;
+    PFNGLMAPBUFFERARBPROC glMapBufferARB;
+    PFNGLUNMAPBUFFERARBPROC glUnmapBufferARB;
+
+    // Pixel buffers that aren't in use, kept for the next read
+    GLuint readback_pool[GL_READBACK_POOL_SIZE];
+    size_t readback_pool_sizes[GL_READBACK_POOL_SIZE];
+    int readback_pool_count;
+
     // Shader support
     GL_ShaderContext *shaders;
 
@@ -1039,7 +1061,6 @@ static bool GL_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL
                             float scale_x, float scale_y)
 {
     GL_TextureData *texturedata = NULL;
-    int i;
     int count = indices ? num_indices : num_vertices;
     GLfloat *verts;
     size_t sz = 2 * sizeof(GLfloat) + 4 * sizeof(GLfloat) + (texture ? 2 : 0) * sizeof(GLfloat);
@@ -1055,39 +1076,10 @@ static bool GL_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL
     }
 
     cmd->data.draw.count = count;
-    size_indices = indices ? size_indices : 0;
-
-    for (i = 0; i < count; i++) {
-        int j;
-        float *xy_;
-        SDL_FColor *col_;
-        if (size_indices == 4) {
-            j = ((const Uint32 *)indices)[i];
-        } else if (size_indices == 2) {
-            j = ((const Uint16 *)indices)[i];
-        } else if (size_indices == 1) {
-            j = ((const Uint8 *)indices)[i];
-        } else {
-            j = i;
-        }
-
-        xy_ = (float *)((char *)xy + j * xy_stride);
-
-        *(verts++) = xy_[0] * scale_x;
-        *(verts++) = xy_[1] * scale_y;
 
-        col_ = (SDL_FColor *)((char *)color + j * color_stride);
-        *(verts++) = col_->r * color_scale;
-        *(verts++) = col_->g * color_scale;
-        *(verts++) = col_->b * color_scale;
-        *(verts++) = col_->a;
-
-        if (texture) {
-            float *uv_ = (float *)((char *)uv + j * uv_stride);
-            *(verts++) = uv_[0] * texturedata->texw;
-            *(verts++) = uv_[1] * texturedata->texh;
-        }
-    }
+    SDL_CopyRenderGeometry(verts, xy, xy_stride, color, color_stride, texture ? uv : NULL, uv_stride,
+                           indices, size_indices, count, scale_x, scale_y, color_scale,
+                           texturedata ? texturedata->texw : 1.0f, texturedata ? texturedata->texh : 1.0f);
     return true;
 }
 
@@ -1655,6 +1647,181 @@ static SDL_Surface *GL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *
     return surface;
 }
 
+typedef struct
+{
+    GLuint pbo;
+    size_t pbo_size;
+    GLsync fence;
+    SDL_PixelFormat format;
+    bool flip;
+} GL_ReadbackData;
+
+// Take the smallest pooled pixel buffer that fits, or create a new one, and bind it for packing
+static void GL_AcquireReadbackBuffer(GL_RenderData *data, size_t size, GLuint *pbo, size_t *pbo_size)
+{
+    int best = -1;
+
+    for (int i = 0; i < data->readback_pool_count; ++i) {
+        if (data->readback_pool_sizes[i] >= size &&
+            (best < 0 || data->readback_pool_sizes[i] < data->readback_pool_sizes[best])) {
+            best = i;
+        }
+    }
+
+    if (best >= 0) {
+        const int last = --data->readback_pool_count;
+
+        *pbo = data->readback_pool[best];
+        *pbo_size = data->readback_pool_sizes[best];
+        data->readback_pool[best] = data->readback_pool[last];
+        data->readback_pool_sizes[best] = data->readback_pool_sizes[last];
+        data->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, *pbo);
+        return;
+    }
+
+    data->glGenBuffersARB(1, pbo);
+    data->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, *pbo);
+    data->glBufferDataARB(GL_PIXEL_PACK_BUFFER_ARB, (GLsizeiptrARB)size, NULL, GL_STREAM_READ_ARB);
+    *pbo_size = size;
+}
+
+// Return a pixel buffer to the pool, replacing the smallest one if the pool is full
+static void GL_ReleaseReadbackBuffer(GL_RenderData *data, GLuint pbo, size_t pbo_size)
+{
+    int slot = data->readback_pool_count;
+
+    if (slot == GL_READBACK_POOL_SIZE) {
+        slot = 0;
+        for (int i = 1; i < data->readback_pool_count; ++i) {
+            if (data->readback_pool_sizes[i] < data->readback_pool_sizes[slot]) {
+                slot = i;
+            }
+        }
+        if (data->readback_pool_sizes[slot] >= pbo_size) {
+            data->glDeleteBuffersARB(1, &pbo);
+            return;
+        }
+        data->glDeleteBuffersARB(1, &data->readback_pool[slot]);
+    } else {
+        ++data->readback_pool_count;
+    }
+    data->readback_pool[slot] = pbo;
+    data->readback_pool_sizes[slot] = pbo_size;
+}
+
+// Read the pixels into a pixel buffer and insert a fence after the read, without waiting for it
+static bool GL_RenderReadPixelsAsync(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->internal;
+    const SDL_Rect *rect = &readback->rect;
+    SDL_PixelFormat format = renderer->target ? renderer->target->format : SDL_PIXELFORMAT_RGBA32;
+    GL_ReadbackData *readbackdata;
+    GLint internalFormat;
+    GLenum targetFormat, type;
+    size_t row_size, image_size;
+
+    GL_ActivateRenderer(renderer);
+
+    if (!convert_format(format, &internalFormat, &targetFormat, &type)) {
+        return SDL_SetError("Texture format %s not supported by OpenGL", SDL_GetPixelFormatName(format));
+    }
+
+    if (!SDL_size_mul_check_overflow(rect->w, SDL_BYTESPERPIXEL(format), &row_size) ||
+        !SDL_size_mul_check_overflow(rect->h, row_size, &image_size)) {
+        return SDL_SetError("read size overflow");
+    }
+
+    readbackdata = (GL_ReadbackData *)SDL_calloc(1, sizeof(*readbackdata));
+    if (!readbackdata) {
+        return false;
+    }
+    readbackdata->format = format;
+    readbackdata->flip = !renderer->target;
+
+    int y = rect->y;
+    if (!renderer->target) {
+        int w, h;
+        SDL_GetRenderOutputSize(renderer, &w, &h);
+        y = (h - y) - rect->h;
+    }
+
+    GL_AcquireReadbackBuffer(data, image_size, &readbackdata->pbo, &readbackdata->pbo_size);
+    data->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    data->glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    data->glReadPixels(rect->x, y, rect->w, rect->h, targetFormat, type, NULL);
+    data->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+    if (!GL_CheckError("glReadPixels()", renderer)) {
+        GL_ReleaseReadbackBuffer(data, readbackdata->pbo, readbackdata->pbo_size);
+        SDL_free(readbackdata);
+        return false;
+    }
+
+    readbackdata->fence = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!readbackdata->fence) {
+        GL_ReleaseReadbackBuffer(data, readbackdata->pbo, readbackdata->pbo_size);
+        SDL_free(readbackdata);
+        return SDL_SetError("glFenceSync() failed");
+    }
+
+    readback->internal = readbackdata;
+    return true;
+}
+
+static bool GL_FinishReadPixelsAsync(SDL_Renderer *renderer, SDL_RenderReadback *readback, bool wait)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->internal;
+    GL_ReadbackData *readbackdata = (GL_ReadbackData *)readback->internal;
+    const int w = readback->rect.w;
+    const int h = readback->rect.h;
+    const size_t row_size = (size_t)w * SDL_BYTESPERPIXEL(readbackdata->format);
+    GLenum status;
+
+    GL_ActivateRenderer(renderer);
+
+    status = data->glClientWaitSync(readbackdata->fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? SDL_MAX_UINT64 : 0);
+    if (status == GL_TIMEOUT_EXPIRED && !wait) {
+        return false;
+    }
+    data->glDeleteSync(readbackdata->fence);
+
+    SDL_Surface *surface = NULL;
+    if (status != GL_WAIT_FAILED) {
+        surface = SDL_CreateSurface(w, h, readbackdata->format);
+    }
+    if (surface) {
+        data->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, readbackdata->pbo);
+        const Uint8 *input = (const Uint8 *)data->glMapBufferARB(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB);
+        if (input) {
+            Uint8 *output = surface->pixels;
+            int pitch = surface->pitch;
+
+            // Flip the rows to be top-down if necessary
+            if (readbackdata->flip) {
+                output += (size_t)(h - 1) * surface->pitch;
+                pitch = -pitch;
+            }
+            for (int row = 0; row < h; ++row) {
+                SDL_memcpy(output, input, row_size);
+                output += pitch;
+                input += row_size;
+            }
+            data->glUnmapBufferARB(GL_PIXEL_PACK_BUFFER_ARB);
+        } else {
+            SDL_DestroySurface(surface);
+            surface = NULL;
+        }
+        data->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+    }
+    GL_CheckError("glMapBufferARB()", renderer);
+
+    GL_ReleaseReadbackBuffer(data, readbackdata->pbo, readbackdata->pbo_size);
+    SDL_free(readbackdata);
+    readback->internal = NULL;
+    readback->surface = surface;
+    return true;
+}
+
 static bool GL_RenderPresent(SDL_Renderer *renderer)
 {
     GL_ActivateRenderer(renderer);
@@ -1724,6 +1891,9 @@ static void GL_DestroyRenderer(SDL_Renderer *renderer)
             GL_DestroyShaderContext(data->shaders);
         }
         if (data->context) {
+            if (data->readback_pool_count > 0) {
+                data->glDeleteBuffersARB(data->readback_pool_count, data->readback_pool);
+            }
             while (data->framebuffers) {
                 GL_FBOList *nextnode = data->framebuffers->next;
                 // delete the framebuffer object
@@ -2003,6 +2173,32 @@ static bool GL_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pr
         goto error;
     }
 
+    if (real_major > 3 || (real_major == 3 && real_minor >= 2) ||
+        SDL_GL_ExtensionSupported("GL_ARB_sync")) {
+        data->glFenceSync = (PFNGLFENCESYNCPROC)SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = (PFNGLDELETESYNCPROC)SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+            data->GL_ARB_sync_supported = true;
+        }
+    }
+    if (SDL_GL_ExtensionSupported("GL_ARB_pixel_buffer_object")) {
+        data->glGenBuffersARB = (PFNGLGENBUFFERSARBPROC)SDL_GL_GetProcAddress("glGenBuffersARB");
+        data->glDeleteBuffersARB = (PFNGLDELETEBUFFERSARBPROC)SDL_GL_GetProcAddress("glDeleteBuffersARB");
+        data->glBindBufferARB = (PFNGLBINDBUFFERARBPROC)SDL_GL_GetProcAddress("glBindBufferARB");
+        data->glBufferDataARB = (PFNGLBUFFERDATAARBPROC)SDL_GL_GetProcAddress("glBufferDataARB");
+        data->glMapBufferARB = (PFNGLMAPBUFFERARBPROC)SDL_GL_GetProcAddress("glMapBufferARB");
+        data->glUnmapBufferARB = (PFNGLUNMAPBUFFERARBPROC)SDL_GL_GetProcAddress("glUnmapBufferARB");
+        if (data->glGenBuffersARB && data->glDeleteBuffersARB && data->glBindBufferARB &&
+            data->glBufferDataARB && data->glMapBufferARB && data->glUnmapBufferARB) {
+            data->GL_ARB_pixel_buffer_object_supported = true;
+        }
+    }
+    if (data->GL_ARB_sync_supported && data->GL_ARB_pixel_buffer_object_supported) {
+        renderer->RenderReadPixelsAsync = GL_RenderReadPixelsAsync;
+        renderer->FinishReadPixelsAsync = GL_FinishReadPixelsAsync;
+    }
+
     // Set up parameters for rendering
     data->glMatrixMode(GL_MODELVIEW);
     data->glLoadIdentity();
@@ -45,10 +45,77 @@ typedef struct
     SDL_Color color;
 } SW_DrawStateCache;
 
+#define SW_TILE_SIZE         64
+#define SW_TILE_OP_ELEMENTS  32 // points, rects or triangles in one tile op
+#define SW_TILE_MAX_TEXTURES 32 // textures used by one batch of tiles
+
+typedef struct SW_TileRenderer SW_TileRenderer;
+
+// A piece of a draw command with the draw state it runs with
+typedef struct
+{
+    const SDL_RenderCommand *cmd;
+    int first;       // the first point, rect or vertex of the command drawn by this op
+    int count;
+    SDL_Rect clip;   // the draw clip rect, in target coordinates
+    SDL_Rect bounds; // the area this op can touch, within clip
+    SDL_Color color;
+    Uint32 pixel;    // color mapped to the target format
+    int texture;     // index into the batch textures, or -1
+} SW_TileOp;
+
+typedef struct
+{
+    SW_TileRenderer *tiles;
+    SDL_Thread *thread;
+    SDL_Surface *target;
+    SDL_Surface **textures;
+    SDL_Surface *views[SW_TILE_MAX_TEXTURES];
+} SW_TileWorker;
+
+struct SW_TileRenderer
+{
+    SW_TileWorker *workers; // workers[0] is the thread running the command queue
+    int num_workers;
+    SDL_Semaphore *work_ready;
+    SDL_Semaphore *work_done;
+    bool quit;
+
+    // The surface the worker targets share their pixels with
+    SDL_Surface *target;
+    void *target_pixels;
+    int target_w;
+    int target_h;
+    int target_pitch;
+    SDL_PixelFormat target_format;
+    SDL_Palette *target_palette;
+
+    // Textures the workers have views of, slots may be NULL
+    SDL_Surface *textures[SW_TILE_MAX_TEXTURES];
+    int num_textures;
+    Uint32 batch_textures; // the slots used by the batch being recorded
+
+    // The batch being recorded
+    void *vertices;
+    SW_TileOp *ops;
+    int num_ops;
+    int max_ops;
+
+    // Tile i is drawn by the ops tile_ops[tile_start[i]] to tile_ops[tile_start[i + 1] - 1]
+    int tiles_x;
+    int tiles_y;
+    int *tile_start;
+    int max_tiles;
+    int *tile_ops;
+    int max_tile_ops;
+    SDL_AtomicInt next_tile;
+};
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+    SW_TileRenderer *tiles; // NULL when drawing on one thread
 } SW_RenderData;
 
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
@@ -662,15 +729,12 @@ static bool SW_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL
     return true;
 }
 
-static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate)
+static void PrepSurfaceForCopy(SDL_Surface *surface, SDL_BlendMode blend, SDL_Color color)
 {
-    const Uint8 r = drawstate->color.r;
-    const Uint8 g = drawstate->color.g;
-    const Uint8 b = drawstate->color.b;
-    const Uint8 a = drawstate->color.a;
-    const SDL_BlendMode blend = cmd->data.draw.blend;
-    SDL_Texture *texture = cmd->data.draw.texture;
-    SDL_Surface *surface = (SDL_Surface *)texture->internal;
+    const Uint8 r = color.r;
+    const Uint8 g = color.g;
+    const Uint8 b = color.b;
+    const Uint8 a = color.a;
     const bool colormod = ((r & g & b) != 0xFF);
     const bool alphamod = (a != 0xFF);
     const bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
@@ -685,24 +749,38 @@ static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *
     SDL_SetSurfaceBlendMode(surface, blend);
 }
 
+static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate)
+{
+    SDL_Texture *texture = cmd->data.draw.texture;
+
+    PrepSurfaceForCopy((SDL_Surface *)texture->internal, cmd->data.draw.blend, drawstate->color);
+}
+
+static void GetDrawClipRect(const SW_DrawStateCache *drawstate, SDL_Rect *rect)
+{
+    const SDL_Rect *viewport = drawstate->viewport;
+    const SDL_Rect *cliprect = drawstate->cliprect;
+    SDL_assert_release(viewport != NULL); // the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT
+
+    if (cliprect && viewport) {
+        SDL_Rect clip_rect;
+        clip_rect.x = cliprect->x + viewport->x;
+        clip_rect.y = cliprect->y + viewport->y;
+        clip_rect.w = cliprect->w;
+        clip_rect.h = cliprect->h;
+        SDL_GetRectIntersection(viewport, &clip_rect, &clip_rect);
+        *rect = clip_rect;
+    } else {
+        *rect = *viewport;
+    }
+}
+
 static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
 {
     if (drawstate->surface_cliprect_dirty) {
-        const SDL_Rect *viewport = drawstate->viewport;
-        const SDL_Rect *cliprect = drawstate->cliprect;
-        SDL_assert_release(viewport != NULL); // the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT
-
-        if (cliprect && viewport) {
-            SDL_Rect clip_rect;
-            clip_rect.x = cliprect->x + viewport->x;
-            clip_rect.y = cliprect->y + viewport->y;
-            clip_rect.w = cliprect->w;
-            clip_rect.h = cliprect->h;
-            SDL_GetRectIntersection(viewport, &clip_rect, &clip_rect);
-            SDL_SetSurfaceClipRect(surface, &clip_rect);
-        } else {
-            SDL_SetSurfaceClipRect(surface, drawstate->viewport);
-        }
+        SDL_Rect clip_rect;
+        GetDrawClipRect(drawstate, &clip_rect);
+        SDL_SetSurfaceClipRect(surface, &clip_rect);
         drawstate->surface_cliprect_dirty = false;
     }
 }
@@ -713,45 +791,30 @@ static void SW_InvalidateCachedState(SDL_Renderer *renderer)
 }
 
 
-static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+static void SW_RunCommands(SDL_Renderer *renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, SDL_RenderCommand *end, void *vertices, SW_DrawStateCache *drawstate)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SW_DrawStateCache drawstate;
-
-    if (!SDL_SurfaceValid(surface)) {
-        return false;
-    }
-
-    drawstate.viewport = NULL;
-    drawstate.cliprect = NULL;
-    drawstate.surface_cliprect_dirty = true;
-    drawstate.color.r = 0;
-    drawstate.color.g = 0;
-    drawstate.color.b = 0;
-    drawstate.color.a = 0;
-
-    while (cmd) {
+    while (cmd != end) {
         switch (cmd->command) {
         case SDL_RENDERCMD_SETDRAWCOLOR:
         {
-            drawstate.color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+            drawstate->color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+            drawstate->color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+            drawstate->color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+            drawstate->color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
             break;
         }
 
         case SDL_RENDERCMD_SETVIEWPORT:
         {
-            drawstate.viewport = &cmd->data.viewport.rect;
-            drawstate.surface_cliprect_dirty = true;
+            drawstate->viewport = &cmd->data.viewport.rect;
+            drawstate->surface_cliprect_dirty = true;
             break;
         }
 
         case SDL_RENDERCMD_SETCLIPRECT:
         {
-            drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
-            drawstate.surface_cliprect_dirty = true;
+            drawstate->cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+            drawstate->surface_cliprect_dirty = true;
             break;
         }
 
@@ -764,27 +827,27 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             // By definition the clear ignores the clip rect
             SDL_SetSurfaceClipRect(surface, NULL);
             SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            drawstate.surface_cliprect_dirty = true;
+            drawstate->surface_cliprect_dirty = true;
             break;
         }
 
         case SDL_RENDERCMD_DRAW_POINTS:
         {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
+            const Uint8 r = drawstate->color.r;
+            const Uint8 g = drawstate->color.g;
+            const Uint8 b = drawstate->color.b;
+            const Uint8 a = drawstate->color.a;
             const int count = (int)cmd->data.draw.count;
             SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
             const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
+            SetDrawState(surface, drawstate);
 
             // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
                 int i;
                 for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
+                    verts[i].x += drawstate->viewport->x;
+                    verts[i].y += drawstate->viewport->y;
                 }
             }
 
@@ -798,21 +861,21 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
 
         case SDL_RENDERCMD_DRAW_LINES:
         {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
+            const Uint8 r = drawstate->color.r;
+            const Uint8 g = drawstate->color.g;
+            const Uint8 b = drawstate->color.b;
+            const Uint8 a = drawstate->color.a;
             const int count = (int)cmd->data.draw.count;
             SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
             const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
+            SetDrawState(surface, drawstate);
 
             // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
                 int i;
                 for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
+                    verts[i].x += drawstate->viewport->x;
+                    verts[i].y += drawstate->viewport->y;
                 }
             }
 
@@ -826,21 +889,21 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
 
         case SDL_RENDERCMD_FILL_RECTS:
         {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
+            const Uint8 r = drawstate->color.r;
+            const Uint8 g = drawstate->color.g;
+            const Uint8 b = drawstate->color.b;
+            const Uint8 a = drawstate->color.a;
             const int count = (int)cmd->data.draw.count;
             SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
             const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
+            SetDrawState(surface, drawstate);
 
             // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
                 int i;
                 for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
+                    verts[i].x += drawstate->viewport->x;
+                    verts[i].y += drawstate->viewport->y;
                 }
             }
 
@@ -860,14 +923,14 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             SDL_Texture *texture = cmd->data.draw.texture;
             SDL_Surface *src = (SDL_Surface *)texture->internal;
 
-            SetDrawState(surface, &drawstate);
+            SetDrawState(surface, drawstate);
 
-            PrepTextureForCopy(cmd, &drawstate);
+            PrepTextureForCopy(cmd, drawstate);
 
             // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                dstrect->x += drawstate.viewport->x;
-                dstrect->y += drawstate.viewport->y;
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                dstrect->x += drawstate->viewport->x;
+                dstrect->y += drawstate->viewport->y;
             }
 
             if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
@@ -920,15 +983,15 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
         case SDL_RENDERCMD_COPY_EX:
         {
             CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            SetDrawState(surface, &drawstate);
-            PrepTextureForCopy(cmd, &drawstate);
+            SetDrawState(surface, drawstate);
+            PrepTextureForCopy(cmd, drawstate);
 
             // Apply viewport
-            if (drawstate.viewport &&
-                (drawstate.viewport->x || drawstate.viewport->y) &&
+            if (drawstate->viewport &&
+                (drawstate->viewport->x || drawstate->viewport->y) &&
                 (copydata->scale_x > 0.0f && copydata->scale_y > 0.0f)) {
-                copydata->dstrect.x += (int)(drawstate.viewport->x / copydata->scale_x);
-                copydata->dstrect.y += (int)(drawstate.viewport->y / copydata->scale_y);
+                copydata->dstrect.x += (int)(drawstate->viewport->x / copydata->scale_x);
+                copydata->dstrect.y += (int)(drawstate->viewport->y / copydata->scale_y);
             }
 
             SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
@@ -945,20 +1008,20 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             SDL_Texture *texture = cmd->data.draw.texture;
             const SDL_BlendMode blend = cmd->data.draw.blend;
 
-            SetDrawState(surface, &drawstate);
+            SetDrawState(surface, drawstate);
 
             if (texture) {
                 SDL_Surface *src = (SDL_Surface *)texture->internal;
 
                 GeometryCopyData *ptr = (GeometryCopyData *)verts;
 
-                PrepTextureForCopy(cmd, &drawstate);
+                PrepTextureForCopy(cmd, drawstate);
 
                 // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
+                if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
                     SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
+                    vp.x = drawstate->viewport->x;
+                    vp.y = drawstate->viewport->y;
                     trianglepoint_2_fixedpoint(&vp);
                     for (i = 0; i < count; i++) {
                         ptr[i].dst.x += vp.x;
@@ -980,10 +1043,10 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
                 GeometryFillData *ptr = (GeometryFillData *)verts;
 
                 // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
+                if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
                     SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
+                    vp.x = drawstate->viewport->x;
+                    vp.y = drawstate->viewport->y;
                     trianglepoint_2_fixedpoint(&vp);
                     for (i = 0; i < count; i++) {
                         ptr[i].dst.x += vp.x;
@@ -1004,7 +1067,844 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
 
         cmd = cmd->next;
     }
+}
+
+/* Tiled rendering
+ *
+ * When SDL_HINT_RENDER_SOFTWARE_THREADS asks for more than one thread, draws
+ * are recorded as ops with the area they can touch, binned into squares of
+ * SW_TILE_SIZE pixels and the tiles are drawn in parallel. Each tile runs its
+ * ops in queue order, clipped to the tile, so the result is the same as
+ * drawing everything on one thread.
+ *
+ * Lines, scaled copies and rotated copies don't come out the same when they
+ * are clipped at a tile edge, so they're drawn on the calling thread between
+ * batches of tiles.
+ */
+static bool SW_UseTiles(SDL_Renderer *renderer, SDL_Surface *surface)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+
+    if (!data->tiles) {
+        return false;
+    }
 
+    // Worker threads draw through their own surfaces sharing the target pixels
+    if (!surface->pixels || SDL_MUSTLOCK(surface)) {
+        return false;
+    }
+
+    // Not worth waking the workers for a single tile
+    if (surface->w <= SW_TILE_SIZE && surface->h <= SW_TILE_SIZE) {
+        return false;
+    }
+    return true;
+}
+
+static bool SW_GrowArray(void **array, int *max, int needed, size_t size)
+{
+    if (needed > *max) {
+        int new_max = SDL_max(*max * 2, SDL_max(needed, 64));
+        void *new_array = SDL_realloc(*array, new_max * size);
+        if (!new_array) {
+            return false;
+        }
+        *array = new_array;
+        *max = new_max;
+    }
+    return true;
+}
+
+static void SW_ReleaseTileTexture(SW_TileRenderer *tiles, int index)
+{
+    int i;
+
+    for (i = 1; i < tiles->num_workers; ++i) {
+        SDL_DestroySurface(tiles->workers[i].views[index]);
+        tiles->workers[i].views[index] = NULL;
+    }
+    tiles->textures[index] = NULL;
+}
+
+/* Textures keep their slot, and the worker views of them, across batches
+ * until the texture is destroyed or the slot is needed for another texture.
+ * If the texture palette changes, the views are given the new palette before
+ * the next batch is drawn.
+ *
+ * While the views exist, the texture isn't RLE encoded, since the workers
+ * read its pixels directly. Its RLE setting is left alone, so it's encoded
+ * again once it's no longer used by tiled rendering.
+ */
+static int SW_AddTileTexture(SW_TileRenderer *tiles, SDL_Texture *texture)
+{
+    SDL_Surface *surface = (SDL_Surface *)texture->internal;
+    int i, empty_slot = -1, unused_slot = -1;
+
+    for (i = tiles->num_textures; i--;) {
+        if (tiles->textures[i] == surface) {
+            tiles->batch_textures |= (1u << i);
+            return i;
+        }
+        if (!tiles->textures[i]) {
+            empty_slot = i;
+        } else if (!(tiles->batch_textures & (1u << i))) {
+            unused_slot = i;
+        }
+    }
+
+    if (empty_slot >= 0) {
+        i = empty_slot;
+    } else if (tiles->num_textures < SW_TILE_MAX_TEXTURES) {
+        i = tiles->num_textures++;
+    } else if (unused_slot >= 0) {
+        // Replace a texture that isn't part of this batch
+        i = unused_slot;
+        SW_ReleaseTileTexture(tiles, i);
+    } else {
+        return -1;
+    }
+
+    tiles->textures[i] = surface;
+    tiles->batch_textures |= (1u << i);
+    return i;
+}
+
+static void SW_RemoveTileTexture(SW_TileRenderer *tiles, SDL_Surface *surface)
+{
+    int i;
+
+    for (i = 0; i < tiles->num_textures; ++i) {
+        if (tiles->textures[i] == surface) {
+            SW_ReleaseTileTexture(tiles, i);
+            break;
+        }
+    }
+}
+
+static void SW_GetTilePointBounds(const SDL_Point *points, int count, SDL_Rect *bounds)
+{
+    int minx = points[0].x, maxx = points[0].x;
+    int miny = points[0].y, maxy = points[0].y;
+    int i;
+
+    for (i = 1; i < count; ++i) {
+        minx = SDL_min(minx, points[i].x);
+        maxx = SDL_max(maxx, points[i].x);
+        miny = SDL_min(miny, points[i].y);
+        maxy = SDL_max(maxy, points[i].y);
+    }
+    bounds->x = minx;
+    bounds->y = miny;
+    bounds->w = maxx - minx + 1;
+    bounds->h = maxy - miny + 1;
+}
+
+static void SW_GetTileRectBounds(const SDL_Rect *rects, int count, SDL_Rect *bounds)
+{
+    int minx = rects[0].x, maxx = rects[0].x + rects[0].w;
+    int miny = rects[0].y, maxy = rects[0].y + rects[0].h;
+    int i;
+
+    for (i = 1; i < count; ++i) {
+        minx = SDL_min(minx, rects[i].x);
+        maxx = SDL_max(maxx, rects[i].x + rects[i].w);
+        miny = SDL_min(miny, rects[i].y);
+        maxy = SDL_max(maxy, rects[i].y + rects[i].h);
+    }
+    bounds->x = minx;
+    bounds->y = miny;
+    bounds->w = maxx - minx;
+    bounds->h = maxy - miny;
+}
+
+// Get the pixels that triangles with fixed point vertices can touch
+static void SW_GetTileTriangleBounds(const Uint8 *vertices, size_t stride, int count, SDL_Rect *bounds)
+{
+    const SDL_Point *point = (const SDL_Point *)vertices;
+    int minx = point->x, maxx = point->x;
+    int miny = point->y, maxy = point->y;
+    int i;
+
+    for (i = 1; i < count; ++i) {
+        point = (const SDL_Point *)(vertices + i * stride);
+        minx = SDL_min(minx, point->x);
+        maxx = SDL_max(maxx, point->x);
+        miny = SDL_min(miny, point->y);
+        maxy = SDL_max(maxy, point->y);
+    }
+    bounds->x = minx >> FP_BITS;
+    bounds->y = miny >> FP_BITS;
+    bounds->w = (maxx >> FP_BITS) - bounds->x + 1;
+    bounds->h = (maxy >> FP_BITS) - bounds->y + 1;
+}
+
+// Record the ops for a draw command, returns false if it has to be drawn on the calling thread
+static bool SW_AddTileOps(SW_TileRenderer *tiles, SDL_Surface *surface, SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate)
+{
+    const SDL_Rect *viewport = drawstate->viewport;
+    Uint8 *verts = NULL;
+    int count = 0;
+    SDL_Texture *texture = NULL;
+    int texture_index = -1;
+    int elements_per_op = SW_TILE_OP_ELEMENTS;
+    size_t stride = 0;
+    SDL_Rect bounds, clip;
+    SDL_Color color = drawstate->color;
+    int i, num_ops;
+
+    if (cmd->command != SDL_RENDERCMD_CLEAR) {
+        verts = (Uint8 *)tiles->vertices + cmd->data.draw.first;
+        count = (int)cmd->data.draw.count;
+    }
+
+    // Check whether the command can be tiled before touching its vertices
+    switch (cmd->command) {
+    case SDL_RENDERCMD_CLEAR:
+        color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+        count = 1;
+        break;
+
+    case SDL_RENDERCMD_DRAW_POINTS:
+        stride = sizeof(SDL_Point);
+        break;
+
+    case SDL_RENDERCMD_FILL_RECTS:
+        stride = sizeof(SDL_Rect);
+        break;
+
+    case SDL_RENDERCMD_COPY:
+    {
+        const SDL_Rect *rects = (const SDL_Rect *)verts;
+        if (rects[0].w != rects[1].w || rects[0].h != rects[1].h) {
+            return false;
+        }
+        texture = cmd->data.draw.texture;
+        count = 1;
+        break;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+        texture = cmd->data.draw.texture;
+        stride = texture ? sizeof(GeometryCopyData) : sizeof(GeometryFillData);
+        elements_per_op *= 3;
+        break;
+
+    default:
+        return false;
+    }
+
+    if (count <= 0) {
+        return true;
+    }
+
+    if (texture) {
+        texture_index = SW_AddTileTexture(tiles, texture);
+        if (texture_index < 0) {
+            return false;
+        }
+    }
+
+    num_ops = (count + elements_per_op - 1) / elements_per_op;
+    if (!SW_GrowArray((void **)&tiles->ops, &tiles->max_ops, tiles->num_ops + num_ops, sizeof(*tiles->ops))) {
+        return false;
+    }
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = surface->w;
+    bounds.h = surface->h;
+    if (cmd->command == SDL_RENDERCMD_CLEAR) {
+        // By definition the clear ignores the clip rect
+        clip = bounds;
+    } else {
+        GetDrawClipRect(drawstate, &clip);
+        if (!SDL_GetRectIntersection(&clip, &bounds, &clip)) {
+            return true;
+        }
+
+        // Apply viewport, this is done once here so the workers don't modify the vertices
+        if (viewport && (viewport->x || viewport->y)) {
+            if (cmd->command == SDL_RENDERCMD_GEOMETRY) {
+                SDL_Point vp;
+                vp.x = viewport->x;
+                vp.y = viewport->y;
+                trianglepoint_2_fixedpoint(&vp);
+                for (i = 0; i < count; i++) {
+                    SDL_Point *dst = texture ? &((GeometryCopyData *)verts)[i].dst : &((GeometryFillData *)verts)[i].dst;
+                    dst->x += vp.x;
+                    dst->y += vp.y;
+                }
+            } else if (cmd->command == SDL_RENDERCMD_COPY) {
+                SDL_Rect *dstrect = (SDL_Rect *)verts + 1;
+                dstrect->x += viewport->x;
+                dstrect->y += viewport->y;
+            } else if (cmd->command == SDL_RENDERCMD_DRAW_POINTS) {
+                SDL_Point *points = (SDL_Point *)verts;
+                for (i = 0; i < count; i++) {
+                    points[i].x += viewport->x;
+                    points[i].y += viewport->y;
+                }
+            } else {
+                SDL_Rect *rects = (SDL_Rect *)verts;
+                for (i = 0; i < count; i++) {
+                    rects[i].x += viewport->x;
+                    rects[i].y += viewport->y;
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < count; i += elements_per_op) {
+        SW_TileOp *op = &tiles->ops[tiles->num_ops];
+
+        op->cmd = cmd;
+        op->first = i;
+        op->count = SDL_min(count - i, elements_per_op);
+        op->clip = clip;
+        op->color = color;
+        op->pixel = SDL_MapSurfaceRGBA(surface, color.r, color.g, color.b, color.a);
+        op->texture = texture_index;
+
+        switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR:
+            bounds = clip;
+            break;
+        case SDL_RENDERCMD_DRAW_POINTS:
+            SW_GetTilePointBounds((const SDL_Point *)verts + i, op->count, &bounds);
+            break;
+        case SDL_RENDERCMD_FILL_RECTS:
+            SW_GetTileRectBounds((const SDL_Rect *)verts + i, op->count, &bounds);
+            break;
+        case SDL_RENDERCMD_COPY:
+            bounds = ((const SDL_Rect *)verts)[1];
+            break;
+        default:
+            // The destination point comes first in both kinds of geometry vertex
+            if (texture) {
+                SW_GetTileTriangleBounds((const Uint8 *)&((const GeometryCopyData *)verts)[i].dst, stride, op->count, &bounds);
+            } else {
+                SW_GetTileTriangleBounds((const Uint8 *)&((const GeometryFillData *)verts)[i].dst, stride, op->count, &bounds);
+            }
+            break;
+        }
+
+        // Drop anything that can't touch the target
+        if (SDL_GetRectIntersection(&bounds, &clip, &op->bounds)) {
+            ++tiles->num_ops;
+        }
+    }
+    return true;
+}
+
+static void SW_RunTileOp(SW_TileRenderer *tiles, SW_TileWorker *worker, const SW_TileOp *op, const SDL_Rect *tile)
+{
+    const SDL_RenderCommand *cmd = op->cmd;
+    SDL_BlendMode blend = SDL_BLENDMODE_NONE;
+    Uint8 *verts = NULL;
+    SDL_Surface *target = worker->target;
+    SDL_Rect clip;
+    int i;
+
+    if (!SDL_GetRectIntersection(&op->clip, tile, &clip)) {
+        return;
+    }
+    SDL_SetSurfaceClipRect(target, &clip);
+
+    if (cmd->command != SDL_RENDERCMD_CLEAR) {
+        blend = cmd->data.draw.blend;
+        verts = (Uint8 *)tiles->vertices + cmd->data.draw.first;
+    }
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_CLEAR:
+        SDL_FillSurfaceRect(target, &clip, op->pixel);
+        break;
+
+    case SDL_RENDERCMD_DRAW_POINTS:
+    {
+        const SDL_Point *points = (const SDL_Point *)verts + op->first;
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawPoints(target, points, op->count, op->pixel);
+        } else {
+            SDL_BlendPoints(target, points, op->count, blend, op->color.r, op->color.g, op->color.b, op->color.a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        const SDL_Rect *rects = (const SDL_Rect *)verts + op->first;
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_FillSurfaceRects(target, rects, op->count, op->pixel);
+        } else {
+            SDL_BlendFillRects(target, rects, op->count, blend, op->color.r, op->color.g, op->color.b, op->color.a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY:
+    {
+        const SDL_Rect *rects = (const SDL_Rect *)verts;
+        SDL_Surface *src = worker->textures[op->texture];
+
+        PrepSurfaceForCopy(src, blend, op->color);
+        SDL_BlitSurface(src, &rects[0], target, &rects[1]);
+        break;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+        if (cmd->data.draw.texture) {
+            GeometryCopyData *ptr = (GeometryCopyData *)verts + op->first;
+            SDL_Surface *src = worker->textures[op->texture];
+
+            PrepSurfaceForCopy(src, blend, op->color);
+
+            for (i = 0; i < op->count; i += 3, ptr += 3) {
+                SDL_Rect bounds;
+                SW_GetTileTriangleBounds((const Uint8 *)&ptr->dst, sizeof(*ptr), 3, &bounds);
+                if (!SDL_HasRectIntersection(&bounds, &clip)) {
+                    continue;
+                }
+                SDL_SW_BlitTriangle(
+                    src,
+                    &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
+                    target,
+                    &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
+                    ptr[0].color, ptr[1].color, ptr[2].color,
+                    cmd->data.draw.texture_address_mode_u,
+                    cmd->data.draw.texture_address_mode_v);
+            }
+        } else {
+            GeometryFillData *ptr = (GeometryFillData *)verts + op->first;
+
+            for (i = 0; i < op->count; i += 3, ptr += 3) {
+                SDL_Rect bounds;
+                SW_GetTileTriangleBounds((const Uint8 *)&ptr->dst, sizeof(*ptr), 3, &bounds);
+                if (!SDL_HasRectIntersection(&bounds, &clip)) {
+                    continue;
+                }
+                SDL_SW_FillTriangle(target, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void SW_RunTileWork(SW_TileRenderer *tiles, SW_TileWorker *worker)
+{
+    const int num_tiles = tiles->tiles_x * tiles->tiles_y;
+    const int w = worker->target->w;
+    const int h = worker->target->h;
+
+    for (;;) {
+        const int tile = SDL_AddAtomicInt(&tiles->next_tile, 1);
+        SDL_Rect rect;
+        int i;
+
+        if (tile >= num_tiles) {
+            break;
+        }
+
+        rect.x = (tile % tiles->tiles_x) * SW_TILE_SIZE;
+        rect.y = (tile / tiles->tiles_x) * SW_TILE_SIZE;
+        rect.w = SDL_min(SW_TILE_SIZE, w - rect.x);
+        rect.h = SDL_min(SW_TILE_SIZE, h - rect.y);
+        for (i = tiles->tile_start[tile]; i < tiles->tile_start[tile + 1]; ++i) {
+            SW_RunTileOp(tiles, worker, &tiles->ops[tiles->tile_ops[i]], &rect);
+        }
+    }
+}
+
+static int SDLCALL SW_TileThread(void *data)
+{
+    SW_TileWorker *worker = (SW_TileWorker *)data;
+    SW_TileRenderer *tiles = worker->tiles;
+
+    for (;;) {
+        SDL_WaitSemaphore(tiles->work_ready);
+        if (tiles->quit) {
+            break;
+        }
+        SW_RunTileWork(tiles, worker);
+        SDL_SignalSemaphore(tiles->work_done);
+    }
+    return 0;
+}
+
+static void SW_DestroyTileWorkerTargets(SW_TileRenderer *tiles)
+{
+    int i;
+
+    for (i = 1; i < tiles->num_workers; ++i) {
+        SDL_DestroySurface(tiles->workers[i].target);
+        tiles->workers[i].target = NULL;
+    }
+    tiles->target = NULL;
+}
+
+// The worker surfaces are kept between batches and only rebuilt when the target or a texture changes
+static bool SW_UpdateTileWorkerSurfaces(SW_TileRenderer *tiles, SDL_Surface *surface)
+{
+    int i, j;
+
+    if (surface != tiles->target ||
+        surface->pixels != tiles->target_pixels ||
+        surface->w != tiles->target_w ||
+        surface->h != tiles->target_h ||
+        surface->pitch != tiles->target_pitch ||
+        surface->format != tiles->target_format ||
+        surface->palette != tiles->target_palette) {
+        SW_DestroyTileWorkerTargets(tiles);
+
+        for (i = 1; i < tiles->num_workers; ++i) {
+            SW_TileWorker *worker = &tiles->workers[i];
+
+            /* This isn't a view of the target, since views record their damage in
+             * the parent surface, and that isn't safe from several threads. The
+             * whole target has already been damaged for this command queue.
+             */
+            worker->target = SDL_CreateSurfaceFrom(surface->w, surface->h, surface->format, surface->pixels, surface->pitch);
+            if (!worker->target) {
+                SW_DestroyTileWorkerTargets(tiles);
+                return false;
+            }
+            if (surface->palette) {
+                SDL_SetSurfacePalette(worker->target, surface->palette);
+            }
+        }
+        tiles->target = surface;
+        tiles->target_pixels = surface->pixels;
+        tiles->target_w = surface->w;
+        tiles->target_h = surface->h;
+        tiles->target_pitch = surface->pitch;
+        tiles->target_format = surface->format;
+        tiles->target_palette = surface->palette;
+    }
+
+    for (i = 1; i < tiles->num_workers; ++i) {
+        SW_TileWorker *worker = &tiles->workers[i];
+
+        SDL_SetSurfaceColorspace(worker->target, surface->colorspace);
+
+        for (j = 0; j < tiles->num_textures; ++j) {
+            if (!(tiles->batch_textures & (1u << j))) {
+                continue;
+            }
+            if (!worker->views[j]) {
+                worker->views[j] = SDL_CreateSurfaceView(tiles->textures[j], NULL);
+                if (!worker->views[j]) {
+                    return false;
+                }
+            } else if (worker->views[j]->palette != tiles->textures[j]->palette) {
+                // The texture palette was changed since the view was created
+                if (!SDL_SetSurfacePalette(worker->views[j], tiles->textures[j]->palette)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Draw the recorded ops and start a new batch
+static void SW_RunTiles(SW_TileRenderer *tiles, SDL_Surface *surface)
+{
+    const int num_tiles = tiles->tiles_x * tiles->tiles_y;
+    int *tile_start = tiles->tile_start;
+    int i, x, y, num_tile_ops = 0;
+    int num_threads = 0;
+
+    if (tiles->num_ops == 0) {
+        return;
+    }
+
+    // Worker 0 is the calling thread, which draws to the real surfaces
+    tiles->workers[0].target = surface;
+    tiles->workers[0].textures = tiles->textures;
+
+    // Count the ops touching each tile...
+    SDL_memset(tile_start, 0, (num_tiles + 1) * sizeof(*tile_start));
+    for (i = 0; i < tiles->num_ops; ++i) {
+        const SDL_Rect *bounds = &tiles->ops[i].bounds;
+        const int x0 = bounds->x / SW_TILE_SIZE, x1 = (bounds->x + bounds->w - 1) / SW_TILE_SIZE;
+        const int y0 = bounds->y / SW_TILE_SIZE, y1 = (bounds->y + bounds->h - 1) / SW_TILE_SIZE;
+        for (y = y0; y <= y1; ++y) {
+            for (x = x0; x <= x1; ++x) {
+                ++tile_start[y * tiles->tiles_x + x + 1];
+            }
+        }
+        num_tile_ops += (x1 - x0 + 1) * (y1 - y0 + 1);
+    }
+    for (i = 0; i < num_tiles; ++i) {
+        tile_start[i + 1] += tile_start[i];
+    }
+
+    if (SW_GrowArray((void **)&tiles->tile_ops, &tiles->max_tile_ops, num_tile_ops, sizeof(*tiles->tile_ops))) {
+        // ... then list them in queue order, leaving tile_start[i] at the end of tile i
+        for (i = 0; i < tiles->num_ops; ++i) {
+            const SDL_Rect *bounds = &tiles->ops[i].bounds;
+            const int x0 = bounds->x / SW_TILE_SIZE, x1 = (bounds->x + bounds->w - 1) / SW_TILE_SIZE;
+            const int y0 = bounds->y / SW_TILE_SIZE, y1 = (bounds->y + bounds->h - 1) / SW_TILE_SIZE;
+            for (y = y0; y <= y1; ++y) {
+                for (x = x0; x <= x1; ++x) {
+                    tiles->tile_ops[tile_start[y * tiles->tiles_x + x]++] = i;
+                }
+            }
+        }
+        SDL_memmove(tile_start + 1, tile_start, num_tiles * sizeof(*tile_start));
+        tile_start[0] = 0;
+
+        // If the worker surfaces can't be created, the calling thread draws every tile
+        if (SW_UpdateTileWorkerSurfaces(tiles, surface)) {
+            num_threads = tiles->num_workers - 1;
+        }
+
+        SDL_SetAtomicInt(&tiles->next_tile, 0);
+        for (i = 0; i < num_threads; ++i) {
+            SDL_SignalSemaphore(tiles->work_ready);
+        }
+        SW_RunTileWork(tiles, &tiles->workers[0]);
+        for (i = 0; i < num_threads; ++i) {
+            SDL_WaitSemaphore(tiles->work_done);
+        }
+    } else {
+        // Out of memory, draw the whole target as one tile
+        SDL_Rect rect;
+        rect.x = 0;
+        rect.y = 0;
+        rect.w = surface->w;
+        rect.h = surface->h;
+        for (i = 0; i < tiles->num_ops; ++i) {
+            SW_RunTileOp(tiles, &tiles->workers[0], &tiles->ops[i], &rect);
+        }
+    }
+
+    tiles->num_ops = 0;
+    tiles->batch_textures = 0;
+}
+
+static bool SW_RunCommandQueueTiled(SDL_Renderer *renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices, SW_DrawStateCache *drawstate)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    SW_TileRenderer *tiles = data->tiles;
+    const int num_tiles = ((surface->w + SW_TILE_SIZE - 1) / SW_TILE_SIZE) * ((surface->h + SW_TILE_SIZE - 1) / SW_TILE_SIZE);
+
+    if (!SW_GrowArray((void **)&tiles->tile_start, &tiles->max_tiles, num_tiles + 1, sizeof(*tiles->tile_start))) {
+        SW_RunCommands(renderer, surface, cmd, NULL, vertices, drawstate);
+        return true;
+    }
+
+    tiles->vertices = vertices;
+    tiles->tiles_x = (surface->w + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+    tiles->tiles_y = (surface->h + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+
+    while (cmd) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+        case SDL_RENDERCMD_SETVIEWPORT:
+        case SDL_RENDERCMD_SETCLIPRECT:
+        case SDL_RENDERCMD_NO_OP:
+            // These only update the draw state
+            SW_RunCommands(renderer, surface, cmd, cmd->next, vertices, drawstate);
+            break;
+
+        default:
+            if (!SW_AddTileOps(tiles, surface, cmd, drawstate)) {
+                // Draw everything before this command, then the command itself
+                SW_RunTiles(tiles, surface);
+                drawstate->surface_cliprect_dirty = true;
+                SW_RunCommands(renderer, surface, cmd, cmd->next, vertices, drawstate);
+            }
+            break;
+        }
+        cmd = cmd->next;
+    }
+    SW_RunTiles(tiles, surface);
+
+    return true;
+}
+
+static void SW_DestroyTileRenderer(SW_TileRenderer *tiles)
+{
+    int i;
+
+    if (!tiles) {
+        return;
+    }
+
+    tiles->quit = true;
+    for (i = 1; i < tiles->num_workers; ++i) {
+        SDL_SignalSemaphore(tiles->work_ready);
+    }
+    for (i = 1; i < tiles->num_workers; ++i) {
+        SDL_WaitThread(tiles->workers[i].thread, NULL);
+    }
+    if (tiles->workers) {
+        for (i = 0; i < tiles->num_textures; ++i) {
+            SW_ReleaseTileTexture(tiles, i);
+        }
+        SW_DestroyTileWorkerTargets(tiles);
+    }
+    SDL_DestroySemaphore(tiles->work_ready);
+    SDL_DestroySemaphore(tiles->work_done);
+    SDL_free(tiles->workers);
+    SDL_free(tiles->ops);
+    SDL_free(tiles->tile_start);
+    SDL_free(tiles->tile_ops);
+    SDL_free(tiles);
+}
+
+static SW_TileRenderer *SW_CreateTileRenderer(int num_threads)
+{
+    SW_TileRenderer *tiles;
+
+    tiles = (SW_TileRenderer *)SDL_calloc(1, sizeof(*tiles));
+    if (!tiles) {
+        return NULL;
+    }
+
+    tiles->workers = (SW_TileWorker *)SDL_calloc(num_threads, sizeof(*tiles->workers));
+    tiles->work_ready = SDL_CreateSemaphore(0);
+    tiles->work_done = SDL_CreateSemaphore(0);
+    if (!tiles->workers || !tiles->work_ready || !tiles->work_done) {
+        SW_DestroyTileRenderer(tiles);
+        return NULL;
+    }
+
+    tiles->workers[0].tiles = tiles;
+    for (tiles->num_workers = 1; tiles->num_workers < num_threads; ++tiles->num_workers) {
+        SW_TileWorker *worker = &tiles->workers[tiles->num_workers];
+
+        worker->tiles = tiles;
+        worker->textures = worker->views;
+        worker->thread = SDL_CreateThread(SW_TileThread, "SDLRenderTiles", worker);
+        if (!worker->thread) {
+            SW_DestroyTileRenderer(tiles);
+            return NULL;
+        }
+    }
+    return tiles;
+}
+
+// Add the area a draw command can touch to the damage of the target, before the viewport is applied to its vertices
+static void SW_AddCommandDamage(SDL_Surface *surface, const SDL_RenderCommand *cmd, const void *vertices, SW_DrawStateCache *drawstate)
+{
+    const Uint8 *verts = (const Uint8 *)vertices + cmd->data.draw.first;
+    const int count = (int)cmd->data.draw.count;
+    SDL_Rect bounds, clip;
+
+    if (count <= 0) {
+        return;
+    }
+
+    if (!drawstate->viewport) {
+        SDL_AddSurfaceDamage(surface, NULL);
+        return;
+    }
+    GetDrawClipRect(drawstate, &clip);
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_POINTS:
+    case SDL_RENDERCMD_DRAW_LINES:
+        SW_GetTilePointBounds((const SDL_Point *)verts, count, &bounds);
+        break;
+    case SDL_RENDERCMD_FILL_RECTS:
+        SW_GetTileRectBounds((const SDL_Rect *)verts, count, &bounds);
+        break;
+    case SDL_RENDERCMD_COPY:
+        bounds = ((const SDL_Rect *)verts)[1];
+        break;
+    case SDL_RENDERCMD_GEOMETRY:
+        // The destination point comes first in both kinds of geometry vertex
+        if (cmd->data.draw.texture) {
+            SW_GetTileTriangleBounds(verts, sizeof(GeometryCopyData), count, &bounds);
+        } else {
+            SW_GetTileTriangleBounds(verts, sizeof(GeometryFillData), count, &bounds);
+        }
+        break;
+    default:
+        // Rotated copies can touch anything within the clip rect
+        SDL_AddSurfaceDamage(surface, &clip);
+        return;
+    }
+
+    bounds.x += drawstate->viewport->x;
+    bounds.y += drawstate->viewport->y;
+    if (SDL_GetRectIntersection(&bounds, &clip, &bounds)) {
+        SDL_AddSurfaceDamage(surface, &bounds);
+    }
+}
+
+// Record the areas of the target that the queued commands draw to
+static void SW_AddDamage(SDL_Surface *surface, const SDL_RenderCommand *cmd, const void *vertices)
+{
+    SW_DrawStateCache drawstate;
+
+    SDL_zero(drawstate);
+
+    for (; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETVIEWPORT:
+            drawstate.viewport = &cmd->data.viewport.rect;
+            break;
+        case SDL_RENDERCMD_SETCLIPRECT:
+            drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+            break;
+        case SDL_RENDERCMD_CLEAR:
+            SDL_AddSurfaceDamage(surface, NULL);
+            break;
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+            SW_AddCommandDamage(surface, cmd, vertices, &drawstate);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_DrawStateCache drawstate;
+
+    if (!SDL_SurfaceValid(surface)) {
+        return false;
+    }
+
+    // The target may be a duplicated surface sharing its pixels
+    if (!SDL_MakeSurfaceWritable(surface)) {
+        return false;
+    }
+
+    // Primitives are drawn directly to the pixels, so record the areas they touch
+    if (surface->damage || surface->view_parent) {
+        SW_AddDamage(surface, cmd, vertices);
+    }
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.surface_cliprect_dirty = true;
+    drawstate.color.r = 0;
+    drawstate.color.g = 0;
+    drawstate.color.b = 0;
+    drawstate.color.a = 0;
+
+    if (SW_UseTiles(renderer, surface)) {
+        return SW_RunCommandQueueTiled(renderer, surface, cmd, vertices, &drawstate);
+    }
+
+    SW_RunCommands(renderer, surface, cmd, NULL, vertices, &drawstate);
     return true;
 }
 
@@ -1046,8 +1946,12 @@ static bool SW_RenderPresent(SDL_Renderer *renderer)
 
 static void SW_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
     SDL_Surface *surface = (SDL_Surface *)texture->internal;
 
+    if (data->tiles) {
+        SW_RemoveTileTexture(data->tiles, surface);
+    }
     SDL_DestroySurface(surface);
 }
 
@@ -1059,6 +1963,7 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
+    SW_DestroyTileRenderer(data->tiles);
     SDL_free(data);
 }
 
@@ -1163,6 +2068,7 @@ static void SW_SelectBestFormats(SDL_Renderer *renderer, SDL_PixelFormat format)
 bool SW_CreateRendererForSurface(SDL_Renderer *renderer, SDL_Surface *surface, SDL_PropertiesID create_props)
 {
     SW_RenderData *data;
+    const char *hint;
 
     CHECK_PARAM(!SDL_SurfaceValid(surface)) {
         return SDL_InvalidParamError("surface");
@@ -1220,6 +2126,18 @@ bool SW_CreateRendererForSurface(SDL_Renderer *renderer, SDL_Surface *surface, S
         return SDL_SetError("Unsupported output colorspace");
     }
 
+    hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    if (hint && *hint) {
+        int num_threads = SDL_atoi(hint);
+        if (num_threads <= 0) {
+            num_threads = SDL_GetNumLogicalCPUCores();
+        }
+        if (num_threads > 1) {
+            // If the threads can't be created, everything is drawn on the calling thread
+            data->tiles = SW_CreateTileRenderer(num_threads);
+        }
+    }
+
     return true;
 }
 
@@ -1248,6 +2166,10 @@ static bool SW_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pr
         return false;
     }
 
+    if (SDL_GetHintBoolean(SDL_HINT_RENDER_SOFTWARE_DAMAGE_TRACKING, false)) {
+        SDL_SetWindowSurfaceDamageTracking(window, true);
+    }
+
     return SW_CreateRendererForSurface(renderer, surface, create_props);
 }
 
@@ -28,14 +28,6 @@
 
 #include "../../video/SDL_surface_c.h"
 
-/* fixed points bits precision
- * Set to 1, so that it can start rendering with middle of a pixel precision.
- * It doesn't need to be increased.
- * But, if increased too much, it overflows (srcx, srcy) coordinates used for filling with texture.
- * (which could be turned to int64).
- */
-#define FP_BITS 1
-
 #define COLOR_EQ(c1, c2) ((c1).r == (c2).r && (c1).g == (c2).g && (c1).b == (c2).b && (c1).a == (c2).a)
 
 static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
@@ -226,6 +218,423 @@ static void bounding_rect_fixedpoint(const SDL_Point *a, const SDL_Point *b, con
     }                     \
     }
 
+/* Half-space rasterizer for ARGB8888 and XRGB8888 targets
+ *
+ * The bounding rect is walked in TRIANGLE_BLOCK_SIZE square blocks. The edge
+ * functions are linear, so their values at the corners of a block tell
+ * whether the block is entirely outside the triangle, entirely inside it, or
+ * needs the coverage test per pixel. Pixels are then shaded four at a time.
+ *
+ * Colors and texture coordinates use the same integer formulas as the scalar
+ * loops. The numerators are exact in doubles and the quotients are small, so
+ * the truncated results are identical.
+ */
+typedef enum
+{
+    TRIANGLE_SHADE_COLOR,   // a single mapped color
+    TRIANGLE_SHADE_GOURAUD, // interpolated vertex colors
+    TRIANGLE_SHADE_COPY,    // texels copied unchanged
+    TRIANGLE_SHADE_TEXTURE  // texels converted, modulated and blended
+} TriangleShadeMode;
+
+typedef struct
+{
+    // The clipped bounding rect and the destination pixel at its top left
+    SDL_Rect dstrect;
+    SDL_PixelFormat dst_format;
+    Uint8 *dst;
+    int dst_pitch;
+
+    // Edge functions at the top left pixel and their steps per pixel
+    Sint64 w_row[3];
+    int w_dx[3];
+    int w_dy[3];
+    int bias[3];
+    Sint64 area;
+
+    TriangleShadeMode mode;
+    Uint32 color; // the mapped color, or the modulation color as ARGB8888
+    SDL_Color c0, c1, c2;
+    bool is_uniform;
+
+    // Texturing
+    SDL_Surface *src;
+    int flags; // SDL_COPY_* flags, as passed to SDL_BlitTriangle_Slow()
+    int s2s0_x, s2s1_x, s2s0_y, s2s1_y;
+    SDL_Point s2_x_area;
+    SDL_TextureAddressMode texture_address_mode_u;
+    SDL_TextureAddressMode texture_address_mode_v;
+
+    // Filled in by SDL_RasterizeTriangle()
+    bool dst_alpha; // ARGB8888 rather than XRGB8888
+    bool src_alpha;
+    bool src_bgr;   // ABGR8888 or XBGR8888
+    int blend;      // SDL_COPY_BLEND, SDL_COPY_ADD, SDL_COPY_MOD or 0
+} TriangleRaster;
+
+#define TRIANGLE_BLOCK_SIZE 8
+
+static bool IsTriangleRasterFormat(SDL_PixelFormat format)
+{
+    return format == SDL_PIXELFORMAT_ARGB8888 || format == SDL_PIXELFORMAT_XRGB8888;
+}
+
+static bool IsTriangleTextureFormat(SDL_PixelFormat format)
+{
+    return IsTriangleRasterFormat(format) || format == SDL_PIXELFORMAT_ABGR8888 || format == SDL_PIXELFORMAT_XBGR8888;
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+
+static int TriangleTextureCoord(int coord, int size, SDL_TextureAddressMode mode)
+{
+    if (mode == SDL_TEXTURE_ADDRESS_CLAMP) {
+        if (coord < 0) {
+            coord = 0;
+        } else if (coord >= size) {
+            coord = size - 1;
+        }
+    } else if (mode == SDL_TEXTURE_ADDRESS_WRAP) {
+        coord %= size;
+        if (coord < 0) {
+            coord += (size - 1);
+        }
+    }
+    return coord;
+}
+
+
+// x / 255 for 0 <= x <= 65535, truncated
+#define TRIANGLE_DIV255_SSE2(x) _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16((short)0x8081)), 7)
+
+// (w0 * k0 + w1 * k1 + w2 * k2 + k3) / area, truncated towards zero
+static __m128i SDL_TARGETING("sse2") TriangleInterpolateSSE2(const __m128i w[3], double k0, double k1, double k2, double k3, __m128d area)
+{
+    __m128d n, lo, hi;
+
+    n = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(w[0]), _mm_set1_pd(k0)), _mm_mul_pd(_mm_cvtepi32_pd(w[1]), _mm_set1_pd(k1)));
+    n = _mm_add_pd(n, _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(w[2]), _mm_set1_pd(k2)), _mm_set1_pd(k3)));
+    lo = _mm_div_pd(n, area);
+
+    n = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(w[0], w[0])), _mm_set1_pd(k0)),
+                   _mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(w[1], w[1])), _mm_set1_pd(k1)));
+    n = _mm_add_pd(n, _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(w[2], w[2])), _mm_set1_pd(k2)), _mm_set1_pd(k3)));
+    hi = _mm_div_pd(n, area);
+
+    return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+}
+
+// Interpolate the vertex colors as ARGB8888 pixels
+static __m128i SDL_TARGETING("sse2") TriangleGouraudSSE2(const TriangleRaster *raster, const __m128i w[3], __m128d area)
+{
+    const SDL_Color c0 = raster->c0, c1 = raster->c1, c2 = raster->c2;
+    __m128i r = TriangleInterpolateSSE2(w, c0.r, c1.r, c2.r, 0.0, area);
+    __m128i g = TriangleInterpolateSSE2(w, c0.g, c1.g, c2.g, 0.0, area);
+    __m128i b = TriangleInterpolateSSE2(w, c0.b, c1.b, c2.b, 0.0, area);
+    __m128i a = TriangleInterpolateSSE2(w, c0.a, c1.a, c2.a, 0.0, area);
+
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(a, 24), _mm_slli_epi32(r, 16)), _mm_or_si128(_mm_slli_epi32(g, 8), b));
+}
+
+// Modulate and blend two pixels unpacked to 16 bits per channel, the same way as SDL_BlitTriangle_Slow()
+static __m128i SDL_TARGETING("sse2") TriangleBlendSSE2(__m128i src, __m128i mod, __m128i dst, int blend)
+{
+    const __m128i alpha = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+    const __m128i full = _mm_set1_epi16(255);
+    __m128i src_alpha, result;
+
+    src = TRIANGLE_DIV255_SSE2(_mm_mullo_epi16(src, mod));
+    src_alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+    switch (blend) {
+    case SDL_COPY_BLEND:
+    case SDL_COPY_ADD:
+        // Premultiply the color, an alpha of 255 leaves it unchanged
+        src = TRIANGLE_DIV255_SSE2(_mm_mullo_epi16(src, _mm_or_si128(_mm_andnot_si128(alpha, src_alpha), _mm_and_si128(alpha, full))));
+        if (blend == SDL_COPY_BLEND) {
+            return _mm_add_epi16(src, TRIANGLE_DIV255_SSE2(_mm_mullo_epi16(_mm_sub_epi16(full, src_alpha), dst)));
+        }
+        result = _mm_min_epi16(_mm_add_epi16(src, dst), full);
+        break;
+    case SDL_COPY_MOD:
+        result = TRIANGLE_DIV255_SSE2(_mm_mullo_epi16(src, dst));
+        break;
+    default:
+        return src;
+    }
+
+    // Additive and modulated blending keep the destination alpha
+    return _mm_or_si128(_mm_andnot_si128(alpha, result), _mm_and_si128(alpha, dst));
+}
+
+static __m128i SDL_TARGETING("sse2") TriangleTextureSSE2(const TriangleRaster *raster, const __m128i w[3], __m128d area, int active, __m128i dst)
+{
+    const SDL_Surface *src = raster->src;
+    const __m128i zero = _mm_setzero_si128();
+    int srcx[4], srcy[4];
+    Uint32 texels[4] = { 0, 0, 0, 0 };
+    __m128i pixels, mod;
+    int i;
+
+    _mm_storeu_si128((__m128i *)srcx, TriangleInterpolateSSE2(w, raster->s2s0_x, raster->s2s1_x, 0.0, raster->s2_x_area.x, area));
+    _mm_storeu_si128((__m128i *)srcy, TriangleInterpolateSSE2(w, raster->s2s0_y, raster->s2s1_y, 0.0, raster->s2_x_area.y, area));
+
+    // Texture coordinates outside the triangle may be outside the texture
+    for (i = 0; i < 4; ++i) {
+        if (active & (1 << i)) {
+            const int x = TriangleTextureCoord(srcx[i], src->w, raster->texture_address_mode_u);
+            const int y = TriangleTextureCoord(srcy[i], src->h, raster->texture_address_mode_v);
+            texels[i] = ((const Uint32 *)((const Uint8 *)src->pixels + y * src->pitch))[x];
+        }
+    }
+    pixels = _mm_loadu_si128((const __m128i *)texels);
+
+    if (raster->mode == TRIANGLE_SHADE_COPY) {
+        return pixels;
+    }
+
+    if (raster->src_bgr) {
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        pixels = _mm_or_si128(_mm_and_si128(pixels, _mm_set1_epi32((int)0xFF00FF00)),
+                              _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 16), mask), _mm_slli_epi32(_mm_and_si128(pixels, mask), 16)));
+    }
+    if (!raster->src_alpha) {
+        pixels = _mm_or_si128(pixels, _mm_set1_epi32((int)0xFF000000));
+    }
+    if (!raster->dst_alpha) {
+        dst = _mm_or_si128(dst, _mm_set1_epi32((int)0xFF000000));
+    }
+
+    if (raster->is_uniform) {
+        mod = _mm_set1_epi32((int)raster->color);
+    } else {
+        mod = TriangleGouraudSSE2(raster, w, area);
+    }
+    if (!(raster->flags & SDL_COPY_MODULATE_COLOR)) {
+        mod = _mm_or_si128(mod, _mm_set1_epi32(0x00FFFFFF));
+    }
+    if (!(raster->flags & SDL_COPY_MODULATE_ALPHA)) {
+        mod = _mm_or_si128(mod, _mm_set1_epi32((int)0xFF000000));
+    }
+
+    return _mm_packus_epi16(
+        TriangleBlendSSE2(_mm_unpacklo_epi8(pixels, zero), _mm_unpacklo_epi8(mod, zero), _mm_unpacklo_epi8(dst, zero), raster->blend),
+        TriangleBlendSSE2(_mm_unpackhi_epi8(pixels, zero), _mm_unpackhi_epi8(mod, zero), _mm_unpackhi_epi8(dst, zero), raster->blend));
+}
+
+// Shade up to four pixels starting at dptr, where mask selects the pixels inside the triangle
+static void SDL_TARGETING("sse2") TriangleShadeSSE2(const TriangleRaster *raster, const __m128i w[3], __m128d area, __m128i mask, Uint32 *dptr, int count)
+{
+    const int active = _mm_movemask_ps(_mm_castsi128_ps(mask));
+    Uint32 old_pixels[4] = { 0, 0, 0, 0 };
+    __m128i dst, pixels;
+    int i;
+
+    if (count >= 4) {
+        dst = _mm_loadu_si128((const __m128i *)dptr);
+    } else {
+        for (i = 0; i < count; ++i) {
+            old_pixels[i] = dptr[i];
+        }
+        dst = _mm_loadu_si128((const __m128i *)old_pixels);
+    }
+
+    switch (raster->mode) {
+    case TRIANGLE_SHADE_COLOR:
+        pixels = _mm_set1_epi32((int)raster->color);
+        break;
+    case TRIANGLE_SHADE_GOURAUD:
+        pixels = TriangleGouraudSSE2(raster, w, area);
+        break;
+    default:
+        pixels = TriangleTextureSSE2(raster, w, area, active, dst);
+        break;
+    }
+    if (!raster->dst_alpha && raster->mode != TRIANGLE_SHADE_COPY) {
+        pixels = _mm_and_si128(pixels, _mm_set1_epi32(0x00FFFFFF));
+    }
+    pixels = _mm_or_si128(_mm_and_si128(mask, pixels), _mm_andnot_si128(mask, dst));
+
+    if (count >= 4) {
+        _mm_storeu_si128((__m128i *)dptr, pixels);
+    } else {
+        _mm_storeu_si128((__m128i *)old_pixels, pixels);
+        for (i = 0; i < count; ++i) {
+            dptr[i] = old_pixels[i];
+        }
+    }
+}
+
+// Returns false if the edge functions don't fit in 32 bits, and the triangle should be drawn with the scalar loops
+static bool SDL_TARGETING("sse2") SDL_RasterizeTriangleSSE2(const TriangleRaster *raster)
+{
+    const int w = raster->dstrect.w;
+    const int h = raster->dstrect.h;
+    const __m128d area = _mm_set1_pd((double)raster->area);
+    const __m128i tail_masks[4] = {
+        _mm_setr_epi32(0, 0, 0, 0),
+        _mm_setr_epi32(-1, 0, 0, 0),
+        _mm_setr_epi32(-1, -1, 0, 0),
+        _mm_setr_epi32(-1, -1, -1, 0)
+    };
+    __m128i lane_steps[3], biases[3];
+    int bx, by, x, y, i;
+
+    if (w <= 0 || h <= 0) {
+        return true;
+    }
+
+    for (i = 0; i < 3; ++i) {
+        if (raster->w_dx[i] <= -(1 << 28) || raster->w_dx[i] >= (1 << 28)) {
+            return false;
+        }
+        const Sint64 right = (Sint64)(w - 1) * raster->w_dx[i];
+        const Sint64 bottom = (Sint64)(h - 1) * raster->w_dy[i];
+        const Sint64 limit = (Sint64)1 << 30;
+        const Sint64 corners[4] = { raster->w_row[i], raster->w_row[i] + right, raster->w_row[i] + bottom, raster->w_row[i] + right + bottom };
+        int j;
+
+        for (j = 0; j < 4; ++j) {
+            if (corners[j] <= -limit || corners[j] >= limit) {
+                return false;
+            }
+        }
+        lane_steps[i] = _mm_setr_epi32(0, raster->w_dx[i], 2 * raster->w_dx[i], 3 * raster->w_dx[i]);
+        biases[i] = _mm_set1_epi32(raster->bias[i] + 1);
+    }
+
+    for (by = 0; by < h; by += TRIANGLE_BLOCK_SIZE) {
+        const int bh = SDL_min(TRIANGLE_BLOCK_SIZE, h - by);
+
+        for (bx = 0; bx < w; bx += TRIANGLE_BLOCK_SIZE) {
+            const int bw = SDL_min(TRIANGLE_BLOCK_SIZE, w - bx);
+            bool inside = true;
+
+            // Classify the block by the edge functions at its corners
+            for (i = 0; i < 3; ++i) {
+                const Sint64 top_left = raster->w_row[i] + (Sint64)bx * raster->w_dx[i] + (Sint64)by * raster->w_dy[i];
+                const Sint64 right = (Sint64)(bw - 1) * raster->w_dx[i];
+                const Sint64 bottom = (Sint64)(bh - 1) * raster->w_dy[i];
+                const Sint64 lowest = top_left + SDL_min(right, 0) + SDL_min(bottom, 0) + raster->bias[i];
+                const Sint64 highest = top_left + SDL_max(right, 0) + SDL_max(bottom, 0) + raster->bias[i];
+
+                if (highest < 0) {
+                    break;
+                }
+                if (lowest < 0) {
+                    inside = false;
+                }
+            }
+            if (i < 3) {
+                continue;
+            }
+
+            for (y = by; y < by + bh; ++y) {
+                Uint32 *row = (Uint32 *)(raster->dst + y * raster->dst_pitch);
+                int w_start[3];
+
+                for (i = 0; i < 3; ++i) {
+                    w_start[i] = (int)(raster->w_row[i] + (Sint64)bx * raster->w_dx[i] + (Sint64)y * raster->w_dy[i]);
+                }
+
+                for (x = 0; x < bw; x += 4) {
+                    const int count = SDL_min(4, bw - x);
+                    __m128i edges[3], mask;
+
+                    for (i = 0; i < 3; ++i) {
+                        edges[i] = _mm_add_epi32(_mm_set1_epi32(w_start[i] + x * raster->w_dx[i]), lane_steps[i]);
+                    }
+
+                    if (inside) {
+                        mask = _mm_set1_epi32(-1);
+                    } else {
+                        // w + bias >= 0
+                        mask = _mm_and_si128(_mm_cmpgt_epi32(_mm_add_epi32(edges[0], biases[0]), _mm_setzero_si128()),
+                                             _mm_cmpgt_epi32(_mm_add_epi32(edges[1], biases[1]), _mm_setzero_si128()));
+                        mask = _mm_and_si128(mask, _mm_cmpgt_epi32(_mm_add_epi32(edges[2], biases[2]), _mm_setzero_si128()));
+                    }
+                    if (count < 4) {
+                        mask = _mm_and_si128(mask, tail_masks[count]);
+                    }
+                    if (!_mm_movemask_epi8(mask)) {
+                        continue;
+                    }
+
+                    // Whole vectors are only read and written inside the bounding rect
+                    TriangleShadeSSE2(raster, edges, area, mask, row + bx + x, (bx + x + 4 <= w) ? 4 : count);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+#endif // SDL_SSE2_INTRINSICS
+
+// Returns false if the triangle should be drawn with the scalar loops
+static bool SDL_RasterizeTriangle(TriangleRaster *raster)
+{
+    if (!IsTriangleRasterFormat(raster->dst_format) || raster->area <= 0 || raster->area > INT_MAX) {
+        return false;
+    }
+    raster->dst_alpha = (raster->dst_format == SDL_PIXELFORMAT_ARGB8888);
+
+    if (raster->src) {
+        const SDL_PixelFormat format = raster->src->format;
+        const int limit = 1 << 20;
+
+        if (!IsTriangleTextureFormat(format) || (raster->flags & (SDL_COPY_COLORKEY | SDL_COPY_MUL))) {
+            return false;
+        }
+        if (raster->mode == TRIANGLE_SHADE_COPY && format != raster->dst_format) {
+            return false;
+        }
+        // Keep the texture coordinate numerators exact in doubles
+        if (SDL_abs(raster->s2s0_x) >= limit || SDL_abs(raster->s2s1_x) >= limit ||
+            SDL_abs(raster->s2s0_y) >= limit || SDL_abs(raster->s2s1_y) >= limit) {
+            return false;
+        }
+        raster->src_alpha = SDL_ISPIXELFORMAT_ALPHA(format);
+        raster->src_bgr = (format == SDL_PIXELFORMAT_ABGR8888 || format == SDL_PIXELFORMAT_XBGR8888);
+        raster->blend = raster->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+        if (raster->blend != 0 && raster->blend != SDL_COPY_BLEND && raster->blend != SDL_COPY_ADD && raster->blend != SDL_COPY_MOD) {
+            return false;
+        }
+    }
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_RasterizeTriangleSSE2(raster);
+    }
+#endif
+    return false;
+}
+
+// Set up the rasterizer with the edge functions of the scalar loops
+#define TRIANGLE_INIT_RASTER(raster, format)     \
+    SDL_zero(raster);                            \
+    raster.dstrect = dstrect;                    \
+    raster.dst_format = format;                  \
+    raster.dst = dst_ptr;                        \
+    raster.dst_pitch = dst_pitch;                \
+    raster.area = area;                          \
+    raster.w_row[0] = w0_row;                    \
+    raster.w_row[1] = w1_row;                    \
+    raster.w_row[2] = w2_row;                    \
+    raster.w_dx[0] = d2d1_y;                     \
+    raster.w_dx[1] = d0d2_y;                     \
+    raster.w_dx[2] = d1d0_y;                     \
+    raster.w_dy[0] = d1d2_x;                     \
+    raster.w_dy[1] = d2d0_x;                     \
+    raster.w_dy[2] = d0d1_x;                     \
+    raster.bias[0] = bias_w0;                    \
+    raster.bias[1] = bias_w1;                    \
+    raster.bias[2] = bias_w2;                    \
+    raster.c0 = c0;                              \
+    raster.c1 = c1;                              \
+    raster.c2 = c2;                              \
+    raster.is_uniform = is_uniform;
+
 bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
 {
     bool result = true;
@@ -246,6 +655,8 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
 
     bool is_uniform;
 
+    TriangleRaster raster;
+
     SDL_Surface *tmp = NULL;
 
     if (!SDL_SurfaceValid(dst)) {
@@ -369,7 +780,17 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
     bias_w1 = (is_top_left(d2, d0, is_clockwise) ? 0 : -1);
     bias_w2 = (is_top_left(d0, d1, is_clockwise) ? 0 : -1);
 
+    TRIANGLE_INIT_RASTER(raster, (tmp ? tmp->format : dst->format))
     if (is_uniform) {
+        raster.mode = TRIANGLE_SHADE_COLOR;
+        raster.color = SDL_MapSurfaceRGBA(tmp ? tmp : dst, c0.r, c0.g, c0.b, c0.a);
+    } else {
+        raster.mode = TRIANGLE_SHADE_GOURAUD;
+    }
+
+    if (SDL_RasterizeTriangle(&raster)) {
+        // Drawn with SIMD
+    } else if (is_uniform) {
         Uint32 color;
         if (tmp) {
             color = SDL_MapSurfaceRGBA(tmp, c0.r, c0.g, c0.b, c0.a);
@@ -502,6 +923,8 @@ bool SDL_SW_BlitTriangle(
 
     bool has_modulation;
 
+    TriangleRaster raster;
+
     CHECK_PARAM(!SDL_SurfaceValid(src)) {
         return SDL_InvalidParamError("src");
     }
@@ -632,7 +1055,35 @@ bool SDL_SW_BlitTriangle(
         goto end;
     }
 
+    TRIANGLE_INIT_RASTER(raster, dst->format)
+    raster.src = src;
+    raster.s2s0_x = s2s0_x;
+    raster.s2s1_x = s2s1_x;
+    raster.s2s0_y = s2s0_y;
+    raster.s2s1_y = s2s1_y;
+    raster.s2_x_area = s2_x_area;
+    raster.texture_address_mode_u = texture_address_mode_u;
+    raster.texture_address_mode_v = texture_address_mode_v;
     if (blend != SDL_BLENDMODE_NONE || src->format != dst->format || has_modulation || !is_uniform) {
+        raster.mode = TRIANGLE_SHADE_TEXTURE;
+        raster.color = ((Uint32)c0.a << 24) | ((Uint32)c0.r << 16) | ((Uint32)c0.g << 8) | c0.b;
+        raster.flags = src->map.info.flags & ~(SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA);
+        if (c0.r != 255 || c1.r != 255 || c2.r != 255 ||
+            c0.g != 255 || c1.g != 255 || c2.g != 255 ||
+            c0.b != 255 || c1.b != 255 || c2.b != 255) {
+            raster.flags |= SDL_COPY_MODULATE_COLOR;
+        }
+        if (c0.a != 255 || c1.a != 255 || c2.a != 255) {
+            raster.flags |= SDL_COPY_MODULATE_ALPHA;
+        }
+    } else {
+        raster.mode = TRIANGLE_SHADE_COPY;
+    }
+    if (SDL_RasterizeTriangle(&raster)) {
+        goto end;
+    }
+
+    if (raster.mode == TRIANGLE_SHADE_TEXTURE) {
         // Use SDL_BlitTriangle_Slow
 
         SDL_BlitInfo *info = &src->map.info;
@@ -310,6 +310,7 @@ typedef struct
     VkCommandBuffer *commandBuffers;
     uint32_t currentCommandBufferIndex;
     VkCommandBuffer currentCommandBuffer;
+    Uint64 submissionCount; // incremented each time a command buffer is submitted
     VkFence *fences;
     VkSurfaceCapabilitiesKHR surfaceCapabilities;
     VkSurfaceFormatKHR *surfaceFormats;
@@ -483,6 +484,7 @@ static VkFormat SDLPixelFormatToVkTextureFormat(Uint32 format, Uint32 output_col
 
 static void VULKAN_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture);
 static void VULKAN_DestroyBuffer(VULKAN_RenderData *rendererData, VULKAN_Buffer *vulkanBuffer);
+static void VULKAN_DestroyReadbacks(SDL_Renderer *renderer);
 static void VULKAN_DestroyImage(VULKAN_RenderData *rendererData, VULKAN_Image *vulkanImage);
 static void VULKAN_ResetCommandList(VULKAN_RenderData *rendererData);
 static bool VULKAN_FindMemoryTypeIndex(VULKAN_RenderData *rendererData, uint32_t typeBits, VkMemoryPropertyFlags requiredFlags, VkMemoryPropertyFlags desiredFlags, uint32_t *memoryTypeIndexOut);
@@ -508,6 +510,8 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
         VULKAN_DestroyTexture(renderer, texture);
     }
 
+    VULKAN_DestroyReadbacks(renderer);
+
     if (rendererData->waitDestStageMasks) {
         SDL_free(rendererData->waitDestStageMasks);
         rendererData->waitDestStageMasks = NULL;
@@ -1102,6 +1106,7 @@ static VkResult VULKAN_IssueBatch(VULKAN_RenderData *rendererData)
 
     result = vkQueueSubmit(rendererData->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
     rendererData->currentImageAvailableSemaphore = VK_NULL_HANDLE;
+    ++rendererData->submissionCount;
 
     VULKAN_WaitForGPU(rendererData);
 
@@ -4128,17 +4133,13 @@ static bool VULKAN_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cm
     return true;
 }
 
-static SDL_Surface *VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+// Record a copy of the render target into a new host visible buffer, leaving the render target ready to be copied from
+static bool VULKAN_RecordReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect, VULKAN_Buffer *readbackBuffer, VkFormat *vkFormat, VkImage *backBuffer, VkImageLayout **imageLayout)
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
-    VkImage backBuffer;
-    VkImageLayout *imageLayout;
-    VULKAN_Buffer readbackBuffer;
     VkDeviceSize pixelSize;
     VkDeviceSize length;
     VkDeviceSize readbackBufferSize;
-    VkFormat vkFormat;
-    SDL_Surface *output;
 
     VULKAN_EnsureCommandBuffer(rendererData);
 
@@ -4149,16 +4150,16 @@ static SDL_Surface *VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
     }
 
     if (rendererData->textureRenderTarget) {
-        backBuffer = rendererData->textureRenderTarget->mainImage.image;
-        imageLayout = &rendererData->textureRenderTarget->mainImage.imageLayout;
-        vkFormat = rendererData->textureRenderTarget->mainImage.format;
+        *backBuffer = rendererData->textureRenderTarget->mainImage.image;
+        *imageLayout = &rendererData->textureRenderTarget->mainImage.imageLayout;
+        *vkFormat = rendererData->textureRenderTarget->mainImage.format;
     } else {
-        backBuffer = rendererData->swapchainImages[rendererData->currentSwapchainImageIndex];
-        imageLayout = &rendererData->swapchainImageLayouts[rendererData->currentSwapchainImageIndex];
-        vkFormat = rendererData->surfaceFormat.format;
+        *backBuffer = rendererData->swapchainImages[rendererData->currentSwapchainImageIndex];
+        *imageLayout = &rendererData->swapchainImageLayouts[rendererData->currentSwapchainImageIndex];
+        *vkFormat = rendererData->surfaceFormat.format;
     }
 
-    pixelSize = VULKAN_GetBytesPerPixel(vkFormat, 0);
+    pixelSize = VULKAN_GetBytesPerPixel(*vkFormat, 0);
     length = rect->w * pixelSize;
     readbackBufferSize = length * rect->h;
     if (VULKAN_AllocateBuffer(rendererData, readbackBufferSize,
@@ -4166,8 +4167,8 @@ static SDL_Surface *VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        &readbackBuffer) != VK_SUCCESS) {
-        return NULL;
+        readbackBuffer) != VK_SUCCESS) {
+        return false;
     }
 
 
@@ -4178,8 +4179,8 @@ static SDL_Surface *VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
         VK_PIPELINE_STAGE_TRANSFER_BIT,
         VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-        backBuffer,
-        imageLayout);
+        *backBuffer,
+        *imageLayout);
 
     // Copy the image to the readback buffer
     VkBufferImageCopy region;
@@ -4196,11 +4197,13 @@ static SDL_Surface *VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
     region.imageExtent.width = rect->w;
     region.imageExtent.height = rect->h;
     region.imageExtent.depth = 1;
-    vkCmdCopyImageToBuffer(rendererData->currentCommandBuffer, backBuffer, *imageLayout, readbackBuffer.buffer, 1, &region);
+    vkCmdCopyImageToBuffer(rendererData->currentCommandBuffer, *backBuffer, **imageLayout, readbackBuffer->buffer, 1, &region);
 
-    // We need to issue the command list for the copy to finish
-    VULKAN_IssueBatch(rendererData);
+    return true;
+}
 
+static void VULKAN_RecordReadPixelsDone(VULKAN_RenderData *rendererData, VkImage backBuffer, VkImageLayout *imageLayout)
+{
     // Transition the render target back to a render target
      VULKAN_RecordPipelineImageBarrier(rendererData,
         VK_ACCESS_TRANSFER_WRITE_BIT,
@@ -4210,19 +4213,146 @@ static SDL_Surface *VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
         backBuffer,
         imageLayout);
+}
+
+static SDL_Surface *VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VkImage backBuffer;
+    VkImageLayout *imageLayout;
+    VULKAN_Buffer readbackBuffer;
+    VkFormat vkFormat;
+    SDL_Surface *output;
+
+    if (!VULKAN_RecordReadPixels(renderer, rect, &readbackBuffer, &vkFormat, &backBuffer, &imageLayout)) {
+        return NULL;
+    }
+
+    // We need to issue the command list for the copy to finish
+    VULKAN_IssueBatch(rendererData);
+
+    VULKAN_RecordReadPixelsDone(rendererData, backBuffer, imageLayout);
 
     output = SDL_DuplicatePixels(
         rect->w, rect->h,
         VULKAN_VkFormatToSDLPixelFormat(vkFormat),
         renderer->target ? renderer->target->colorspace : renderer->output_colorspace,
         readbackBuffer.mappedBufferPtr,
-        (int)length);
+        (int)(rect->w * VULKAN_GetBytesPerPixel(vkFormat, 0)));
 
     VULKAN_DestroyBuffer(rendererData, &readbackBuffer);
 
     return output;
 }
 
+typedef struct
+{
+    VULKAN_Buffer buffer; // destroyed early if the device is lost
+    VkFence fence;        // created once the copy has been submitted
+    Uint64 submission;    // the submission count when the copy was recorded
+    VkFormat format;
+    SDL_Colorspace colorspace;
+} VULKAN_ReadbackData;
+
+/* Record the copy in the current command buffer, which is submitted as usual.
+ * A fence is only added once that has happened, so nothing waits here.
+ */
+static bool VULKAN_RenderReadPixelsAsync(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_ReadbackData *readbackData;
+    VkImage backBuffer;
+    VkImageLayout *imageLayout;
+
+    readbackData = (VULKAN_ReadbackData *)SDL_calloc(1, sizeof(*readbackData));
+    if (!readbackData) {
+        return false;
+    }
+
+    if (!VULKAN_RecordReadPixels(renderer, &readback->rect, &readbackData->buffer, &readbackData->format, &backBuffer, &imageLayout)) {
+        SDL_free(readbackData);
+        return false;
+    }
+    VULKAN_RecordReadPixelsDone(rendererData, backBuffer, imageLayout);
+
+    readbackData->submission = rendererData->submissionCount;
+    readbackData->colorspace = renderer->target ? renderer->target->colorspace : renderer->output_colorspace;
+    readback->internal = readbackData;
+    return true;
+}
+
+static bool VULKAN_FinishReadPixelsAsync(SDL_Renderer *renderer, SDL_RenderReadback *readback, bool wait)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_ReadbackData *readbackData = (VULKAN_ReadbackData *)readback->internal;
+    VkResult result;
+
+    if (readbackData->buffer.buffer != VK_NULL_HANDLE) {
+        if (readbackData->submission == rendererData->submissionCount) {
+            /* The copy hasn't been submitted yet. Submit it now even if we're not
+             * waiting, since nothing else is submitted while the window is hidden
+             * and SDL_RenderPresent() skips presenting.
+             */
+            VULKAN_IssueBatch(rendererData);
+        } else {
+            if (readbackData->fence == VK_NULL_HANDLE) {
+                // An empty submission signals the fence once all earlier work on the queue has finished
+                VkFenceCreateInfo fenceCreateInfo = { 0 };
+                fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+                result = vkCreateFence(rendererData->device, &fenceCreateInfo, NULL, &readbackData->fence);
+                if (result == VK_SUCCESS) {
+                    result = vkQueueSubmit(rendererData->graphicsQueue, 0, NULL, readbackData->fence);
+                }
+                if (result != VK_SUCCESS) {
+                    if (readbackData->fence != VK_NULL_HANDLE) {
+                        vkDestroyFence(rendererData->device, readbackData->fence, NULL);
+                        readbackData->fence = VK_NULL_HANDLE;
+                    }
+                    VULKAN_WaitForGPU(rendererData);
+                }
+            }
+            if (readbackData->fence != VK_NULL_HANDLE) {
+                if (!wait && vkGetFenceStatus(rendererData->device, readbackData->fence) == VK_NOT_READY) {
+                    return false;
+                }
+                vkWaitForFences(rendererData->device, 1, &readbackData->fence, VK_TRUE, UINT64_MAX);
+                vkDestroyFence(rendererData->device, readbackData->fence, NULL);
+            }
+        }
+
+        readback->surface = SDL_DuplicatePixels(
+            readback->rect.w, readback->rect.h,
+            VULKAN_VkFormatToSDLPixelFormat(readbackData->format),
+            readbackData->colorspace,
+            readbackData->buffer.mappedBufferPtr,
+            (int)(readback->rect.w * VULKAN_GetBytesPerPixel(readbackData->format, 0)));
+
+        VULKAN_DestroyBuffer(rendererData, &readbackData->buffer);
+    }
+
+    SDL_free(readbackData);
+    readback->internal = NULL;
+    return true;
+}
+
+// The pending reads can't finish on a lost device, so they'll be delivered without pixels
+static void VULKAN_DestroyReadbacks(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+
+    for (SDL_RenderReadback *readback = renderer->readbacks; readback; readback = readback->next) {
+        VULKAN_ReadbackData *readbackData = (VULKAN_ReadbackData *)readback->internal;
+
+        if (readbackData) {
+            if (readbackData->fence != VK_NULL_HANDLE) {
+                vkDestroyFence(rendererData->device, readbackData->fence, NULL);
+                readbackData->fence = VK_NULL_HANDLE;
+            }
+            VULKAN_DestroyBuffer(rendererData, &readbackData->buffer);
+        }
+    }
+}
+
 static bool VULKAN_AddVulkanRenderSemaphores(SDL_Renderer *renderer, Uint32 wait_stage_mask, Sint64 wait_semaphore, Sint64 signal_semaphore)
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
@@ -4339,6 +4469,7 @@ static bool VULKAN_RenderPresent(SDL_Renderer *renderer)
         }
         rendererData->currentCommandBuffer = VK_NULL_HANDLE;
         rendererData->currentImageAvailableSemaphore = VK_NULL_HANDLE;
+        ++rendererData->submissionCount;
 
         VkPresentInfoKHR presentInfo = { 0 };
         presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -4448,6 +4579,8 @@ static bool VULKAN_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SD
     renderer->InvalidateCachedState = VULKAN_InvalidateCachedState;
     renderer->RunCommandQueue = VULKAN_RunCommandQueue;
     renderer->RenderReadPixels = VULKAN_RenderReadPixels;
+    renderer->RenderReadPixelsAsync = VULKAN_RenderReadPixelsAsync;
+    renderer->FinishReadPixelsAsync = VULKAN_FinishReadPixelsAsync;
     renderer->AddVulkanRenderSemaphores = VULKAN_AddVulkanRenderSemaphores;
     renderer->RenderPresent = VULKAN_RenderPresent;
     renderer->DestroyTexture = VULKAN_DestroyTexture;
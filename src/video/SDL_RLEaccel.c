@@ -1179,13 +1179,7 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
 
     // Now that we have it encoded, release the original pixels
     if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
-        } else {
-            SDL_free(surface->pixels);
-        }
-        surface->pixels = NULL;
+        SDL_FreeSurfacePixels(surface);
     }
 
     // reallocate the buffer to release unused memory
@@ -1355,13 +1349,7 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
 
     // Now that we have it encoded, release the original pixels
     if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
-        } else {
-            SDL_free(surface->pixels);
-        }
-        surface->pixels = NULL;
+        SDL_FreeSurfacePixels(surface);
     }
 
     // reallocate the buffer to release unused memory
@@ -1396,6 +1384,11 @@ bool SDL_RLESurface(SDL_Surface *surface)
         return false;
     }
 
+    // Views refer to the pixels, so they can't be freed
+    if (surface->num_views > 0) {
+        return false;
+    }
+
     flags = surface->map.info.flags;
     if (flags & SDL_COPY_COLORKEY) {
         // ok
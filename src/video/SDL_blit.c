@@ -51,7 +51,7 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
     // Lock the source if it's in hardware
     src_locked = 0;
     if (SDL_MUSTLOCK(src)) {
-        if (!SDL_LockSurface(src)) {
+        if (!SDL_LockSurfaceReadOnly(src)) {
             okay = false;
         } else {
             src_locked = 1;
@@ -175,10 +175,52 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(SDL_PixelFormat src_format, SDL_PixelForm
 }
 #endif // SDL_HAVE_BLIT_AUTO
 
+/* This is useful for finding out which combinations fall off the fast paths.
+ *
+ * The same blit is usually repeated many times, so a path is only logged
+ * when it's different from the last one chosen for that stage. The path is
+ * expected to be a string literal, so it's compared by address.
+ */
+void SDL_LogBlitPath(bool scaling, SDL_PixelFormat src_format, SDL_PixelFormat dst_format, const char *path)
+{
+    typedef struct
+    {
+        SDL_PixelFormat src_format;
+        SDL_PixelFormat dst_format;
+        const char *path;
+    } SDL_BlitPathLogEntry;
+    static SDL_SpinLock lock;
+    static SDL_BlitPathLogEntry last[2];
+    SDL_BlitPathLogEntry *entry = &last[scaling ? 1 : 0];
+    bool changed = false;
+
+    if (SDL_GetLogPriority(SDL_LOG_CATEGORY_VIDEO) > SDL_LOG_PRIORITY_DEBUG) {
+        return;
+    }
+
+    SDL_LockSpinlock(&lock);
+    if (entry->src_format != src_format || entry->dst_format != dst_format || entry->path != path) {
+        entry->src_format = src_format;
+        entry->dst_format = dst_format;
+        entry->path = path;
+        changed = true;
+    }
+    SDL_UnlockSpinlock(&lock);
+
+    if (changed) {
+        if (scaling) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Scaling %s to %s with %s", SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format), path);
+        } else {
+            SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Blitting %s to %s with %s blitter", SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format), path);
+        }
+    }
+}
+
 // Figure out which of many blit routines to set up on a surface
 bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
 {
     SDL_BlitFunc blit = NULL;
+    const char *blit_path = NULL;
     SDL_BlitMap *map = &surface->map;
     SDL_Colorspace src_colorspace = surface->colorspace;
     SDL_Colorspace dst_colorspace = dst->colorspace;
@@ -208,6 +250,7 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
     // See if we can do RLE acceleration
     if (map->info.flags & SDL_COPY_RLE_DESIRED) {
         if (SDL_RLESurface(surface)) {
+            SDL_LogBlitPath(false, surface->format, dst->format, "RLE");
             return true;
         }
     }
@@ -219,35 +262,42 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
             SDL_BYTESPERPIXEL(surface->format) > 4 ||
             SDL_BYTESPERPIXEL(dst->format) > 4) {
             blit = SDL_Blit_Slow_Float;
+            blit_path = "slow float";
         }
     }
     if (!blit) {
         if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
             blit = SDL_BlitCopy;
+            blit_path = "copy";
         } else if (SDL_ISPIXELFORMAT_10BIT(surface->format) ||
                    SDL_ISPIXELFORMAT_10BIT(dst->format)) {
             blit = SDL_Blit_Slow;
+            blit_path = "slow";
         }
 #ifdef SDL_HAVE_BLIT_0
         else if (SDL_BITSPERPIXEL(surface->format) < 8 &&
                  SDL_ISPIXELFORMAT_INDEXED(surface->format)) {
             blit = SDL_CalculateBlit0(surface);
+            blit_path = "0";
         }
 #endif
 #ifdef SDL_HAVE_BLIT_1
         else if (SDL_BYTESPERPIXEL(surface->format) == 1 &&
                  SDL_ISPIXELFORMAT_INDEXED(surface->format)) {
             blit = SDL_CalculateBlit1(surface);
+            blit_path = "1";
         }
 #endif
 #ifdef SDL_HAVE_BLIT_A
         else if (map->info.flags & SDL_COPY_BLEND) {
             blit = SDL_CalculateBlitA(surface);
+            blit_path = "A";
         }
 #endif
 #ifdef SDL_HAVE_BLIT_N
         else {
             blit = SDL_CalculateBlitN(surface);
+            blit_path = "N";
         }
 #endif
     }
@@ -259,6 +309,7 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
         blit =
             SDL_ChooseBlitFunc(src_format, dst_format, map->info.flags,
                                SDL_GeneratedBlitFuncTable);
+        blit_path = "auto";
     }
 #endif
 
@@ -276,6 +327,7 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
              (dst_format == SDL_PIXELFORMAT_INDEX8 && dst->palette)) &&
             !SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
             blit = SDL_Blit_Slow;
+            blit_path = "slow";
         }
     }
     map->data = (void *)blit;
@@ -286,5 +338,7 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
         return SDL_SetError("Blit combination not supported");
     }
 
+    SDL_LogBlitPath(false, surface->format, dst->format, blit_path);
+
     return true;
 }
@@ -105,6 +105,7 @@ typedef struct SDL_BlitMap
 
 // Functions found in SDL_blit.c
 extern bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst);
+extern void SDL_LogBlitPath(bool scaling, SDL_PixelFormat src_format, SDL_PixelFormat dst_format, const char *path);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface);
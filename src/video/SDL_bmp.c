@@ -177,6 +177,57 @@ static void CorrectAlphaChannel(SDL_Surface *surface)
     }
 }
 
+static SDL_Surface *MapBMPSurface(SDL_IOStream *src, Sint64 offset, int width, int height, Uint16 biBitCount, SDL_PixelFormat format)
+{
+    /*
+    | Creates a surface whose pixels point directly into the file, for
+    | uncompressed top-down images that need no conversion at all.
+    */
+    SDL_MappedSurfacePixels *mapping;
+    SDL_Surface *surface;
+    size_t pitch, size;
+    int bpp;
+
+    if (format == SDL_PIXELFORMAT_UNKNOWN) {
+        return NULL;
+    }
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    // These pixels need to be byte-swapped
+    if (biBitCount == 15 || biBitCount == 16 || biBitCount == 32) {
+        return NULL;
+    }
+#endif
+
+    // Multi-byte pixels must be naturally aligned, mappings start on a page boundary
+    bpp = SDL_BYTESPERPIXEL(format);
+    if ((bpp == 2 || bpp == 4) && (offset % bpp) != 0) {
+        return NULL;
+    }
+
+    // BMP rows are padded to a multiple of 4 bytes
+    if (!SDL_CalculateSurfaceSize(format, width, 1, NULL, &pitch, true)) {
+        return NULL;
+    }
+    pitch = (pitch + 3) & ~(size_t)3;
+    if (pitch > SDL_MAX_SINT32 || !SDL_size_mul_check_overflow(pitch, (size_t)height, &size)) {
+        return NULL;
+    }
+
+    mapping = SDL_MapSurfacePixels(src, offset, size);
+    if (!mapping) {
+        return NULL;
+    }
+
+    surface = SDL_CreateSurfaceFrom(width, height, format, mapping->pixels, (int)pitch);
+    if (!surface) {
+        SDL_UnmapSurfacePixels(mapping);
+        return NULL;
+    }
+    surface->internal_flags |= SDL_INTERNAL_SURFACE_MAPPED;
+    surface->mapped_pixels = mapping;
+    return surface;
+}
+
 SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
 {
     bool was_error = true;
@@ -193,6 +244,7 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
     bool haveRGBMasks = false;
     bool haveAlphaMask = false;
     bool correctAlpha = false;
+    bool mapped = false;
 
     // The Win32 BMP file header (14 bytes)
     char magic[2];
@@ -414,7 +466,19 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
 
         // Get the pixel format
         format = SDL_GetPixelFormatForMasks(biBitCount, Rmask, Gmask, Bmask, Amask);
-        surface = SDL_CreateSurface(biWidth, biHeight, format);
+
+        // Use the pixels in the file directly, if possible
+        if (topDown &&
+            (biCompression == BI_RGB || biCompression == BI_BITFIELDS) &&
+            SDL_GetHintBoolean(SDL_HINT_BMP_LOAD_MEMORY_MAPPED, false)) {
+            surface = MapBMPSurface(src, fp_offset + bfOffBits, biWidth, biHeight, biBitCount, format);
+            if (surface) {
+                mapped = true;
+            }
+        }
+        if (!surface) {
+            surface = SDL_CreateSurface(biWidth, biHeight, format);
+        }
 
         if (!surface) {
             goto done;
@@ -501,8 +565,14 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
     } else {
         bits = end - surface->pitch;
     }
+    if (mapped) {
+        // The pixels are already in place, leave the stream where reading them would have
+        if (SDL_SeekIO(src, (Sint64)surface->h * surface->pitch, SDL_IO_SEEK_CUR) < 0) {
+            goto done;
+        }
+    }
     while (bits >= top && bits < end) {
-        if (SDL_ReadIO(src, bits, surface->pitch) != (size_t)surface->pitch) {
+        if (!mapped && SDL_ReadIO(src, bits, surface->pitch) != (size_t)surface->pitch) {
             goto done;
         }
         if (biBitCount == 8 && surface->palette && biClrUsed < (1u << biBitCount)) {
@@ -681,7 +751,7 @@ bool SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
         saveLegacyBMP = SDL_GetHintBoolean(SDL_HINT_BMP_SAVE_LEGACY_FORMAT, false);
     }
 
-    if (SDL_LockSurface(intermediate_surface)) {
+    if (SDL_LockSurfaceReadOnly(intermediate_surface)) {
         const size_t bw = intermediate_surface->w * intermediate_surface->fmt->bytes_per_pixel;
 
         // Set the BMP file header values
@@ -22,6 +22,33 @@
 
 #include "SDL_surface_c.h"
 
+// Fills at least this large use non-temporal stores, so they don't evict the cache
+#define SDL_FILLRECT_STREAM_THRESHOLD (1024 * 1024)
+
+// Fill the unaligned ends of a row, n is in bytes and a multiple of bpp
+static SDL_INLINE Uint8 *SDL_FillPixelRun(Uint8 *p, Uint32 color, int n, int bpp)
+{
+    switch (bpp) {
+    case 1:
+        SDL_memset(p, (Uint8)color, n);
+        p += n;
+        break;
+    case 2:
+        for (; n > 0; n -= 2) {
+            *(Uint16 *)p = (Uint16)color;
+            p += 2;
+        }
+        break;
+    default:
+        for (; n > 0; n -= 4) {
+            *(Uint32 *)p = color;
+            p += 4;
+        }
+        break;
+    }
+    return p;
+}
+
 #ifdef SDL_SSE_INTRINSICS
 /* *INDENT-OFF* */ // clang-format off
 
@@ -43,95 +70,257 @@
     c128 = *(__m128 *)cccc;
 #endif
 
-#define SSE_WORK \
+#define SSE_WORK(store) \
     for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
+        store((float *)(p+0), c128); \
+        store((float *)(p+16), c128); \
+        store((float *)(p+32), c128); \
+        store((float *)(p+48), c128); \
         p += 64; \
     }
 
-#define SSE_END
+static SDL_INLINE void SDL_TARGETING("sse") SDL_FillSurfaceRectSSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h, int bpp, bool stream)
+{
+    int i, n;
+
+    /* If the number of bytes per row is equal to the pitch, treat */
+    /* all rows as one long continuous row (for better performance) */
+    if (w * bpp == pitch) {
+        w = w * h;
+        h = 1;
+    }
+
+    SSE_BEGIN;
+
+    while (h--) {
+        Uint8 *p = pixels;
+        n = w * bpp;
+
+        if (n > 63) {
+            int adjust = (int)((16 - ((uintptr_t)p & 15)) & 15);
+            p = SDL_FillPixelRun(p, color, adjust, bpp);
+            n -= adjust;
+            if (stream) {
+                SSE_WORK(_mm_stream_ps);
+            } else {
+                SSE_WORK(_mm_store_ps);
+            }
+            n &= 63;
+        }
+        SDL_FillPixelRun(p, color, n, bpp);
+        pixels += pitch;
+    }
 
-#define DEFINE_SSE_FILLRECT(bpp, type) \
+    if (stream) {
+        // Make the non-temporal stores visible before anything else touches the pixels
+        _mm_sfence();
+    }
+}
+
+#define DEFINE_SSE_FILLRECT(bpp) \
 static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
 { \
-    int i, n; \
-    Uint8 *p = NULL; \
-  \
-    /* If the number of bytes per row is equal to the pitch, treat */ \
-    /* all rows as one long continuous row (for better performance) */ \
-    if ((w) * (bpp) == pitch) { \
-        w = w * h; \
-        h = 1; \
-    } \
- \
-    SSE_BEGIN; \
- \
-    while (h--) { \
-        n = (w) * (bpp); \
-        p = pixels; \
- \
-        if (n > 63) { \
-            int adjust = 16 - ((uintptr_t)p & 15); \
-            if (adjust < 16) { \
-                n -= adjust; \
-                adjust /= (bpp); \
-                while (adjust--) { \
-                    *((type *)p) = (type)color; \
-                    p += (bpp); \
-                } \
-            } \
-            SSE_WORK; \
-        } \
-        if (n & 63) { \
-            int remainder = (n & 63); \
-            remainder /= (bpp); \
-            while (remainder--) { \
-                *((type *)p) = (type)color; \
-                p += (bpp); \
-            } \
-        } \
-        pixels += pitch; \
-    } \
- \
-    SSE_END; \
+    SDL_FillSurfaceRectSSE(pixels, pitch, color, w, h, bpp, false); \
+} \
+static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSEStream(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    SDL_FillSurfaceRectSSE(pixels, pitch, color, w, h, bpp, true); \
 }
 
-static void SDL_TARGETING("sse") SDL_FillSurfaceRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+DEFINE_SSE_FILLRECT(1)
+DEFINE_SSE_FILLRECT(2)
+DEFINE_SSE_FILLRECT(4)
+
+/* *INDENT-ON* */ // clang-format on
+#endif            // __SSE__
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") SDL_FillSurfaceRect3SSE2(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
+    DECLARE_ALIGNED(Uint8, pattern[48], 16);
+    __m128i c0, c1, c2;
     int i, n;
 
-    SSE_BEGIN;
+    // 16 pixels fill exactly three vectors
+    for (i = 0; i < 48; i += 3) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        pattern[i + 0] = (Uint8)(color & 0xFF);
+        pattern[i + 1] = (Uint8)((color >> 8) & 0xFF);
+        pattern[i + 2] = (Uint8)((color >> 16) & 0xFF);
+#else
+        pattern[i + 0] = (Uint8)((color >> 16) & 0xFF);
+        pattern[i + 1] = (Uint8)((color >> 8) & 0xFF);
+        pattern[i + 2] = (Uint8)(color & 0xFF);
+#endif
+    }
+    c0 = _mm_load_si128((const __m128i *)(pattern + 0));
+    c1 = _mm_load_si128((const __m128i *)(pattern + 16));
+    c2 = _mm_load_si128((const __m128i *)(pattern + 32));
+
     while (h--) {
         Uint8 *p = pixels;
-        n = w;
 
-        if (n > 63) {
-            int adjust = 16 - ((uintptr_t)p & 15);
-            if (adjust) {
-                n -= adjust;
-                SDL_memset(p, color, adjust);
-                p += adjust;
+        for (n = w; n >= 16; n -= 16) {
+            _mm_storeu_si128((__m128i *)(p + 0), c0);
+            _mm_storeu_si128((__m128i *)(p + 16), c1);
+            _mm_storeu_si128((__m128i *)(p + 32), c2);
+            p += 48;
+        }
+        if (n) {
+            SDL_memcpy(p, pattern, n * 3);
+        }
+        pixels += pitch;
+    }
+}
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_INLINE void SDL_TARGETING("avx2") SDL_FillSurfaceRectAVX2(Uint8 *pixels, int pitch, Uint32 color, int w, int h, int bpp, bool stream)
+{
+    const __m256i c256 = _mm256_set1_epi32((int)color);
+    int i, n;
+
+    if (w * bpp == pitch) {
+        w = w * h;
+        h = 1;
+    }
+
+    while (h--) {
+        Uint8 *p = pixels;
+        n = w * bpp;
+
+        if (n > 127) {
+            int adjust = (int)((32 - ((uintptr_t)p & 31)) & 31);
+            p = SDL_FillPixelRun(p, color, adjust, bpp);
+            n -= adjust;
+            if (stream) {
+                for (i = n / 128; i--;) {
+                    _mm256_stream_si256((__m256i *)(p + 0), c256);
+                    _mm256_stream_si256((__m256i *)(p + 32), c256);
+                    _mm256_stream_si256((__m256i *)(p + 64), c256);
+                    _mm256_stream_si256((__m256i *)(p + 96), c256);
+                    p += 128;
+                }
+            } else {
+                for (i = n / 128; i--;) {
+                    _mm256_store_si256((__m256i *)(p + 0), c256);
+                    _mm256_store_si256((__m256i *)(p + 32), c256);
+                    _mm256_store_si256((__m256i *)(p + 64), c256);
+                    _mm256_store_si256((__m256i *)(p + 96), c256);
+                    p += 128;
+                }
             }
-            SSE_WORK;
+            n &= 127;
         }
-        if (n & 63) {
-            int remainder = (n & 63);
-            SDL_memset(p, color, remainder);
+        SDL_FillPixelRun(p, color, n, bpp);
+        pixels += pitch;
+    }
+
+    if (stream) {
+        _mm_sfence();
+    }
+}
+
+#define DEFINE_AVX2_FILLRECT(bpp) \
+static void SDL_TARGETING("avx2") SDL_FillSurfaceRect##bpp##AVX2(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    SDL_FillSurfaceRectAVX2(pixels, pitch, color, w, h, bpp, false); \
+} \
+static void SDL_TARGETING("avx2") SDL_FillSurfaceRect##bpp##AVX2Stream(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    SDL_FillSurfaceRectAVX2(pixels, pitch, color, w, h, bpp, true); \
+}
+
+DEFINE_AVX2_FILLRECT(1)
+DEFINE_AVX2_FILLRECT(2)
+DEFINE_AVX2_FILLRECT(4)
+#endif // SDL_AVX2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+// NEON has no portable non-temporal store, so these always use regular stores
+static SDL_INLINE void SDL_FillSurfaceRectNEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h, int bpp)
+{
+    const uint32x4_t c128 = vdupq_n_u32(color);
+    int i, n;
+
+    if (w * bpp == pitch) {
+        w = w * h;
+        h = 1;
+    }
+
+    while (h--) {
+        Uint8 *p = pixels;
+        n = w * bpp;
+
+        if (n > 63) {
+            int adjust = (int)((16 - ((uintptr_t)p & 15)) & 15);
+            p = SDL_FillPixelRun(p, color, adjust, bpp);
+            n -= adjust;
+            for (i = n / 64; i--;) {
+                vst1q_u32((uint32_t *)(p + 0), c128);
+                vst1q_u32((uint32_t *)(p + 16), c128);
+                vst1q_u32((uint32_t *)(p + 32), c128);
+                vst1q_u32((uint32_t *)(p + 48), c128);
+                p += 64;
+            }
+            n &= 63;
         }
+        SDL_FillPixelRun(p, color, n, bpp);
         pixels += pitch;
     }
+}
 
-    SSE_END;
+static void SDL_FillSurfaceRect1NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    SDL_FillSurfaceRectNEON(pixels, pitch, color, w, h, 1);
 }
-// DEFINE_SSE_FILLRECT(1, Uint8)
-DEFINE_SSE_FILLRECT(2, Uint16)
-DEFINE_SSE_FILLRECT(4, Uint32)
 
-/* *INDENT-ON* */ // clang-format on
-#endif            // __SSE__
+static void SDL_FillSurfaceRect2NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    SDL_FillSurfaceRectNEON(pixels, pitch, color, w, h, 2);
+}
+
+static void SDL_FillSurfaceRect3NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    uint8x16x3_t c;
+    Uint8 bytes[3];
+    int n;
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    bytes[0] = (Uint8)(color & 0xFF);
+    bytes[1] = (Uint8)((color >> 8) & 0xFF);
+    bytes[2] = (Uint8)((color >> 16) & 0xFF);
+#else
+    bytes[0] = (Uint8)((color >> 16) & 0xFF);
+    bytes[1] = (Uint8)((color >> 8) & 0xFF);
+    bytes[2] = (Uint8)(color & 0xFF);
+#endif
+    c.val[0] = vdupq_n_u8(bytes[0]);
+    c.val[1] = vdupq_n_u8(bytes[1]);
+    c.val[2] = vdupq_n_u8(bytes[2]);
+
+    while (h--) {
+        Uint8 *p = pixels;
+
+        // Interleaving stores write 16 pixels at a time
+        for (n = w; n >= 16; n -= 16) {
+            vst3q_u8(p, c);
+            p += 48;
+        }
+        while (n--) {
+            *p++ = bytes[0];
+            *p++ = bytes[1];
+            *p++ = bytes[2];
+        }
+        pixels += pitch;
+    }
+}
+
+static void SDL_FillSurfaceRect4NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    SDL_FillSurfaceRectNEON(pixels, pitch, color, w, h, 4);
+}
+#endif // SDL_NEON_INTRINSICS
 
 static void SDL_FillSurfaceRect1(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
@@ -233,6 +422,125 @@ static void SDL_FillSurfaceRect4(Uint8 *pixels, int pitch, Uint32 color, int w,
     }
 }
 
+typedef void (*SDL_FillFunction)(Uint8 *pixels, int pitch, Uint32 color, int w, int h);
+
+// Choose the fill functions for a pixel size, stream_function is left NULL if there isn't one
+static bool SDL_GetFillFunctions(int bpp, bool aligned, SDL_FillFunction *fill_function, SDL_FillFunction *stream_function)
+{
+    *stream_function = NULL;
+
+    switch (bpp) {
+    case 1:
+    {
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            *fill_function = SDL_FillSurfaceRect1AVX2;
+            *stream_function = SDL_FillSurfaceRect1AVX2Stream;
+            break;
+        }
+#endif
+#ifdef SDL_SSE_INTRINSICS
+        if (SDL_HasSSE()) {
+            *fill_function = SDL_FillSurfaceRect1SSE;
+            *stream_function = SDL_FillSurfaceRect1SSEStream;
+            break;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            *fill_function = SDL_FillSurfaceRect1NEON;
+            break;
+        }
+#endif
+        *fill_function = SDL_FillSurfaceRect1;
+        break;
+    }
+
+    case 2:
+    {
+        if (!aligned) {
+            *fill_function = SDL_FillSurfaceRect2;
+            break;
+        }
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            *fill_function = SDL_FillSurfaceRect2AVX2;
+            *stream_function = SDL_FillSurfaceRect2AVX2Stream;
+            break;
+        }
+#endif
+#ifdef SDL_SSE_INTRINSICS
+        if (SDL_HasSSE()) {
+            *fill_function = SDL_FillSurfaceRect2SSE;
+            *stream_function = SDL_FillSurfaceRect2SSEStream;
+            break;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            *fill_function = SDL_FillSurfaceRect2NEON;
+            break;
+        }
+#endif
+        *fill_function = SDL_FillSurfaceRect2;
+        break;
+    }
+
+    case 3:
+    {
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            *fill_function = SDL_FillSurfaceRect3SSE2;
+            break;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            *fill_function = SDL_FillSurfaceRect3NEON;
+            break;
+        }
+#endif
+        *fill_function = SDL_FillSurfaceRect3;
+        break;
+    }
+
+    case 4:
+    {
+        if (!aligned) {
+            *fill_function = SDL_FillSurfaceRect4;
+            break;
+        }
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            *fill_function = SDL_FillSurfaceRect4AVX2;
+            *stream_function = SDL_FillSurfaceRect4AVX2Stream;
+            break;
+        }
+#endif
+#ifdef SDL_SSE_INTRINSICS
+        if (SDL_HasSSE()) {
+            *fill_function = SDL_FillSurfaceRect4SSE;
+            *stream_function = SDL_FillSurfaceRect4SSEStream;
+            break;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            *fill_function = SDL_FillSurfaceRect4NEON;
+            break;
+        }
+#endif
+        *fill_function = SDL_FillSurfaceRect4;
+        break;
+    }
+
+    default:
+        return false;
+    }
+    return true;
+
+}
+
 /*
  * This function performs a fast fill of the given rectangle with 'color'
  */
@@ -259,7 +567,10 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
     SDL_Rect clipped;
     Uint8 *pixels;
     const SDL_Rect *rect;
-    void (*fill_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
+    SDL_FillFunction fill_function;
+    SDL_FillFunction stream_function;
+    int bpp;
+    bool aligned;
     int i;
 
     CHECK_PARAM(!SDL_SurfaceValid(dst)) {
@@ -279,6 +590,10 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         return true;
     }
 
+    if (!SDL_MakeSurfaceWritable(dst)) {
+        return false;
+    }
+
     /* This function doesn't usually work on surfaces < 8 bpp
      * Except: support for 4bits, when filling full size.
      */
@@ -289,6 +604,7 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
                 if (SDL_BITSPERPIXEL(dst->format) == 4) {
                     Uint8 b = (((Uint8)color << 4) | (Uint8)color);
                     SDL_memset(dst->pixels, b, (size_t)dst->h * dst->pitch);
+                    SDL_AddSurfaceDamage(dst, NULL);
                     return true;
                 }
             }
@@ -296,57 +612,23 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         return SDL_SetError("SDL_FillSurfaceRects(): Unsupported surface format");
     }
 
-    if (fill_function == NULL) {
-        switch (SDL_BYTESPERPIXEL(dst->format)) {
-        case 1:
-        {
-            color |= (color << 8);
-            color |= (color << 16);
-#ifdef SDL_SSE_INTRINSICS
-            if (SDL_HasSSE()) {
-                fill_function = SDL_FillSurfaceRect1SSE;
-                break;
-            }
-#endif
-            fill_function = SDL_FillSurfaceRect1;
-            break;
-        }
-
-        case 2:
-        {
-            color |= (color << 16);
-#ifdef SDL_SSE_INTRINSICS
-            if (SDL_HasSSE()) {
-                fill_function = SDL_FillSurfaceRect2SSE;
-                break;
-            }
-#endif
-            fill_function = SDL_FillSurfaceRect2;
-            break;
-        }
-
-        case 3:
-            // 24-bit RGB is a slow path, at least for now.
-            {
-                fill_function = SDL_FillSurfaceRect3;
-                break;
-            }
-
-        case 4:
-        {
-#ifdef SDL_SSE_INTRINSICS
-            if (SDL_HasSSE()) {
-                fill_function = SDL_FillSurfaceRect4SSE;
-                break;
-            }
-#endif
-            fill_function = SDL_FillSurfaceRect4;
-            break;
-        }
-
-        default:
-            return SDL_SetError("Unsupported pixel format");
-        }
+    // The vector fills need every pixel to be naturally aligned
+    bpp = SDL_BYTESPERPIXEL(dst->format);
+    aligned = (bpp == 3 || (((uintptr_t)dst->pixels | (uintptr_t)dst->pitch) & (bpp - 1)) == 0);
+
+    switch (bpp) {
+    case 1:
+        color |= (color << 8);
+        color |= (color << 16);
+        break;
+    case 2:
+        color |= (color << 16);
+        break;
+    default:
+        break;
+    }
+    if (!SDL_GetFillFunctions(bpp, aligned, &fill_function, &stream_function)) {
+        return SDL_SetError("Unsupported pixel format");
     }
 
     for (i = 0; i < count; ++i) {
@@ -356,13 +638,42 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
             continue;
         }
         rect = &clipped;
+        SDL_AddSurfaceDamage(dst, rect);
 
         pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch +
-                 rect->x * SDL_BYTESPERPIXEL(dst->format);
+                 rect->x * bpp;
 
-        fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        if (stream_function &&
+            (size_t)rect->w * rect->h * bpp >= SDL_FILLRECT_STREAM_THRESHOLD) {
+            stream_function(pixels, dst->pitch, color, rect->w, rect->h);
+        } else {
+            fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        }
     }
 
     // We're done!
     return true;
 }
+
+/*
+ * Set every byte of a pixel buffer to the same value, used to clear whole surfaces
+ */
+void SDL_FillSurfaceBytes(void *pixels, Uint8 value, size_t size)
+{
+    SDL_FillFunction fill_function;
+    SDL_FillFunction stream_function;
+    const Uint32 color = value * 0x01010101u;
+    Uint8 *p = (Uint8 *)pixels;
+
+    SDL_GetFillFunctions(1, true, &fill_function, &stream_function);
+    if (stream_function && size >= SDL_FILLRECT_STREAM_THRESHOLD) {
+        fill_function = stream_function;
+    }
+
+    while (size > 0) {
+        const int chunk = (int)SDL_min(size, (size_t)1 << 30);
+        fill_function(p, chunk, color, chunk, 1);
+        p += chunk;
+        size -= chunk;
+    }
+}
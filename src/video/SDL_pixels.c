@@ -1441,6 +1441,336 @@ void SDL_GetRGBA(Uint32 pixelvalue, const SDL_PixelFormatDetails *format, const
     }
 }
 
+// Arrays longer than this cache their palette matches in a hash table
+#define SDL_MAP_ARRAY_PALETTE_CACHE_THRESHOLD 64
+
+/*
+ * Bulk mapping for packed formats with at most 8 bits per channel.
+ *
+ * SDL_Color is laid out in memory as R, G, B, A, so on little endian systems
+ * each color can be loaded as a 32-bit value with red in the low byte. Every
+ * channel is then converted with the same shift and mask for all pixels, which
+ * maps directly onto SIMD shifts by a scalar count.
+ */
+typedef struct SDL_PackedChannels
+{
+    int color_shift[4];     // right shift from a color to the top bits of the channel
+    Uint32 mask[4];         // channel mask, after shifting down
+    int pixel_shift[4];     // position of the channel in the pixel
+    int bits[4];
+} SDL_PackedChannels;
+
+static bool SDL_GetPackedChannels(const SDL_PixelFormatDetails *format, SDL_PackedChannels *channels)
+{
+    const Uint8 bits[4] = { format->Rbits, format->Gbits, format->Bbits, format->Abits };
+    const Uint8 shift[4] = { format->Rshift, format->Gshift, format->Bshift, format->Ashift };
+    int i;
+
+    if (SDL_ISPIXELFORMAT_INDEXED(format->format) ||
+        SDL_ISPIXELFORMAT_FOURCC(format->format) ||
+        SDL_ISPIXELFORMAT_10BIT(format->format) ||
+        format->bytes_per_pixel > sizeof(Uint32)) {
+        return false;
+    }
+
+    for (i = 0; i < 4; ++i) {
+        if (bits[i] > 8) {
+            return false;
+        }
+        channels->bits[i] = bits[i];
+        channels->color_shift[i] = i * 8 + (8 - bits[i]);
+        channels->mask[i] = (1u << bits[i]) - 1;
+        channels->pixel_shift[i] = bits[i] ? shift[i] : 0;
+    }
+    return true;
+}
+
+static void SDL_MapPackedColors(const SDL_PackedChannels *channels, const SDL_Color *colors, Uint32 *pixels, int count)
+{
+    int i, c;
+
+    for (i = 0; i < count; ++i) {
+        const Uint8 rgba[4] = { colors[i].r, colors[i].g, colors[i].b, colors[i].a };
+        Uint32 pixel = 0;
+
+        for (c = 0; c < 4; ++c) {
+            pixel |= ((Uint32)(rgba[c] >> (8 - channels->bits[c])) & channels->mask[c]) << channels->pixel_shift[c];
+        }
+        pixels[i] = pixel;
+    }
+}
+
+static void SDL_GetPackedColors(const SDL_PackedChannels *channels, const Uint32 *pixels, SDL_Color *colors, int count)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        const Uint32 pixel = pixels[i];
+
+        colors[i].r = SDL_expand_byte[channels->bits[0]][(pixel >> channels->pixel_shift[0]) & channels->mask[0]];
+        colors[i].g = SDL_expand_byte[channels->bits[1]][(pixel >> channels->pixel_shift[1]) & channels->mask[1]];
+        colors[i].b = SDL_expand_byte[channels->bits[2]][(pixel >> channels->pixel_shift[2]) & channels->mask[2]];
+        colors[i].a = SDL_expand_byte[channels->bits[3]][(pixel >> channels->pixel_shift[3]) & channels->mask[3]];
+    }
+}
+
+#if defined(SDL_SSE2_INTRINSICS) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+static int SDL_TARGETING("sse2") SDL_MapPackedColorsSSE2(const SDL_PackedChannels *channels, const SDL_Color *colors, Uint32 *pixels, int count)
+{
+    __m128i color_shift[4], mask[4], pixel_shift[4];
+    int i, c;
+
+    for (c = 0; c < 4; ++c) {
+        color_shift[c] = _mm_cvtsi32_si128(channels->color_shift[c]);
+        mask[c] = _mm_set1_epi32((int)channels->mask[c]);
+        pixel_shift[c] = _mm_cvtsi32_si128(channels->pixel_shift[c]);
+    }
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128i rgba = _mm_loadu_si128((const __m128i *)&colors[i]);
+        __m128i pixel = _mm_setzero_si128();
+
+        for (c = 0; c < 4; ++c) {
+            __m128i v = _mm_and_si128(_mm_srl_epi32(rgba, color_shift[c]), mask[c]);
+            pixel = _mm_or_si128(pixel, _mm_sll_epi32(v, pixel_shift[c]));
+        }
+        _mm_storeu_si128((__m128i *)&pixels[i], pixel);
+    }
+    return i;
+}
+
+static int SDL_TARGETING("sse2") SDL_GetPackedColorsSSE2(const SDL_PackedChannels *channels, const Uint32 *pixels, SDL_Color *colors, int count)
+{
+    __m128i pixel_shift[4], mask[4], expand_shift[4], bits[4], bits2[4], bits4[4], color_shift[4], opaque;
+    int i, c;
+
+    opaque = _mm_setzero_si128();
+    for (c = 0; c < 4; ++c) {
+        const int b = channels->bits[c];
+
+        pixel_shift[c] = _mm_cvtsi32_si128(channels->pixel_shift[c]);
+        mask[c] = _mm_set1_epi32((int)channels->mask[c]);
+        expand_shift[c] = _mm_cvtsi32_si128(8 - b);
+        bits[c] = _mm_cvtsi32_si128(b);
+        bits2[c] = _mm_cvtsi32_si128(b * 2);
+        bits4[c] = _mm_cvtsi32_si128(b * 4);
+        color_shift[c] = _mm_cvtsi32_si128(c * 8);
+        if (!b) {
+            // Channels that aren't present read as fully on, like SDL_expand_byte[0]
+            opaque = _mm_or_si128(opaque, _mm_set1_epi32(0xFF << (c * 8)));
+        }
+    }
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128i pixel = _mm_loadu_si128((const __m128i *)&pixels[i]);
+        __m128i rgba = opaque;
+
+        for (c = 0; c < 4; ++c) {
+            // Move the channel to the top of the byte and replicate its bits downwards
+            __m128i v = _mm_and_si128(_mm_srl_epi32(pixel, pixel_shift[c]), mask[c]);
+            v = _mm_sll_epi32(v, expand_shift[c]);
+            v = _mm_or_si128(v, _mm_srl_epi32(v, bits[c]));
+            v = _mm_or_si128(v, _mm_srl_epi32(v, bits2[c]));
+            v = _mm_or_si128(v, _mm_srl_epi32(v, bits4[c]));
+            rgba = _mm_or_si128(rgba, _mm_sll_epi32(v, color_shift[c]));
+        }
+        _mm_storeu_si128((__m128i *)&colors[i], rgba);
+    }
+    return i;
+}
+#endif // SDL_SSE2_INTRINSICS
+
+#if defined(SDL_NEON_INTRINSICS) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+static int SDL_MapPackedColorsNEON(const SDL_PackedChannels *channels, const SDL_Color *colors, Uint32 *pixels, int count)
+{
+    int32x4_t color_shift[4], pixel_shift[4];
+    uint32x4_t mask[4];
+    int i, c;
+
+    for (c = 0; c < 4; ++c) {
+        color_shift[c] = vdupq_n_s32(-channels->color_shift[c]);
+        mask[c] = vdupq_n_u32(channels->mask[c]);
+        pixel_shift[c] = vdupq_n_s32(channels->pixel_shift[c]);
+    }
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const uint32x4_t rgba = vreinterpretq_u32_u8(vld1q_u8((const Uint8 *)&colors[i]));
+        uint32x4_t pixel = vdupq_n_u32(0);
+
+        for (c = 0; c < 4; ++c) {
+            uint32x4_t v = vandq_u32(vshlq_u32(rgba, color_shift[c]), mask[c]);
+            pixel = vorrq_u32(pixel, vshlq_u32(v, pixel_shift[c]));
+        }
+        vst1q_u32(&pixels[i], pixel);
+    }
+    return i;
+}
+
+static int SDL_GetPackedColorsNEON(const SDL_PackedChannels *channels, const Uint32 *pixels, SDL_Color *colors, int count)
+{
+    int32x4_t pixel_shift[4], expand_shift[4], bits[4], bits2[4], bits4[4], color_shift[4];
+    uint32x4_t mask[4], opaque;
+    int i, c;
+
+    opaque = vdupq_n_u32(0);
+    for (c = 0; c < 4; ++c) {
+        const int b = channels->bits[c];
+
+        pixel_shift[c] = vdupq_n_s32(-channels->pixel_shift[c]);
+        mask[c] = vdupq_n_u32(channels->mask[c]);
+        expand_shift[c] = vdupq_n_s32(8 - b);
+        bits[c] = vdupq_n_s32(-b);
+        bits2[c] = vdupq_n_s32(-b * 2);
+        bits4[c] = vdupq_n_s32(-b * 4);
+        color_shift[c] = vdupq_n_s32(c * 8);
+        if (!b) {
+            // Channels that aren't present read as fully on, like SDL_expand_byte[0]
+            opaque = vorrq_u32(opaque, vdupq_n_u32(0xFFu << (c * 8)));
+        }
+    }
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const uint32x4_t pixel = vld1q_u32(&pixels[i]);
+        uint32x4_t rgba = opaque;
+
+        for (c = 0; c < 4; ++c) {
+            // Move the channel to the top of the byte and replicate its bits downwards
+            uint32x4_t v = vandq_u32(vshlq_u32(pixel, pixel_shift[c]), mask[c]);
+            v = vshlq_u32(v, expand_shift[c]);
+            v = vorrq_u32(v, vshlq_u32(v, bits[c]));
+            v = vorrq_u32(v, vshlq_u32(v, bits2[c]));
+            v = vorrq_u32(v, vshlq_u32(v, bits4[c]));
+            rgba = vorrq_u32(rgba, vshlq_u32(v, color_shift[c]));
+        }
+        vst1q_u8((Uint8 *)&colors[i], vreinterpretq_u8_u32(rgba));
+    }
+    return i;
+}
+#endif // SDL_NEON_INTRINSICS
+
+bool SDL_MapRGBAArray(const SDL_PixelFormatDetails *format, const SDL_Palette *palette, const SDL_Color *colors, Uint32 *pixels, int count)
+{
+    SDL_PackedChannels channels;
+    int i = 0;
+
+    CHECK_PARAM(!format) {
+        return SDL_InvalidParamError("format");
+    }
+    CHECK_PARAM(count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    CHECK_PARAM(count > 0 && !colors) {
+        return SDL_InvalidParamError("colors");
+    }
+    CHECK_PARAM(count > 0 && !pixels) {
+        return SDL_InvalidParamError("pixels");
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(format->format)) {
+        SDL_HashTable *palette_map = NULL;
+        Uint32 last_color = 0;
+        Uint8 last_index = 0;
+
+        CHECK_PARAM(!palette) {
+            return SDL_InvalidParamError("palette");
+        }
+
+        // Searching the palette is slow, so remember the colors we've already matched
+        if (count > SDL_MAP_ARRAY_PALETTE_CACHE_THRESHOLD) {
+            palette_map = SDL_CreateHashTable(0, false, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+        }
+        for (i = 0; i < count; ++i) {
+            const Uint32 color = ((Uint32)colors[i].r << 24) | ((Uint32)colors[i].g << 16) | ((Uint32)colors[i].b << 8) | colors[i].a;
+
+            if (i == 0 || color != last_color) {
+                if (palette_map) {
+                    last_index = SDL_LookupRGBAColor(palette_map, color, palette);
+                } else {
+                    last_index = SDL_FindColor(palette, colors[i].r, colors[i].g, colors[i].b, colors[i].a);
+                }
+                last_color = color;
+            }
+            pixels[i] = last_index;
+        }
+        if (palette_map) {
+            SDL_DestroyHashTable(palette_map);
+        }
+        return true;
+    }
+
+    if (!SDL_GetPackedChannels(format, &channels)) {
+        for (i = 0; i < count; ++i) {
+            pixels[i] = SDL_MapRGBA(format, palette, colors[i].r, colors[i].g, colors[i].b, colors[i].a);
+        }
+        return true;
+    }
+
+#if defined(SDL_SSE2_INTRINSICS) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+    if (SDL_HasSSE2()) {
+        i = SDL_MapPackedColorsSSE2(&channels, colors, pixels, count);
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+    if (i == 0 && SDL_HasNEON()) {
+        i = SDL_MapPackedColorsNEON(&channels, colors, pixels, count);
+    }
+#endif
+    SDL_MapPackedColors(&channels, colors + i, pixels + i, count - i);
+    return true;
+}
+
+bool SDL_GetRGBAArray(const Uint32 *pixels, const SDL_PixelFormatDetails *format, const SDL_Palette *palette, SDL_Color *colors, int count)
+{
+    SDL_PackedChannels channels;
+    int i = 0;
+
+    CHECK_PARAM(!format) {
+        return SDL_InvalidParamError("format");
+    }
+    CHECK_PARAM(count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    CHECK_PARAM(count > 0 && !pixels) {
+        return SDL_InvalidParamError("pixels");
+    }
+    CHECK_PARAM(count > 0 && !colors) {
+        return SDL_InvalidParamError("colors");
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(format->format)) {
+        static const SDL_Color black = { 0, 0, 0, 0 };
+
+        for (i = 0; i < count; ++i) {
+            if (palette && pixels[i] < (Uint32)palette->ncolors) {
+                colors[i] = palette->colors[pixels[i]];
+            } else {
+                colors[i] = black;
+            }
+        }
+        return true;
+    }
+
+    if (!SDL_GetPackedChannels(format, &channels)) {
+        for (i = 0; i < count; ++i) {
+            SDL_GetRGBA(pixels[i], format, palette, &colors[i].r, &colors[i].g, &colors[i].b, &colors[i].a);
+        }
+        return true;
+    }
+
+#if defined(SDL_SSE2_INTRINSICS) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+    if (SDL_HasSSE2()) {
+        i = SDL_GetPackedColorsSSE2(&channels, pixels, colors, count);
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+    if (i == 0 && SDL_HasNEON()) {
+        i = SDL_GetPackedColorsNEON(&channels, pixels, colors, count);
+    }
+#endif
+    SDL_GetPackedColors(&channels, pixels + i, colors + i, count - i);
+    return true;
+}
+
 // Map from Palette to Palette
 static Uint8 *Map1to1(const SDL_Palette *src, const SDL_Palette *dst, int *identical)
 {
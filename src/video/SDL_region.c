@@ -0,0 +1,868 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* Regions are stored as y-x banded arrays of boxes, like the X server and
+ * pixman regions:
+ *
+ * - Boxes are sorted by their top edge, and then by their left edge.
+ * - Boxes with the same top edge form a band, and have the same bottom edge.
+ * - Boxes in a band don't overlap or touch, and bands don't overlap.
+ * - Vertically adjacent bands are merged if they have the same spans.
+ *
+ * This makes the representation of a region unique, and lets the region
+ * operations walk both box lists once, a band at a time.
+ */
+
+typedef struct SDL_RegionBox
+{
+    int x1, y1, x2, y2;
+} SDL_RegionBox;
+
+struct SDL_Region
+{
+    SDL_RegionBox extents;
+    SDL_RegionBox *boxes;
+    int num_boxes;
+    int max_boxes;      // 0 if the boxes aren't owned by the region
+    SDL_Rect *rects;    // The boxes as rectangles, for SDL_GetRegionRects()
+    int max_rects;
+    bool rects_valid;
+};
+
+typedef bool (*SDL_RegionOverlapFunc)(SDL_Region *out,
+                                      const SDL_RegionBox *r1, const SDL_RegionBox *r1_end,
+                                      const SDL_RegionBox *r2, const SDL_RegionBox *r2_end,
+                                      int y1, int y2);
+
+static void SDL_InitRegionBox(SDL_Region *region, SDL_RegionBox *box)
+{
+    SDL_zerop(region);
+    region->extents = *box;
+    region->boxes = box;
+    region->num_boxes = 1;
+}
+
+static bool SDL_RectToRegionBox(const SDL_Rect *rect, SDL_RegionBox *box)
+{
+    if (rect->w <= 0 || rect->h <= 0) {
+        return false;
+    }
+    box->x1 = rect->x;
+    box->y1 = rect->y;
+    box->x2 = rect->x + rect->w;
+    box->y2 = rect->y + rect->h;
+    return true;
+}
+
+static void SDL_FreeRegionBoxes(SDL_Region *region)
+{
+    if (region->max_boxes > 0) {
+        SDL_free(region->boxes);
+    }
+    region->boxes = NULL;
+    region->num_boxes = 0;
+    region->max_boxes = 0;
+    region->rects_valid = false;
+}
+
+static bool SDL_ReserveRegionBoxes(SDL_Region *region, int count)
+{
+    if (region->num_boxes + count > region->max_boxes) {
+        int max_boxes = SDL_max(SDL_max(region->max_boxes * 2, region->num_boxes + count), 8);
+        SDL_RegionBox *boxes;
+
+        if (region->max_boxes > 0) {
+            boxes = (SDL_RegionBox *)SDL_realloc(region->boxes, max_boxes * sizeof(*boxes));
+        } else {
+            boxes = (SDL_RegionBox *)SDL_malloc(max_boxes * sizeof(*boxes));
+            if (boxes && region->num_boxes > 0) {
+                SDL_memcpy(boxes, region->boxes, region->num_boxes * sizeof(*boxes));
+            }
+        }
+        if (!boxes) {
+            return false;
+        }
+        region->boxes = boxes;
+        region->max_boxes = max_boxes;
+    }
+    return true;
+}
+
+static bool SDL_AppendRegionBox(SDL_Region *region, int x1, int y1, int x2, int y2)
+{
+    SDL_RegionBox *box;
+
+    if (!SDL_ReserveRegionBoxes(region, 1)) {
+        return false;
+    }
+    box = &region->boxes[region->num_boxes++];
+    box->x1 = x1;
+    box->y1 = y1;
+    box->x2 = x2;
+    box->y2 = y2;
+    return true;
+}
+
+static void SDL_UpdateRegionExtents(SDL_Region *region)
+{
+    int i;
+
+    region->rects_valid = false;
+
+    if (region->num_boxes == 0) {
+        SDL_zero(region->extents);
+        return;
+    }
+
+    region->extents.x1 = region->boxes[0].x1;
+    region->extents.y1 = region->boxes[0].y1;
+    region->extents.x2 = region->boxes[0].x2;
+    region->extents.y2 = region->boxes[region->num_boxes - 1].y2;
+    for (i = 1; i < region->num_boxes; ++i) {
+        region->extents.x1 = SDL_min(region->extents.x1, region->boxes[i].x1);
+        region->extents.x2 = SDL_max(region->extents.x2, region->boxes[i].x2);
+    }
+}
+
+// Replace the boxes of a region with the result of an operation
+static void SDL_MoveRegionBoxes(SDL_Region *region, SDL_Region *out)
+{
+    SDL_FreeRegionBoxes(region);
+    region->boxes = out->boxes;
+    region->num_boxes = out->num_boxes;
+    region->max_boxes = out->max_boxes;
+    SDL_UpdateRegionExtents(region);
+}
+
+static bool SDL_CopyRegionBoxes(SDL_Region *dst, const SDL_Region *src)
+{
+    if (dst == src) {
+        return true;
+    }
+
+    dst->num_boxes = 0;
+    if (dst->max_boxes == 0) {
+        dst->boxes = NULL;
+    }
+    if (!SDL_ReserveRegionBoxes(dst, src->num_boxes)) {
+        return false;
+    }
+    if (src->num_boxes > 0) {
+        SDL_memcpy(dst->boxes, src->boxes, src->num_boxes * sizeof(*dst->boxes));
+    }
+    dst->num_boxes = src->num_boxes;
+    dst->extents = src->extents;
+    dst->rects_valid = false;
+    return true;
+}
+
+static bool SDL_RegionBoxesOverlap(const SDL_RegionBox *a, const SDL_RegionBox *b)
+{
+    return a->x1 < b->x2 && b->x1 < a->x2 && a->y1 < b->y2 && b->y1 < a->y2;
+}
+
+static bool SDL_RegionBoxContains(const SDL_RegionBox *a, const SDL_RegionBox *b)
+{
+    return a->x1 <= b->x1 && a->x2 >= b->x2 && a->y1 <= b->y1 && a->y2 >= b->y2;
+}
+
+static const SDL_RegionBox *SDL_FindRegionBandEnd(const SDL_RegionBox *r, const SDL_RegionBox *r_end)
+{
+    const int y1 = r->y1;
+
+    while (r != r_end && r->y1 == y1) {
+        ++r;
+    }
+    return r;
+}
+
+/* Merge the band starting at cur_band with the band before it if they touch
+ * and have the same spans, returning the start of the last band.
+ */
+static int SDL_CoalesceRegionBand(SDL_Region *out, int prev_band, int cur_band)
+{
+    const int cur_count = out->num_boxes - cur_band;
+    const int prev_count = cur_band - prev_band;
+    SDL_RegionBox *prev, *cur;
+    int i;
+
+    if (cur_count == 0) {
+        // Nothing was added
+        return prev_band;
+    }
+    if (prev_count != cur_count) {
+        return cur_band;
+    }
+
+    prev = &out->boxes[prev_band];
+    cur = &out->boxes[cur_band];
+    if (prev->y2 != cur->y1) {
+        return cur_band;
+    }
+    for (i = 0; i < cur_count; ++i) {
+        if (prev[i].x1 != cur[i].x1 || prev[i].x2 != cur[i].x2) {
+            return cur_band;
+        }
+    }
+    for (i = 0; i < cur_count; ++i) {
+        prev[i].y2 = cur[i].y2;
+    }
+    out->num_boxes = cur_band;
+    return prev_band;
+}
+
+static bool SDL_AppendRegionBand(SDL_Region *out, const SDL_RegionBox *r, const SDL_RegionBox *r_end, int y1, int y2)
+{
+    for (; r != r_end; ++r) {
+        if (!SDL_AppendRegionBox(out, r->x1, y1, r->x2, y2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool SDL_UnionRegionBands(SDL_Region *out,
+                                 const SDL_RegionBox *r1, const SDL_RegionBox *r1_end,
+                                 const SDL_RegionBox *r2, const SDL_RegionBox *r2_end,
+                                 int y1, int y2)
+{
+    const SDL_RegionBox *r;
+    int x1, x2;
+
+    // Start with the leftmost span and merge everything that overlaps or touches it
+    if (r1->x1 < r2->x1) {
+        r = r1++;
+    } else {
+        r = r2++;
+    }
+    x1 = r->x1;
+    x2 = r->x2;
+
+    while (r1 != r1_end || r2 != r2_end) {
+        if (r2 == r2_end || (r1 != r1_end && r1->x1 < r2->x1)) {
+            r = r1++;
+        } else {
+            r = r2++;
+        }
+        if (r->x1 <= x2) {
+            x2 = SDL_max(x2, r->x2);
+        } else {
+            if (!SDL_AppendRegionBox(out, x1, y1, x2, y2)) {
+                return false;
+            }
+            x1 = r->x1;
+            x2 = r->x2;
+        }
+    }
+    return SDL_AppendRegionBox(out, x1, y1, x2, y2);
+}
+
+static bool SDL_IntersectRegionBands(SDL_Region *out,
+                                     const SDL_RegionBox *r1, const SDL_RegionBox *r1_end,
+                                     const SDL_RegionBox *r2, const SDL_RegionBox *r2_end,
+                                     int y1, int y2)
+{
+    int x1, x2;
+
+    while (r1 != r1_end && r2 != r2_end) {
+        x1 = SDL_max(r1->x1, r2->x1);
+        x2 = SDL_min(r1->x2, r2->x2);
+        if (x1 < x2) {
+            if (!SDL_AppendRegionBox(out, x1, y1, x2, y2)) {
+                return false;
+            }
+        }
+
+        // Advance whichever span ends first
+        if (r1->x2 < r2->x2) {
+            ++r1;
+        } else if (r2->x2 < r1->x2) {
+            ++r2;
+        } else {
+            ++r1;
+            ++r2;
+        }
+    }
+    return true;
+}
+
+static bool SDL_SubtractRegionBands(SDL_Region *out,
+                                    const SDL_RegionBox *r1, const SDL_RegionBox *r1_end,
+                                    const SDL_RegionBox *r2, const SDL_RegionBox *r2_end,
+                                    int y1, int y2)
+{
+    int x1 = r1->x1;
+
+    while (r1 != r1_end && r2 != r2_end) {
+        if (r2->x2 <= x1) {
+            // The subtrahend is entirely to the left
+            ++r2;
+        } else if (r2->x1 <= x1) {
+            // The subtrahend covers the left part of the minuend
+            x1 = r2->x2;
+            if (x1 >= r1->x2) {
+                if (++r1 != r1_end) {
+                    x1 = r1->x1;
+                }
+            } else {
+                ++r2;
+            }
+        } else if (r2->x1 < r1->x2) {
+            // The subtrahend splits the minuend
+            if (!SDL_AppendRegionBox(out, x1, y1, r2->x1, y2)) {
+                return false;
+            }
+            x1 = r2->x2;
+            if (x1 >= r1->x2) {
+                if (++r1 != r1_end) {
+                    x1 = r1->x1;
+                }
+            } else {
+                ++r2;
+            }
+        } else {
+            // The subtrahend is entirely to the right
+            if (!SDL_AppendRegionBox(out, x1, y1, r1->x2, y2)) {
+                return false;
+            }
+            if (++r1 != r1_end) {
+                x1 = r1->x1;
+            }
+        }
+    }
+
+    while (r1 != r1_end) {
+        if (!SDL_AppendRegionBox(out, x1, y1, r1->x2, y2)) {
+            return false;
+        }
+        if (++r1 != r1_end) {
+            x1 = r1->x1;
+        }
+    }
+    return true;
+}
+
+/* Combine two non-empty regions into result, which may be the same as reg1.
+ *
+ * The bands of both regions are walked together. Where only one region has
+ * boxes, they're copied if the operation keeps them, and where both do, the
+ * overlap function combines the spans of the two bands.
+ */
+static bool SDL_RegionOp(SDL_Region *result, const SDL_Region *reg1, const SDL_Region *reg2,
+                         SDL_RegionOverlapFunc overlap, bool append_non1, bool append_non2)
+{
+    const SDL_RegionBox *r1 = reg1->boxes;
+    const SDL_RegionBox *r1_end = r1 + reg1->num_boxes;
+    const SDL_RegionBox *r2 = reg2->boxes;
+    const SDL_RegionBox *r2_end = r2 + reg2->num_boxes;
+    const SDL_RegionBox *r1_band_end, *r2_band_end;
+    SDL_Region out;
+    int ytop, ybot, top, bot;
+    int prev_band = 0, cur_band;
+
+    SDL_zero(out);
+    if (!SDL_ReserveRegionBoxes(&out, reg1->num_boxes + reg2->num_boxes)) {
+        return false;
+    }
+
+    // ybot is the bottom of the area that has been processed
+    ybot = SDL_min(r1->y1, r2->y1);
+
+    do {
+        r1_band_end = SDL_FindRegionBandEnd(r1, r1_end);
+        r2_band_end = SDL_FindRegionBandEnd(r2, r2_end);
+
+        // Handle the part of a band that is above the other region's band
+        if (r1->y1 < r2->y1) {
+            if (append_non1) {
+                top = SDL_max(r1->y1, ybot);
+                bot = SDL_min(r1->y2, r2->y1);
+                if (top < bot) {
+                    cur_band = out.num_boxes;
+                    if (!SDL_AppendRegionBand(&out, r1, r1_band_end, top, bot)) {
+                        goto failed;
+                    }
+                    prev_band = SDL_CoalesceRegionBand(&out, prev_band, cur_band);
+                }
+            }
+            ytop = r2->y1;
+        } else if (r2->y1 < r1->y1) {
+            if (append_non2) {
+                top = SDL_max(r2->y1, ybot);
+                bot = SDL_min(r2->y2, r1->y1);
+                if (top < bot) {
+                    cur_band = out.num_boxes;
+                    if (!SDL_AppendRegionBand(&out, r2, r2_band_end, top, bot)) {
+                        goto failed;
+                    }
+                    prev_band = SDL_CoalesceRegionBand(&out, prev_band, cur_band);
+                }
+            }
+            ytop = r1->y1;
+        } else {
+            ytop = r1->y1;
+        }
+
+        // Handle the part where the bands overlap
+        ybot = SDL_min(r1->y2, r2->y2);
+        if (ybot > ytop) {
+            cur_band = out.num_boxes;
+            if (!overlap(&out, r1, r1_band_end, r2, r2_band_end, ytop, ybot)) {
+                goto failed;
+            }
+            prev_band = SDL_CoalesceRegionBand(&out, prev_band, cur_band);
+        }
+
+        if (r1->y2 == ybot) {
+            r1 = r1_band_end;
+        }
+        if (r2->y2 == ybot) {
+            r2 = r2_band_end;
+        }
+    } while (r1 != r1_end && r2 != r2_end);
+
+    // Handle the bands left over in one of the regions
+    if (r1 != r1_end && append_non1) {
+        do {
+            r1_band_end = SDL_FindRegionBandEnd(r1, r1_end);
+            cur_band = out.num_boxes;
+            if (!SDL_AppendRegionBand(&out, r1, r1_band_end, SDL_max(r1->y1, ybot), r1->y2)) {
+                goto failed;
+            }
+            prev_band = SDL_CoalesceRegionBand(&out, prev_band, cur_band);
+            r1 = r1_band_end;
+        } while (r1 != r1_end);
+    } else if (r2 != r2_end && append_non2) {
+        do {
+            r2_band_end = SDL_FindRegionBandEnd(r2, r2_end);
+            cur_band = out.num_boxes;
+            if (!SDL_AppendRegionBand(&out, r2, r2_band_end, SDL_max(r2->y1, ybot), r2->y2)) {
+                goto failed;
+            }
+            prev_band = SDL_CoalesceRegionBand(&out, prev_band, cur_band);
+            r2 = r2_band_end;
+        } while (r2 != r2_end);
+    }
+
+    SDL_MoveRegionBoxes(result, &out);
+    return true;
+
+failed:
+    SDL_FreeRegionBoxes(&out);
+    return false;
+}
+
+static bool SDL_UnionRegionInternal(SDL_Region *region, const SDL_Region *other)
+{
+    if (other->num_boxes == 0 || region == other) {
+        return true;
+    }
+    if (region->num_boxes == 0) {
+        return SDL_CopyRegionBoxes(region, other);
+    }
+    if (region->num_boxes == 1 && SDL_RegionBoxContains(&region->extents, &other->extents)) {
+        return true;
+    }
+    if (other->num_boxes == 1 && SDL_RegionBoxContains(&other->extents, &region->extents)) {
+        return SDL_CopyRegionBoxes(region, other);
+    }
+    return SDL_RegionOp(region, region, other, SDL_UnionRegionBands, true, true);
+}
+
+static bool SDL_IntersectRegionInternal(SDL_Region *region, const SDL_Region *other)
+{
+    if (region == other) {
+        return true;
+    }
+    if (region->num_boxes == 0 || other->num_boxes == 0 ||
+        !SDL_RegionBoxesOverlap(&region->extents, &other->extents)) {
+        region->num_boxes = 0;
+        SDL_UpdateRegionExtents(region);
+        return true;
+    }
+    if (region->num_boxes == 1 && other->num_boxes == 1) {
+        SDL_RegionBox *box = &region->boxes[0];
+
+        box->x1 = SDL_max(box->x1, other->boxes[0].x1);
+        box->y1 = SDL_max(box->y1, other->boxes[0].y1);
+        box->x2 = SDL_min(box->x2, other->boxes[0].x2);
+        box->y2 = SDL_min(box->y2, other->boxes[0].y2);
+        SDL_UpdateRegionExtents(region);
+        return true;
+    }
+    return SDL_RegionOp(region, region, other, SDL_IntersectRegionBands, false, false);
+}
+
+static bool SDL_SubtractRegionInternal(SDL_Region *region, const SDL_Region *other)
+{
+    if (region == other) {
+        region->num_boxes = 0;
+        SDL_UpdateRegionExtents(region);
+        return true;
+    }
+    if (region->num_boxes == 0 || other->num_boxes == 0 ||
+        !SDL_RegionBoxesOverlap(&region->extents, &other->extents)) {
+        return true;
+    }
+    return SDL_RegionOp(region, region, other, SDL_SubtractRegionBands, true, false);
+}
+
+SDL_Region *SDL_CreateRegion(void)
+{
+    return (SDL_Region *)SDL_calloc(1, sizeof(SDL_Region));
+}
+
+void SDL_DestroyRegion(SDL_Region *region)
+{
+    if (region) {
+        SDL_FreeRegionBoxes(region);
+        SDL_free(region->rects);
+        SDL_free(region);
+    }
+}
+
+bool SDL_CopyRegion(SDL_Region *dst, const SDL_Region *src)
+{
+    CHECK_PARAM(!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+    CHECK_PARAM(!src) {
+        return SDL_InvalidParamError("src");
+    }
+
+    return SDL_CopyRegionBoxes(dst, src);
+}
+
+bool SDL_ClearRegion(SDL_Region *region)
+{
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+
+    region->num_boxes = 0;
+    SDL_UpdateRegionExtents(region);
+    return true;
+}
+
+bool SDL_RegionEmpty(const SDL_Region *region)
+{
+    return !region || region->num_boxes == 0;
+}
+
+bool SDL_GetRegionBounds(const SDL_Region *region, SDL_Rect *rect)
+{
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+    CHECK_PARAM(!rect) {
+        return SDL_InvalidParamError("rect");
+    }
+
+    rect->x = region->extents.x1;
+    rect->y = region->extents.y1;
+    rect->w = region->extents.x2 - region->extents.x1;
+    rect->h = region->extents.y2 - region->extents.y1;
+    return region->num_boxes > 0;
+}
+
+const SDL_Rect *SDL_GetRegionRects(SDL_Region *region, int *count)
+{
+    int i;
+
+    if (count) {
+        *count = 0;
+    }
+
+    CHECK_PARAM(!region) {
+        SDL_InvalidParamError("region");
+        return NULL;
+    }
+
+    if (!region->rects_valid) {
+        if (!region->rects || region->num_boxes > region->max_rects) {
+            int max_rects = SDL_max(region->num_boxes, 1);
+            SDL_Rect *rects = (SDL_Rect *)SDL_realloc(region->rects, max_rects * sizeof(*rects));
+            if (!rects) {
+                return NULL;
+            }
+            region->rects = rects;
+            region->max_rects = max_rects;
+        }
+        for (i = 0; i < region->num_boxes; ++i) {
+            const SDL_RegionBox *box = &region->boxes[i];
+            SDL_Rect *rect = &region->rects[i];
+
+            rect->x = box->x1;
+            rect->y = box->y1;
+            rect->w = box->x2 - box->x1;
+            rect->h = box->y2 - box->y1;
+        }
+        region->rects_valid = true;
+    }
+
+    if (count) {
+        *count = region->num_boxes;
+    }
+    return region->rects;
+}
+
+bool SDL_PointInRegion(const SDL_Point *p, const SDL_Region *region)
+{
+    int i, lo, hi;
+
+    if (!p || !region || region->num_boxes == 0) {
+        return false;
+    }
+    if (p->x < region->extents.x1 || p->x >= region->extents.x2 ||
+        p->y < region->extents.y1 || p->y >= region->extents.y2) {
+        return false;
+    }
+
+    // Bands don't overlap, so the bottom edges are sorted too and we can binary search for the band
+    lo = 0;
+    hi = region->num_boxes;
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (region->boxes[mid].y2 <= p->y) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for (i = lo; i < region->num_boxes; ++i) {
+        const SDL_RegionBox *box = &region->boxes[i];
+
+        if (p->y < box->y1 || p->x < box->x1) {
+            // The point is above this band or left of this box
+            break;
+        }
+        if (p->x < box->x2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SDL_TranslateRegion(SDL_Region *region, int dx, int dy)
+{
+    int i;
+
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+
+    if (region->num_boxes == 0) {
+        return true;
+    }
+
+    for (i = 0; i < region->num_boxes; ++i) {
+        SDL_RegionBox *box = &region->boxes[i];
+
+        box->x1 += dx;
+        box->y1 += dy;
+        box->x2 += dx;
+        box->y2 += dy;
+    }
+    region->extents.x1 += dx;
+    region->extents.y1 += dy;
+    region->extents.x2 += dx;
+    region->extents.y2 += dy;
+    region->rects_valid = false;
+    return true;
+}
+
+bool SDL_UnionRegion(SDL_Region *region, const SDL_Region *other)
+{
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+    CHECK_PARAM(!other) {
+        return SDL_InvalidParamError("other");
+    }
+
+    return SDL_UnionRegionInternal(region, other);
+}
+
+bool SDL_IntersectRegion(SDL_Region *region, const SDL_Region *other)
+{
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+    CHECK_PARAM(!other) {
+        return SDL_InvalidParamError("other");
+    }
+
+    return SDL_IntersectRegionInternal(region, other);
+}
+
+bool SDL_SubtractRegion(SDL_Region *region, const SDL_Region *other)
+{
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+    CHECK_PARAM(!other) {
+        return SDL_InvalidParamError("other");
+    }
+
+    return SDL_SubtractRegionInternal(region, other);
+}
+
+bool SDL_UnionRegionRect(SDL_Region *region, const SDL_Rect *rect)
+{
+    SDL_Region other;
+    SDL_RegionBox box;
+
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+    CHECK_PARAM(!rect) {
+        return SDL_InvalidParamError("rect");
+    }
+
+    if (!SDL_RectToRegionBox(rect, &box)) {
+        return true;
+    }
+    SDL_InitRegionBox(&other, &box);
+    return SDL_UnionRegionInternal(region, &other);
+}
+
+bool SDL_IntersectRegionRect(SDL_Region *region, const SDL_Rect *rect)
+{
+    SDL_Region other;
+    SDL_RegionBox box;
+
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+    CHECK_PARAM(!rect) {
+        return SDL_InvalidParamError("rect");
+    }
+
+    if (!SDL_RectToRegionBox(rect, &box)) {
+        return SDL_ClearRegion(region);
+    }
+    SDL_InitRegionBox(&other, &box);
+    return SDL_IntersectRegionInternal(region, &other);
+}
+
+bool SDL_SubtractRegionRect(SDL_Region *region, const SDL_Rect *rect)
+{
+    SDL_Region other;
+    SDL_RegionBox box;
+
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+    CHECK_PARAM(!rect) {
+        return SDL_InvalidParamError("rect");
+    }
+
+    if (!SDL_RectToRegionBox(rect, &box)) {
+        return true;
+    }
+    SDL_InitRegionBox(&other, &box);
+    return SDL_SubtractRegionInternal(region, &other);
+}
+
+static int SDLCALL SDL_CompareRegionBoxes(const void *a, const void *b)
+{
+    const SDL_RegionBox *A = (const SDL_RegionBox *)a;
+    const SDL_RegionBox *B = (const SDL_RegionBox *)b;
+
+    if (A->y1 != B->y1) {
+        return (A->y1 < B->y1) ? -1 : 1;
+    }
+    if (A->x1 != B->x1) {
+        return (A->x1 < B->x1) ? -1 : 1;
+    }
+    return 0;
+}
+
+bool SDL_UnionRegionRects(SDL_Region *region, const SDL_Rect *rects, int count)
+{
+    SDL_RegionBox *boxes;
+    SDL_Region *parts;
+    int i, num_parts;
+    bool result = true;
+
+    CHECK_PARAM(!region) {
+        return SDL_InvalidParamError("region");
+    }
+    CHECK_PARAM(count < 0 || (count > 0 && !rects)) {
+        return SDL_InvalidParamError("rects");
+    }
+
+    if (count == 0) {
+        return true;
+    }
+    if (count == 1) {
+        return SDL_UnionRegionRect(region, rects);
+    }
+
+    boxes = (SDL_RegionBox *)SDL_malloc(count * sizeof(*boxes));
+    parts = (SDL_Region *)SDL_malloc(count * sizeof(*parts));
+    if (!boxes || !parts) {
+        SDL_free(boxes);
+        SDL_free(parts);
+        return false;
+    }
+
+    num_parts = 0;
+    for (i = 0; i < count; ++i) {
+        if (SDL_RectToRegionBox(&rects[i], &boxes[num_parts])) {
+            ++num_parts;
+        }
+    }
+
+    /* Adding the rectangles one at a time is quadratic, so merge them in
+     * pairs instead. Sorting them first means most merges only append bands.
+     */
+    SDL_qsort(boxes, num_parts, sizeof(*boxes), SDL_CompareRegionBoxes);
+    for (i = 0; i < num_parts; ++i) {
+        SDL_InitRegionBox(&parts[i], &boxes[i]);
+    }
+    while (num_parts > 1) {
+        for (i = 0; i + 1 < num_parts; i += 2) {
+            if (result) {
+                result = SDL_UnionRegionInternal(&parts[i], &parts[i + 1]);
+            }
+            SDL_FreeRegionBoxes(&parts[i + 1]);
+            parts[i / 2] = parts[i];
+        }
+        if (i < num_parts) {
+            parts[i / 2] = parts[i];
+            ++i;
+        }
+        num_parts = (i + 1) / 2;
+    }
+
+    if (num_parts == 1) {
+        if (result) {
+            result = SDL_UnionRegionInternal(region, &parts[0]);
+        }
+        SDL_FreeRegionBoxes(&parts[0]);
+    }
+    SDL_free(parts);
+    SDL_free(boxes);
+    return result;
+}
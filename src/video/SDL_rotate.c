@@ -555,7 +555,7 @@ SDL_Surface *SDLgfx_rotateSurface(SDL_Surface *src, double angle, int smooth, in
 
     // Lock source surface
     if (SDL_MUSTLOCK(src)) {
-        if (!SDL_LockSurface(src)) {
+        if (!SDL_LockSurfaceReadOnly(src)) {
             SDL_DestroySurface(rz_dst);
             return NULL;
         }
@@ -73,6 +73,7 @@
 #define MINIZ_SDL_NOUNUSED
 #include "miniz.h"
 
+#undef memcpy
 #undef memset
 #endif // SDL_HAVE_STB
 
@@ -380,7 +381,522 @@ SDL_Surface *SDL_LoadPNG(const char *file)
     return SDL_LoadPNG_IO(stream, true);
 }
 
-bool SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
+// PNG row filters, the values are the filter type stored in each row
+#define SDL_PNG_FILTER_NONE     0
+#define SDL_PNG_FILTER_SUB      1
+#define SDL_PNG_FILTER_UP       2
+#define SDL_PNG_FILTER_PAETH    4
+#define SDL_PNG_FILTER_ADAPTIVE 5
+
+#ifdef SDL_HAVE_STB
+/* PNG encoding
+ *
+ * The image data is filtered a row at a time and compressed with the miniz
+ * deflate compressor. Large images can be split into bands of rows that are
+ * compressed in parallel as raw deflate streams ending in a sync flush, which
+ * are concatenated into a single zlib stream, the same way pigz does it.
+ */
+
+// Don't split the image into pieces smaller than this, the compression ratio gets worse
+#define SDL_PNG_MIN_CHUNK_SIZE (128 * 1024)
+
+typedef struct SDL_PNGChunk
+{
+    const Uint8 *pixels;
+    int pitch;
+    int row_size;
+    int bpp;
+    int y_start;
+    int y_end;
+    int filter;
+    int flags;
+    bool last;
+    tdefl_output_buffer output;
+    mz_ulong adler;
+    size_t data_size;
+    bool result;
+    SDL_Thread *thread;
+} SDL_PNGChunk;
+
+static void SDL_FilterPNGRowSub(Uint8 *dst, const Uint8 *row, int size, int bpp)
+{
+    int i = 0;
+
+    for (; i < bpp; ++i) {
+        dst[i] = row[i];
+    }
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        for (; i + 16 <= size; i += 16) {
+            const __m128i x = _mm_loadu_si128((const __m128i *)(row + i));
+            const __m128i a = _mm_loadu_si128((const __m128i *)(row + i - bpp));
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_sub_epi8(x, a));
+        }
+    }
+#elif defined(SDL_NEON_INTRINSICS)
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(dst + i, vsubq_u8(vld1q_u8(row + i), vld1q_u8(row + i - bpp)));
+    }
+#endif
+    for (; i < size; ++i) {
+        dst[i] = (Uint8)(row[i] - row[i - bpp]);
+    }
+}
+
+static void SDL_FilterPNGRowUp(Uint8 *dst, const Uint8 *row, const Uint8 *prior, int size)
+{
+    int i = 0;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        for (; i + 16 <= size; i += 16) {
+            const __m128i x = _mm_loadu_si128((const __m128i *)(row + i));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(prior + i));
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_sub_epi8(x, b));
+        }
+    }
+#elif defined(SDL_NEON_INTRINSICS)
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(dst + i, vsubq_u8(vld1q_u8(row + i), vld1q_u8(prior + i)));
+    }
+#endif
+    for (; i < size; ++i) {
+        dst[i] = (Uint8)(row[i] - prior[i]);
+    }
+}
+
+static Uint8 SDL_PaethPredictor(int a, int b, int c)
+{
+    const int pa = SDL_abs(b - c);
+    const int pb = SDL_abs(a - c);
+    const int pc = SDL_abs(a + b - c - c);
+
+    if (pa <= pb && pa <= pc) {
+        return (Uint8)a;
+    } else if (pb <= pc) {
+        return (Uint8)b;
+    }
+    return (Uint8)c;
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") SDL_FilterPNGRowPaeth_SSE2(Uint8 *dst, const Uint8 *row, const Uint8 *prior, int size, int bpp, int *pos)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low_byte = _mm_set1_epi16(0xFF);
+    int i = *pos;
+
+    // All the inputs are known when encoding, so 8 predictors can be computed at a time in 16-bit lanes
+    for (; i + 8 <= size; i += 8) {
+        const __m128i x = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(row + i)), zero);
+        const __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(row + i - bpp)), zero);
+        const __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(prior + i)), zero);
+        const __m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(prior + i - bpp)), zero);
+        __m128i pa = _mm_sub_epi16(b, c);
+        __m128i pb = _mm_sub_epi16(a, c);
+        __m128i pc = _mm_add_epi16(pa, pb);
+        __m128i use_a, use_b, pred;
+
+        pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+        pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+        pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+
+        use_a = _mm_andnot_si128(_mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc)), _mm_set1_epi16(-1));
+        use_b = _mm_andnot_si128(_mm_cmpgt_epi16(pb, pc), _mm_set1_epi16(-1));
+        pred = _mm_or_si128(_mm_and_si128(use_b, b), _mm_andnot_si128(use_b, c));
+        pred = _mm_or_si128(_mm_and_si128(use_a, a), _mm_andnot_si128(use_a, pred));
+
+        // Keep only the low byte of the difference so packing wraps instead of saturating
+        _mm_storel_epi64((__m128i *)(dst + i), _mm_packus_epi16(_mm_and_si128(_mm_sub_epi16(x, pred), low_byte), zero));
+    }
+    *pos = i;
+}
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+static void SDL_FilterPNGRowPaeth_NEON(Uint8 *dst, const Uint8 *row, const Uint8 *prior, int size, int bpp, int *pos)
+{
+    int i = *pos;
+
+    for (; i + 8 <= size; i += 8) {
+        const uint8x8_t x = vld1_u8(row + i);
+        const uint8x8_t a = vld1_u8(row + i - bpp);
+        const uint8x8_t b = vld1_u8(prior + i);
+        const uint8x8_t c = vld1_u8(prior + i - bpp);
+        const int16x8_t pa_s = vreinterpretq_s16_u16(vsubl_u8(b, c));
+        const int16x8_t pb_s = vreinterpretq_s16_u16(vsubl_u8(a, c));
+        const uint16x8_t pa = vreinterpretq_u16_s16(vabsq_s16(pa_s));
+        const uint16x8_t pb = vreinterpretq_u16_s16(vabsq_s16(pb_s));
+        const uint16x8_t pc = vreinterpretq_u16_s16(vabsq_s16(vaddq_s16(pa_s, pb_s)));
+        const uint8x8_t use_a = vmovn_u16(vandq_u16(vcleq_u16(pa, pb), vcleq_u16(pa, pc)));
+        const uint8x8_t use_b = vmovn_u16(vcleq_u16(pb, pc));
+        const uint8x8_t pred = vbsl_u8(use_a, a, vbsl_u8(use_b, b, c));
+
+        vst1_u8(dst + i, vsub_u8(x, pred));
+    }
+    *pos = i;
+}
+#endif // SDL_NEON_INTRINSICS
+
+static void SDL_FilterPNGRowPaeth(Uint8 *dst, const Uint8 *row, const Uint8 *prior, int size, int bpp)
+{
+    int i = 0;
+
+    for (; i < bpp; ++i) {
+        dst[i] = (Uint8)(row[i] - prior[i]);
+    }
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SDL_FilterPNGRowPaeth_SSE2(dst, row, prior, size, bpp, &i);
+    }
+#elif defined(SDL_NEON_INTRINSICS)
+    SDL_FilterPNGRowPaeth_NEON(dst, row, prior, size, bpp, &i);
+#endif
+    for (; i < size; ++i) {
+        dst[i] = (Uint8)(row[i] - SDL_PaethPredictor(row[i - bpp], prior[i], prior[i - bpp]));
+    }
+}
+
+// The sum of the filtered bytes as signed values, the usual heuristic for choosing a filter
+static Uint32 SDL_GetPNGRowCost(const Uint8 *row, int size)
+{
+    Uint32 cost = 0;
+    int i = 0;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i sum = zero;
+
+        for (; i + 16 <= size; i += 16) {
+            const __m128i x = _mm_loadu_si128((const __m128i *)(row + i));
+            sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_min_epu8(x, _mm_sub_epi8(zero, x)), zero));
+        }
+        cost = (Uint32)(_mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8)));
+    }
+#elif defined(SDL_NEON_INTRINSICS)
+    {
+        uint32x4_t sum = vdupq_n_u32(0);
+
+        for (; i + 16 <= size; i += 16) {
+            const uint8x16_t x = vld1q_u8(row + i);
+            const uint8x16_t neg = vreinterpretq_u8_s8(vnegq_s8(vreinterpretq_s8_u8(x)));
+            sum = vpadalq_u16(sum, vpaddlq_u8(vminq_u8(x, neg)));
+        }
+        cost = vgetq_lane_u32(sum, 0) + vgetq_lane_u32(sum, 1) + vgetq_lane_u32(sum, 2) + vgetq_lane_u32(sum, 3);
+    }
+#endif
+    for (; i < size; ++i) {
+        cost += (row[i] < 128) ? row[i] : (256 - row[i]);
+    }
+    return cost;
+}
+
+static Uint8 *SDL_FilterPNGRow(Uint8 *buffers, const Uint8 *row, const Uint8 *prior, int size, int bpp, int filter)
+{
+    const int stride = 1 + size;
+    Uint8 *best;
+    Uint32 best_cost, cost;
+
+    switch (filter) {
+    case SDL_PNG_FILTER_SUB:
+        buffers[0] = SDL_PNG_FILTER_SUB;
+        SDL_FilterPNGRowSub(buffers + 1, row, size, bpp);
+        return buffers;
+    case SDL_PNG_FILTER_UP:
+        buffers[0] = SDL_PNG_FILTER_UP;
+        SDL_FilterPNGRowUp(buffers + 1, row, prior, size);
+        return buffers;
+    case SDL_PNG_FILTER_PAETH:
+        buffers[0] = SDL_PNG_FILTER_PAETH;
+        SDL_FilterPNGRowPaeth(buffers + 1, row, prior, size, bpp);
+        return buffers;
+    case SDL_PNG_FILTER_ADAPTIVE:
+        // Try each filter and keep the one that's most likely to compress well
+        buffers[0] = SDL_PNG_FILTER_NONE;
+        SDL_memcpy(buffers + 1, row, size);
+        best = buffers;
+        best_cost = SDL_GetPNGRowCost(buffers + 1, size);
+
+        buffers[stride] = SDL_PNG_FILTER_SUB;
+        SDL_FilterPNGRowSub(buffers + stride + 1, row, size, bpp);
+        cost = SDL_GetPNGRowCost(buffers + stride + 1, size);
+        if (cost < best_cost) {
+            best = buffers + stride;
+            best_cost = cost;
+        }
+
+        buffers[2 * stride] = SDL_PNG_FILTER_UP;
+        SDL_FilterPNGRowUp(buffers + 2 * stride + 1, row, prior, size);
+        cost = SDL_GetPNGRowCost(buffers + 2 * stride + 1, size);
+        if (cost < best_cost) {
+            best = buffers + 2 * stride;
+            best_cost = cost;
+        }
+
+        buffers[3 * stride] = SDL_PNG_FILTER_PAETH;
+        SDL_FilterPNGRowPaeth(buffers + 3 * stride + 1, row, prior, size, bpp);
+        cost = SDL_GetPNGRowCost(buffers + 3 * stride + 1, size);
+        if (cost < best_cost) {
+            best = buffers + 3 * stride;
+        }
+        return best;
+    default:
+        buffers[0] = SDL_PNG_FILTER_NONE;
+        SDL_memcpy(buffers + 1, row, size);
+        return buffers;
+    }
+}
+
+static bool SDL_CompressPNGChunk(SDL_PNGChunk *chunk)
+{
+    const size_t stride = 1 + (size_t)chunk->row_size;
+    const int num_buffers = (chunk->filter == SDL_PNG_FILTER_ADAPTIVE) ? 4 : 1;
+    tdefl_compressor *compressor;
+    Uint8 *buffers, *zero_row;
+    tdefl_status status;
+    int y;
+
+    compressor = (tdefl_compressor *)SDL_malloc(sizeof(*compressor));
+    buffers = (Uint8 *)SDL_malloc(stride * num_buffers);
+    zero_row = (Uint8 *)SDL_calloc(1, chunk->row_size + 1);
+    if (!compressor || !buffers || !zero_row) {
+        SDL_free(compressor);
+        SDL_free(buffers);
+        SDL_free(zero_row);
+        return false;
+    }
+
+    tdefl_init(compressor, tdefl_output_buffer_putter, &chunk->output, chunk->flags);
+    chunk->adler = MZ_ADLER32_INIT;
+    for (y = chunk->y_start; y < chunk->y_end; ++y) {
+        const Uint8 *row = chunk->pixels + (size_t)y * chunk->pitch;
+        const Uint8 *prior = (y > 0) ? (row - chunk->pitch) : zero_row;
+        const Uint8 *filtered = SDL_FilterPNGRow(buffers, row, prior, chunk->row_size, chunk->bpp, chunk->filter);
+
+        chunk->adler = mz_adler32(chunk->adler, filtered, stride);
+        if (tdefl_compress_buffer(compressor, filtered, stride, TDEFL_NO_FLUSH) < 0) {
+            break;
+        }
+    }
+    chunk->data_size = stride * (chunk->y_end - chunk->y_start);
+
+    // Only the last chunk ends the deflate stream, the others end on a byte boundary so they can be joined
+    if (y < chunk->y_end) {
+        chunk->result = false;
+    } else if (chunk->last) {
+        status = tdefl_compress_buffer(compressor, NULL, 0, TDEFL_FINISH);
+        chunk->result = (status == TDEFL_STATUS_DONE);
+    } else {
+        status = tdefl_compress_buffer(compressor, NULL, 0, TDEFL_SYNC_FLUSH);
+        chunk->result = (status == TDEFL_STATUS_OKAY);
+    }
+
+    SDL_free(compressor);
+    SDL_free(buffers);
+    SDL_free(zero_row);
+    return chunk->result;
+}
+
+static int SDLCALL SDL_CompressPNGChunkThread(void *data)
+{
+    SDL_CompressPNGChunk((SDL_PNGChunk *)data);
+    return 0;
+}
+
+// Combine the Adler-32 checksums of two pieces of data, as in zlib's adler32_combine()
+static mz_ulong SDL_CombineAdler32(mz_ulong adler1, mz_ulong adler2, size_t len2)
+{
+    const mz_ulong base = 65521;
+    const mz_ulong rem = (mz_ulong)(len2 % base);
+    mz_ulong sum1 = adler1 & 0xffff;
+    mz_ulong sum2 = (rem * sum1) % base;
+
+    sum1 += (adler2 & 0xffff) + base - 1;
+    sum2 += ((adler1 >> 16) & 0xffff) + ((adler2 >> 16) & 0xffff) + base - rem;
+    if (sum1 >= base) {
+        sum1 -= base;
+    }
+    if (sum1 >= base) {
+        sum1 -= base;
+    }
+    if (sum2 >= (base << 1)) {
+        sum2 -= (base << 1);
+    }
+    if (sum2 >= base) {
+        sum2 -= base;
+    }
+    return sum1 | (sum2 << 16);
+}
+
+static void SDL_PutPNGU32(Uint8 *dst, Uint32 value)
+{
+    dst[0] = (Uint8)(value >> 24);
+    dst[1] = (Uint8)(value >> 16);
+    dst[2] = (Uint8)(value >> 8);
+    dst[3] = (Uint8)value;
+}
+
+static bool SDL_WritePNGChunk(SDL_IOStream *dst, const char *type, const Uint8 *data, size_t size)
+{
+    mz_ulong crc;
+
+    if (size > SDL_MAX_SINT32) {
+        return SDL_SetError("PNG chunk too large");
+    }
+    crc = mz_crc32(MZ_CRC32_INIT, (const mz_uint8 *)type, 4);
+    if (size > 0) {
+        crc = mz_crc32(crc, data, size);
+    }
+
+    if (!SDL_WriteU32BE(dst, (Uint32)size) ||
+        SDL_WriteIO(dst, type, 4) != 4 ||
+        SDL_WriteIO(dst, data, size) != size ||
+        !SDL_WriteU32BE(dst, (Uint32)crc)) {
+        return false;
+    }
+    return true;
+}
+
+static bool SDL_WritePNG(SDL_IOStream *dst, const Uint8 *pixels, int w, int h, int bpp, int pitch,
+                         const Uint8 *plte, int plte_size, const Uint8 *trns, int trns_size,
+                         int level, int filter, int num_threads)
+{
+    static const Uint8 signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    static const mz_uint num_probes[11] = { 0, 1, 6, 32, 16, 32, 128, 256, 512, 768, 1500 };
+    const int row_size = w * bpp;
+    const size_t data_size = (size_t)(1 + row_size) * h;
+    Uint8 header[13];
+    Uint8 zlib_header[2];
+    Uint8 trailer[4];
+    SDL_PNGChunk *chunks;
+    mz_ulong adler;
+    int flags, num_chunks, i;
+    bool result = true;
+
+    // Each thread compresses one piece of the image, as long as the pieces aren't too small
+    num_chunks = (int)SDL_min((size_t)num_threads, data_size / SDL_PNG_MIN_CHUNK_SIZE);
+    num_chunks = SDL_clamp(num_chunks, 1, SDL_max(h, 1));
+
+    chunks = (SDL_PNGChunk *)SDL_calloc(num_chunks, sizeof(*chunks));
+    if (!chunks) {
+        return false;
+    }
+
+    if (level == 0) {
+        flags = TDEFL_FORCE_ALL_RAW_BLOCKS;
+    } else {
+        flags = (int)num_probes[level];
+        if (level <= 3) {
+            flags |= TDEFL_GREEDY_PARSING_FLAG;
+        }
+    }
+
+    zlib_header[0] = 0x78;
+    if (level <= 1) {
+        zlib_header[1] = 0x01;
+    } else if (level <= 5) {
+        zlib_header[1] = 0x5e;
+    } else if (level == 6) {
+        zlib_header[1] = 0x9c;
+    } else {
+        zlib_header[1] = 0xda;
+    }
+
+    for (i = 0; i < num_chunks; ++i) {
+        SDL_PNGChunk *chunk = &chunks[i];
+
+        chunk->pixels = pixels;
+        chunk->pitch = pitch;
+        chunk->row_size = row_size;
+        chunk->bpp = bpp;
+        chunk->y_start = (int)(((Sint64)h * i) / num_chunks);
+        chunk->y_end = (int)(((Sint64)h * (i + 1)) / num_chunks);
+        chunk->filter = filter;
+        chunk->flags = flags;
+        chunk->last = (i == num_chunks - 1);
+        chunk->output.m_expandable = MZ_TRUE;
+        if (i == 0 && !tdefl_output_buffer_putter(zlib_header, sizeof(zlib_header), &chunk->output)) {
+            SDL_free(chunks);
+            return false;
+        }
+        if (i > 0) {
+            chunk->thread = SDL_CreateThread(SDL_CompressPNGChunkThread, "SDLPNGCompress", chunk);
+        }
+    }
+
+    // Compress the first chunk on this thread, and anything we couldn't start a thread for
+    for (i = 0; i < num_chunks; ++i) {
+        if (!chunks[i].thread) {
+            SDL_CompressPNGChunk(&chunks[i]);
+        }
+    }
+    for (i = 0; i < num_chunks; ++i) {
+        if (chunks[i].thread) {
+            SDL_WaitThread(chunks[i].thread, NULL);
+        }
+        if (!chunks[i].result) {
+            result = false;
+        }
+    }
+    if (!result) {
+        SDL_SetError("Failed to compress image");
+        goto done;
+    }
+
+    // Write the header chunks
+    SDL_PutPNGU32(header + 0, (Uint32)w);
+    SDL_PutPNGU32(header + 4, (Uint32)h);
+    header[8] = 8;  // bit depth
+    if (plte_size > 0) {
+        header[9] = 3;  // indexed
+    } else if (bpp == 4) {
+        header[9] = 6;  // RGBA
+    } else {
+        header[9] = 0;  // grayscale
+    }
+    header[10] = 0;  // deflate compression
+    header[11] = 0;  // adaptive filtering
+    header[12] = 0;  // no interlace
+    if (SDL_WriteIO(dst, signature, sizeof(signature)) != sizeof(signature) ||
+        !SDL_WritePNGChunk(dst, "IHDR", header, sizeof(header)) ||
+        (plte_size > 0 && !SDL_WritePNGChunk(dst, "PLTE", plte, plte_size)) ||
+        (trns_size > 0 && !SDL_WritePNGChunk(dst, "tRNS", trns, trns_size))) {
+        result = false;
+        goto done;
+    }
+
+    // Write the zlib stream, with one IDAT chunk per compressed piece
+    adler = chunks[0].adler;
+    for (i = 1; i < num_chunks; ++i) {
+        adler = SDL_CombineAdler32(adler, chunks[i].adler, chunks[i].data_size);
+    }
+    SDL_PutPNGU32(trailer, (Uint32)adler);
+    if (!tdefl_output_buffer_putter(trailer, sizeof(trailer), &chunks[num_chunks - 1].output)) {
+        result = false;
+        goto done;
+    }
+    for (i = 0; i < num_chunks; ++i) {
+        if (!SDL_WritePNGChunk(dst, "IDAT", chunks[i].output.m_pBuf, chunks[i].output.m_size)) {
+            result = false;
+            goto done;
+        }
+    }
+    if (!SDL_WritePNGChunk(dst, "IEND", NULL, 0)) {
+        result = false;
+        goto done;
+    }
+
+done:
+    for (i = 0; i < num_chunks; ++i) {
+        SDL_free(chunks[i].output.m_pBuf);
+    }
+    SDL_free(chunks);
+    return result;
+}
+#endif // SDL_HAVE_STB
+
+static bool SDL_SavePNG_Internal(SDL_Surface *surface, SDL_IOStream *dst, bool closeio, int level, int filter, int num_threads)
 {
     bool retval = false;
     Uint8 *plte = NULL;
@@ -439,16 +955,8 @@ bool SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
         }
     }
 
-    size_t size = 0;
-    void *png = tdefl_write_image_to_png_file_in_memory_ex(surface->pixels, surface->w, surface->h, SDL_BYTESPERPIXEL(surface->format), surface->pitch, &size, 6, MZ_FALSE, plte, plte_size, trns, trns_size);
-    if (png) {
-        if (SDL_WriteIO(dst, png, size)) {
-            retval = true;
-        }
-        mz_free(png); /* calls SDL_free() */
-    } else {
-        SDL_SetError("Failed to convert and save image");
-    }
+    retval = SDL_WritePNG(dst, (const Uint8 *)surface->pixels, surface->w, surface->h, SDL_BYTESPERPIXEL(surface->format), surface->pitch,
+                          plte, plte_size, trns, trns_size, level, filter, num_threads);
 
 #else
     SDL_SetError("SDL not built with STB image support");
@@ -467,6 +975,41 @@ done:
     return retval;
 }
 
+bool SDL_SavePNG_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
+{
+    return SDL_SavePNG_Internal(surface, dst, closeio, 6, SDL_PNG_FILTER_NONE, 1);
+}
+
+bool SDL_SavePNG_IOWithProperties(SDL_Surface *surface, SDL_IOStream *dst, bool closeio, SDL_PropertiesID props)
+{
+    int level = (int)SDL_GetNumberProperty(props, SDL_PROP_PNG_SAVE_COMPRESSION_LEVEL_NUMBER, 6);
+    const char *filter_name = SDL_GetStringProperty(props, SDL_PROP_PNG_SAVE_FILTER_STRING, NULL);
+    int num_threads = (int)SDL_GetNumberProperty(props, SDL_PROP_PNG_SAVE_THREADS_NUMBER, 1);
+    int filter = SDL_PNG_FILTER_NONE;
+
+    level = SDL_clamp(level, 0, 10);
+    if (num_threads <= 0) {
+        num_threads = SDL_GetNumLogicalCPUCores();
+    }
+    if (filter_name) {
+        if (SDL_strcasecmp(filter_name, "sub") == 0) {
+            filter = SDL_PNG_FILTER_SUB;
+        } else if (SDL_strcasecmp(filter_name, "up") == 0) {
+            filter = SDL_PNG_FILTER_UP;
+        } else if (SDL_strcasecmp(filter_name, "paeth") == 0) {
+            filter = SDL_PNG_FILTER_PAETH;
+        } else if (SDL_strcasecmp(filter_name, "adaptive") == 0) {
+            filter = SDL_PNG_FILTER_ADAPTIVE;
+        } else if (SDL_strcasecmp(filter_name, "none") != 0) {
+            if (dst && closeio) {
+                SDL_CloseIO(dst);
+            }
+            return SDL_SetError("Unknown PNG filter: %s", filter_name);
+        }
+    }
+    return SDL_SavePNG_Internal(surface, dst, closeio, level, filter, num_threads);
+}
+
 bool SDL_SavePNG(SDL_Surface *surface, const char *file)
 {
 #ifdef SDL_HAVE_STB
@@ -40,6 +40,11 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
         return SDL_InvalidParamError("dst");
     }
 
+    if (!SDL_MakeSurfaceWritable(dst)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(dst, dstrect);
+
     if (src->format != dst->format) {
         // Slow!
         SDL_Surface *src_tmp = SDL_ConvertSurfaceAndColorspace(src, dst->format, dst->palette, dst->colorspace, dst->props);
@@ -146,7 +151,7 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
     // Lock the source if it's in hardware
     src_locked = 0;
     if (SDL_MUSTLOCK(src)) {
-        if (!SDL_LockSurface(src)) {
+        if (!SDL_LockSurfaceReadOnly(src)) {
             if (dst_locked) {
                 SDL_UnlockSurface(dst);
             }
@@ -187,6 +187,28 @@ static bool SDL_InitializeSurface(SDL_Surface *surface, int width, int height, S
     return true;
 }
 
+/*
+ * Allocate pixels owned by the surface, from the surface pool if it's enabled
+ */
+static bool SDL_AllocateSurfacePixels(SDL_Surface *surface, size_t size)
+{
+    if (SDL_UseSurfacePool(size)) {
+        surface->pixels = SDL_AllocSurfacePoolPixels(SDL_GetSIMDAlignment(), size);
+        if (!surface->pixels) {
+            return false;
+        }
+        surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
+        surface->internal_flags |= SDL_INTERNAL_SURFACE_POOLED;
+    } else {
+        surface->pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
+        if (!surface->pixels) {
+            return false;
+        }
+        surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
+    }
+    return true;
+}
+
 /*
  * Create an empty surface of the appropriate depth using the given format
  */
@@ -227,12 +249,10 @@ SDL_Surface *SDL_CreateSurface(int width, int height, SDL_PixelFormat format)
 
     if (surface->w && surface->h && format != SDL_PIXELFORMAT_MJPG) {
         surface->flags &= ~SDL_SURFACE_PREALLOCATED;
-        surface->pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
-        if (!surface->pixels) {
+        if (!SDL_AllocateSurfacePixels(surface, size)) {
             SDL_DestroySurface(surface);
             return NULL;
         }
-        surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
 
         // This is important for bitmaps
         SDL_memset(surface->pixels, 0, size);
@@ -286,6 +306,98 @@ SDL_Surface *SDL_CreateSurfaceFrom(int width, int height, SDL_PixelFormat format
     return surface;
 }
 
+/*
+ * Create a surface referring to a rectangle of another surface's pixels
+ */
+SDL_Surface *SDL_CreateSurfaceView(SDL_Surface *surface, const SDL_Rect *rect)
+{
+    SDL_Rect area;
+    SDL_Surface *view;
+    Uint8 *pixels;
+    int bits;
+
+    CHECK_PARAM(!SDL_SurfaceValid(surface)) {
+        SDL_InvalidParamError("surface");
+        return NULL;
+    }
+
+    if (rect) {
+        area = *rect;
+    } else {
+        area.x = 0;
+        area.y = 0;
+        area.w = surface->w;
+        area.h = surface->h;
+    }
+
+    CHECK_PARAM(area.x < 0 || area.y < 0 || area.w < 0 || area.h < 0 ||
+                area.w > surface->w - area.x || area.h > surface->h - area.y) {
+        SDL_InvalidParamError("rect");
+        return NULL;
+    }
+
+    if (SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
+        SDL_SetError("Views aren't supported for FOURCC formats");
+        return NULL;
+    }
+
+    bits = SDL_BITSPERPIXEL(surface->format);
+    if (bits < 8 && ((area.x * bits) % 8) != 0) {
+        SDL_SetError("View must start on a byte boundary");
+        return NULL;
+    }
+
+#ifdef SDL_HAVE_RLE
+    // The view needs the decoded pixels, and they stay decoded while it exists
+    if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+        SDL_UnRLESurface(surface, true);
+    }
+#endif
+
+    // The view writes directly to the pixels, so they can't be shared
+    if (!SDL_MakeSurfaceWritable(surface)) {
+        return NULL;
+    }
+
+    pixels = (Uint8 *)surface->pixels;
+    if (pixels) {
+        pixels += (size_t)area.y * surface->pitch + ((size_t)area.x * bits) / 8;
+    }
+
+    view = SDL_CreateSurfaceFrom(area.w, area.h, surface->format, pixels, surface->pitch);
+    if (!view) {
+        return NULL;
+    }
+
+    // Inherit the parent's surface state
+    if (surface->palette) {
+        SDL_SetSurfacePalette(view, surface->palette);
+    }
+    SDL_SetSurfaceColorspace(view, surface->colorspace);
+    view->map.info.r = surface->map.info.r;
+    view->map.info.g = surface->map.info.g;
+    view->map.info.b = surface->map.info.b;
+    view->map.info.a = surface->map.info.a;
+    view->map.info.colorkey = surface->map.info.colorkey;
+    view->map.info.flags = (surface->map.info.flags & ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
+    SDL_InvalidateMap(&view->map);
+    SDL_UpdateSurfaceLockFlag(view);
+    if (surface->props) {
+        if (!SDL_CopyProperties(surface->props, SDL_GetSurfaceProperties(view))) {
+            SDL_DestroySurface(view);
+            return NULL;
+        }
+        SDL_ClearProperty(SDL_GetSurfaceProperties(view), "sdl2-compat.surface2");
+    }
+
+    // Keep the parent, and with it the pixels, alive as long as the view
+    ++surface->refcount;
+    ++surface->num_views;
+    view->view_parent = surface;
+
+    return view;
+}
+
 SDL_PropertiesID SDL_GetSurfaceProperties(SDL_Surface *surface)
 {
     CHECK_PARAM(!SDL_SurfaceValid(surface)) {
@@ -1010,6 +1122,10 @@ bool SDL_BlitSurfaceUnchecked(SDL_Surface *src, const SDL_Rect *srcrect,
     if (!SDL_ValidateMap(src, dst)) {
         return false;
     }
+    if (!SDL_MakeSurfaceWritable(dst)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(dst, dstrect);
     return src->map.blit(src, srcrect, dst, dstrect);
 }
 
@@ -1207,7 +1323,7 @@ bool SDL_BlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surfac
     }
 
     if (SDL_MUSTLOCK(src)) {
-        if (!SDL_LockSurface(src)) {
+        if (!SDL_LockSurfaceReadOnly(src)) {
             return false;
         }
     }
@@ -1254,17 +1370,23 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             src->format == dst->format &&
             !SDL_ISPIXELFORMAT_INDEXED(src->format) &&
             SDL_BYTESPERPIXEL(src->format) <= 4) {
+            SDL_LogBlitPath(true, src->format, dst->format, "nearest stretch");
             return SDL_StretchSurface(src, srcrect, dst, dstrect, SDL_SCALEMODE_NEAREST);
         } else if (SDL_BITSPERPIXEL(src->format) < 8) {
             // Scaling bitmap not yet supported, convert to RGBA for blit
             bool result = false;
-            SDL_Surface *tmp = SDL_ConvertSurface(src, SDL_PIXELFORMAT_ARGB8888);
+            SDL_Surface *tmp;
+
+            SDL_LogBlitPath(true, src->format, dst->format, "conversion to ARGB8888");
+            tmp = SDL_ConvertSurface(src, SDL_PIXELFORMAT_ARGB8888);
             if (tmp) {
                 result = SDL_BlitSurfaceUncheckedScaled(tmp, srcrect, dst, dstrect, SDL_SCALEMODE_NEAREST);
                 SDL_DestroySurface(tmp);
             }
             return result;
         } else {
+            // The blitter does the scaling
+            SDL_LogBlitPath(true, src->format, dst->format, "nearest blitter");
             return SDL_BlitSurfaceUnchecked(src, srcrect, dst, dstrect);
         }
     } else {
@@ -1274,11 +1396,15 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             SDL_BYTESPERPIXEL(src->format) == 4 &&
             src->format != SDL_PIXELFORMAT_ARGB2101010) {
             // fast path
+            SDL_LogBlitPath(true, src->format, dst->format, "linear stretch");
             return SDL_StretchSurface(src, srcrect, dst, dstrect, SDL_SCALEMODE_LINEAR);
         } else if (SDL_BITSPERPIXEL(src->format) < 8) {
             // Scaling bitmap not yet supported, convert to RGBA for blit
             bool result = false;
-            SDL_Surface *tmp = SDL_ConvertSurface(src, SDL_PIXELFORMAT_ARGB8888);
+            SDL_Surface *tmp;
+
+            SDL_LogBlitPath(true, src->format, dst->format, "conversion to ARGB8888");
+            tmp = SDL_ConvertSurface(src, SDL_PIXELFORMAT_ARGB8888);
             if (tmp) {
                 result = SDL_BlitSurfaceUncheckedScaled(tmp, srcrect, dst, dstrect, scaleMode);
                 SDL_DestroySurface(tmp);
@@ -1290,6 +1416,8 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             bool result;
             SDL_Rect srcrect2;
             int is_complex_copy_flags = (src->map.info.flags & complex_copy_flags);
+            const bool convert = (SDL_BYTESPERPIXEL(src->format) != 4 || src->format == SDL_PIXELFORMAT_ARGB2101010);
+            SDL_PixelFormat src_format = src->format;
 
             Uint8 r, g, b;
             Uint8 alpha;
@@ -1305,7 +1433,7 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             srcrect2.h = srcrect->h;
 
             // Change source format if not appropriate for scaling
-            if (SDL_BYTESPERPIXEL(src->format) != 4 || src->format == SDL_PIXELFORMAT_ARGB2101010) {
+            if (convert) {
                 SDL_Rect tmprect;
                 SDL_PixelFormat fmt;
                 tmprect.x = 0;
@@ -1332,7 +1460,10 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             // Intermediate scaling
             if (is_complex_copy_flags || src->format != dst->format) {
                 SDL_Rect tmprect;
-                SDL_Surface *tmp2 = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
+                SDL_Surface *tmp2;
+
+                SDL_LogBlitPath(true, src_format, dst->format, convert ? "conversion, linear stretch and blit" : "linear stretch and blit");
+                tmp2 = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
                 SDL_StretchSurface(src, &srcrect2, tmp2, NULL, SDL_SCALEMODE_LINEAR);
 
                 SDL_SetSurfaceColorMod(tmp2, r, g, b);
@@ -1346,6 +1477,7 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
                 result = SDL_BlitSurfaceUnchecked(tmp2, &tmprect, dst, dstrect);
                 SDL_DestroySurface(tmp2);
             } else {
+                SDL_LogBlitPath(true, src_format, dst->format, convert ? "conversion and linear stretch" : "linear stretch");
                 result = SDL_StretchSurface(src, &srcrect2, dst, dstrect, SDL_SCALEMODE_LINEAR);
             }
 
@@ -1722,13 +1854,17 @@ bool SDL_BlitSurface9Grid(SDL_Surface *src, const SDL_Rect *srcrect, int left_wi
 /*
  * Lock a surface to directly access the pixels
  */
-bool SDL_LockSurface(SDL_Surface *surface)
+static bool SDL_LockSurfaceInternal(SDL_Surface *surface, bool writable)
 {
     CHECK_PARAM(!SDL_SurfaceValid(surface)) {
         return SDL_InvalidParamError("surface");
     }
 
     if (!surface->locked) {
+        if (writable && !SDL_MakeSurfaceWritable(surface)) {
+            return false;
+        }
+
 #ifdef SDL_HAVE_RLE
         // Perform the lock
         if (surface->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
@@ -1747,6 +1883,21 @@ bool SDL_LockSurface(SDL_Surface *surface)
     return true;
 }
 
+bool SDL_LockSurface(SDL_Surface *surface)
+{
+    // The caller may write to the pixels
+    return SDL_LockSurfaceInternal(surface, true);
+}
+
+/*
+ * Lock a surface for reading, this leaves pixels shared with duplicated
+ * surfaces alone, so the caller must not modify them.
+ */
+bool SDL_LockSurfaceReadOnly(SDL_Surface *surface)
+{
+    return SDL_LockSurfaceInternal(surface, false);
+}
+
 /*
  * Unlock a previously locked surface
  */
@@ -1848,6 +1999,10 @@ bool SDL_FlipSurface(SDL_Surface *surface, SDL_FlipMode flip)
     if (!surface->pixels) {
         return true;
     }
+    if (!SDL_MakeSurfaceWritable(surface)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(surface, NULL);
 
     bool result = true;
     switch (flip) {
@@ -2203,6 +2358,92 @@ SDL_Surface *SDL_RotateSurface(SDL_Surface *surface, float angle)
     return rotated;
 }
 
+/*
+ * Create a surface sharing the pixels of another surface, copy-on-write.
+ * Returns NULL without setting an error if the surface can't be shared.
+ */
+static SDL_Surface *SDL_DuplicateSurfaceShared(SDL_Surface *surface)
+{
+    SDL_SharedSurfacePixels *shared;
+    SDL_Surface *duplicate;
+    Uint32 copy_flags = surface->map.info.flags;
+
+    // Only pixels owned by the surface can be shared, colorkeyed surfaces
+    // may have their pixels modified by SDL_ConvertSurface(), and views
+    // write directly to the pixels of their parent
+    if (!surface->pixels || surface->num_views > 0 ||
+        (surface->flags & SDL_SURFACE_PREALLOCATED) ||
+        (surface->internal_flags & (SDL_INTERNAL_SURFACE_STACK | SDL_INTERNAL_SURFACE_RLEACCEL)) ||
+        SDL_ISPIXELFORMAT_FOURCC(surface->format) ||
+        (copy_flags & SDL_COPY_COLORKEY)) {
+        return NULL;
+    }
+
+    duplicate = SDL_CreateSurfaceFrom(surface->w, surface->h, surface->format, surface->pixels, surface->pitch);
+    if (!duplicate) {
+        return NULL;
+    }
+
+    if (!(surface->internal_flags & SDL_INTERNAL_SURFACE_SHARED)) {
+        shared = (SDL_SharedSurfacePixels *)SDL_malloc(sizeof(*shared));
+        if (!shared) {
+            SDL_DestroySurface(duplicate);
+            return NULL;
+        }
+        SDL_SetAtomicInt(&shared->refcount, 1);
+        shared->pixels = surface->pixels;
+        shared->flags = (surface->flags & SDL_SURFACE_SIMD_ALIGNED);
+        shared->internal_flags = (surface->internal_flags & SDL_INTERNAL_SURFACE_POOLED);
+        surface->internal_flags |= SDL_INTERNAL_SURFACE_SHARED;
+        surface->internal_flags &= ~SDL_INTERNAL_SURFACE_POOLED;
+        surface->shared_pixels = shared;
+    }
+    shared = surface->shared_pixels;
+    SDL_AtomicIncRef(&shared->refcount);
+
+    duplicate->flags &= ~SDL_SURFACE_PREALLOCATED;
+    duplicate->flags |= shared->flags;
+    duplicate->internal_flags |= SDL_INTERNAL_SURFACE_SHARED;
+    duplicate->shared_pixels = shared;
+
+    // Copy the surface state the same way SDL_ConvertSurface() would
+    if (surface->palette) {
+        SDL_SetSurfacePalette(duplicate, surface->palette);
+    }
+    SDL_SetSurfaceColorspace(duplicate, surface->colorspace);
+    duplicate->map.info.r = surface->map.info.r;
+    duplicate->map.info.g = surface->map.info.g;
+    duplicate->map.info.b = surface->map.info.b;
+    duplicate->map.info.a = surface->map.info.a;
+    duplicate->map.info.flags =
+        (copy_flags &
+         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND | SDL_COPY_RLE_DESIRED | SDL_COPY_RLE_COLORKEY |
+           SDL_COPY_RLE_ALPHAKEY));
+    SDL_InvalidateMap(&duplicate->map);
+    SDL_SetSurfaceClipRect(duplicate, &surface->clip_rect);
+    if (SDL_ISPIXELFORMAT_ALPHA(surface->format) ||
+        (copy_flags & SDL_COPY_MODULATE_ALPHA)) {
+        SDL_SetSurfaceBlendMode(duplicate, SDL_BLENDMODE_BLEND);
+    }
+    if (copy_flags & SDL_COPY_RLE_DESIRED) {
+        SDL_SetSurfaceRLE(duplicate, true);
+    }
+    for (int i = 0; i < surface->num_images; ++i) {
+        if (!SDL_AddSurfaceAlternateImage(duplicate, surface->images[i])) {
+            SDL_DestroySurface(duplicate);
+            return NULL;
+        }
+    }
+    if (surface->props) {
+        if (!SDL_CopyProperties(surface->props, SDL_GetSurfaceProperties(duplicate))) {
+            SDL_DestroySurface(duplicate);
+            return NULL;
+        }
+        SDL_ClearProperty(SDL_GetSurfaceProperties(duplicate), "sdl2-compat.surface2");
+    }
+    return duplicate;
+}
+
 SDL_Surface *SDL_DuplicateSurface(SDL_Surface *surface)
 {
     CHECK_PARAM(!SDL_SurfaceValid(surface)) {
@@ -2210,6 +2451,13 @@ SDL_Surface *SDL_DuplicateSurface(SDL_Surface *surface)
         return NULL;
     }
 
+    if (SDL_GetHintBoolean(SDL_HINT_SURFACE_DUPLICATE_COPY_ON_WRITE, false)) {
+        SDL_Surface *duplicate = SDL_DuplicateSurfaceShared(surface);
+        if (duplicate) {
+            return duplicate;
+        }
+    }
+
     return SDL_ConvertSurfaceAndColorspace(surface, surface->format, surface->palette, surface->colorspace, surface->props);
 }
 
@@ -2438,11 +2686,53 @@ bool SDL_ConvertPixels(int width, int height, SDL_PixelFormat src_format, const
 /*
  * Premultiply the alpha on a block of pixels
  *
- * Here are some ideas for optimization:
+ * The 8888 formats have SSE2, AVX2 and NEON kernels, and the 128-bit float
+ * format used by the linear path has SSE and NEON kernels. The results are
+ * bit-identical to the scalar code, so the kernels can be selected at runtime.
+ *
+ * Here are some ideas for further optimization:
  * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
  * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
  */
 
+static SDL_INLINE Uint32 SDL_PremultiplyPixel8888(Uint32 pixel, int alpha_shift)
+{
+    const Uint32 srcA = (pixel >> alpha_shift) & 0xFF;
+    Uint32 dstpixel = (srcA << alpha_shift);
+    int shift;
+
+    for (shift = 0; shift < 32; shift += 8) {
+        if (shift != alpha_shift) {
+            const Uint32 srcC = (pixel >> shift) & 0xFF;
+            dstpixel |= ((srcA * srcC) / 255) << shift;
+        }
+    }
+    return dstpixel;
+}
+
+static SDL_INLINE Uint32 SDL_UnpremultiplyPixel8888(Uint32 pixel, int alpha_shift)
+{
+    const Uint32 srcA = (pixel >> alpha_shift) & 0xFF;
+    Uint32 dstpixel = (srcA << alpha_shift);
+    int shift;
+
+    if (srcA == 0) {
+        return dstpixel;
+    }
+
+    for (shift = 0; shift < 32; shift += 8) {
+        if (shift != alpha_shift) {
+            const float srcC = (float)((pixel >> shift) & 0xFF);
+            Uint32 dstC = (Uint32)((srcC * 255.0f) / (float)srcA + 0.5f);
+            if (dstC > 255) {
+                dstC = 255;
+            }
+            dstpixel |= dstC << shift;
+        }
+    }
+    return dstpixel;
+}
+
 static void SDL_PremultiplyAlpha_AXYZ8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
 {
     int c;
@@ -2505,147 +2795,688 @@ static void SDL_PremultiplyAlpha_XYZA8888(int width, int height, const void *src
     }
 }
 
-static void SDL_PremultiplyAlpha_AXYZ128(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+static void SDL_UnpremultiplyAlpha_8888_Scalar(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
 {
     int c;
-    float flR, flG, flB, flA;
 
     while (height--) {
-        const float *src_px = (const float *)src;
-        float *dst_px = (float *)dst;
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
         for (c = width; c; --c) {
-            flA = *src_px++;
-            flR = *src_px++;
-            flG = *src_px++;
-            flB = *src_px++;
-
-            // Alpha pre-multiplication of each component.
-            flR *= flA;
-            flG *= flA;
-            flB *= flA;
-
-            *dst_px++ = flA;
-            *dst_px++ = flR;
-            *dst_px++ = flG;
-            *dst_px++ = flB;
+            *dst_px++ = SDL_UnpremultiplyPixel8888(*src_px++, alpha_shift);
         }
         src = (const Uint8 *)src + src_pitch;
         dst = (Uint8 *)dst + dst_pitch;
     }
 }
 
-static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch, bool linear)
+#ifdef SDL_SSE2_INTRINSICS
+
+static void SDL_TARGETING("sse2") SDL_PremultiplyAlpha_8888_SSE2(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
 {
-    SDL_Surface *convert = NULL;
-    void *final_dst = dst;
-    int final_dst_pitch = dst_pitch;
-    SDL_PixelFormat format;
-    SDL_Colorspace colorspace;
-    bool result = false;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha_mask = _mm_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m128i alpha_shift128 = _mm_cvtsi32_si128(alpha_shift);
 
-    CHECK_PARAM(!src) {
-        return SDL_InvalidParamError("src");
-    }
-    CHECK_PARAM(!src_pitch) {
-        return SDL_InvalidParamError("src_pitch");
-    }
-    CHECK_PARAM(!dst) {
-        return SDL_InvalidParamError("dst");
-    }
-    CHECK_PARAM(!dst_pitch) {
-        return SDL_InvalidParamError("dst_pitch");
-    }
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        int i = 0;
 
-    // Use a high precision format if we're converting to linear colorspace or using high precision pixel formats
-    if (linear ||
-        SDL_ISPIXELFORMAT_10BIT(src_format) || SDL_BITSPERPIXEL(src_format) > 32 ||
-        SDL_ISPIXELFORMAT_10BIT(dst_format) || SDL_BITSPERPIXEL(dst_format) > 32) {
-        if (src_format == SDL_PIXELFORMAT_ARGB128_FLOAT ||
-            src_format == SDL_PIXELFORMAT_ABGR128_FLOAT) {
-            format = src_format;
-        } else {
-            format = SDL_PIXELFORMAT_ARGB128_FLOAT;
-        }
-    } else {
-        if (src_format == SDL_PIXELFORMAT_ARGB8888 ||
-            src_format == SDL_PIXELFORMAT_ABGR8888 ||
-            src_format == SDL_PIXELFORMAT_RGBA8888 ||
-            src_format == SDL_PIXELFORMAT_BGRA8888) {
-            format = src_format;
-        } else {
-            format = SDL_PIXELFORMAT_ARGB8888;
-        }
-    }
-    if (linear) {
-        colorspace = SDL_COLORSPACE_SRGB_LINEAR;
-    } else {
-        colorspace = SDL_COLORSPACE_SRGB;
-    }
+        for (; i + 4 <= width; i += 4) {
+            __m128i px = _mm_loadu_si128((const __m128i *)src_px);
 
-    if (src_format != format || src_colorspace != colorspace) {
-        convert = SDL_CreateSurface(width, height, format);
-        if (!convert) {
-            goto done;
-        }
-        if (!SDL_ConvertPixelsAndColorspace(width, height, src_format, src_colorspace, src_properties, src, src_pitch, format, colorspace, 0, convert->pixels, convert->pitch)) {
-            goto done;
-        }
+            // Splat the alpha of each pixel into all four of its bytes
+            __m128i a = _mm_srl_epi32(_mm_and_si128(px, alpha_mask), alpha_shift128);
+            a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+            a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
 
-        src = convert->pixels;
-        src_pitch = convert->pitch;
-        dst = convert->pixels;
-        dst_pitch = convert->pitch;
+            // Widen to 16 bits and multiply each component by alpha
+            __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), _mm_unpacklo_epi8(a, zero));
+            __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), _mm_unpackhi_epi8(a, zero));
 
-    } else if (dst_format != format || dst_colorspace != colorspace) {
-        convert = SDL_CreateSurface(width, height, format);
-        if (!convert) {
-            goto done;
-        }
-        dst = convert->pixels;
-        dst_pitch = convert->pitch;
-    }
+            // x / 255 = ((x + 1) * 257) >> 16, exact for x <= 255 * 255
+            lo = _mm_mulhi_epu16(_mm_add_epi16(lo, _mm_set1_epi16(1)), _mm_set1_epi16(257));
+            hi = _mm_mulhi_epu16(_mm_add_epi16(hi, _mm_set1_epi16(1)), _mm_set1_epi16(257));
 
-    switch (format) {
-    case SDL_PIXELFORMAT_ARGB8888:
-    case SDL_PIXELFORMAT_ABGR8888:
-        SDL_PremultiplyAlpha_AXYZ8888(width, height, src, src_pitch, dst, dst_pitch);
-        break;
-    case SDL_PIXELFORMAT_RGBA8888:
-    case SDL_PIXELFORMAT_BGRA8888:
-        SDL_PremultiplyAlpha_XYZA8888(width, height, src, src_pitch, dst, dst_pitch);
-        break;
-    case SDL_PIXELFORMAT_ARGB128_FLOAT:
-    case SDL_PIXELFORMAT_ABGR128_FLOAT:
-        SDL_PremultiplyAlpha_AXYZ128(width, height, src, src_pitch, dst, dst_pitch);
-        break;
-    default:
-        SDL_SetError("Unexpected internal pixel format");
-        goto done;
-    }
+            // Pack the result and put the original alpha back
+            px = _mm_or_si128(_mm_andnot_si128(alpha_mask, _mm_packus_epi16(lo, hi)), _mm_and_si128(px, alpha_mask));
+            _mm_storeu_si128((__m128i *)dst_px, px);
 
-    if (dst != final_dst) {
-        if (!SDL_ConvertPixelsAndColorspace(width, height, format, colorspace, 0, convert->pixels, convert->pitch, dst_format, dst_colorspace, dst_properties, final_dst, final_dst_pitch)) {
-            goto done;
+            src_px += 4;
+            dst_px += 4;
         }
-    }
-    result = true;
 
-done:
-    if (convert) {
-        SDL_DestroySurface(convert);
+        for (; i < width; ++i) {
+            *dst_px++ = SDL_PremultiplyPixel8888(*src_px++, alpha_shift);
+        }
+
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
     }
-    return result;
 }
 
-bool SDL_PremultiplyAlpha(int width, int height,
-                         SDL_PixelFormat src_format, const void *src, int src_pitch,
-                         SDL_PixelFormat dst_format, void *dst, int dst_pitch, bool linear)
+static void SDL_TARGETING("sse2") SDL_UnpremultiplyAlpha_8888_SSE2(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
 {
-    SDL_Colorspace src_colorspace = SDL_GetDefaultColorspaceForFormat(src_format);
-    SDL_Colorspace dst_colorspace = SDL_GetDefaultColorspaceForFormat(dst_format);
-
-    return SDL_PremultiplyAlphaPixelsAndColorspace(width, height, src_format, src_colorspace, 0, src, src_pitch, dst_format, dst_colorspace, 0, dst, dst_pitch, linear);
-}
+    const __m128i byte_mask = _mm_set1_epi32(0xFF);
+    const __m128i alpha_mask = _mm_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 max = _mm_set1_ps(255.0f);
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        int i = 0;
+
+        for (; i + 4 <= width; i += 4) {
+            const __m128i px = _mm_loadu_si128((const __m128i *)src_px);
+            const __m128 a = _mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(px, _mm_cvtsi32_si128(alpha_shift)), byte_mask));
+            const __m128 valid = _mm_cmpneq_ps(a, zero);
+            __m128i out = _mm_and_si128(px, alpha_mask);
+            int shift;
+
+            for (shift = 0; shift < 32; shift += 8) {
+                if (shift != alpha_shift) {
+                    const __m128i shift128 = _mm_cvtsi32_si128(shift);
+                    __m128 c = _mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(px, shift128), byte_mask));
+
+                    // Same operation order as the scalar code, so the rounding matches
+                    c = _mm_div_ps(_mm_mul_ps(c, max), a);
+                    c = _mm_and_ps(_mm_min_ps(_mm_add_ps(c, half), max), valid);
+                    out = _mm_or_si128(out, _mm_sll_epi32(_mm_cvttps_epi32(c), shift128));
+                }
+            }
+            _mm_storeu_si128((__m128i *)dst_px, out);
+
+            src_px += 4;
+            dst_px += 4;
+        }
+
+        for (; i < width; ++i) {
+            *dst_px++ = SDL_UnpremultiplyPixel8888(*src_px++, alpha_shift);
+        }
+
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_AVX2_INTRINSICS
+
+static void SDL_TARGETING("avx2") SDL_PremultiplyAlpha_8888_AVX2(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alpha_mask = _mm256_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m128i alpha_shift128 = _mm_cvtsi32_si128(alpha_shift);
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            __m256i px = _mm256_loadu_si256((const __m256i *)src_px);
+
+            // Splat the alpha of each pixel into all four of its bytes
+            __m256i a = _mm256_srl_epi32(_mm256_and_si256(px, alpha_mask), alpha_shift128);
+            a = _mm256_or_si256(a, _mm256_slli_epi32(a, 8));
+            a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+
+            // Widen to 16 bits and multiply each component by alpha
+            __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(px, zero), _mm256_unpacklo_epi8(a, zero));
+            __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(px, zero), _mm256_unpackhi_epi8(a, zero));
+
+            // x / 255 = ((x + 1) * 257) >> 16, exact for x <= 255 * 255
+            lo = _mm256_mulhi_epu16(_mm256_add_epi16(lo, _mm256_set1_epi16(1)), _mm256_set1_epi16(257));
+            hi = _mm256_mulhi_epu16(_mm256_add_epi16(hi, _mm256_set1_epi16(1)), _mm256_set1_epi16(257));
+
+            // Pack the result (in-lane, so the pixel order is preserved) and put the original alpha back
+            px = _mm256_or_si256(_mm256_andnot_si256(alpha_mask, _mm256_packus_epi16(lo, hi)), _mm256_and_si256(px, alpha_mask));
+            _mm256_storeu_si256((__m256i *)dst_px, px);
+
+            src_px += 8;
+            dst_px += 8;
+        }
+
+        for (; i < width; ++i) {
+            *dst_px++ = SDL_PremultiplyPixel8888(*src_px++, alpha_shift);
+        }
+
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_UnpremultiplyAlpha_8888_AVX2(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+    const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+    const __m256i alpha_mask = _mm256_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 max = _mm256_set1_ps(255.0f);
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            const __m256i px = _mm256_loadu_si256((const __m256i *)src_px);
+            const __m256 a = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(px, _mm_cvtsi32_si128(alpha_shift)), byte_mask));
+            const __m256 valid = _mm256_cmp_ps(a, zero, _CMP_NEQ_UQ);
+            __m256i out = _mm256_and_si256(px, alpha_mask);
+            int shift;
+
+            for (shift = 0; shift < 32; shift += 8) {
+                if (shift != alpha_shift) {
+                    const __m128i shift128 = _mm_cvtsi32_si128(shift);
+                    __m256 c = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(px, shift128), byte_mask));
+
+                    // Same operation order as the scalar code, so the rounding matches
+                    c = _mm256_div_ps(_mm256_mul_ps(c, max), a);
+                    c = _mm256_and_ps(_mm256_min_ps(_mm256_add_ps(c, half), max), valid);
+                    out = _mm256_or_si256(out, _mm256_sll_epi32(_mm256_cvttps_epi32(c), shift128));
+                }
+            }
+            _mm256_storeu_si256((__m256i *)dst_px, out);
+
+            src_px += 8;
+            dst_px += 8;
+        }
+
+        for (; i < width; ++i) {
+            *dst_px++ = SDL_UnpremultiplyPixel8888(*src_px++, alpha_shift);
+        }
+
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+#endif // SDL_AVX2_INTRINSICS
+
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+
+static void SDL_PremultiplyAlpha_8888_NEON(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+    const int alpha_index = alpha_shift / 8;
+    const uint16x8_t one = vdupq_n_u16(1);
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        int i = 0;
+
+        for (; i + 16 <= width; i += 16) {
+            // Deinterleave 16 pixels into one vector per byte position
+            uint8x16x4_t px = vld4q_u8((const uint8_t *)src_px);
+            const uint8x16_t a = px.val[alpha_index];
+            int j;
+
+            for (j = 0; j < 4; ++j) {
+                if (j != alpha_index) {
+                    // x / 255 = (x + 1 + ((x + 1) >> 8)) >> 8, exact for x <= 255 * 255
+                    uint16x8_t lo = vaddq_u16(vmull_u8(vget_low_u8(px.val[j]), vget_low_u8(a)), one);
+                    uint16x8_t hi = vaddq_u16(vmull_u8(vget_high_u8(px.val[j]), vget_high_u8(a)), one);
+                    lo = vsraq_n_u16(lo, lo, 8);
+                    hi = vsraq_n_u16(hi, hi, 8);
+                    px.val[j] = vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+                }
+            }
+            vst4q_u8((uint8_t *)dst_px, px);
+
+            src_px += 16;
+            dst_px += 16;
+        }
+
+        for (; i < width; ++i) {
+            *dst_px++ = SDL_PremultiplyPixel8888(*src_px++, alpha_shift);
+        }
+
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+#if defined(__aarch64__) || defined(_M_ARM64) // vdivq_f32() is only available on 64-bit ARM
+
+static void SDL_UnpremultiplyAlpha_8888_NEON(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+    const uint32x4_t byte_mask = vdupq_n_u32(0xFF);
+    const uint32x4_t alpha_mask = vdupq_n_u32(0xFFu << alpha_shift);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t max = vdupq_n_f32(255.0f);
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        int i = 0;
+
+        for (; i + 4 <= width; i += 4) {
+            const uint32x4_t px = vld1q_u32(src_px);
+            const float32x4_t a = vcvtq_f32_u32(vandq_u32(vshlq_u32(px, vdupq_n_s32(-alpha_shift)), byte_mask));
+            const uint32x4_t valid = vmvnq_u32(vceqq_f32(a, vdupq_n_f32(0.0f)));
+            uint32x4_t out = vandq_u32(px, alpha_mask);
+            int shift;
+
+            for (shift = 0; shift < 32; shift += 8) {
+                if (shift != alpha_shift) {
+                    float32x4_t c = vcvtq_f32_u32(vandq_u32(vshlq_u32(px, vdupq_n_s32(-shift)), byte_mask));
+
+                    // Same operation order as the scalar code, so the rounding matches
+                    c = vdivq_f32(vmulq_f32(c, max), a);
+                    c = vminq_f32(vaddq_f32(c, half), max);
+                    out = vorrq_u32(out, vshlq_u32(vandq_u32(vcvtq_u32_f32(c), valid), vdupq_n_s32(shift)));
+                }
+            }
+            vst1q_u32(dst_px, out);
+
+            src_px += 4;
+            dst_px += 4;
+        }
+
+        for (; i < width; ++i) {
+            *dst_px++ = SDL_UnpremultiplyPixel8888(*src_px++, alpha_shift);
+        }
+
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+#endif // __aarch64__ || _M_ARM64
+
+#endif // SDL_NEON_INTRINSICS && __ARM_ARCH >= 8
+
+static void SDL_PremultiplyAlpha_8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SDL_PremultiplyAlpha_8888_AVX2(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+        return;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SDL_PremultiplyAlpha_8888_SSE2(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+        return;
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+    SDL_PremultiplyAlpha_8888_NEON(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+    return;
+#endif
+    if (alpha_shift == 24) {
+        SDL_PremultiplyAlpha_AXYZ8888(width, height, src, src_pitch, dst, dst_pitch);
+    } else {
+        SDL_PremultiplyAlpha_XYZA8888(width, height, src, src_pitch, dst, dst_pitch);
+    }
+}
+
+static void SDL_UnpremultiplyAlpha_8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SDL_UnpremultiplyAlpha_8888_AVX2(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+        return;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SDL_UnpremultiplyAlpha_8888_SSE2(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+        return;
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8) && (defined(__aarch64__) || defined(_M_ARM64))
+    SDL_UnpremultiplyAlpha_8888_NEON(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+    return;
+#endif
+    SDL_UnpremultiplyAlpha_8888_Scalar(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+}
+
+static void SDL_PremultiplyAlpha_AXYZ128_Scalar(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+    int c;
+    float flR, flG, flB, flA;
+
+    while (height--) {
+        const float *src_px = (const float *)src;
+        float *dst_px = (float *)dst;
+        for (c = width; c; --c) {
+            flA = *src_px++;
+            flR = *src_px++;
+            flG = *src_px++;
+            flB = *src_px++;
+
+            // Alpha pre-multiplication of each component.
+            flR *= flA;
+            flG *= flA;
+            flB *= flA;
+
+            *dst_px++ = flA;
+            *dst_px++ = flR;
+            *dst_px++ = flG;
+            *dst_px++ = flB;
+        }
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+static void SDL_UnpremultiplyAlpha_AXYZ128_Scalar(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+    int c;
+    float flR, flG, flB, flA;
+
+    while (height--) {
+        const float *src_px = (const float *)src;
+        float *dst_px = (float *)dst;
+        for (c = width; c; --c) {
+            flA = *src_px++;
+            flR = *src_px++;
+            flG = *src_px++;
+            flB = *src_px++;
+
+            // Alpha un-pre-multiplication of each component.
+            if (flA != 0.0f) {
+                flR /= flA;
+                flG /= flA;
+                flB /= flA;
+            } else {
+                flR = flG = flB = 0.0f;
+            }
+
+            *dst_px++ = flA;
+            *dst_px++ = flR;
+            *dst_px++ = flG;
+            *dst_px++ = flB;
+        }
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+#ifdef SDL_SSE_INTRINSICS
+
+static void SDL_TARGETING("sse") SDL_PremultiplyAlpha_AXYZ128_SSE(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+    int c;
+
+    while (height--) {
+        const float *src_px = (const float *)src;
+        float *dst_px = (float *)dst;
+        for (c = width; c; --c) {
+            const __m128 px = _mm_loadu_ps(src_px);
+            const __m128 a = _mm_shuffle_ps(px, px, _MM_SHUFFLE(0, 0, 0, 0));
+
+            // Multiply everything by alpha, then put the original alpha back in lane 0
+            _mm_storeu_ps(dst_px, _mm_move_ss(_mm_mul_ps(px, a), px));
+
+            src_px += 4;
+            dst_px += 4;
+        }
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse") SDL_UnpremultiplyAlpha_AXYZ128_SSE(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+    const __m128 zero = _mm_setzero_ps();
+    int c;
+
+    while (height--) {
+        const float *src_px = (const float *)src;
+        float *dst_px = (float *)dst;
+        for (c = width; c; --c) {
+            const __m128 px = _mm_loadu_ps(src_px);
+            const __m128 a = _mm_shuffle_ps(px, px, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 q = _mm_and_ps(_mm_div_ps(px, a), _mm_cmpneq_ps(a, zero));
+
+            // Put the original alpha back in lane 0
+            _mm_storeu_ps(dst_px, _mm_move_ss(q, px));
+
+            src_px += 4;
+            dst_px += 4;
+        }
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+#endif // SDL_SSE_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+
+static void SDL_PremultiplyAlpha_AXYZ128_NEON(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+    while (height--) {
+        const float *src_px = (const float *)src;
+        float *dst_px = (float *)dst;
+        int i = 0;
+
+        for (; i + 4 <= width; i += 4) {
+            // Deinterleave 4 pixels, val[0] holds the alpha
+            float32x4x4_t px = vld4q_f32(src_px);
+            px.val[1] = vmulq_f32(px.val[1], px.val[0]);
+            px.val[2] = vmulq_f32(px.val[2], px.val[0]);
+            px.val[3] = vmulq_f32(px.val[3], px.val[0]);
+            vst4q_f32(dst_px, px);
+
+            src_px += 16;
+            dst_px += 16;
+        }
+
+        if (i < width) {
+            SDL_PremultiplyAlpha_AXYZ128_Scalar(width - i, 1, src_px, 0, dst_px, 0);
+        }
+
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+#if defined(__aarch64__) || defined(_M_ARM64) // vdivq_f32() is only available on 64-bit ARM
+
+static void SDL_UnpremultiplyAlpha_AXYZ128_NEON(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    while (height--) {
+        const float *src_px = (const float *)src;
+        float *dst_px = (float *)dst;
+        int i = 0;
+
+        for (; i + 4 <= width; i += 4) {
+            // Deinterleave 4 pixels, val[0] holds the alpha
+            float32x4x4_t px = vld4q_f32(src_px);
+            const uint32x4_t valid = vmvnq_u32(vceqq_f32(px.val[0], zero));
+            int j;
+
+            for (j = 1; j < 4; ++j) {
+                const uint32x4_t q = vreinterpretq_u32_f32(vdivq_f32(px.val[j], px.val[0]));
+                px.val[j] = vreinterpretq_f32_u32(vandq_u32(q, valid));
+            }
+            vst4q_f32(dst_px, px);
+
+            src_px += 16;
+            dst_px += 16;
+        }
+
+        if (i < width) {
+            SDL_UnpremultiplyAlpha_AXYZ128_Scalar(width - i, 1, src_px, 0, dst_px, 0);
+        }
+
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+#endif // __aarch64__ || _M_ARM64
+
+#endif // SDL_NEON_INTRINSICS
+
+static void SDL_PremultiplyAlpha_AXYZ128(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        SDL_PremultiplyAlpha_AXYZ128_SSE(width, height, src, src_pitch, dst, dst_pitch);
+        return;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SDL_PremultiplyAlpha_AXYZ128_NEON(width, height, src, src_pitch, dst, dst_pitch);
+        return;
+    }
+#endif
+    SDL_PremultiplyAlpha_AXYZ128_Scalar(width, height, src, src_pitch, dst, dst_pitch);
+}
+
+static void SDL_UnpremultiplyAlpha_AXYZ128(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        SDL_UnpremultiplyAlpha_AXYZ128_SSE(width, height, src, src_pitch, dst, dst_pitch);
+        return;
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+    if (SDL_HasNEON()) {
+        SDL_UnpremultiplyAlpha_AXYZ128_NEON(width, height, src, src_pitch, dst, dst_pitch);
+        return;
+    }
+#endif
+    SDL_UnpremultiplyAlpha_AXYZ128_Scalar(width, height, src, src_pitch, dst, dst_pitch);
+}
+
+static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch, bool linear, bool unpremultiply)
+{
+    SDL_Surface *convert = NULL;
+    void *final_dst = dst;
+    int final_dst_pitch = dst_pitch;
+    SDL_PixelFormat format;
+    SDL_Colorspace colorspace;
+    bool result = false;
+
+    CHECK_PARAM(!src) {
+        return SDL_InvalidParamError("src");
+    }
+    CHECK_PARAM(!src_pitch) {
+        return SDL_InvalidParamError("src_pitch");
+    }
+    CHECK_PARAM(!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+    CHECK_PARAM(!dst_pitch) {
+        return SDL_InvalidParamError("dst_pitch");
+    }
+
+    // Use a high precision format if we're converting to linear colorspace or using high precision pixel formats
+    if (linear ||
+        SDL_ISPIXELFORMAT_10BIT(src_format) || SDL_BITSPERPIXEL(src_format) > 32 ||
+        SDL_ISPIXELFORMAT_10BIT(dst_format) || SDL_BITSPERPIXEL(dst_format) > 32) {
+        if (src_format == SDL_PIXELFORMAT_ARGB128_FLOAT ||
+            src_format == SDL_PIXELFORMAT_ABGR128_FLOAT) {
+            format = src_format;
+        } else {
+            format = SDL_PIXELFORMAT_ARGB128_FLOAT;
+        }
+    } else {
+        if (src_format == SDL_PIXELFORMAT_ARGB8888 ||
+            src_format == SDL_PIXELFORMAT_ABGR8888 ||
+            src_format == SDL_PIXELFORMAT_RGBA8888 ||
+            src_format == SDL_PIXELFORMAT_BGRA8888) {
+            format = src_format;
+        } else {
+            format = SDL_PIXELFORMAT_ARGB8888;
+        }
+    }
+    if (linear) {
+        colorspace = SDL_COLORSPACE_SRGB_LINEAR;
+    } else {
+        colorspace = SDL_COLORSPACE_SRGB;
+    }
+
+    if (src_format != format || src_colorspace != colorspace) {
+        convert = SDL_CreateSurface(width, height, format);
+        if (!convert) {
+            goto done;
+        }
+        if (!SDL_ConvertPixelsAndColorspace(width, height, src_format, src_colorspace, src_properties, src, src_pitch, format, colorspace, 0, convert->pixels, convert->pitch)) {
+            goto done;
+        }
+
+        src = convert->pixels;
+        src_pitch = convert->pitch;
+        dst = convert->pixels;
+        dst_pitch = convert->pitch;
+
+    } else if (dst_format != format || dst_colorspace != colorspace) {
+        convert = SDL_CreateSurface(width, height, format);
+        if (!convert) {
+            goto done;
+        }
+        dst = convert->pixels;
+        dst_pitch = convert->pitch;
+    }
+
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        if (unpremultiply) {
+            SDL_UnpremultiplyAlpha_8888(width, height, src, src_pitch, dst, dst_pitch, 24);
+        } else {
+            SDL_PremultiplyAlpha_8888(width, height, src, src_pitch, dst, dst_pitch, 24);
+        }
+        break;
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        if (unpremultiply) {
+            SDL_UnpremultiplyAlpha_8888(width, height, src, src_pitch, dst, dst_pitch, 0);
+        } else {
+            SDL_PremultiplyAlpha_8888(width, height, src, src_pitch, dst, dst_pitch, 0);
+        }
+        break;
+    case SDL_PIXELFORMAT_ARGB128_FLOAT:
+    case SDL_PIXELFORMAT_ABGR128_FLOAT:
+        if (unpremultiply) {
+            SDL_UnpremultiplyAlpha_AXYZ128(width, height, src, src_pitch, dst, dst_pitch);
+        } else {
+            SDL_PremultiplyAlpha_AXYZ128(width, height, src, src_pitch, dst, dst_pitch);
+        }
+        break;
+    default:
+        SDL_SetError("Unexpected internal pixel format");
+        goto done;
+    }
+
+    if (dst != final_dst) {
+        if (!SDL_ConvertPixelsAndColorspace(width, height, format, colorspace, 0, convert->pixels, convert->pitch, dst_format, dst_colorspace, dst_properties, final_dst, final_dst_pitch)) {
+            goto done;
+        }
+    }
+    result = true;
+
+done:
+    if (convert) {
+        SDL_DestroySurface(convert);
+    }
+    return result;
+}
+
+bool SDL_PremultiplyAlpha(int width, int height,
+                         SDL_PixelFormat src_format, const void *src, int src_pitch,
+                         SDL_PixelFormat dst_format, void *dst, int dst_pitch, bool linear)
+{
+    SDL_Colorspace src_colorspace = SDL_GetDefaultColorspaceForFormat(src_format);
+    SDL_Colorspace dst_colorspace = SDL_GetDefaultColorspaceForFormat(dst_format);
+
+    return SDL_PremultiplyAlphaPixelsAndColorspace(width, height, src_format, src_colorspace, 0, src, src_pitch, dst_format, dst_colorspace, 0, dst, dst_pitch, linear, false);
+}
 
 bool SDL_PremultiplySurfaceAlpha(SDL_Surface *surface, bool linear)
 {
@@ -2655,9 +3486,74 @@ bool SDL_PremultiplySurfaceAlpha(SDL_Surface *surface, bool linear)
         return SDL_InvalidParamError("surface");
     }
 
+    if (!SDL_MakeSurfaceWritable(surface)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(surface, NULL);
+
+    colorspace = surface->colorspace;
+
+    return SDL_PremultiplyAlphaPixelsAndColorspace(surface->w, surface->h, surface->format, colorspace, surface->props, surface->pixels, surface->pitch, surface->format, colorspace, surface->props, surface->pixels, surface->pitch, linear, false);
+}
+
+bool SDL_UnpremultiplyAlpha(int width, int height,
+                           SDL_PixelFormat src_format, const void *src, int src_pitch,
+                           SDL_PixelFormat dst_format, void *dst, int dst_pitch, bool linear)
+{
+    SDL_Colorspace src_colorspace = SDL_GetDefaultColorspaceForFormat(src_format);
+    SDL_Colorspace dst_colorspace = SDL_GetDefaultColorspaceForFormat(dst_format);
+
+    return SDL_PremultiplyAlphaPixelsAndColorspace(width, height, src_format, src_colorspace, 0, src, src_pitch, dst_format, dst_colorspace, 0, dst, dst_pitch, linear, true);
+}
+
+bool SDL_UnpremultiplySurfaceAlpha(SDL_Surface *surface, bool linear)
+{
+    SDL_Colorspace colorspace;
+
+    CHECK_PARAM(!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
+
+    if (!SDL_MakeSurfaceWritable(surface)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(surface, NULL);
+
     colorspace = surface->colorspace;
 
-    return SDL_PremultiplyAlphaPixelsAndColorspace(surface->w, surface->h, surface->format, colorspace, surface->props, surface->pixels, surface->pitch, surface->format, colorspace, surface->props, surface->pixels, surface->pitch, linear);
+    return SDL_PremultiplyAlphaPixelsAndColorspace(surface->w, surface->h, surface->format, colorspace, surface->props, surface->pixels, surface->pitch, surface->format, colorspace, surface->props, surface->pixels, surface->pitch, linear, true);
+}
+
+/*
+ * Check whether filling a surface with a color sets every byte of the pixels
+ * to the same value, which is always true for formats of 8 bits or less.
+ */
+static bool SDL_GetSurfaceFillByte(SDL_Surface *surface, Uint32 color, Uint8 *value)
+{
+    int bpp, i;
+
+    switch (SDL_BITSPERPIXEL(surface->format)) {
+    case 1:
+        *value = (color & 0x1) ? 0xFF : 0x00;
+        return true;
+    case 2:
+        *value = (Uint8)((color & 0x3) * 0x55);
+        return true;
+    case 4:
+        *value = (Uint8)((color & 0xF) * 0x11);
+        return true;
+    default:
+        break;
+    }
+
+    bpp = SDL_BYTESPERPIXEL(surface->format);
+    *value = (Uint8)color;
+    for (i = 1; i < bpp; ++i) {
+        if ((Uint8)(color >> (i * 8)) != *value) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool SDL_ClearSurface(SDL_Surface *surface, float r, float g, float b, float a)
@@ -2669,19 +3565,33 @@ bool SDL_ClearSurface(SDL_Surface *surface, float r, float g, float b, float a)
         return SDL_InvalidParamError("surface");
     }
 
+    if (!SDL_MakeSurfaceWritable(surface)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(surface, NULL);
+
     SDL_GetSurfaceClipRect(surface, &clip_rect);
     SDL_SetSurfaceClipRect(surface, NULL);
 
     if (!SDL_ISPIXELFORMAT_FOURCC(surface->format) &&
         SDL_BYTESPERPIXEL(surface->format) <= sizeof(Uint32)) {
         Uint32 color;
+        Uint8 value;
 
         color = SDL_MapSurfaceRGBA(surface,
                     (Uint8)SDL_roundf(SDL_clamp(r, 0.0f, 1.0f) * 255.0f),
                     (Uint8)SDL_roundf(SDL_clamp(g, 0.0f, 1.0f) * 255.0f),
                     (Uint8)SDL_roundf(SDL_clamp(b, 0.0f, 1.0f) * 255.0f),
                     (Uint8)SDL_roundf(SDL_clamp(a, 0.0f, 1.0f) * 255.0f));
-        result = SDL_FillSurfaceRect(surface, NULL, color);
+        if (surface->pixels && SDL_GetSurfaceFillByte(surface, color, &value) &&
+            ((!(surface->flags & SDL_SURFACE_PREALLOCATED) && !surface->view_parent) ||
+             surface->pitch == (surface->w * SDL_BITSPERPIXEL(surface->format) + 7) / 8)) {
+            // The whole buffer is ours to overwrite, clear it in one pass
+            SDL_FillSurfaceBytes(surface->pixels, value, (size_t)surface->h * surface->pitch);
+            result = true;
+        } else {
+            result = SDL_FillSurfaceRect(surface, NULL, color);
+        }
     } else if (SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
         // We can't directly set an RGB value on a YUV surface
         SDL_Surface *tmp = SDL_CreateSurface(surface->w, surface->h, SDL_PIXELFORMAT_ARGB8888);
@@ -2732,6 +3642,14 @@ Uint32 SDL_MapSurfaceRGBA(SDL_Surface *surface, Uint8 r, Uint8 g, Uint8 b, Uint8
     return SDL_MapRGBA(surface->fmt, surface->palette, r, g, b, a);
 }
 
+bool SDL_MapSurfaceRGBAArray(SDL_Surface *surface, const SDL_Color *colors, Uint32 *pixels, int count)
+{
+    CHECK_PARAM(!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
+    return SDL_MapRGBAArray(surface->fmt, surface->palette, colors, pixels, count);
+}
+
 // This function Copyright 2023 Collabora Ltd., contributed to SDL under the ZLib license
 bool SDL_ReadSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a)
 {
@@ -2780,7 +3698,7 @@ bool SDL_ReadSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 *r, Uint8 *g
     bytes_per_pixel = SDL_BYTESPERPIXEL(surface->format);
 
     if (SDL_MUSTLOCK(surface)) {
-        if (!SDL_LockSurface(surface)) {
+        if (!SDL_LockSurfaceReadOnly(surface)) {
             return false;
         }
     }
@@ -2887,7 +3805,7 @@ bool SDL_ReadSurfacePixelFloat(SDL_Surface *surface, int x, int y, float *r, flo
         Uint8 *p;
 
         if (SDL_MUSTLOCK(surface)) {
-            if (!SDL_LockSurface(surface)) {
+            if (!SDL_LockSurfaceReadOnly(surface)) {
                 return false;
             }
         }
@@ -2922,6 +3840,7 @@ bool SDL_ReadSurfacePixelFloat(SDL_Surface *surface, int x, int y, float *r, flo
 
 bool SDL_WriteSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
+    const SDL_Rect pixel_rect = { x, y, 1, 1 };
     Uint32 pixel = 0;
     size_t bytes_per_pixel;
     Uint8 *p;
@@ -2941,6 +3860,11 @@ bool SDL_WriteSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 r, Uint8 g,
 
     bytes_per_pixel = SDL_BYTESPERPIXEL(surface->format);
 
+    if (!SDL_MakeSurfaceWritable(surface)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(surface, &pixel_rect);
+
     if (SDL_MUSTLOCK(surface)) {
         if (!SDL_LockSurface(surface)) {
             return false;
@@ -3006,9 +3930,15 @@ bool SDL_WriteSurfacePixelFloat(SDL_Surface *surface, int x, int y, float r, flo
         result = SDL_Unsupported();
     } else {
         // This is really slow, but it gets the job done
+        const SDL_Rect pixel_rect = { x, y, 1, 1 };
         float rgba[4];
         Uint8 *p;
 
+        if (!SDL_MakeSurfaceWritable(surface)) {
+            return false;
+        }
+        SDL_AddSurfaceDamage(surface, &pixel_rect);
+
         if (SDL_MUSTLOCK(surface)) {
             if (!SDL_LockSurface(surface)) {
                 return false;
@@ -3039,6 +3969,190 @@ bool SDL_WriteSurfacePixelFloat(SDL_Surface *surface, int x, int y, float r, flo
     return result;
 }
 
+static void SDL_FreePixelBuffer(void *pixels, SDL_SurfaceFlags flags, SDL_SurfaceDataFlags internal_flags)
+{
+    if (internal_flags & SDL_INTERNAL_SURFACE_POOLED) {
+        // Return to the pool
+        SDL_FreeSurfacePoolPixels(pixels);
+    } else if (flags & SDL_SURFACE_SIMD_ALIGNED) {
+        // Free aligned
+        SDL_aligned_free(pixels);
+    } else {
+        // Normal
+        SDL_free(pixels);
+    }
+}
+
+static void SDL_ReleaseSharedSurfacePixels(SDL_SharedSurfacePixels *shared)
+{
+    if (SDL_AtomicDecRef(&shared->refcount)) {
+        SDL_FreePixelBuffer(shared->pixels, shared->flags, shared->internal_flags);
+        SDL_free(shared);
+    }
+}
+
+/*
+ * Release the pixels owned by a surface, if any.
+ */
+void SDL_FreeSurfacePixels(SDL_Surface *surface)
+{
+    if (surface->internal_flags & SDL_INTERNAL_SURFACE_MAPPED) {
+        // Release the file mapping the pixels point into
+        SDL_UnmapSurfacePixels(surface->mapped_pixels);
+        surface->mapped_pixels = NULL;
+    } else if (surface->flags & SDL_SURFACE_PREALLOCATED) {
+        // Don't free
+    } else if (surface->internal_flags & SDL_INTERNAL_SURFACE_SHARED) {
+        // Drop our reference, the last surface out frees the pixels
+        SDL_ReleaseSharedSurfacePixels(surface->shared_pixels);
+        surface->shared_pixels = NULL;
+    } else {
+        SDL_FreePixelBuffer(surface->pixels, surface->flags, surface->internal_flags);
+    }
+    surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
+    surface->internal_flags &= ~(SDL_INTERNAL_SURFACE_POOLED | SDL_INTERNAL_SURFACE_SHARED | SDL_INTERNAL_SURFACE_MAPPED);
+    surface->pixels = NULL;
+}
+
+/*
+ * Give a surface its own copy of any pixels it shares with duplicated
+ * surfaces, this must be called before modifying the pixels.
+ */
+bool SDL_MakeSurfaceWritable(SDL_Surface *surface)
+{
+    SDL_SharedSurfacePixels *shared;
+
+    if (!(surface->internal_flags & SDL_INTERNAL_SURFACE_SHARED)) {
+        return true;
+    }
+
+    shared = surface->shared_pixels;
+    if (SDL_GetAtomicInt(&shared->refcount) == 1) {
+        // Everyone else has let go, just take the pixels back
+        surface->flags = (surface->flags & ~SDL_SURFACE_SIMD_ALIGNED) | shared->flags;
+        surface->internal_flags = (surface->internal_flags & ~SDL_INTERNAL_SURFACE_POOLED) | shared->internal_flags;
+        SDL_free(shared);
+    } else {
+        size_t size = (size_t)surface->h * surface->pitch;
+
+        surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
+        if (!SDL_AllocateSurfacePixels(surface, size)) {
+            surface->pixels = shared->pixels;
+            surface->flags |= shared->flags;
+            return false;
+        }
+        SDL_memcpy(surface->pixels, shared->pixels, size);
+        SDL_ReleaseSharedSurfacePixels(shared);
+    }
+    surface->internal_flags &= ~SDL_INTERNAL_SURFACE_SHARED;
+    surface->shared_pixels = NULL;
+    return true;
+}
+
+/*
+ * Start or stop recording the areas of a surface that are written.
+ * The whole surface is damaged when tracking starts.
+ */
+bool SDL_SetSurfaceDamageTracking(SDL_Surface *surface, bool enabled)
+{
+    if (enabled) {
+        if (!surface->damage) {
+            surface->damage = (SDL_SurfaceDamage *)SDL_calloc(1, sizeof(*surface->damage));
+            if (!surface->damage) {
+                return false;
+            }
+            SDL_AddSurfaceDamage(surface, NULL);
+        }
+    } else {
+        SDL_free(surface->damage);
+        surface->damage = NULL;
+    }
+    return true;
+}
+
+static Sint64 SDL_GetRectArea(const SDL_Rect *rect)
+{
+    return (Sint64)rect->w * rect->h;
+}
+
+/*
+ * Record that an area of a surface has been written, or the whole surface
+ * if rect is NULL. Overlapping areas are coalesced, and when there are too
+ * many areas they are merged into the area that grows the least.
+ */
+void SDL_AddSurfaceDamage(SDL_Surface *surface, const SDL_Rect *rect)
+{
+    SDL_SurfaceDamage *damage;
+    SDL_Rect bounds, area, merged;
+    int i, best;
+    Sint64 growth, best_growth;
+
+    if (!surface->damage && !surface->view_parent) {
+        return;
+    }
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = surface->w;
+    bounds.h = surface->h;
+    if (!rect) {
+        area = bounds;
+    } else if (!SDL_GetRectIntersection(rect, &bounds, &area)) {
+        return;
+    }
+
+    if (surface->view_parent) {
+        // Views are damaged through the surface they refer to
+        SDL_Surface *parent = surface->view_parent;
+        size_t offset = (Uint8 *)surface->pixels - (Uint8 *)parent->pixels;
+
+        area.x += (int)(((offset % parent->pitch) * 8) / SDL_BITSPERPIXEL(parent->format));
+        area.y += (int)(offset / parent->pitch);
+        SDL_AddSurfaceDamage(parent, &area);
+    }
+
+    damage = surface->damage;
+    if (!damage) {
+        return;
+    }
+
+    for (;;) {
+        for (i = 0; i < damage->num_rects; ++i) {
+            if (SDL_GetRectIntersection(&damage->rects[i], &area, &merged)) {
+                if (SDL_RectsEqual(&merged, &area)) {
+                    // Already damaged
+                    return;
+                }
+                break;
+            }
+        }
+        if (i < damage->num_rects) {
+            // Merge the overlapping area and check the others against the result
+            SDL_GetRectUnion(&damage->rects[i], &area, &area);
+            damage->rects[i] = damage->rects[--damage->num_rects];
+            continue;
+        }
+
+        if (damage->num_rects < SDL_MAX_SURFACE_DAMAGE_RECTS) {
+            damage->rects[damage->num_rects++] = area;
+            return;
+        }
+
+        best = 0;
+        best_growth = 0;
+        for (i = 0; i < damage->num_rects; ++i) {
+            SDL_GetRectUnion(&damage->rects[i], &area, &merged);
+            growth = SDL_GetRectArea(&merged) - SDL_GetRectArea(&damage->rects[i]) - SDL_GetRectArea(&area);
+            if (i == 0 || growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        SDL_GetRectUnion(&damage->rects[best], &area, &area);
+        damage->rects[best] = damage->rects[--damage->num_rects];
+    }
+}
+
 /*
  * Free a surface created by the above function.
  */
@@ -3070,14 +4184,21 @@ void SDL_DestroySurface(SDL_Surface *surface)
 #endif
     SDL_SetSurfacePalette(surface, NULL);
 
-    if (surface->flags & SDL_SURFACE_PREALLOCATED) {
-        // Don't free
-    } else if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-        // Free aligned
-        SDL_aligned_free(surface->pixels);
-    } else {
-        // Normal
-        SDL_free(surface->pixels);
+    SDL_FreeSurfacePixels(surface);
+
+    SDL_free(surface->damage);
+    surface->damage = NULL;
+
+    if (surface->view_parent) {
+        SDL_Surface *parent = surface->view_parent;
+
+        surface->view_parent = NULL;
+        --parent->num_views;
+        if (parent->internal_flags & SDL_INTERNAL_SURFACE_DONTFREE) {
+            --parent->refcount;
+        } else {
+            SDL_DestroySurface(parent);
+        }
     }
 
     surface->reserved = NULL;
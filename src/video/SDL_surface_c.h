@@ -33,6 +33,36 @@ typedef Uint32 SDL_SurfaceDataFlags;
 #define SDL_INTERNAL_SURFACE_DONTFREE   0x00000001u /**< Surface is referenced internally */
 #define SDL_INTERNAL_SURFACE_STACK      0x00000002u /**< Surface is allocated on the stack */
 #define SDL_INTERNAL_SURFACE_RLEACCEL   0x00000004u /**< Surface is RLE encoded */
+#define SDL_INTERNAL_SURFACE_POOLED     0x00000008u /**< Surface pixels were allocated from the surface pool */
+#define SDL_INTERNAL_SURFACE_SHARED     0x00000010u /**< Surface pixels are shared copy-on-write with other surfaces */
+#define SDL_INTERNAL_SURFACE_MAPPED     0x00000020u /**< Surface pixels point into a private mapping of a file */
+
+// Pixels shared between duplicated surfaces until one of them is written
+typedef struct SDL_SharedSurfacePixels
+{
+    SDL_AtomicInt refcount;
+    void *pixels;
+    SDL_SurfaceFlags flags;                 // SDL_SURFACE_SIMD_ALIGNED, if set for the original allocation
+    SDL_SurfaceDataFlags internal_flags;    // SDL_INTERNAL_SURFACE_POOLED, if set for the original allocation
+} SDL_SharedSurfacePixels;
+
+// Pixels mapped copy-on-write from a file, released when the surface is destroyed
+typedef struct SDL_MappedSurfacePixels
+{
+    void *pixels;   // the start of the pixel data within the mapping
+    void *base;     // the start of the mapping
+    size_t size;    // the size of the mapping
+    void *handle;   // the file mapping object, on Windows
+} SDL_MappedSurfacePixels;
+
+// Areas of a surface that have been written since the damage was last cleared
+#define SDL_MAX_SURFACE_DAMAGE_RECTS 16
+
+typedef struct SDL_SurfaceDamage
+{
+    int num_rects;
+    SDL_Rect rects[SDL_MAX_SURFACE_DAMAGE_RECTS];
+} SDL_SurfaceDamage;
 
 // Surface internal data definition
 struct SDL_Surface
@@ -66,6 +96,21 @@ struct SDL_Surface
     /** palette for indexed surfaces */
     SDL_Palette *palette;
 
+    /** pixels shared with duplicated surfaces, if SDL_INTERNAL_SURFACE_SHARED is set */
+    SDL_SharedSurfacePixels *shared_pixels;
+
+    /** the file mapping the pixels point into, if SDL_INTERNAL_SURFACE_MAPPED is set */
+    SDL_MappedSurfacePixels *mapped_pixels;
+
+    /** the surface this surface is a view into, if any */
+    SDL_Surface *view_parent;
+
+    /** the number of views into this surface */
+    int num_views;
+
+    /** areas written to this surface, if damage tracking is enabled */
+    SDL_SurfaceDamage *damage;
+
     /** Alternate representation of images */
     int num_images;
     SDL_Surface **images;
@@ -89,5 +134,21 @@ extern float SDL_GetSurfaceSDRWhitePoint(SDL_Surface *surface, SDL_Colorspace co
 extern float SDL_GetDefaultHDRHeadroom(SDL_Colorspace colorspace);
 extern float SDL_GetSurfaceHDRHeadroom(SDL_Surface *surface, SDL_Colorspace colorspace);
 extern SDL_Surface *SDL_GetSurfaceImage(SDL_Surface *surface, float display_scale);
+extern void SDL_FreeSurfacePixels(SDL_Surface *surface);
+extern bool SDL_MakeSurfaceWritable(SDL_Surface *surface);
+extern bool SDL_LockSurfaceReadOnly(SDL_Surface *surface);
+extern void SDL_FillSurfaceBytes(void *pixels, Uint8 value, size_t size);
+extern bool SDL_SetSurfaceDamageTracking(SDL_Surface *surface, bool enabled);
+extern void SDL_AddSurfaceDamage(SDL_Surface *surface, const SDL_Rect *rect);
+
+// Surface pixel file mapping functions
+extern SDL_MappedSurfacePixels *SDL_MapSurfacePixels(SDL_IOStream *src, Sint64 offset, size_t size);
+extern void SDL_UnmapSurfacePixels(SDL_MappedSurfacePixels *mapping);
+
+// Surface pixel pool functions
+extern bool SDL_UseSurfacePool(size_t size);
+extern void *SDL_AllocSurfacePoolPixels(size_t alignment, size_t size);
+extern void SDL_FreeSurfacePoolPixels(void *pixels);
+extern void SDL_QuitSurfacePool(void);
 
 #endif // SDL_surface_c_h_
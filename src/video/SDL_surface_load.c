@@ -0,0 +1,516 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* Loading images in any of the formats SDL supports, optionally on a pool of
+ * worker threads.
+ *
+ * Files loaded through a queue are read with SDL_LoadFileAsync(). One idle
+ * worker at a time waits on the async I/O queue, and each completed read is
+ * handed to the next free worker to decode, so reading and decoding overlap.
+ */
+
+typedef struct SDL_SurfaceLoadTask
+{
+    struct SDL_SurfaceLoadTask *next;
+    char *file;             // the file being read, for error messages
+    SDL_IOStream *src;      // the stream to decode, if not loaded from a file
+    bool closeio;
+    void *buffer;           // the file contents, once they've been read
+    size_t size;
+    SDL_Surface *surface;
+    char *error;
+    int index;
+    void *userdata;
+} SDL_SurfaceLoadTask;
+
+struct SDL_SurfaceLoadQueue
+{
+    SDL_AsyncIOQueue *io_queue;
+    SDL_Mutex *lock;
+    SDL_Condition *task_ready;
+    SDL_Condition *result_ready;
+    SDL_SurfaceLoadTask *tasks;         // tasks waiting to be decoded
+    SDL_SurfaceLoadTask *tasks_tail;
+    SDL_SurfaceLoadTask *results;       // tasks waiting to be collected
+    SDL_SurfaceLoadTask *results_tail;
+    int pending_reads;
+    bool reading;                       // whether a worker is waiting on io_queue
+    bool quit;
+    int num_threads;
+    SDL_Thread **threads;
+};
+
+SDL_Surface *SDL_LoadSurface_IO(SDL_IOStream *src, bool closeio)
+{
+    Sint64 start;
+    Uint8 magic[4];
+    size_t len;
+
+    CHECK_PARAM(!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+
+    start = SDL_TellIO(src);
+    len = SDL_ReadIO(src, magic, sizeof(magic));
+    SDL_SeekIO(src, start, SDL_IO_SEEK_SET);
+
+    if (len >= 2 && magic[0] == 'B' && magic[1] == 'M') {
+        return SDL_LoadBMP_IO(src, closeio);
+    }
+    if (len == 4 && magic[0] == 0x89 && magic[1] == 'P' && magic[2] == 'N' && magic[3] == 'G') {
+        return SDL_LoadPNG_IO(src, closeio);
+    }
+
+    SDL_SetError("Unsupported image format");
+    if (closeio) {
+        SDL_CloseIO(src);
+    }
+    return NULL;
+}
+
+SDL_Surface *SDL_LoadSurface(const char *file)
+{
+    SDL_IOStream *stream = SDL_IOFromFile(file, "rb");
+    if (!stream) {
+        return NULL;
+    }
+    return SDL_LoadSurface_IO(stream, true);
+}
+
+static void SDL_FreeSurfaceLoadTask(SDL_SurfaceLoadTask *task)
+{
+    if (task->src && task->closeio) {
+        SDL_CloseIO(task->src);
+    }
+    SDL_free(task->file);
+    SDL_free(task->buffer);
+    SDL_DestroySurface(task->surface);
+    SDL_free(task->error);
+    SDL_free(task);
+}
+
+// These must be called with the queue locked
+static void SDL_AddSurfaceLoadTask(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadTask *task)
+{
+    task->next = NULL;
+    if (queue->tasks_tail) {
+        queue->tasks_tail->next = task;
+    } else {
+        queue->tasks = task;
+    }
+    queue->tasks_tail = task;
+    SDL_SignalCondition(queue->task_ready);
+}
+
+static void SDL_AddSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadTask *task)
+{
+    if (!task->surface && !task->error) {
+        task->error = SDL_strdup(SDL_GetError());
+    }
+
+    task->next = NULL;
+    if (queue->results_tail) {
+        queue->results_tail->next = task;
+    } else {
+        queue->results = task;
+    }
+    queue->results_tail = task;
+    SDL_SignalCondition(queue->result_ready);
+}
+
+static void SDL_RunSurfaceLoadTask(SDL_SurfaceLoadTask *task)
+{
+    if (task->buffer) {
+        SDL_IOStream *src = SDL_IOFromConstMem(task->buffer, task->size);
+        if (src) {
+            task->surface = SDL_LoadSurface_IO(src, true);
+        }
+        SDL_free(task->buffer);
+        task->buffer = NULL;
+    } else {
+        task->surface = SDL_LoadSurface_IO(task->src, task->closeio);
+        task->src = NULL;
+    }
+}
+
+static int SDLCALL SDL_SurfaceLoadThread(void *data)
+{
+    SDL_SurfaceLoadQueue *queue = (SDL_SurfaceLoadQueue *)data;
+
+    SDL_LockMutex(queue->lock);
+    for (;;) {
+        SDL_SurfaceLoadTask *task = queue->tasks;
+
+        if (task && !queue->quit) {
+            queue->tasks = task->next;
+            if (!queue->tasks) {
+                queue->tasks_tail = NULL;
+            }
+            SDL_UnlockMutex(queue->lock);
+
+            SDL_RunSurfaceLoadTask(task);
+
+            SDL_LockMutex(queue->lock);
+            SDL_AddSurfaceLoadResult(queue, task);
+
+        } else if (queue->pending_reads > 0 && !queue->reading) {
+            SDL_AsyncIOOutcome outcome;
+            bool completed;
+
+            // Reads always complete, so this can't wait forever
+            queue->reading = true;
+            SDL_UnlockMutex(queue->lock);
+
+            completed = SDL_WaitAsyncIOResult(queue->io_queue, &outcome, -1);
+
+            SDL_LockMutex(queue->lock);
+            queue->reading = false;
+            if (completed) {
+                --queue->pending_reads;
+                task = (SDL_SurfaceLoadTask *)outcome.userdata;
+                if (queue->quit) {
+                    SDL_free(outcome.buffer);
+                    SDL_FreeSurfaceLoadTask(task);
+                } else if (outcome.result == SDL_ASYNCIO_COMPLETE) {
+                    task->buffer = outcome.buffer;
+                    task->size = (size_t)outcome.bytes_transferred;
+                    SDL_AddSurfaceLoadTask(queue, task);
+                } else {
+                    SDL_free(outcome.buffer);
+                    SDL_SetError("Couldn't read %s: %s", task->file,
+                                 outcome.result == SDL_ASYNCIO_CANCELED ? "read canceled" : "I/O error");
+                    SDL_AddSurfaceLoadResult(queue, task);
+                }
+            }
+
+            // Let another worker take over waiting for reads
+            SDL_BroadcastCondition(queue->task_ready);
+
+        } else if (queue->quit && queue->pending_reads == 0) {
+            break;
+        } else {
+            SDL_WaitCondition(queue->task_ready, queue->lock);
+        }
+    }
+    SDL_UnlockMutex(queue->lock);
+
+    return 0;
+}
+
+SDL_SurfaceLoadQueue *SDL_CreateSurfaceLoadQueue(int num_threads)
+{
+    SDL_SurfaceLoadQueue *queue;
+    int i;
+
+    CHECK_PARAM(num_threads < 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+
+    if (num_threads == 0) {
+        num_threads = SDL_max(SDL_GetNumLogicalCPUCores(), 1);
+    }
+
+    queue = (SDL_SurfaceLoadQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+    queue->io_queue = SDL_CreateAsyncIOQueue();
+    queue->lock = SDL_CreateMutex();
+    queue->task_ready = SDL_CreateCondition();
+    queue->result_ready = SDL_CreateCondition();
+    queue->threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(*queue->threads));
+    if (!queue->io_queue || !queue->lock || !queue->task_ready || !queue->result_ready || !queue->threads) {
+        SDL_DestroySurfaceLoadQueue(queue);
+        return NULL;
+    }
+
+    for (i = 0; i < num_threads; ++i) {
+        queue->threads[i] = SDL_CreateThread(SDL_SurfaceLoadThread, "SDLSurfaceLoad", queue);
+        if (!queue->threads[i]) {
+            SDL_DestroySurfaceLoadQueue(queue);
+            return NULL;
+        }
+        ++queue->num_threads;
+    }
+    return queue;
+}
+
+static bool SDL_QueueSurfaceLoadFile(SDL_SurfaceLoadQueue *queue, const char *file, int index, void *userdata)
+{
+    SDL_SurfaceLoadTask *task = (SDL_SurfaceLoadTask *)SDL_calloc(1, sizeof(*task));
+    if (!task) {
+        return false;
+    }
+    task->file = SDL_strdup(file);
+    if (!task->file) {
+        SDL_free(task);
+        return false;
+    }
+    task->index = index;
+    task->userdata = userdata;
+
+    // Hold the lock so the read can't be collected before it's counted
+    SDL_LockMutex(queue->lock);
+    if (!SDL_LoadFileAsync(file, queue->io_queue, task)) {
+        SDL_UnlockMutex(queue->lock);
+        SDL_FreeSurfaceLoadTask(task);
+        return false;
+    }
+    ++queue->pending_reads;
+    SDL_SignalCondition(queue->task_ready);
+    SDL_UnlockMutex(queue->lock);
+
+    return true;
+}
+
+static bool SDL_QueueSurfaceLoadStream(SDL_SurfaceLoadQueue *queue, SDL_IOStream *src, bool closeio, int index, void *userdata)
+{
+    SDL_SurfaceLoadTask *task = (SDL_SurfaceLoadTask *)SDL_calloc(1, sizeof(*task));
+    if (!task) {
+        return false;
+    }
+    task->src = src;
+    task->closeio = closeio;
+    task->index = index;
+    task->userdata = userdata;
+
+    SDL_LockMutex(queue->lock);
+    SDL_AddSurfaceLoadTask(queue, task);
+    SDL_UnlockMutex(queue->lock);
+
+    return true;
+}
+
+// Report a load that couldn't be started, using the current error
+static bool SDL_QueueSurfaceLoadFailure(SDL_SurfaceLoadQueue *queue, int index, void *userdata)
+{
+    SDL_SurfaceLoadTask *task = (SDL_SurfaceLoadTask *)SDL_calloc(1, sizeof(*task));
+    if (!task) {
+        return false;
+    }
+    task->index = index;
+    task->userdata = userdata;
+
+    SDL_LockMutex(queue->lock);
+    SDL_AddSurfaceLoadResult(queue, task);
+    SDL_UnlockMutex(queue->lock);
+
+    return true;
+}
+
+bool SDL_LoadSurfaceAsync(const char *file, SDL_SurfaceLoadQueue *queue, void *userdata)
+{
+    CHECK_PARAM(!file) {
+        return SDL_InvalidParamError("file");
+    }
+    CHECK_PARAM(!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    return SDL_QueueSurfaceLoadFile(queue, file, 0, userdata);
+}
+
+bool SDL_LoadSurfaceAsync_IO(SDL_IOStream *src, bool closeio, SDL_SurfaceLoadQueue *queue, void *userdata)
+{
+    CHECK_PARAM(!src) {
+        return SDL_InvalidParamError("src");
+    }
+    CHECK_PARAM(!queue) {
+        if (closeio) {
+            SDL_CloseIO(src);
+        }
+        return SDL_InvalidParamError("queue");
+    }
+
+    if (!SDL_QueueSurfaceLoadStream(queue, src, closeio, 0, userdata)) {
+        if (closeio) {
+            SDL_CloseIO(src);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool SDL_LoadSurfacesAsync(const char * const *files, int num_files, SDL_SurfaceLoadQueue *queue, void *userdata)
+{
+    int i;
+
+    CHECK_PARAM(!files && num_files > 0) {
+        return SDL_InvalidParamError("files");
+    }
+    CHECK_PARAM(num_files < 0) {
+        return SDL_InvalidParamError("num_files");
+    }
+    CHECK_PARAM(!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    for (i = 0; i < num_files; ++i) {
+        if (!files[i]) {
+            SDL_InvalidParamError("file");
+        } else if (SDL_QueueSurfaceLoadFile(queue, files[i], i, userdata)) {
+            continue;
+        }
+        if (!SDL_QueueSurfaceLoadFailure(queue, i, userdata)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SDL_LoadSurfacesAsync_IO(SDL_IOStream * const *streams, int num_streams, bool closeio, SDL_SurfaceLoadQueue *queue, void *userdata)
+{
+    int i;
+
+    CHECK_PARAM(!streams && num_streams > 0) {
+        return SDL_InvalidParamError("streams");
+    }
+    CHECK_PARAM(num_streams < 0) {
+        return SDL_InvalidParamError("num_streams");
+    }
+    CHECK_PARAM(!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    for (i = 0; i < num_streams; ++i) {
+        if (!streams[i]) {
+            SDL_InvalidParamError("src");
+        } else if (SDL_QueueSurfaceLoadStream(queue, streams[i], closeio, i, userdata)) {
+            continue;
+        } else if (closeio) {
+            SDL_CloseIO(streams[i]);
+        }
+        if (!SDL_QueueSurfaceLoadFailure(queue, i, userdata)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// This must be called with the queue locked
+static bool SDL_TakeSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome)
+{
+    SDL_SurfaceLoadTask *task = queue->results;
+
+    if (!task) {
+        return false;
+    }
+    queue->results = task->next;
+    if (!queue->results) {
+        queue->results_tail = NULL;
+    }
+
+    outcome->surface = task->surface;
+    outcome->index = task->index;
+    outcome->userdata = task->userdata;
+    if (!task->surface) {
+        SDL_SetError("%s", task->error ? task->error : "Out of memory");
+    }
+    task->surface = NULL;
+    SDL_FreeSurfaceLoadTask(task);
+
+    return true;
+}
+
+bool SDL_GetSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome)
+{
+    bool result;
+
+    CHECK_PARAM(!queue || !outcome) {
+        return false;
+    }
+
+    SDL_LockMutex(queue->lock);
+    result = SDL_TakeSurfaceLoadResult(queue, outcome);
+    SDL_UnlockMutex(queue->lock);
+
+    return result;
+}
+
+bool SDL_WaitSurfaceLoadResult(SDL_SurfaceLoadQueue *queue, SDL_SurfaceLoadOutcome *outcome, Sint32 timeoutMS)
+{
+    bool result;
+
+    CHECK_PARAM(!queue || !outcome) {
+        return false;
+    }
+
+    SDL_LockMutex(queue->lock);
+    if (timeoutMS < 0) {
+        while (!queue->results) {
+            SDL_WaitCondition(queue->result_ready, queue->lock);
+        }
+    } else if (!queue->results) {
+        Uint64 deadline = SDL_GetTicks() + timeoutMS;
+        Uint64 now;
+
+        while (!queue->results && (now = SDL_GetTicks()) < deadline) {
+            SDL_WaitConditionTimeout(queue->result_ready, queue->lock, (Sint32)(deadline - now));
+        }
+    }
+    result = SDL_TakeSurfaceLoadResult(queue, outcome);
+    SDL_UnlockMutex(queue->lock);
+
+    return result;
+}
+
+void SDL_DestroySurfaceLoadQueue(SDL_SurfaceLoadQueue *queue)
+{
+    SDL_SurfaceLoadTask *task;
+    int i;
+
+    if (!queue) {
+        return;
+    }
+
+    if (queue->num_threads > 0) {
+        SDL_LockMutex(queue->lock);
+        queue->quit = true;
+        SDL_BroadcastCondition(queue->task_ready);
+        SDL_UnlockMutex(queue->lock);
+
+        // The workers finish any reads in progress before exiting
+        for (i = 0; i < queue->num_threads; ++i) {
+            SDL_WaitThread(queue->threads[i], NULL);
+        }
+    }
+    SDL_free(queue->threads);
+
+    while (queue->tasks) {
+        task = queue->tasks;
+        queue->tasks = task->next;
+        SDL_FreeSurfaceLoadTask(task);
+    }
+    while (queue->results) {
+        task = queue->results;
+        queue->results = task->next;
+        SDL_FreeSurfaceLoadTask(task);
+    }
+
+    SDL_DestroyAsyncIOQueue(queue->io_queue);
+    SDL_DestroyCondition(queue->result_ready);
+    SDL_DestroyCondition(queue->task_ready);
+    SDL_DestroyMutex(queue->lock);
+    SDL_free(queue);
+}
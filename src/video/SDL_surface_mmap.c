@@ -0,0 +1,155 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_surface_c.h"
+
+/* Surface pixels that point directly into a file.
+ *
+ * Image loaders can use this for uncompressed pixel data laid out the way
+ * SDL expects, so the pixels are paged in from the file on demand instead of
+ * being read into a new allocation. The mapping is private and copy-on-write,
+ * so writing to the surface never modifies the file.
+ */
+
+#if defined(SDL_PLATFORM_WINDOWS) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+#include "../core/windows/SDL_windows.h"
+#define HAVE_SURFACE_MMAP_WINDOWS
+#elif defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE) || defined(SDL_PLATFORM_ANDROID)
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAVE_SURFACE_MMAP_POSIX
+#endif
+
+SDL_MappedSurfacePixels *SDL_MapSurfacePixels(SDL_IOStream *src, Sint64 offset, size_t size)
+{
+#if defined(HAVE_SURFACE_MMAP_WINDOWS) || defined(HAVE_SURFACE_MMAP_POSIX)
+    SDL_PropertiesID props = SDL_GetIOProperties(src);
+    SDL_MappedSurfacePixels *mapping;
+    Sint64 file_size = SDL_GetIOSize(src);
+    Uint64 granularity, base_offset;
+    size_t delta;
+
+    if (offset < 0 || size == 0) {
+        SDL_InvalidParamError("offset");
+        return NULL;
+    }
+
+    // Touching pages past the end of the file would crash, so don't map anything that isn't there
+    if (file_size < 0 || (Uint64)offset > (Uint64)file_size || size > (Uint64)file_size - (Uint64)offset) {
+        SDL_SetError("Pixel data is past the end of the file");
+        return NULL;
+    }
+
+#ifdef HAVE_SURFACE_MMAP_WINDOWS
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        granularity = info.dwAllocationGranularity;
+    }
+#else
+    granularity = (Uint64)sysconf(_SC_PAGESIZE);
+#endif
+    base_offset = (Uint64)offset - ((Uint64)offset % granularity);
+    delta = (size_t)((Uint64)offset - base_offset);
+    if (size > SDL_SIZE_MAX - delta) {
+        SDL_SetError("Pixel data is too large to map");
+        return NULL;
+    }
+
+    mapping = (SDL_MappedSurfacePixels *)SDL_calloc(1, sizeof(*mapping));
+    if (!mapping) {
+        return NULL;
+    }
+    mapping->size = size + delta;
+
+#ifdef HAVE_SURFACE_MMAP_WINDOWS
+    {
+        HANDLE file = (HANDLE)SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_WINDOWS_HANDLE_POINTER, NULL);
+        HANDLE handle;
+
+        if (!file) {
+            SDL_free(mapping);
+            SDL_Unsupported();
+            return NULL;
+        }
+
+        handle = CreateFileMappingW(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if (!handle) {
+            SDL_free(mapping);
+            WIN_SetError("CreateFileMapping()");
+            return NULL;
+        }
+        mapping->base = MapViewOfFile(handle, FILE_MAP_COPY, (DWORD)(base_offset >> 32), (DWORD)base_offset, mapping->size);
+        if (!mapping->base) {
+            WIN_SetError("MapViewOfFile()");
+            CloseHandle(handle);
+            SDL_free(mapping);
+            return NULL;
+        }
+        mapping->handle = handle;
+    }
+#else
+    {
+        int fd = (int)SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER, -1);
+        void *base;
+
+        if (fd < 0) {
+            SDL_free(mapping);
+            SDL_Unsupported();
+            return NULL;
+        }
+
+        base = mmap(NULL, mapping->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, (off_t)base_offset);
+        if (base == MAP_FAILED) {
+            SDL_free(mapping);
+            SDL_SetError("mmap() failed.");
+            return NULL;
+        }
+        mapping->base = base;
+    }
+#endif
+
+    mapping->pixels = (Uint8 *)mapping->base + delta;
+    return mapping;
+#else
+    (void)src;
+    (void)offset;
+    (void)size;
+    SDL_Unsupported();
+    return NULL;
+#endif
+}
+
+void SDL_UnmapSurfacePixels(SDL_MappedSurfacePixels *mapping)
+{
+    if (!mapping) {
+        return;
+    }
+
+#ifdef HAVE_SURFACE_MMAP_WINDOWS
+    UnmapViewOfFile(mapping->base);
+    CloseHandle((HANDLE)mapping->handle);
+#elif defined(HAVE_SURFACE_MMAP_POSIX)
+    munmap(mapping->base, mapping->size);
+#endif
+    SDL_free(mapping);
+}
@@ -0,0 +1,420 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_surface_c.h"
+#include "../SDL_hints_c.h"
+
+/* A cache of surface pixel buffers, keyed by size and alignment.
+ *
+ * Applications that create and destroy surfaces of the same size every frame
+ * (camera frames, decoded video, renderer scratch surfaces) get their buffers
+ * back from the cache instead of going through the heap. The cache is capped
+ * by SDL_HINT_SURFACE_POOL_SIZE and is disabled by default.
+ *
+ * On Linux, very large buffers can also be backed by transparent huge pages,
+ * see SDL_HINT_SURFACE_POOL_HUGEPAGES.
+ */
+
+#ifdef SDL_PLATFORM_LINUX
+#include <sys/mman.h>
+#ifdef MADV_HUGEPAGE
+#define HAVE_SURFACE_POOL_HUGEPAGES
+#endif
+#endif
+
+// Buffers at least this large are eligible for huge page backing
+#define SDL_SURFACE_POOL_HUGEPAGE_SIZE  (2 * 1024 * 1024)
+
+// The most buckets kept, empty buckets are reused for new sizes past this
+#define SDL_SURFACE_POOL_MAX_BUCKETS    64
+
+// This lives immediately before the pixels handed out to the surface
+typedef struct SDL_SurfacePoolBuffer
+{
+    struct SDL_SurfacePoolBuffer *next;
+    void *base;         // the start of the underlying allocation
+    size_t base_size;   // the size of the underlying allocation
+    size_t size;        // the usable size of the pixel buffer
+    size_t alignment;   // the alignment of the pixel buffer
+    bool mapped;        // whether the allocation came from mmap()
+} SDL_SurfacePoolBuffer;
+
+typedef struct SDL_SurfacePoolBucket
+{
+    size_t size;
+    size_t alignment;
+    SDL_SurfacePoolBuffer *buffers;
+    struct SDL_SurfacePoolBucket *next;
+} SDL_SurfacePoolBucket;
+
+static SDL_InitState SDL_surface_pool_init;
+static SDL_SpinLock SDL_surface_pool_lock;
+static SDL_SurfacePoolBucket *SDL_surface_pool_buckets;
+static int SDL_surface_pool_bucket_count;
+static size_t SDL_surface_pool_max_bytes;
+static size_t SDL_surface_pool_cached_bytes;
+static Uint64 SDL_surface_pool_hits;
+static Uint64 SDL_surface_pool_misses;
+static bool SDL_surface_pool_hugepages;
+
+static void SDL_DestroySurfacePoolBuffer(SDL_SurfacePoolBuffer *buffer)
+{
+#ifdef HAVE_SURFACE_POOL_HUGEPAGES
+    if (buffer->mapped) {
+        munmap(buffer->base, buffer->base_size);
+        return;
+    }
+#endif
+    SDL_free(buffer->base);
+}
+
+/* Take cached buffers out of the pool until it fits in max_bytes, must be
+ * called with the lock held. Empty buckets stay in the list so the sizes
+ * they're for can be cached again without allocating, unless the pool is
+ * being emptied completely, in which case they're returned in buckets.
+ */
+static SDL_SurfacePoolBuffer *SDL_TrimSurfacePool(size_t max_bytes, SDL_SurfacePoolBucket **buckets)
+{
+    SDL_SurfacePoolBuffer *freelist = NULL;
+    SDL_SurfacePoolBucket *bucket;
+
+    for (bucket = SDL_surface_pool_buckets; bucket && SDL_surface_pool_cached_bytes > max_bytes; bucket = bucket->next) {
+        while (bucket->buffers && SDL_surface_pool_cached_bytes > max_bytes) {
+            SDL_SurfacePoolBuffer *buffer = bucket->buffers;
+            bucket->buffers = buffer->next;
+            SDL_surface_pool_cached_bytes -= buffer->size;
+            buffer->next = freelist;
+            freelist = buffer;
+        }
+    }
+
+    if (max_bytes == 0) {
+        *buckets = SDL_surface_pool_buckets;
+        SDL_surface_pool_buckets = NULL;
+        SDL_surface_pool_bucket_count = 0;
+    } else {
+        *buckets = NULL;
+    }
+    return freelist;
+}
+
+static void SDL_DestroySurfacePoolBuffers(SDL_SurfacePoolBuffer *buffers, SDL_SurfacePoolBucket *buckets)
+{
+    while (buffers) {
+        SDL_SurfacePoolBuffer *next = buffers->next;
+        SDL_DestroySurfacePoolBuffer(buffers);
+        buffers = next;
+    }
+    while (buckets) {
+        SDL_SurfacePoolBucket *next = buckets->next;
+        SDL_free(buckets);
+        buckets = next;
+    }
+}
+
+static void SDLCALL SDL_SurfacePoolSizeChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_SurfacePoolBuffer *freelist;
+    SDL_SurfacePoolBucket *buckets;
+
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    SDL_surface_pool_max_bytes = (size_t)SDL_GetStringInteger(hint, 0);
+    freelist = SDL_TrimSurfacePool(SDL_surface_pool_max_bytes, &buckets);
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+    SDL_DestroySurfacePoolBuffers(freelist, buckets);
+}
+
+static void SDLCALL SDL_SurfacePoolHugePagesChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_surface_pool_hugepages = SDL_GetStringBoolean(hint, false);
+}
+
+static void SDL_InitSurfacePool(void)
+{
+    if (SDL_ShouldInit(&SDL_surface_pool_init)) {
+        SDL_AddHintCallback(SDL_HINT_SURFACE_POOL_SIZE, SDL_SurfacePoolSizeChanged, NULL);
+        SDL_AddHintCallback(SDL_HINT_SURFACE_POOL_HUGEPAGES, SDL_SurfacePoolHugePagesChanged, NULL);
+        SDL_SetInitialized(&SDL_surface_pool_init, true);
+    }
+}
+
+void SDL_QuitSurfacePool(void)
+{
+    SDL_SurfacePoolBuffer *freelist;
+    SDL_SurfacePoolBucket *buckets;
+
+    if (!SDL_ShouldQuit(&SDL_surface_pool_init)) {
+        return;
+    }
+
+    SDL_RemoveHintCallback(SDL_HINT_SURFACE_POOL_SIZE, SDL_SurfacePoolSizeChanged, NULL);
+    SDL_RemoveHintCallback(SDL_HINT_SURFACE_POOL_HUGEPAGES, SDL_SurfacePoolHugePagesChanged, NULL);
+
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    freelist = SDL_TrimSurfacePool(0, &buckets);
+    SDL_surface_pool_max_bytes = 0;
+    SDL_surface_pool_hugepages = false;
+    SDL_surface_pool_hits = 0;
+    SDL_surface_pool_misses = 0;
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+    SDL_DestroySurfacePoolBuffers(freelist, buckets);
+
+    SDL_SetInitialized(&SDL_surface_pool_init, false);
+}
+
+bool SDL_UseSurfacePool(size_t size)
+{
+    SDL_InitSurfacePool();
+
+    if (SDL_surface_pool_max_bytes > 0) {
+        return true;
+    }
+#ifdef HAVE_SURFACE_POOL_HUGEPAGES
+    if (SDL_surface_pool_hugepages && size >= SDL_SURFACE_POOL_HUGEPAGE_SIZE) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+static SDL_SurfacePoolBuffer *SDL_CreateSurfacePoolBuffer(size_t alignment, size_t size)
+{
+    SDL_SurfacePoolBuffer *buffer;
+    size_t header_size = sizeof(*buffer);
+    size_t base_size;
+    Uint8 *base = NULL;
+    Uint8 *pixels;
+    bool mapped = false;
+
+    if (!SDL_size_add_check_overflow(size, header_size, &base_size) ||
+        !SDL_size_add_check_overflow(base_size, alignment - 1, &base_size)) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+#ifdef HAVE_SURFACE_POOL_HUGEPAGES
+    if (SDL_surface_pool_hugepages && size >= SDL_SURFACE_POOL_HUGEPAGE_SIZE) {
+        // Huge pages need 2 MB aligned memory, so over-allocate and trim the ends off the mapping
+        const size_t hugepage_mask = SDL_SURFACE_POOL_HUGEPAGE_SIZE - 1;
+        size_t map_size;
+
+        if (SDL_size_add_check_overflow(base_size, hugepage_mask, &map_size) &&
+            SDL_size_add_check_overflow(map_size & ~hugepage_mask, hugepage_mask, &map_size)) {
+            void *mem = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mem != MAP_FAILED) {
+                Uint8 *start = (Uint8 *)mem;
+                Uint8 *aligned = (Uint8 *)(((uintptr_t)start + hugepage_mask) & ~(uintptr_t)hugepage_mask);
+                size_t aligned_size = (base_size + hugepage_mask) & ~hugepage_mask;
+                size_t tail_size = map_size - (size_t)(aligned - start) - aligned_size;
+
+                if (aligned > start) {
+                    munmap(start, (size_t)(aligned - start));
+                }
+                if (tail_size > 0) {
+                    munmap(aligned + aligned_size, tail_size);
+                }
+
+                // This is advisory, the mapping works either way
+                madvise(aligned, aligned_size, MADV_HUGEPAGE);
+                base = aligned;
+                base_size = aligned_size;
+                mapped = true;
+            }
+        }
+    }
+#endif
+    if (!base) {
+        base = (Uint8 *)SDL_malloc(base_size);
+        if (!base) {
+            return NULL;
+        }
+    }
+
+    pixels = base + header_size;
+    pixels += (alignment - ((uintptr_t)pixels % alignment)) % alignment;
+
+    buffer = (SDL_SurfacePoolBuffer *)(pixels - header_size);
+    buffer->next = NULL;
+    buffer->base = base;
+    buffer->base_size = base_size;
+    buffer->size = size;
+    buffer->alignment = alignment;
+    buffer->mapped = mapped;
+    return buffer;
+}
+
+// Find the bucket for a size and alignment and move it to the front of the list, must be called with the lock held
+static SDL_SurfacePoolBucket *SDL_FindSurfacePoolBucket(size_t alignment, size_t size)
+{
+    SDL_SurfacePoolBucket *bucket, *prev = NULL;
+
+    for (bucket = SDL_surface_pool_buckets; bucket; bucket = bucket->next) {
+        if (bucket->size == size && bucket->alignment == alignment) {
+            // Keep recently used sizes at the front of the list
+            if (prev) {
+                prev->next = bucket->next;
+                bucket->next = SDL_surface_pool_buckets;
+                SDL_surface_pool_buckets = bucket;
+            }
+            return bucket;
+        }
+        prev = bucket;
+    }
+    return NULL;
+}
+
+// Repurpose the least recently used empty bucket for a new size, must be called with the lock held
+static SDL_SurfacePoolBucket *SDL_ReuseSurfacePoolBucket(size_t alignment, size_t size)
+{
+    SDL_SurfacePoolBucket *bucket, *prev = NULL;
+    SDL_SurfacePoolBucket *found = NULL, *found_prev = NULL;
+
+    for (bucket = SDL_surface_pool_buckets; bucket; bucket = bucket->next) {
+        if (!bucket->buffers) {
+            found = bucket;
+            found_prev = prev;
+        }
+        prev = bucket;
+    }
+
+    if (found) {
+        if (found_prev) {
+            found_prev->next = found->next;
+            found->next = SDL_surface_pool_buckets;
+            SDL_surface_pool_buckets = found;
+        }
+        found->size = size;
+        found->alignment = alignment;
+    }
+    return found;
+}
+
+void *SDL_AllocSurfacePoolPixels(size_t alignment, size_t size)
+{
+    SDL_SurfacePoolBuffer *buffer = NULL;
+    SDL_SurfacePoolBucket *bucket;
+
+    SDL_assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    SDL_InitSurfacePool();
+
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    bucket = SDL_FindSurfacePoolBucket(alignment, size);
+    if (bucket && bucket->buffers) {
+        buffer = bucket->buffers;
+        bucket->buffers = buffer->next;
+        SDL_surface_pool_cached_bytes -= size;
+        ++SDL_surface_pool_hits;
+    } else {
+        ++SDL_surface_pool_misses;
+    }
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+    if (!buffer) {
+        buffer = SDL_CreateSurfacePoolBuffer(alignment, size);
+        if (!buffer) {
+            return NULL;
+        }
+    }
+    buffer->next = NULL;
+    return buffer + 1;
+}
+
+void SDL_FreeSurfacePoolPixels(void *pixels)
+{
+    SDL_SurfacePoolBuffer *buffer;
+    SDL_SurfacePoolBucket *bucket, *new_bucket = NULL;
+
+    if (!pixels) {
+        return;
+    }
+
+    buffer = (SDL_SurfacePoolBuffer *)pixels - 1;
+
+    for (;;) {
+        SDL_LockSpinlock(&SDL_surface_pool_lock);
+        if (SDL_surface_pool_cached_bytes + buffer->size > SDL_surface_pool_max_bytes) {
+            break;
+        }
+
+        bucket = SDL_FindSurfacePoolBucket(buffer->alignment, buffer->size);
+        if (!bucket && SDL_surface_pool_bucket_count >= SDL_SURFACE_POOL_MAX_BUCKETS) {
+            bucket = SDL_ReuseSurfacePoolBucket(buffer->alignment, buffer->size);
+            if (!bucket) {
+                // Every bucket is in use, don't cache this size
+                break;
+            }
+        }
+        if (!bucket && new_bucket) {
+            bucket = new_bucket;
+            new_bucket = NULL;
+            bucket->size = buffer->size;
+            bucket->alignment = buffer->alignment;
+            bucket->buffers = NULL;
+            bucket->next = SDL_surface_pool_buckets;
+            SDL_surface_pool_buckets = bucket;
+            ++SDL_surface_pool_bucket_count;
+        }
+        if (bucket) {
+            buffer->next = bucket->buffers;
+            bucket->buffers = buffer;
+            SDL_surface_pool_cached_bytes += buffer->size;
+            buffer = NULL;
+            break;
+        }
+        SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+        // This is the first time we've seen this size, allocate a bucket outside the lock and try again
+        new_bucket = (SDL_SurfacePoolBucket *)SDL_malloc(sizeof(*new_bucket));
+        if (!new_bucket) {
+            SDL_LockSpinlock(&SDL_surface_pool_lock);
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+    // Another thread may have added the bucket while we were allocating it
+    SDL_free(new_bucket);
+
+    if (buffer) {
+        SDL_DestroySurfacePoolBuffer(buffer);
+    }
+}
+
+bool SDL_GetSurfacePoolStats(Uint64 *hits, Uint64 *misses, Uint64 *cached_bytes)
+{
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    if (hits) {
+        *hits = SDL_surface_pool_hits;
+    }
+    if (misses) {
+        *misses = SDL_surface_pool_misses;
+    }
+    if (cached_bytes) {
+        *cached_bytes = SDL_surface_pool_cached_bytes;
+    }
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+    return true;
+}
@@ -99,6 +99,7 @@ struct SDL_Window
 
     SDL_Surface *surface;
     bool surface_valid;
+    bool surface_damage_tracking;
 
     bool is_hiding;
     bool restore_on_show; // Child was hidden recursively by the parent, restore when shown.
@@ -3690,6 +3690,9 @@ SDL_Surface *SDL_GetWindowSurface(SDL_Window *window)
         if (window->surface) {
             window->surface_valid = true;
             window->surface->internal_flags |= SDL_INTERNAL_SURFACE_DONTFREE;
+            if (window->surface_damage_tracking) {
+                SDL_SetSurfaceDamageTracking(window->surface, true);
+            }
         }
     }
     return window->surface;
@@ -3721,6 +3724,20 @@ bool SDL_UpdateWindowSurface(SDL_Window *window)
 
     CHECK_WINDOW_MAGIC(window, false);
 
+    if (window->surface_valid && window->surface->damage) {
+        SDL_SurfaceDamage *damage = window->surface->damage;
+
+        if (damage->num_rects == 0) {
+            // Nothing has changed
+            return true;
+        }
+        if (!SDL_UpdateWindowSurfaceRects(window, damage->rects, damage->num_rects)) {
+            return false;
+        }
+        damage->num_rects = 0;
+        return true;
+    }
+
     full_rect.x = 0;
     full_rect.y = 0;
     SDL_GetWindowSizeInPixels(window, &full_rect.w, &full_rect.h);
@@ -3742,6 +3759,61 @@ bool SDL_UpdateWindowSurfaceRects(SDL_Window *window, const SDL_Rect *rects,
     return _this->UpdateWindowFramebuffer(_this, window, rects, numrects);
 }
 
+bool SDL_SetWindowSurfaceDamageTracking(SDL_Window *window, bool enabled)
+{
+    CHECK_WINDOW_MAGIC(window, false);
+
+    if (window->surface && !SDL_SetSurfaceDamageTracking(window->surface, enabled)) {
+        return false;
+    }
+    window->surface_damage_tracking = enabled;
+    return true;
+}
+
+bool SDL_AddWindowSurfaceDamage(SDL_Window *window, const SDL_Rect *rect)
+{
+    CHECK_WINDOW_MAGIC(window, false);
+
+    if (window->surface) {
+        SDL_AddSurfaceDamage(window->surface, rect);
+    }
+    return true;
+}
+
+SDL_Rect *SDL_GetWindowSurfaceDamage(SDL_Window *window, int *count)
+{
+    SDL_Rect *rects;
+    int num_rects = 0;
+
+    if (count) {
+        *count = 0;
+    }
+
+    CHECK_WINDOW_MAGIC(window, NULL);
+
+    if (!window->surface_damage_tracking) {
+        SDL_SetError("Window surface damage tracking is not enabled");
+        return NULL;
+    }
+
+    if (window->surface && window->surface->damage) {
+        num_rects = window->surface->damage->num_rects;
+    }
+    rects = (SDL_Rect *)SDL_malloc((num_rects + 1) * sizeof(*rects));
+    if (!rects) {
+        return NULL;
+    }
+    if (num_rects > 0) {
+        SDL_memcpy(rects, window->surface->damage->rects, num_rects * sizeof(*rects));
+    }
+    SDL_zero(rects[num_rects]);
+
+    if (count) {
+        *count = num_rects;
+    }
+    return rects;
+}
+
 bool SDL_DestroyWindowSurface(SDL_Window *window)
 {
     CHECK_WINDOW_MAGIC(window, false);
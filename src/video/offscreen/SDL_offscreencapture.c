@@ -0,0 +1,417 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifdef SDL_VIDEO_DRIVER_OFFSCREEN
+
+/* Saving frames for the offscreen video driver.
+ *
+ * Frames are either written as they are presented, or copied into a ring of
+ * preallocated surfaces and written by a background thread, so rendering
+ * isn't limited by the speed of the encoder and the disk.
+ */
+
+#include "../SDL_sysvideo.h"
+#include "../../SDL_hints_c.h"
+#include "SDL_offscreencapture_c.h"
+
+#define OFFSCREEN_MAX_CAPTURE_BUFFERS 64
+
+typedef enum OFFSCREEN_CaptureFormat
+{
+    OFFSCREEN_CAPTURE_BMP,
+    OFFSCREEN_CAPTURE_PNG,
+    OFFSCREEN_CAPTURE_RAW,
+    OFFSCREEN_CAPTURE_Y4M
+} OFFSCREEN_CaptureFormat;
+
+typedef struct OFFSCREEN_CaptureBuffer
+{
+    SDL_Surface *surface;
+    int frame_number;
+} OFFSCREEN_CaptureBuffer;
+
+struct OFFSCREEN_Capture
+{
+    SDL_Window *window;
+    SDL_WindowID window_id;
+    OFFSCREEN_CaptureFormat format;
+    int frame_number;
+    Sint64 saved_frames;
+    Sint64 dropped_frames;
+
+    // The ring of frames waiting to be written, if saving in the background
+    SDL_Thread *thread;
+    SDL_Mutex *lock;
+    SDL_Condition *frame_queued;
+    SDL_Condition *frame_written;
+    OFFSCREEN_CaptureBuffer *buffers;
+    int num_buffers;
+    int read_index;
+    int write_index;
+    int num_queued;
+    bool drop_frames;
+    bool quit;
+
+    // The output for formats that append frames to a single file
+    SDL_IOStream *stream;
+    int stream_w;
+    int stream_h;
+    Uint8 *yuv;
+    size_t yuv_size;
+};
+
+static OFFSCREEN_CaptureFormat OFFSCREEN_GetCaptureFormat(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_FORMAT);
+
+    if (hint) {
+        if (SDL_strcasecmp(hint, "png") == 0) {
+            return OFFSCREEN_CAPTURE_PNG;
+        } else if (SDL_strcasecmp(hint, "raw") == 0) {
+            return OFFSCREEN_CAPTURE_RAW;
+        } else if (SDL_strcasecmp(hint, "y4m") == 0) {
+            return OFFSCREEN_CAPTURE_Y4M;
+        }
+    }
+    return OFFSCREEN_CAPTURE_BMP;
+}
+
+static bool OFFSCREEN_OpenCaptureStream(OFFSCREEN_Capture *capture, SDL_Surface *surface, int frame_number)
+{
+    char file[128];
+
+    if (capture->stream) {
+        if (surface->w == capture->stream_w && surface->h == capture->stream_h) {
+            return true;
+        }
+
+        // The frame size changed, start a new file
+        SDL_CloseIO(capture->stream);
+        capture->stream = NULL;
+    }
+
+    if (capture->format == OFFSCREEN_CAPTURE_Y4M) {
+        (void)SDL_snprintf(file, sizeof(file), "SDL_window%" SDL_PRIu32 "-%8.8d.y4m",
+                           capture->window_id, frame_number);
+    } else {
+        (void)SDL_snprintf(file, sizeof(file), "SDL_window%" SDL_PRIu32 "-%8.8d-%dx%d.raw",
+                           capture->window_id, frame_number, surface->w, surface->h);
+    }
+    capture->stream = SDL_IOFromFile(file, "wb");
+    if (!capture->stream) {
+        return false;
+    }
+    capture->stream_w = surface->w;
+    capture->stream_h = surface->h;
+
+    if (capture->format == OFFSCREEN_CAPTURE_Y4M) {
+        // The frames are converted to full range BT.601, which is what C420jpeg means to most readers
+        if (!SDL_IOprintf(capture->stream, "YUV4MPEG2 W%d H%d F60:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n", surface->w, surface->h)) {
+            SDL_CloseIO(capture->stream);
+            capture->stream = NULL;
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool OFFSCREEN_WriteRawFrame(OFFSCREEN_Capture *capture, SDL_Surface *surface)
+{
+    const size_t length = (size_t)surface->w * SDL_BYTESPERPIXEL(surface->format);
+    const Uint8 *src = (const Uint8 *)surface->pixels;
+    int row;
+
+    if (length == (size_t)surface->pitch) {
+        return SDL_WriteIO(capture->stream, src, length * surface->h) == length * surface->h;
+    }
+    for (row = 0; row < surface->h; ++row) {
+        if (SDL_WriteIO(capture->stream, src, length) != length) {
+            return false;
+        }
+        src += surface->pitch;
+    }
+    return true;
+}
+
+static bool OFFSCREEN_WriteY4MFrame(OFFSCREEN_Capture *capture, SDL_Surface *surface)
+{
+    const size_t size = (size_t)surface->w * surface->h + 2 * ((size_t)((surface->w + 1) / 2) * ((surface->h + 1) / 2));
+    static const char frame_header[] = "FRAME\n";
+
+    if (size > capture->yuv_size) {
+        Uint8 *yuv = (Uint8 *)SDL_realloc(capture->yuv, size);
+        if (!yuv) {
+            return false;
+        }
+        capture->yuv = yuv;
+        capture->yuv_size = size;
+    }
+
+    if (!SDL_ConvertPixelsAndColorspace(surface->w, surface->h,
+                                        surface->format, SDL_GetSurfaceColorspace(surface), 0, surface->pixels, surface->pitch,
+                                        SDL_PIXELFORMAT_IYUV, SDL_COLORSPACE_JPEG, 0, capture->yuv, surface->w)) {
+        return false;
+    }
+    if (SDL_WriteIO(capture->stream, frame_header, sizeof(frame_header) - 1) != sizeof(frame_header) - 1 ||
+        SDL_WriteIO(capture->stream, capture->yuv, size) != size) {
+        return false;
+    }
+    return true;
+}
+
+static bool OFFSCREEN_WriteFrame(OFFSCREEN_Capture *capture, SDL_Surface *surface, int frame_number)
+{
+    char file[128];
+    bool result;
+
+    switch (capture->format) {
+    case OFFSCREEN_CAPTURE_PNG:
+        (void)SDL_snprintf(file, sizeof(file), "SDL_window%" SDL_PRIu32 "-%8.8d.png",
+                           capture->window_id, frame_number);
+        result = SDL_SavePNG(surface, file);
+        break;
+    case OFFSCREEN_CAPTURE_RAW:
+        result = OFFSCREEN_OpenCaptureStream(capture, surface, frame_number) &&
+                 OFFSCREEN_WriteRawFrame(capture, surface);
+        break;
+    case OFFSCREEN_CAPTURE_Y4M:
+        result = OFFSCREEN_OpenCaptureStream(capture, surface, frame_number) &&
+                 OFFSCREEN_WriteY4MFrame(capture, surface);
+        break;
+    default:
+        (void)SDL_snprintf(file, sizeof(file), "SDL_window%" SDL_PRIu32 "-%8.8d.bmp",
+                           capture->window_id, frame_number);
+        result = SDL_SaveBMP(surface, file);
+        break;
+    }
+    return result;
+}
+
+static int SDLCALL OFFSCREEN_CaptureThread(void *data)
+{
+    OFFSCREEN_Capture *capture = (OFFSCREEN_Capture *)data;
+
+    SDL_LockMutex(capture->lock);
+    for ( ; ; ) {
+        OFFSCREEN_CaptureBuffer *buffer;
+
+        while (capture->num_queued == 0 && !capture->quit) {
+            SDL_WaitCondition(capture->frame_queued, capture->lock);
+        }
+        if (capture->num_queued == 0) {
+            // We've been asked to quit and all the queued frames are written
+            break;
+        }
+
+        // The buffer at the read index isn't touched by the renderer until we release it
+        buffer = &capture->buffers[capture->read_index];
+        SDL_UnlockMutex(capture->lock);
+
+        if (!OFFSCREEN_WriteFrame(capture, buffer->surface, buffer->frame_number)) {
+            // There's nobody to return the error to, so log it
+            SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Couldn't save frame %d of window %" SDL_PRIu32 ": %s",
+                         buffer->frame_number, capture->window_id, SDL_GetError());
+        }
+
+        SDL_LockMutex(capture->lock);
+        capture->read_index = (capture->read_index + 1) % capture->num_buffers;
+        --capture->num_queued;
+        SDL_SignalCondition(capture->frame_written);
+    }
+    SDL_UnlockMutex(capture->lock);
+
+    return 0;
+}
+
+static bool OFFSCREEN_StartCaptureThread(OFFSCREEN_Capture *capture, int num_buffers)
+{
+    capture->buffers = (OFFSCREEN_CaptureBuffer *)SDL_calloc(num_buffers, sizeof(*capture->buffers));
+    capture->lock = SDL_CreateMutex();
+    capture->frame_queued = SDL_CreateCondition();
+    capture->frame_written = SDL_CreateCondition();
+    if (!capture->buffers || !capture->lock || !capture->frame_queued || !capture->frame_written) {
+        return false;
+    }
+    capture->num_buffers = num_buffers;
+
+    capture->thread = SDL_CreateThread(OFFSCREEN_CaptureThread, "SDLOffscreenCapture", capture);
+    if (!capture->thread) {
+        return false;
+    }
+    return true;
+}
+
+static void OFFSCREEN_StopCaptureThread(OFFSCREEN_Capture *capture)
+{
+    int i;
+
+    if (capture->thread) {
+        SDL_LockMutex(capture->lock);
+        capture->quit = true;
+        SDL_SignalCondition(capture->frame_queued);
+        SDL_UnlockMutex(capture->lock);
+
+        SDL_WaitThread(capture->thread, NULL);
+        capture->thread = NULL;
+    }
+
+    if (capture->buffers) {
+        for (i = 0; i < capture->num_buffers; ++i) {
+            SDL_DestroySurface(capture->buffers[i].surface);
+        }
+        SDL_free(capture->buffers);
+        capture->buffers = NULL;
+    }
+    capture->num_buffers = 0;
+
+    SDL_DestroyCondition(capture->frame_written);
+    capture->frame_written = NULL;
+    SDL_DestroyCondition(capture->frame_queued);
+    capture->frame_queued = NULL;
+    SDL_DestroyMutex(capture->lock);
+    capture->lock = NULL;
+}
+
+OFFSCREEN_Capture *OFFSCREEN_CreateCapture(SDL_Window *window)
+{
+    OFFSCREEN_Capture *capture;
+    int num_buffers;
+
+    capture = (OFFSCREEN_Capture *)SDL_calloc(1, sizeof(*capture));
+    if (!capture) {
+        return NULL;
+    }
+    capture->window = window;
+    capture->window_id = SDL_GetWindowID(window);
+    capture->format = OFFSCREEN_GetCaptureFormat();
+    capture->drop_frames = SDL_GetHintBoolean(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_DROP, false);
+
+    num_buffers = SDL_GetStringInteger(SDL_GetHint(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_BUFFERS), 0);
+    if (num_buffers > 0) {
+        num_buffers = SDL_min(num_buffers, OFFSCREEN_MAX_CAPTURE_BUFFERS);
+        if (!OFFSCREEN_StartCaptureThread(capture, num_buffers)) {
+            // Fall back to writing frames as they are presented
+            OFFSCREEN_StopCaptureThread(capture);
+        }
+    }
+    return capture;
+}
+
+// Returns false on error, and sets *queued to false if the frame was dropped
+static bool OFFSCREEN_QueueFrame(OFFSCREEN_Capture *capture, SDL_Surface *surface, int frame_number, bool *queued)
+{
+    OFFSCREEN_CaptureBuffer *buffer;
+
+    *queued = false;
+
+    SDL_LockMutex(capture->lock);
+    if (capture->num_queued == capture->num_buffers) {
+        if (capture->drop_frames) {
+            SDL_UnlockMutex(capture->lock);
+            return true;
+        }
+        while (capture->num_queued == capture->num_buffers) {
+            SDL_WaitCondition(capture->frame_written, capture->lock);
+        }
+    }
+    SDL_UnlockMutex(capture->lock);
+
+    // The buffer at the write index is free until we queue it
+    buffer = &capture->buffers[capture->write_index];
+    if (!buffer->surface ||
+        buffer->surface->w != surface->w ||
+        buffer->surface->h != surface->h ||
+        buffer->surface->format != surface->format) {
+        SDL_DestroySurface(buffer->surface);
+        buffer->surface = SDL_CreateSurface(surface->w, surface->h, surface->format);
+        if (!buffer->surface) {
+            return false;
+        }
+    }
+    if (!SDL_ConvertPixels(surface->w, surface->h,
+                           surface->format, surface->pixels, surface->pitch,
+                           buffer->surface->format, buffer->surface->pixels, buffer->surface->pitch)) {
+        return false;
+    }
+    buffer->frame_number = frame_number;
+
+    SDL_LockMutex(capture->lock);
+    capture->write_index = (capture->write_index + 1) % capture->num_buffers;
+    ++capture->num_queued;
+    SDL_SignalCondition(capture->frame_queued);
+    SDL_UnlockMutex(capture->lock);
+
+    *queued = true;
+    return true;
+}
+
+bool OFFSCREEN_CaptureFrame(OFFSCREEN_Capture *capture, SDL_Surface *surface)
+{
+    const int frame_number = ++capture->frame_number;
+    SDL_PropertiesID props;
+    bool queued = true;
+    bool result;
+
+    if (capture->thread) {
+        result = OFFSCREEN_QueueFrame(capture, surface, frame_number, &queued);
+        if (!result) {
+            // Failures aren't dropped frames, the error is returned to the application
+            return false;
+        }
+    } else {
+        result = OFFSCREEN_WriteFrame(capture, surface, frame_number);
+        if (!result) {
+            // Saving frames is a debugging aid, don't fail the window update over it
+            SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Couldn't save frame %d of window %" SDL_PRIu32 ": %s",
+                         frame_number, SDL_GetWindowID(capture->window), SDL_GetError());
+            return true;
+        }
+    }
+    if (queued) {
+        ++capture->saved_frames;
+    } else {
+        ++capture->dropped_frames;
+    }
+
+    props = SDL_GetWindowProperties(capture->window);
+    SDL_SetNumberProperty(props, SDL_PROP_WINDOW_OFFSCREEN_SAVED_FRAMES_NUMBER, capture->saved_frames);
+    SDL_SetNumberProperty(props, SDL_PROP_WINDOW_OFFSCREEN_DROPPED_FRAMES_NUMBER, capture->dropped_frames);
+    return true;
+}
+
+void OFFSCREEN_DestroyCapture(OFFSCREEN_Capture *capture)
+{
+    if (!capture) {
+        return;
+    }
+
+    // This waits for any queued frames to be written
+    OFFSCREEN_StopCaptureThread(capture);
+
+    if (capture->stream) {
+        SDL_CloseIO(capture->stream);
+    }
+    SDL_free(capture->yuv);
+    SDL_free(capture);
+}
+
+#endif // SDL_VIDEO_DRIVER_OFFSCREEN
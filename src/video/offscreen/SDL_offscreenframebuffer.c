@@ -24,7 +24,9 @@
 
 #include "../SDL_sysvideo.h"
 #include "../../SDL_properties_c.h"
+#include "../SDL_egl_c.h"
 #include "SDL_offscreenframebuffer_c.h"
+#include "SDL_offscreenwindow.h"
 
 #define OFFSCREEN_SURFACE "SDL.internal.window.surface"
 
@@ -53,7 +55,7 @@ bool SDL_OFFSCREEN_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *w
 
 bool SDL_OFFSCREEN_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, const SDL_Rect *rects, int numrects)
 {
-    static int frame_number;
+    SDL_WindowData *data = window->internal;
     SDL_Surface *surface;
 
     surface = (SDL_Surface *)SDL_GetPointerProperty(SDL_GetWindowProperties(window), OFFSCREEN_SURFACE, NULL);
@@ -63,10 +65,15 @@ bool SDL_OFFSCREEN_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *w
 
     // Send the data to the display
     if (SDL_GetHintBoolean(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES, false)) {
-        char file[128];
-        (void)SDL_snprintf(file, sizeof(file), "SDL_window%" SDL_PRIu32 "-%8.8d.bmp",
-                           SDL_GetWindowID(window), ++frame_number);
-        SDL_SaveBMP(surface, file);
+        if (!data->capture) {
+            data->capture = OFFSCREEN_CreateCapture(window);
+            if (!data->capture) {
+                return false;
+            }
+        }
+        if (!OFFSCREEN_CaptureFrame(data->capture, surface)) {
+            return false;
+        }
     }
     return true;
 }
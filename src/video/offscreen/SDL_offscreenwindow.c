@@ -74,6 +74,7 @@ void OFFSCREEN_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window)
     SDL_WindowData *offscreen_window = window->internal;
 
     if (offscreen_window) {
+        OFFSCREEN_DestroyCapture(offscreen_window->capture);
 #ifdef SDL_VIDEO_OPENGL_EGL
         SDL_EGL_DestroySurface(_this, offscreen_window->egl_surface);
 #endif
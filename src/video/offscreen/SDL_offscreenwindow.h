@@ -24,10 +24,12 @@
 #define SDL_offscreenwindow_h
 
 #include "SDL_offscreenvideo.h"
+#include "SDL_offscreencapture_c.h"
 
 struct SDL_WindowData
 {
     SDL_Window *sdl_window;
+    OFFSCREEN_Capture *capture;
 #ifdef SDL_VIDEO_OPENGL_EGL
     EGLSurface egl_surface;
 #endif
@@ -36,6 +36,7 @@
 #include "SDL_x11settings.h"
 #include "../SDL_clipboard_c.h"
 #include "SDL_x11xsync.h"
+#include "SDL_x11framebuffer.h"
 #include "../../core/unix/SDL_poll.h"
 #include "../../events/SDL_events_c.h"
 #include "../../events/SDL_mouse_c.h"
@@ -1291,6 +1292,17 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
     }
 #endif
 
+#ifndef NO_SHARED_MEMORY
+    if (videodata->shm_event_base && (xevent->type == (videodata->shm_event_base + ShmCompletion))) {
+        data = X11_FindWindow(_this, xevent->xany.window);
+        if (data) {
+            XShmCompletionEvent *ev = (XShmCompletionEvent *)xevent;
+            X11_HandleShmCompletion(data, ev->shmseg, ev->serial);
+        }
+        return;
+    }
+#endif
+
 #ifdef DEBUG_XEVENTS
     SDL_Log("X11 event type = %d display = %p window = 0x%lx",
            xevent->type, xevent->xany.display, xevent->xany.window);
@@ -25,9 +25,17 @@
 #include "SDL_x11video.h"
 #include "SDL_x11framebuffer.h"
 #include "SDL_x11xsync.h"
+#include "../../core/unix/SDL_poll.h"
+#include "../../SDL_hints_c.h"
 
 #ifndef NO_SHARED_MEMORY
 
+// Updates with more rectangles than this are sent as a single rectangle
+#define X11_MAX_SHM_DAMAGE_RECTS 16
+
+// How long to wait for the server to release a buffer before syncing
+#define X11_SHM_COMPLETION_TIMEOUT 100
+
 // Shared memory error handler routine
 static int shm_error;
 static int (*X_handler)(Display *, XErrorEvent *) = NULL;
@@ -46,6 +54,200 @@ static bool have_mitshm(Display *dpy)
     return X11_XShmQueryExtension(dpy) ? SDL_X11_HAVE_SHM : false;
 }
 
+static XImage *create_shm_image(Display *display, SDL_WindowData *data, XVisualInfo *vinfo,
+                                int w, int h, int pitch, XShmSegmentInfo *shminfo)
+{
+    XImage *ximage;
+
+    shminfo->shmid = shmget(IPC_PRIVATE, (size_t)h * pitch, IPC_CREAT | 0777);
+    if (shminfo->shmid >= 0) {
+        shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
+        shminfo->readOnly = False;
+        if (shminfo->shmaddr != (char *)-1) {
+            shm_error = False;
+            X_handler = X11_XSetErrorHandler(shm_errhandler);
+            X11_XShmAttach(display, shminfo);
+            X11_XSync(display, False);
+            X11_XSetErrorHandler(X_handler);
+            if (shm_error) {
+                shmdt(shminfo->shmaddr);
+            }
+        } else {
+            shm_error = True;
+        }
+        shmctl(shminfo->shmid, IPC_RMID, NULL);
+    } else {
+        shm_error = True;
+    }
+    if (shm_error) {
+        return NULL;
+    }
+
+    ximage = X11_XShmCreateImage(display, data->visual,
+                                 vinfo->depth, ZPixmap,
+                                 shminfo->shmaddr, shminfo,
+                                 w, h);
+    if (!ximage) {
+        X11_XShmDetach(display, shminfo);
+        X11_XSync(display, False);
+        shmdt(shminfo->shmaddr);
+        return NULL;
+    }
+    ximage->byte_order = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? MSBFirst : LSBFirst;
+    return ximage;
+}
+
+static void destroy_shm_buffers(Display *display, SDL_WindowData *data)
+{
+    int i;
+
+    for (i = 0; i < data->num_shm_buffers; ++i) {
+        XDestroyImage(data->shm_buffers[i].ximage);
+        X11_XShmDetach(display, &data->shm_buffers[i].shminfo);
+    }
+    X11_XSync(display, False);
+    for (i = 0; i < data->num_shm_buffers; ++i) {
+        shmdt(data->shm_buffers[i].shminfo.shmaddr);
+    }
+    SDL_zeroa(data->shm_buffers);
+    data->num_shm_buffers = 0;
+    data->next_shm_buffer = 0;
+}
+
+static bool create_shm_buffers(Display *display, SDL_WindowData *data, XVisualInfo *vinfo,
+                               int w, int h, int pitch, int num_buffers)
+{
+    X11_ShmBuffer *buffer;
+
+    while (data->num_shm_buffers < num_buffers) {
+        buffer = &data->shm_buffers[data->num_shm_buffers];
+        buffer->ximage = create_shm_image(display, data, vinfo, w, h, pitch, &buffer->shminfo);
+        if (!buffer->ximage) {
+            destroy_shm_buffers(display, data);
+            return false;
+        }
+        ++data->num_shm_buffers;
+    }
+    data->videodata->shm_event_base = X11_XShmGetEventBase(display);
+    return true;
+}
+
+void X11_HandleShmCompletion(SDL_WindowData *data, unsigned long shmseg, unsigned long serial)
+{
+    int i;
+
+    for (i = 0; i < data->num_shm_buffers; ++i) {
+        X11_ShmBuffer *buffer = &data->shm_buffers[i];
+
+        // Completions for earlier updates of this buffer don't free it.
+        // The server only sends the low 32 bits of the serial, so compare
+        // them with a signed difference in case they wrapped around.
+        if (buffer->busy && buffer->shminfo.shmseg == shmseg &&
+            (Sint32)((Uint32)serial - (Uint32)buffer->serial) >= 0) {
+            buffer->busy = false;
+        }
+    }
+}
+
+static Bool is_shm_completion(Display *display, XEvent *event, XPointer arg)
+{
+    SDL_WindowData *data = (SDL_WindowData *)arg;
+
+    return event->type == (data->videodata->shm_event_base + ShmCompletion) &&
+           event->xany.window == data->xwindow;
+}
+
+static X11_ShmBuffer *get_free_shm_buffer(Display *display, SDL_WindowData *data)
+{
+    X11_ShmBuffer *buffer = &data->shm_buffers[data->next_shm_buffer];
+    const Uint64 timeout = SDL_GetTicksNS() + SDL_MS_TO_NS(X11_SHM_COMPLETION_TIMEOUT);
+    XEvent event;
+    int i;
+
+    while (buffer->busy) {
+        if (X11_XCheckIfEvent(display, &event, is_shm_completion, (XPointer)data)) {
+            XShmCompletionEvent *ev = (XShmCompletionEvent *)&event;
+            X11_HandleShmCompletion(data, ev->shmseg, ev->serial);
+            continue;
+        }
+
+        const Uint64 now = SDL_GetTicksNS();
+        if (now >= timeout ||
+            SDL_IOReady(ConnectionNumber(display), SDL_IOR_READ, (Sint64)(timeout - now)) <= 0) {
+            // Something went wrong, wait for the server to finish everything we've sent
+            X11_XSync(display, False);
+            for (i = 0; i < data->num_shm_buffers; ++i) {
+                data->shm_buffers[i].busy = false;
+            }
+        }
+    }
+    return buffer;
+}
+
+static void put_shm_buffer_rect(Display *display, SDL_WindowData *data, X11_ShmBuffer *buffer,
+                                const SDL_Rect *rect, bool last)
+{
+    const int bpp = data->ximage->bits_per_pixel / 8;
+    const int src_pitch = data->ximage->bytes_per_line;
+    const int dst_pitch = buffer->ximage->bytes_per_line;
+    const char *src = data->ximage->data + (size_t)rect->y * src_pitch + (size_t)rect->x * bpp;
+    char *dst = buffer->ximage->data + (size_t)rect->y * dst_pitch + (size_t)rect->x * bpp;
+    const size_t length = (size_t)rect->w * bpp;
+    int row;
+
+    for (row = 0; row < rect->h; ++row) {
+        SDL_memcpy(dst, src, length);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+
+    if (last) {
+        // The server reports completion of this request when it's done with the buffer
+        buffer->serial = NextRequest(display);
+        buffer->busy = true;
+    }
+    X11_XShmPutImage(display, data->xwindow, data->gc, buffer->ximage,
+                     rect->x, rect->y, rect->x, rect->y, rect->w, rect->h, last ? True : False);
+}
+
+static void update_shm_buffers(Display *display, SDL_WindowData *data, const SDL_Rect *rects,
+                               int numrects, int window_w, int window_h)
+{
+    const SDL_Rect window_rect = { 0, 0, window_w, window_h };
+    SDL_Rect bounds, rect;
+    X11_ShmBuffer *buffer;
+    Sint64 area = 0;
+    int count = 0;
+    int i;
+
+    SDL_zero(bounds);
+    for (i = 0; i < numrects; ++i) {
+        if (SDL_GetRectIntersection(&rects[i], &window_rect, &rect)) {
+            SDL_GetRectUnion(&bounds, &rect, &bounds);
+            area += (Sint64)rect.w * rect.h;
+            ++count;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+
+    buffer = get_free_shm_buffer(display, data);
+
+    // Send a single rectangle if that doesn't copy much more than the damaged area
+    if (count > X11_MAX_SHM_DAMAGE_RECTS || area * 2 >= (Sint64)bounds.w * bounds.h) {
+        put_shm_buffer_rect(display, data, buffer, &bounds, true);
+    } else {
+        for (i = 0; i < numrects; ++i) {
+            if (SDL_GetRectIntersection(&rects[i], &window_rect, &rect)) {
+                put_shm_buffer_rect(display, data, buffer, &rect, (--count == 0));
+            }
+        }
+    }
+
+    data->next_shm_buffer = (data->next_shm_buffer + 1) % data->num_shm_buffers;
+}
+
 #endif // !NO_SHARED_MEMORY
 
 bool X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_PixelFormat *format,
@@ -85,42 +287,22 @@ bool X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL
     // Create the actual image
 #ifndef NO_SHARED_MEMORY
     if (have_mitshm(display)) {
-        XShmSegmentInfo *shminfo = &data->shminfo;
-
-        shminfo->shmid = shmget(IPC_PRIVATE, (size_t)h * (*pitch), IPC_CREAT | 0777);
-        if (shminfo->shmid >= 0) {
-            shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
-            shminfo->readOnly = False;
-            if (shminfo->shmaddr != (char *)-1) {
-                shm_error = False;
-                X_handler = X11_XSetErrorHandler(shm_errhandler);
-                X11_XShmAttach(display, shminfo);
-                X11_XSync(display, False);
-                X11_XSetErrorHandler(X_handler);
-                if (shm_error) {
-                    shmdt(shminfo->shmaddr);
-                }
-            } else {
-                shm_error = True;
+        int num_buffers = SDL_GetStringInteger(SDL_GetHint(SDL_HINT_VIDEO_X11_SHM_BUFFERS), 1);
+
+        if (num_buffers > 1) {
+            // The application draws into a regular image, and updates are copied to the shared buffers
+            num_buffers = SDL_min(num_buffers, X11_MAX_SHM_BUFFERS);
+            if (!create_shm_buffers(display, data, &vinfo, w, h, *pitch, num_buffers)) {
+                // Fall back to a single shared image rather than XPutImage()
+                num_buffers = 1;
             }
-            shmctl(shminfo->shmid, IPC_RMID, NULL);
-        } else {
-            shm_error = True;
         }
-        if (!shm_error) {
-            data->ximage = X11_XShmCreateImage(display, data->visual,
-                                               vinfo.depth, ZPixmap,
-                                               shminfo->shmaddr, shminfo,
-                                               w, h);
-            if (!data->ximage) {
-                X11_XShmDetach(display, shminfo);
-                X11_XSync(display, False);
-                shmdt(shminfo->shmaddr);
-            } else {
+        if (num_buffers <= 1) {
+            data->ximage = create_shm_image(display, data, &vinfo, w, h, *pitch, &data->shminfo);
+            if (data->ximage) {
                 // Done!
-                data->ximage->byte_order = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? MSBFirst : LSBFirst;
                 data->use_mitshm = true;
-                *pixels = shminfo->shmaddr;
+                *pixels = data->shminfo.shmaddr;
                 return true;
             }
         }
@@ -155,6 +337,18 @@ bool X11_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, con
     SDL_GetWindowSizeInPixels(window, &window_w, &window_h);
 
 #ifndef NO_SHARED_MEMORY
+    if (data->num_shm_buffers > 0) {
+        update_shm_buffers(display, data, rects, numrects, window_w, window_h);
+
+#ifdef SDL_VIDEO_DRIVER_X11_XSYNC
+        X11_HandlePresent(data->window);
+#endif /* SDL_VIDEO_DRIVER_X11_XSYNC */
+
+        // Don't wait for the server, the buffer is tracked with completion events
+        X11_XFlush(display);
+        return true;
+    }
+
     if (data->use_mitshm) {
         for (i = 0; i < numrects; ++i) {
             x = rects[i].x;
@@ -252,6 +446,11 @@ void X11_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
 
         data->ximage = NULL;
     }
+#ifndef NO_SHARED_MEMORY
+    if (data->num_shm_buffers > 0) {
+        destroy_shm_buffers(display, data);
+    }
+#endif // !NO_SHARED_MEMORY
     if (data->gc) {
         X11_XFreeGC(display, data->gc);
         data->gc = NULL;
@@ -30,5 +30,8 @@ extern bool X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *wind
 extern bool X11_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window,
                                         const SDL_Rect *rects, int numrects);
 extern void X11_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window);
+#ifndef NO_SHARED_MEMORY
+extern void X11_HandleShmCompletion(SDL_WindowData *data, unsigned long shmseg, unsigned long serial);
+#endif
 
 #endif // SDL_x11framebuffer_h_
@@ -248,6 +248,7 @@ SDL_X11_SYM(Status,XShmGetImage,(Display* a,Drawable b,XImage *c,int d, int e, u
 SDL_X11_SYM(XImage*,XShmCreateImage,(Display* a,Visual* b,unsigned int c,int d,char* e,XShmSegmentInfo* f,unsigned int g,unsigned int h))
 SDL_X11_SYM(Pixmap,XShmCreatePixmap,(Display *a,Drawable b,char* c,XShmSegmentInfo* d, unsigned int e, unsigned int f, unsigned int g))
 SDL_X11_SYM(Bool,XShmQueryExtension,(Display* a))
+SDL_X11_SYM(int,XShmGetEventBase,(Display* a))
 SDL_X11_SYM(Status,XShmQueryVersion,(Display* a, int *b, int *c, Bool *d))
 SDL_X11_SYM(int,XShmPixmapFormat,(Display* a))
 #endif
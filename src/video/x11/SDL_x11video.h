@@ -142,6 +142,7 @@ struct SDL_VideoData
     bool xinput_hierarchy_changed;
 
     int xrandr_event_base;
+    int shm_event_base;
     struct
     {
         bool xkb_enabled;
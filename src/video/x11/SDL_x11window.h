@@ -33,6 +33,19 @@
 #include <EGL/egl.h>
 #endif
 
+#define X11_MAX_SHM_BUFFERS 3
+
+#ifndef NO_SHARED_MEMORY
+// A shared memory image the X server copies to the window from
+typedef struct X11_ShmBuffer
+{
+    XShmSegmentInfo shminfo;
+    XImage *ximage;
+    unsigned long serial; // The request that will signal completion
+    bool busy;
+} X11_ShmBuffer;
+#endif
+
 typedef enum
 {
     PENDING_FOCUS_NONE,
@@ -50,6 +63,10 @@ struct SDL_WindowData
     // MIT shared memory extension information
     bool use_mitshm;
     XShmSegmentInfo shminfo;
+    // Buffers the server reads from while the application draws the next frame
+    int num_shm_buffers;
+    int next_shm_buffer;
+    X11_ShmBuffer shm_buffers[X11_MAX_SHM_BUFFERS];
 #endif
     XImage *ximage;
     GC gc;
@@ -959,6 +959,105 @@ static int SDLCALL pixels_allocFreePalette(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_MapRGBAArray and SDL_GetRGBAArray
+ *
+ * \sa SDL_MapRGBAArray
+ * \sa SDL_GetRGBAArray
+ */
+static int SDLCALL pixels_mapRGBAArray(void *arg)
+{
+    const int count = 1027; /* not a multiple of the SIMD width */
+    SDL_Color *colors = (SDL_Color *)SDL_malloc(count * sizeof(*colors));
+    SDL_Color *results = (SDL_Color *)SDL_malloc(count * sizeof(*results));
+    Uint32 *pixels = (Uint32 *)SDL_malloc(count * sizeof(*pixels));
+    const SDL_PixelFormatDetails *details;
+    SDL_Palette *palette;
+    bool result;
+    int i, j, mismatches;
+
+    if (!colors || !results || !pixels) {
+        SDLTest_AssertCheck(false, "Allocate test arrays");
+        SDL_free(colors);
+        SDL_free(results);
+        SDL_free(pixels);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < g_numAllFormats; i++) {
+        details = SDL_GetPixelFormatDetails(g_AllFormats[i]);
+        palette = NULL;
+        if (SDL_ISPIXELFORMAT_INDEXED(g_AllFormats[i])) {
+            palette = SDL_CreatePalette(1 << SDL_BITSPERPIXEL(g_AllFormats[i]));
+            for (j = 0; palette && j < palette->ncolors; j++) {
+                palette->colors[j].r = (Uint8)SDLTest_RandomUint8();
+                palette->colors[j].g = (Uint8)SDLTest_RandomUint8();
+                palette->colors[j].b = (Uint8)SDLTest_RandomUint8();
+                palette->colors[j].a = (Uint8)SDLTest_RandomUint8();
+            }
+        }
+
+        /* Random colors, with runs of the same color */
+        for (j = 0; j < count; j++) {
+            if (j > 0 && (j % 7) == 0) {
+                colors[j] = colors[j - 1];
+            } else {
+                colors[j].r = SDLTest_RandomUint8();
+                colors[j].g = SDLTest_RandomUint8();
+                colors[j].b = SDLTest_RandomUint8();
+                colors[j].a = SDLTest_RandomUint8();
+            }
+        }
+
+        result = SDL_MapRGBAArray(details, palette, colors, pixels, count);
+        SDLTest_AssertCheck(result, "Call to SDL_MapRGBAArray(%s), expected: true, got: %s", g_AllFormatsVerbose[i], result ? "true" : "false");
+        mismatches = 0;
+        for (j = 0; j < count; j++) {
+            if (pixels[j] != SDL_MapRGBA(details, palette, colors[j].r, colors[j].g, colors[j].b, colors[j].a)) {
+                mismatches++;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify SDL_MapRGBAArray(%s) matches SDL_MapRGBA, expected 0 mismatches, got %d", g_AllFormatsVerbose[i], mismatches);
+
+        /* Random pixel values, including bits outside of the format and indices outside of the palette */
+        for (j = 0; j < count; j++) {
+            pixels[j] = SDLTest_RandomUint32();
+            if (palette) {
+                pixels[j] %= (Uint32)palette->ncolors + 2;
+            }
+        }
+        result = SDL_GetRGBAArray(pixels, details, palette, results, count);
+        SDLTest_AssertCheck(result, "Call to SDL_GetRGBAArray(%s), expected: true, got: %s", g_AllFormatsVerbose[i], result ? "true" : "false");
+        mismatches = 0;
+        for (j = 0; j < count; j++) {
+            Uint8 r, g, b, a;
+
+            SDL_GetRGBA(pixels[j], details, palette, &r, &g, &b, &a);
+            if (results[j].r != r || results[j].g != g || results[j].b != b || results[j].a != a) {
+                mismatches++;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify SDL_GetRGBAArray(%s) matches SDL_GetRGBA, expected 0 mismatches, got %d", g_AllFormatsVerbose[i], mismatches);
+
+        SDL_DestroyPalette(palette);
+    }
+
+    /* Negative cases */
+    details = SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_INDEX8);
+    result = SDL_MapRGBAArray(details, NULL, colors, pixels, count);
+    SDLTest_AssertCheck(!result, "Call to SDL_MapRGBAArray() with an indexed format and no palette, expected: false, got: %s", result ? "true" : "false");
+    result = SDL_MapRGBAArray(NULL, NULL, colors, pixels, count);
+    SDLTest_AssertCheck(!result, "Call to SDL_MapRGBAArray() with no format, expected: false, got: %s", result ? "true" : "false");
+    result = SDL_GetRGBAArray(pixels, details, NULL, results, -1);
+    SDLTest_AssertCheck(!result, "Call to SDL_GetRGBAArray() with a negative count, expected: false, got: %s", result ? "true" : "false");
+
+    SDL_free(colors);
+    SDL_free(results);
+    SDL_free(pixels);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Call to SDL_SaveBMP and SDL_LoadBMP
  *
@@ -1179,6 +1278,108 @@ static int SDLCALL pixels_saveLoadPNG(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_SavePNG_IOWithProperties and SDL_LoadPNG_IO
+ *
+ * \sa SDL_SavePNG_IOWithProperties
+ * \sa SDL_LoadPNG_IO
+ */
+static int SDLCALL pixels_saveLoadPNGWithProperties(void *arg)
+{
+    static const char *filters[] = { "none", "sub", "up", "paeth", "adaptive" };
+    static const int levels[] = { 0, 1, 6, 9 };
+    static const int threads[] = { 1, 4 };
+    static const struct
+    {
+        SDL_PixelFormat format;
+        int w, h;
+    } images[] = {
+        { SDL_PIXELFORMAT_RGBA32, 37, 29 },
+        { SDL_PIXELFORMAT_RGBA32, 512, 300 },
+        { SDL_PIXELFORMAT_INDEX8, 1024, 600 },
+    };
+    SDL_PropertiesID props;
+    SDL_Surface *surface;
+    SDL_Surface *result;
+    SDL_IOStream *stream;
+    Uint64 seed = 0x1234;
+    size_t i, level, filter, thread;
+    int x, y, ret;
+
+    props = SDL_CreateProperties();
+    SDLTest_AssertCheck(props != 0, "Verify SDL_CreateProperties() succeeded");
+
+    for (i = 0; i < SDL_arraysize(images); i++) {
+        surface = SDL_CreateSurface(images[i].w, images[i].h, images[i].format);
+        SDLTest_AssertCheck(surface != NULL, "Verify surface is not NULL");
+        if (!surface) {
+            continue;
+        }
+
+        /* Fill with gradients and some noise, so every filter gets used */
+        if (SDL_ISPIXELFORMAT_INDEXED(images[i].format)) {
+            SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
+            SDLTest_AssertCheck(palette != NULL, "Verify SDL_CreateSurfacePalette() succeeded");
+            if (palette) {
+                for (x = 0; x < palette->ncolors; x++) {
+                    palette->colors[x].r = (Uint8)x;
+                    palette->colors[x].g = (Uint8)(255 - x);
+                    palette->colors[x].b = (Uint8)(x * 7);
+                    palette->colors[x].a = (Uint8)(x | 0x80);
+                }
+            }
+        }
+        for (y = 0; y < surface->h; y++) {
+            Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+            for (x = 0; x < surface->w * SDL_BYTESPERPIXEL(surface->format); x++) {
+                row[x] = (Uint8)(x + y * 3 + ((x % 7) == 0 ? SDL_rand_r(&seed, 256) : 0));
+            }
+        }
+
+        for (level = 0; level < SDL_arraysize(levels); level++) {
+            for (filter = 0; filter < SDL_arraysize(filters); filter++) {
+                for (thread = 0; thread < SDL_arraysize(threads); thread++) {
+                    SDL_SetNumberProperty(props, SDL_PROP_PNG_SAVE_COMPRESSION_LEVEL_NUMBER, levels[level]);
+                    SDL_SetStringProperty(props, SDL_PROP_PNG_SAVE_FILTER_STRING, filters[filter]);
+                    SDL_SetNumberProperty(props, SDL_PROP_PNG_SAVE_THREADS_NUMBER, threads[thread]);
+
+                    stream = SDL_IOFromDynamicMem();
+                    SDLTest_AssertCheck(stream != NULL, "Verify SDL_IOFromDynamicMem() succeeded");
+                    if (!stream) {
+                        continue;
+                    }
+                    ret = SDL_SavePNG_IOWithProperties(surface, stream, false, props);
+                    SDLTest_AssertCheck(ret, "Verify SDL_SavePNG_IOWithProperties() succeeded for %s %dx%d, level %d, filter %s, %d threads",
+                                        SDL_GetPixelFormatName(images[i].format), images[i].w, images[i].h,
+                                        levels[level], filters[filter], threads[thread]);
+
+                    SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+                    result = SDL_LoadPNG_IO(stream, true);
+                    SDLTest_AssertCheck(result != NULL, "Verify SDL_LoadPNG_IO() succeeded");
+                    if (result) {
+                        ret = SDLTest_CompareSurfaces(result, surface, 0);
+                        SDLTest_AssertCheck(ret == 0, "Verify loaded image matches, expected 0, got %d", ret);
+                        SDL_DestroySurface(result);
+                    }
+                }
+            }
+        }
+        SDL_DestroySurface(surface);
+    }
+
+    /* Invalid filter */
+    surface = SDL_CreateSurface(1, 1, SDL_PIXELFORMAT_RGBA32);
+    stream = SDL_IOFromDynamicMem();
+    SDL_SetStringProperty(props, SDL_PROP_PNG_SAVE_FILTER_STRING, "invalid");
+    ret = SDL_SavePNG_IOWithProperties(surface, stream, true, props);
+    SDLTest_AssertCheck(!ret, "Verify SDL_SavePNG_IOWithProperties() fails with an invalid filter");
+    SDL_DestroySurface(surface);
+
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -1194,6 +1395,10 @@ static const SDLTest_TestCaseReference pixelsTestAllocFreePalette = {
     pixels_allocFreePalette, "pixels_allocFreePalette", "Call to SDL_CreatePalette and SDL_DestroyPalette", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference pixelsTestMapRGBAArray = {
+    pixels_mapRGBAArray, "pixels_mapRGBAArray", "Call to SDL_MapRGBAArray and SDL_GetRGBAArray", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference pixelsTestSaveLoadBMP = {
     pixels_saveLoadBMP, "pixels_saveLoadBMP", "Call to SDL_SaveBMP and SDL_LoadBMP", TEST_ENABLED
 };
@@ -1202,13 +1407,19 @@ static const SDLTest_TestCaseReference pixelsTestSaveLoadPNG = {
     pixels_saveLoadPNG, "pixels_saveLoadPNG", "Call to SDL_SavePNG and SDL_LoadPNG", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference pixelsTestSaveLoadPNGWithProperties = {
+    pixels_saveLoadPNGWithProperties, "pixels_saveLoadPNGWithProperties", "Call to SDL_SavePNG_IOWithProperties and SDL_LoadPNG_IO", TEST_ENABLED
+};
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] = {
     &pixelsTestGetPixelFormatName,
     &pixelsTestGetPixelFormatDetails,
     &pixelsTestAllocFreePalette,
+    &pixelsTestMapRGBAArray,
     &pixelsTestSaveLoadBMP,
     &pixelsTestSaveLoadPNG,
+    &pixelsTestSaveLoadPNGWithProperties,
     NULL
 };
 
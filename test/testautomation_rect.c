@@ -2188,6 +2188,361 @@ static int SDLCALL rect_testGetRectAndLineIntersectionFloat(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Helper functions for SDL_Region tests */
+
+#define REGION_GRID_SIZE 48
+
+/* Fill a grid with the pixels covered by a list of rectangles */
+static void _fillRegionGrid(bool *grid, const SDL_Rect *rects, int count, int op)
+{
+    int i, x, y;
+
+    for (y = 0; y < REGION_GRID_SIZE; y++) {
+        for (x = 0; x < REGION_GRID_SIZE; x++) {
+            bool inside = false;
+            SDL_Point p;
+            p.x = x;
+            p.y = y;
+            for (i = 0; i < count; i++) {
+                if (SDL_PointInRect(&p, &rects[i])) {
+                    inside = true;
+                    break;
+                }
+            }
+            switch (op) {
+            case 0: /* set */
+                grid[y * REGION_GRID_SIZE + x] = inside;
+                break;
+            case 1: /* union */
+                grid[y * REGION_GRID_SIZE + x] |= inside;
+                break;
+            case 2: /* intersect */
+                grid[y * REGION_GRID_SIZE + x] &= inside;
+                break;
+            case 3: /* subtract */
+                grid[y * REGION_GRID_SIZE + x] &= !inside;
+                break;
+            }
+        }
+    }
+}
+
+/* Validate that a region is well formed and covers exactly the pixels in the grid */
+static void _validateRegion(SDL_Region *region, const bool *grid)
+{
+    bool covered[REGION_GRID_SIZE * REGION_GRID_SIZE];
+    const SDL_Rect *rects;
+    int count = -1;
+    int i, x, y;
+    bool sorted = true, banded = true, coalesced = true, overlap = false, match = true, points = true;
+
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck(rects != NULL, "Validate SDL_GetRegionRects() returned rectangles");
+    if (!rects) {
+        return;
+    }
+
+    for (i = 1; i < count; i++) {
+        const SDL_Rect *a = &rects[i - 1];
+        const SDL_Rect *b = &rects[i];
+        if (a->y == b->y) {
+            /* Same band: same height, left to right, not touching */
+            if (a->h != b->h) {
+                banded = false;
+            }
+            if (a->x + a->w >= b->x) {
+                sorted = false;
+            }
+        } else if (b->y < a->y + a->h) {
+            banded = false;
+        }
+    }
+
+    /* Adjacent bands with identical spans should have been merged */
+    for (i = 0; i < count;) {
+        int band_end = i, next_end;
+        while (band_end < count && rects[band_end].y == rects[i].y) {
+            band_end++;
+        }
+        next_end = band_end;
+        while (next_end < count && rects[next_end].y == rects[band_end].y) {
+            next_end++;
+        }
+        if (band_end < count && (next_end - band_end) == (band_end - i) &&
+            rects[band_end].y == rects[i].y + rects[i].h) {
+            int j;
+            bool same = true;
+            for (j = 0; j < band_end - i; j++) {
+                if (rects[i + j].x != rects[band_end + j].x || rects[i + j].w != rects[band_end + j].w) {
+                    same = false;
+                }
+            }
+            if (same) {
+                coalesced = false;
+            }
+        }
+        i = band_end;
+    }
+
+    SDL_zeroa(covered);
+    for (i = 0; i < count; i++) {
+        for (y = rects[i].y; y < rects[i].y + rects[i].h; y++) {
+            for (x = rects[i].x; x < rects[i].x + rects[i].w; x++) {
+                if (covered[y * REGION_GRID_SIZE + x]) {
+                    overlap = true;
+                }
+                covered[y * REGION_GRID_SIZE + x] = true;
+            }
+        }
+    }
+    for (y = 0; y < REGION_GRID_SIZE; y++) {
+        for (x = 0; x < REGION_GRID_SIZE; x++) {
+            SDL_Point p;
+            p.x = x;
+            p.y = y;
+            if (covered[y * REGION_GRID_SIZE + x] != grid[y * REGION_GRID_SIZE + x]) {
+                match = false;
+            }
+            if (SDL_PointInRegion(&p, region) != grid[y * REGION_GRID_SIZE + x]) {
+                points = false;
+            }
+        }
+    }
+
+    SDLTest_AssertCheck(sorted, "Validate region rectangles are sorted and don't touch within a band");
+    SDLTest_AssertCheck(banded, "Validate region rectangles are grouped into bands");
+    SDLTest_AssertCheck(coalesced, "Validate identical adjacent bands are merged");
+    SDLTest_AssertCheck(!overlap, "Validate region rectangles don't overlap");
+    SDLTest_AssertCheck(match, "Validate region covers the expected area");
+    SDLTest_AssertCheck(points, "Validate SDL_PointInRegion() matches the expected area");
+}
+
+static const SDL_Rect *_regionRect(SDL_Rect *rect, int x, int y, int w, int h)
+{
+    rect->x = x;
+    rect->y = y;
+    rect->w = w;
+    rect->h = h;
+    return rect;
+}
+
+static void _randomRegionRects(SDL_Rect *rects, int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        rects[i].x = SDLTest_RandomIntegerInRange(0, REGION_GRID_SIZE - 2);
+        rects[i].y = SDLTest_RandomIntegerInRange(0, REGION_GRID_SIZE - 2);
+        rects[i].w = SDLTest_RandomIntegerInRange(0, REGION_GRID_SIZE - rects[i].x);
+        rects[i].h = SDLTest_RandomIntegerInRange(0, REGION_GRID_SIZE - rects[i].y);
+    }
+}
+
+/* Test case functions */
+
+/**
+ * Tests SDL_Region operations with known results
+ */
+static int SDLCALL rect_testRegionOperations(void *arg)
+{
+    const SDL_Rect a = { 0, 0, 10, 10 };
+    const SDL_Rect b = { 5, 5, 10, 10 };
+    const SDL_Rect c = { 10, 0, 5, 5 };
+    SDL_Region *region;
+    SDL_Region *other;
+    const SDL_Rect *rects;
+    SDL_Rect bounds, r;
+    SDL_Point p;
+    int count = -1;
+
+    region = SDL_CreateRegion();
+    other = SDL_CreateRegion();
+    SDLTest_AssertPass("Call to SDL_CreateRegion()");
+    SDLTest_AssertCheck(region != NULL && other != NULL, "Validate result is not NULL");
+    if (!region || !other) {
+        SDL_DestroyRegion(region);
+        SDL_DestroyRegion(other);
+        return TEST_ABORTED;
+    }
+
+    SDLTest_AssertCheck(SDL_RegionEmpty(region), "Validate new region is empty");
+    SDLTest_AssertCheck(!SDL_GetRegionBounds(region, &bounds), "Validate SDL_GetRegionBounds() returns false for an empty region");
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck(rects != NULL && count == 0, "Validate empty region has 0 rectangles, got %d", count);
+
+    /* Union of two overlapping rectangles gives three bands */
+    SDL_UnionRegionRect(region, &a);
+    SDL_UnionRegionRect(region, &b);
+    SDLTest_AssertPass("Call to SDL_UnionRegionRect()");
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck(count == 3, "Validate union has 3 rectangles, got %d", count);
+    if (count == 3) {
+        SDLTest_AssertCheck(rects[0].x == 0 && rects[0].y == 0 && rects[0].w == 10 && rects[0].h == 5, "Validate top band");
+        SDLTest_AssertCheck(rects[1].x == 0 && rects[1].y == 5 && rects[1].w == 15 && rects[1].h == 5, "Validate middle band");
+        SDLTest_AssertCheck(rects[2].x == 5 && rects[2].y == 10 && rects[2].w == 10 && rects[2].h == 5, "Validate bottom band");
+    }
+    SDLTest_AssertCheck(SDL_GetRegionBounds(region, &bounds), "Validate SDL_GetRegionBounds() returns true");
+    SDLTest_AssertCheck(bounds.x == 0 && bounds.y == 0 && bounds.w == 15 && bounds.h == 15,
+                        "Validate bounds, got {%d, %d, %d, %d}", bounds.x, bounds.y, bounds.w, bounds.h);
+
+    /* Filling in the missing corner merges everything into one rectangle */
+    SDL_UnionRegionRect(region, &c);
+    SDL_UnionRegionRect(other, _regionRect(&r, 0, 10, 5, 5));
+    SDL_UnionRegion(region, other);
+    SDLTest_AssertPass("Call to SDL_UnionRegion()");
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck(count == 1 && rects[0].x == 0 && rects[0].y == 0 && rects[0].w == 15 && rects[0].h == 15,
+                        "Validate union merged into a single rectangle, got %d rectangles", count);
+
+    /* Punch a hole in the middle */
+    SDL_SubtractRegionRect(region, _regionRect(&r, 5, 5, 5, 5));
+    SDLTest_AssertPass("Call to SDL_SubtractRegionRect()");
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck(count == 4, "Validate subtract has 4 rectangles, got %d", count);
+    p.x = 7;
+    p.y = 7;
+    SDLTest_AssertCheck(!SDL_PointInRegion(&p, region), "Validate the hole is not in the region");
+    p.x = 2;
+    SDLTest_AssertCheck(SDL_PointInRegion(&p, region), "Validate the left side is in the region");
+
+    /* Intersect with the right half */
+    SDL_IntersectRegionRect(region, _regionRect(&r, 10, 0, 10, 20));
+    SDLTest_AssertPass("Call to SDL_IntersectRegionRect()");
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck(count == 1 && rects[0].x == 10 && rects[0].y == 0 && rects[0].w == 5 && rects[0].h == 15,
+                        "Validate intersection is the right column, got %d rectangles", count);
+
+    /* Translate */
+    SDL_TranslateRegion(region, -10, 5);
+    SDLTest_AssertPass("Call to SDL_TranslateRegion()");
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck(count == 1 && rects[0].x == 0 && rects[0].y == 5 && rects[0].w == 5 && rects[0].h == 15,
+                        "Validate translated region, got {%d, %d, %d, %d}", rects[0].x, rects[0].y, rects[0].w, rects[0].h);
+
+    /* Copy and subtract from itself */
+    SDL_CopyRegion(other, region);
+    SDLTest_AssertPass("Call to SDL_CopyRegion()");
+    SDL_SubtractRegion(region, other);
+    SDLTest_AssertPass("Call to SDL_SubtractRegion()");
+    SDLTest_AssertCheck(SDL_RegionEmpty(region), "Validate region minus its copy is empty");
+    SDLTest_AssertCheck(!SDL_RegionEmpty(other), "Validate copy is not empty");
+
+    /* Intersecting with an empty region empties it */
+    SDL_IntersectRegion(other, region);
+    SDLTest_AssertPass("Call to SDL_IntersectRegion()");
+    SDLTest_AssertCheck(SDL_RegionEmpty(other), "Validate intersection with an empty region is empty");
+
+    /* Empty rectangles are ignored */
+    SDL_UnionRegionRect(region, _regionRect(&r, 1, 1, 0, 5));
+    SDLTest_AssertCheck(SDL_RegionEmpty(region), "Validate adding an empty rectangle does nothing");
+
+    SDL_DestroyRegion(region);
+    SDL_DestroyRegion(other);
+    SDLTest_AssertPass("Call to SDL_DestroyRegion()");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests SDL_Region operations on random rectangles against a pixel grid
+ */
+static int SDLCALL rect_testRegionRandom(void *arg)
+{
+    bool grid[REGION_GRID_SIZE * REGION_GRID_SIZE];
+    SDL_Rect rects[64];
+    SDL_Region *region;
+    SDL_Region *other;
+    int iteration, i;
+
+    region = SDL_CreateRegion();
+    other = SDL_CreateRegion();
+    SDLTest_AssertCheck(region != NULL && other != NULL, "Validate SDL_CreateRegion() result is not NULL");
+    if (!region || !other) {
+        SDL_DestroyRegion(region);
+        SDL_DestroyRegion(other);
+        return TEST_ABORTED;
+    }
+
+    for (iteration = 0; iteration < 20; iteration++) {
+        int count = SDLTest_RandomIntegerInRange(1, SDL_arraysize(rects));
+
+        /* One rectangle at a time */
+        _randomRegionRects(rects, count);
+        SDL_ClearRegion(region);
+        for (i = 0; i < count; i++) {
+            SDL_UnionRegionRect(region, &rects[i]);
+        }
+        _fillRegionGrid(grid, rects, count, 0);
+        SDLTest_AssertPass("Validate union of %d rectangles", count);
+        _validateRegion(region, grid);
+
+        /* All rectangles at once */
+        SDL_ClearRegion(other);
+        SDL_UnionRegionRects(other, rects, count);
+        SDLTest_AssertPass("Validate SDL_UnionRegionRects() with %d rectangles", count);
+        _validateRegion(other, grid);
+
+        /* Intersect with another random region */
+        count = SDLTest_RandomIntegerInRange(1, 8);
+        _randomRegionRects(rects, count);
+        SDL_ClearRegion(other);
+        SDL_UnionRegionRects(other, rects, count);
+        SDL_IntersectRegion(region, other);
+        _fillRegionGrid(grid, rects, count, 2);
+        SDLTest_AssertPass("Validate intersection with %d rectangles", count);
+        _validateRegion(region, grid);
+
+        /* Add and subtract more */
+        count = SDLTest_RandomIntegerInRange(1, 8);
+        _randomRegionRects(rects, count);
+        SDL_ClearRegion(other);
+        SDL_UnionRegionRects(other, rects, count);
+        SDL_UnionRegion(region, other);
+        _fillRegionGrid(grid, rects, count, 1);
+        SDLTest_AssertPass("Validate union with %d rectangles", count);
+        _validateRegion(region, grid);
+
+        count = SDLTest_RandomIntegerInRange(1, 8);
+        _randomRegionRects(rects, count);
+        SDL_ClearRegion(other);
+        SDL_UnionRegionRects(other, rects, count);
+        SDL_SubtractRegion(region, other);
+        _fillRegionGrid(grid, rects, count, 3);
+        SDLTest_AssertPass("Validate subtraction of %d rectangles", count);
+        _validateRegion(region, grid);
+    }
+
+    SDL_DestroyRegion(region);
+    SDL_DestroyRegion(other);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Negative tests against SDL_Region functions with invalid parameters
+ */
+static int SDLCALL rect_testRegionParam(void *arg)
+{
+    SDL_Region *region = SDL_CreateRegion();
+    SDL_Rect rect = { 0, 0, 1, 1 };
+    SDL_Point p = { 0, 0 };
+
+    SDLTest_AssertCheck(!SDL_UnionRegionRect(NULL, &rect), "Check that function returns false when 1st parameter is NULL");
+    SDLTest_AssertCheck(!SDL_UnionRegionRect(region, NULL), "Check that function returns false when 2nd parameter is NULL");
+    SDLTest_AssertCheck(!SDL_UnionRegion(region, NULL), "Check that function returns false when 2nd parameter is NULL");
+    SDLTest_AssertCheck(!SDL_UnionRegionRects(region, NULL, 1), "Check that function returns false when rects is NULL");
+    SDLTest_AssertCheck(!SDL_UnionRegionRects(region, &rect, -1), "Check that function returns false when count is negative");
+    SDLTest_AssertCheck(SDL_UnionRegionRects(region, NULL, 0), "Check that function returns true when count is 0");
+    SDLTest_AssertCheck(!SDL_GetRegionBounds(region, NULL), "Check that function returns false when 2nd parameter is NULL");
+    SDLTest_AssertCheck(SDL_GetRegionRects(NULL, NULL) == NULL, "Check that function returns NULL when 1st parameter is NULL");
+    SDLTest_AssertCheck(!SDL_PointInRegion(&p, NULL), "Check that function returns false when region is NULL");
+    SDLTest_AssertCheck(SDL_RegionEmpty(NULL), "Check that a NULL region is empty");
+    SDL_DestroyRegion(NULL);
+    SDL_DestroyRegion(region);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Rect test cases */
@@ -2364,6 +2719,19 @@ static const SDLTest_TestCaseReference rectTestGetRectAndLineIntersectionFloat =
     rect_testGetRectAndLineIntersectionFloat, "rect_testGetRectAndLineIntersectionFloat", "Tests SDL_GetRectAndLineIntersectionFloat", TEST_ENABLED
 };
 
+/* SDL_Region */
+static const SDLTest_TestCaseReference rectTestRegionOperations = {
+    rect_testRegionOperations, "rect_testRegionOperations", "Tests SDL_Region operations with known results", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rectTestRegionRandom = {
+    rect_testRegionRandom, "rect_testRegionRandom", "Tests SDL_Region operations on random rectangles against a pixel grid", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rectTestRegionParam = {
+    rect_testRegionParam, "rect_testRegionParam", "Negative tests against SDL_Region functions with invalid parameters", TEST_ENABLED
+};
+
 /**
  * Sequence of Rect test cases; functions that handle simple rectangles including overlaps and merges.
  */
@@ -2408,6 +2776,9 @@ static const SDLTest_TestCaseReference *rectTests[] = {
     &rectTestGetRectUntionFloat,
     &rectTestGetRectEnclosingPointsFloat,
     &rectTestGetRectAndLineIntersectionFloat,
+    &rectTestRegionOperations,
+    &rectTestRegionRandom,
+    &rectTestRegionParam,
     NULL
 };
 
@@ -2102,6 +2102,1143 @@ static int SDLCALL render_testTextureState(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests that consecutive draws with the same state are merged into a single render command.
+ *
+ * \sa SDL_RenderFillRect
+ * \sa SDL_RenderGeometry
+ * \sa SDL_FlushRenderer
+ */
+static int SDLCALL render_testCommandCoalescing(void *arg)
+{
+    const int NUM_DRAWS = 100;
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    SDL_Vertex verts[3];
+    SDL_FRect rect;
+    SDL_Surface *surface;
+    Sint64 count;
+    Uint8 r, g, b, a;
+    int i, mismatches;
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_FlushRenderer(renderer);
+
+    /* Same color for every rect, these should be merged */
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, SDL_ALPHA_OPAQUE);
+    for (i = 0; i < NUM_DRAWS; ++i) {
+        rect.x = (float)(i % 10) * 2.0f;
+        rect.y = (float)(i / 10) * 2.0f;
+        rect.w = 1.0f;
+        rect.h = 1.0f;
+        SDL_RenderFillRect(renderer, &rect);
+    }
+    SDL_FlushRenderer(renderer);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_COMMAND_COUNT_NUMBER, -1);
+    SDLTest_AssertCheck(count > 0 && count < 10, "Verify rects with the same color are merged, expected fewer than 10 commands, got %" SDL_PRIs64, count);
+
+    /* Changing the color between draws prevents merging */
+    for (i = 0; i < NUM_DRAWS; ++i) {
+        SDL_SetRenderDrawColor(renderer, 0, (i & 1) ? 255 : 128, 0, SDL_ALPHA_OPAQUE);
+        rect.x = 1.0f + (float)(i % 10) * 2.0f;
+        rect.y = (float)(i / 10) * 2.0f;
+        rect.w = 1.0f;
+        rect.h = 1.0f;
+        SDL_RenderFillRect(renderer, &rect);
+    }
+    SDL_FlushRenderer(renderer);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_COMMAND_COUNT_NUMBER, -1);
+    SDLTest_AssertCheck(count >= NUM_DRAWS, "Verify rects with different colors aren't merged, expected at least %d commands, got %" SDL_PRIs64, NUM_DRAWS, count);
+
+    /* Geometry with the same state is merged too */
+    SDL_zeroa(verts);
+    for (i = 0; i < SDL_arraysize(verts); ++i) {
+        verts[i].color.b = 1.0f;
+        verts[i].color.a = 1.0f;
+    }
+    for (i = 0; i < NUM_DRAWS; ++i) {
+        const float x = (float)(i % 10) * 2.0f;
+        const float y = 1.0f + (float)(i / 10) * 2.0f;
+
+        verts[0].position.x = x;
+        verts[0].position.y = y;
+        verts[1].position.x = x + 2.0f;
+        verts[1].position.y = y;
+        verts[2].position.x = x;
+        verts[2].position.y = y + 2.0f;
+        SDL_RenderGeometry(renderer, NULL, verts, SDL_arraysize(verts), NULL, 0);
+    }
+    SDL_FlushRenderer(renderer);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_COMMAND_COUNT_NUMBER, -1);
+    SDLTest_AssertCheck(count > 0 && count < 10, "Verify geometry with the same state is merged, expected fewer than 10 commands, got %" SDL_PRIs64, count);
+
+    /* Make sure the merged draws were all rendered */
+    surface = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(surface != NULL, "Verify SDL_RenderReadPixels() result");
+    if (surface) {
+        mismatches = 0;
+        for (i = 0; i < NUM_DRAWS; ++i) {
+            const int x = (i % 10) * 2;
+            const int y = (i / 10) * 2;
+
+            SDL_ReadSurfacePixel(surface, x, y, &r, &g, &b, &a);
+            if (r != 255 || g != 0 || b != 0) {
+                ++mismatches;
+            }
+            SDL_ReadSurfacePixel(surface, x + 1, y, &r, &g, &b, &a);
+            if (r != 0 || g != ((i & 1) ? 255 : 128) || b != 0) {
+                ++mismatches;
+            }
+            SDL_ReadSurfacePixel(surface, x, y + 1, &r, &g, &b, &a);
+            if (r != 0 || g != 0 || b != 255) {
+                ++mismatches;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify all draws were rendered, expected 0 mismatched pixels, got %d", mismatches);
+        SDL_DestroySurface(surface);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Draws a scene exercising every software renderer command to a surface.
+ */
+static bool DrawSoftwareScene(SDL_Surface *target)
+{
+    SDL_Renderer *sw_renderer;
+    SDL_Texture *opaque, *translucent, *replacement, *indexed;
+    SDL_Surface *pattern;
+    SDL_Palette *palettes[2];
+    Uint8 indices[32 * 32];
+    SDL_FRect rect, src;
+    SDL_FPoint points[64];
+    Uint32 stripe[48 * 4];
+    SDL_Rect stripe_rect = { 0, 10, 48, 4 };
+    SDL_Vertex verts[6];
+    SDL_Rect clip;
+    int i, x, y;
+
+    sw_renderer = SDL_CreateSoftwareRenderer(target);
+    if (!sw_renderer) {
+        return false;
+    }
+
+    pattern = SDL_CreateSurface(48, 40, SDL_PIXELFORMAT_ARGB8888);
+    if (!pattern) {
+        SDL_DestroyRenderer(sw_renderer);
+        return false;
+    }
+    for (y = 0; y < pattern->h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)pattern->pixels + y * pattern->pitch);
+        for (x = 0; x < pattern->w; ++x) {
+            row[x] = ((Uint32)((x * y) & 0xFF) << 24) | ((Uint32)(x * 5) << 16) | ((Uint32)(y * 6) << 8) | (Uint32)((x + y) * 3);
+        }
+    }
+    /* Static textures without alpha are RLE encoded by the software renderer */
+    opaque = SDL_CreateTexture(sw_renderer, SDL_PIXELFORMAT_XRGB8888, SDL_TEXTUREACCESS_STATIC, pattern->w, pattern->h);
+    translucent = SDL_CreateTextureFromSurface(sw_renderer, pattern);
+    if (opaque) {
+        SDL_UpdateTexture(opaque, NULL, pattern->pixels, pattern->pitch);
+    }
+    SDL_DestroySurface(pattern);
+    if (!opaque || !translucent) {
+        SDL_DestroyRenderer(sw_renderer);
+        return false;
+    }
+
+    SDL_SetRenderDrawColor(sw_renderer, 20, 40, 60, 255);
+    SDL_RenderClear(sw_renderer);
+
+    /* Sprites crossing tile edges and the edges of the target */
+    for (i = 0; i < 40; ++i) {
+        rect.x = (float)((i * 37) % (target->w + 40) - 30);
+        rect.y = (float)((i * 53) % (target->h + 30) - 20);
+        rect.w = 48.0f;
+        rect.h = 40.0f;
+        SDL_SetTextureColorMod(translucent, 255, (Uint8)(i * 6), 200);
+        SDL_SetTextureAlphaMod(translucent, (Uint8)(255 - i * 3));
+        SDL_RenderTexture(sw_renderer, (i & 1) ? translucent : opaque, NULL, &rect);
+    }
+
+    /* Draw again after a texture used by tiles is updated, and another is replaced */
+    SDL_FlushRenderer(sw_renderer);
+    for (i = 0; i < SDL_arraysize(stripe); ++i) {
+        stripe[i] = 0xFF00C000 | (Uint32)i;
+    }
+    SDL_UpdateTexture(opaque, &stripe_rect, stripe, stripe_rect.w * sizeof(Uint32));
+    replacement = SDL_CreateTexture(sw_renderer, SDL_PIXELFORMAT_XRGB8888, SDL_TEXTUREACCESS_STATIC, stripe_rect.w, stripe_rect.h);
+    if (replacement) {
+        SDL_UpdateTexture(replacement, NULL, stripe, stripe_rect.w * sizeof(Uint32));
+    }
+    for (i = 0; i < 10; ++i) {
+        rect.x = (float)((i * 61) % target->w);
+        rect.y = (float)((i * 43) % target->h);
+        rect.w = 48.0f;
+        rect.h = 40.0f;
+        SDL_RenderTexture(sw_renderer, opaque, NULL, &rect);
+        rect.y += 20.0f;
+        rect.h = 4.0f;
+        SDL_RenderTexture(sw_renderer, replacement, NULL, &rect);
+    }
+    SDL_FlushRenderer(sw_renderer);
+    SDL_DestroyTexture(replacement);
+
+    /* Draw an indexed texture, then again after its palette is changed */
+    indexed = SDL_CreateTexture(sw_renderer, SDL_PIXELFORMAT_INDEX8, SDL_TEXTUREACCESS_STATIC, 32, 32);
+    palettes[0] = SDL_CreatePalette(256);
+    palettes[1] = SDL_CreatePalette(256);
+    if (indexed && palettes[0] && palettes[1]) {
+        for (i = 0; i < 256; ++i) {
+            palettes[0]->colors[i].r = (Uint8)i;
+            palettes[0]->colors[i].g = 0;
+            palettes[0]->colors[i].b = (Uint8)(255 - i);
+            palettes[0]->colors[i].a = 255;
+            palettes[1]->colors[i].r = 0;
+            palettes[1]->colors[i].g = (Uint8)i;
+            palettes[1]->colors[i].b = 128;
+            palettes[1]->colors[i].a = 255;
+        }
+        for (i = 0; i < SDL_arraysize(indices); ++i) {
+            indices[i] = (Uint8)(i * 7);
+        }
+        SDL_UpdateTexture(indexed, NULL, indices, 32);
+        for (i = 0; i < SDL_arraysize(palettes); ++i) {
+            SDL_SetTexturePalette(indexed, palettes[i]);
+            for (y = 0; y < target->h; y += 48) {
+                for (x = i * 16; x < target->w; x += 64) {
+                    rect.x = (float)x;
+                    rect.y = (float)y;
+                    rect.w = 32.0f;
+                    rect.h = 32.0f;
+                    SDL_RenderTexture(sw_renderer, indexed, NULL, &rect);
+                }
+            }
+            SDL_FlushRenderer(sw_renderer);
+        }
+    }
+    SDL_DestroyTexture(indexed);
+    SDL_DestroyPalette(palettes[0]);
+    SDL_DestroyPalette(palettes[1]);
+
+    /* Rects, opaque and blended */
+    SDL_SetRenderDrawBlendMode(sw_renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(sw_renderer, 200, 30, 30, 255);
+    for (i = 0; i < 30; ++i) {
+        rect.x = (float)((i * 71) % target->w);
+        rect.y = (float)((i * 29) % target->h);
+        rect.w = (float)(5 + i * 3);
+        rect.h = (float)(3 + i * 2);
+        SDL_RenderFillRect(sw_renderer, &rect);
+    }
+    SDL_SetRenderDrawBlendMode(sw_renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(sw_renderer, 30, 200, 90, 100);
+    rect.x = 10.0f;
+    rect.y = 15.0f;
+    rect.w = (float)target->w - 20.0f;
+    rect.h = (float)target->h / 2.0f;
+    SDL_RenderFillRect(sw_renderer, &rect);
+
+    /* Points and lines */
+    for (i = 0; i < SDL_arraysize(points); ++i) {
+        points[i].x = (float)((i * 97) % target->w);
+        points[i].y = (float)((i * 41) % target->h);
+    }
+    SDL_SetRenderDrawColor(sw_renderer, 255, 255, 0, 200);
+    SDL_RenderPoints(sw_renderer, points, SDL_arraysize(points));
+    SDL_RenderLines(sw_renderer, points, 16);
+
+    /* Scaled and rotated copies */
+    src.x = 4.0f;
+    src.y = 4.0f;
+    src.w = 30.0f;
+    src.h = 20.0f;
+    rect.x = 100.0f;
+    rect.y = 60.0f;
+    rect.w = 90.0f;
+    rect.h = 70.0f;
+    SDL_RenderTexture(sw_renderer, translucent, &src, &rect);
+    SDL_RenderTextureRotated(sw_renderer, opaque, NULL, &rect, 30.0, NULL, SDL_FLIP_HORIZONTAL);
+
+    /* Geometry in a clipped, offset viewport */
+    clip.x = 40;
+    clip.y = 30;
+    clip.w = target->w - 60;
+    clip.h = target->h - 50;
+    SDL_SetRenderViewport(sw_renderer, &clip);
+    clip.x = 10;
+    clip.y = 5;
+    clip.w = 150;
+    clip.h = 120;
+    SDL_SetRenderClipRect(sw_renderer, &clip);
+    SDL_zeroa(verts);
+    for (i = 0; i < SDL_arraysize(verts); ++i) {
+        verts[i].color.r = (float)(i % 3) / 2.0f;
+        verts[i].color.g = 1.0f - (float)(i % 2);
+        verts[i].color.b = 0.5f;
+        verts[i].color.a = 0.75f;
+    }
+    verts[0].position.x = -20.0f;
+    verts[0].position.y = 10.0f;
+    verts[1].position.x = 170.0f;
+    verts[1].position.y = 40.0f;
+    verts[2].position.x = 60.0f;
+    verts[2].position.y = 140.0f;
+    verts[3].position.x = 30.0f;
+    verts[3].position.y = 0.0f;
+    verts[3].tex_coord.x = 0.0f;
+    verts[3].tex_coord.y = 0.0f;
+    verts[4].position.x = 130.0f;
+    verts[4].position.y = 20.0f;
+    verts[4].tex_coord.x = 1.0f;
+    verts[4].tex_coord.y = 0.0f;
+    verts[5].position.x = 80.0f;
+    verts[5].position.y = 110.0f;
+    verts[5].tex_coord.x = 0.5f;
+    verts[5].tex_coord.y = 1.0f;
+    SDL_RenderGeometry(sw_renderer, NULL, verts, 3, NULL, 0);
+    SDL_RenderGeometry(sw_renderer, translucent, verts + 3, 3, NULL, 0);
+    SDL_SetRenderClipRect(sw_renderer, NULL);
+    SDL_SetRenderViewport(sw_renderer, NULL);
+
+    SDL_FlushRenderer(sw_renderer);
+    SDL_DestroyRenderer(sw_renderer);
+    return true;
+}
+
+/**
+ * Tests that drawing with several software renderer threads gives the same result as one thread.
+ *
+ * \sa SDL_HINT_RENDER_SOFTWARE_THREADS
+ * \sa SDL_CreateSoftwareRenderer
+ */
+static int SDLCALL render_testSoftwareThreads(void *arg)
+{
+    const SDL_PixelFormat formats[] = { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565 };
+    int i, y, mismatches;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        SDL_Surface *expected = SDL_CreateSurface(301, 203, formats[i]);
+        SDL_Surface *actual = SDL_CreateSurface(301, 203, formats[i]);
+        bool drawn;
+
+        SDLTest_AssertCheck(expected && actual, "Verify %s target surfaces were created", SDL_GetPixelFormatName(formats[i]));
+        if (!expected || !actual) {
+            SDL_DestroySurface(expected);
+            SDL_DestroySurface(actual);
+            continue;
+        }
+
+        SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, "1");
+        drawn = DrawSoftwareScene(expected);
+        SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, "4");
+        drawn = DrawSoftwareScene(actual) && drawn;
+        SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+        SDLTest_AssertCheck(drawn, "Verify the scene was drawn with one and four threads");
+
+        mismatches = 0;
+        for (y = 0; y < expected->h; ++y) {
+            const Uint8 *a = (const Uint8 *)expected->pixels + y * expected->pitch;
+            const Uint8 *b = (const Uint8 *)actual->pixels + y * actual->pitch;
+            if (SDL_memcmp(a, b, (size_t)expected->w * SDL_BYTESPERPIXEL(formats[i])) != 0) {
+                ++mismatches;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify drawing with four %s threads matches one thread, expected 0 mismatched rows, got %d", SDL_GetPixelFormatName(formats[i]), mismatches);
+
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Checks that the window surface damage is a single rectangle.
+ */
+static void CheckSoftwareDamage(SDL_Window *damage_window, const SDL_Rect *expected, const char *what)
+{
+    int count = 0;
+    SDL_Rect *rects = SDL_GetWindowSurfaceDamage(damage_window, &count);
+
+    SDLTest_AssertCheck(rects != NULL, "Verify SDL_GetWindowSurfaceDamage() after %s", what);
+    if (!rects) {
+        return;
+    }
+    if (expected) {
+        SDLTest_AssertCheck(count == 1, "Verify %s damaged one area, expected 1, got %d", what, count);
+        if (count == 1) {
+            SDLTest_AssertCheck(SDL_RectsEqual(&rects[0], expected),
+                                "Verify %s damaged (%d,%d %dx%d), got (%d,%d %dx%d)", what,
+                                expected->x, expected->y, expected->w, expected->h,
+                                rects[0].x, rects[0].y, rects[0].w, rects[0].h);
+        }
+    } else {
+        SDLTest_AssertCheck(count == 0, "Verify %s damaged nothing, expected 0, got %d", what, count);
+    }
+    SDL_free(rects);
+}
+
+/**
+ * Tests that the software renderer only damages the areas it draws to.
+ *
+ * \sa SDL_HINT_RENDER_SOFTWARE_DAMAGE_TRACKING
+ * \sa SDL_GetWindowSurfaceDamage
+ */
+static int SDLCALL render_testSoftwareDamage(void *arg)
+{
+    const SDL_Rect viewport = { 10, 20, 200, 100 };
+    const SDL_Rect full = { 0, 0, 320, 240 };
+    SDL_FRect rect = { 5.0f, 5.0f, 20.0f, 10.0f };
+    SDL_Rect expected;
+    SDL_Window *damage_window;
+    SDL_Renderer *sw_renderer;
+    SDL_Texture *texture;
+
+    damage_window = SDL_CreateWindow("render_testSoftwareDamage", full.w, full.h, 0);
+    SDLTest_AssertCheck(damage_window != NULL, "Verify window was created");
+    if (!damage_window) {
+        return TEST_ABORTED;
+    }
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_DAMAGE_TRACKING, "1");
+    sw_renderer = SDL_CreateRenderer(damage_window, SDL_SOFTWARE_RENDERER);
+    SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_DAMAGE_TRACKING);
+    SDLTest_AssertCheck(sw_renderer != NULL, "Verify software renderer was created");
+    if (!sw_renderer) {
+        SDL_DestroyWindow(damage_window);
+        return TEST_ABORTED;
+    }
+
+    /* The first frame presents the whole window */
+    SDL_FlushRenderer(sw_renderer);
+    CheckSoftwareDamage(damage_window, &full, "creating the renderer");
+    SDL_RenderPresent(sw_renderer);
+    CheckSoftwareDamage(damage_window, NULL, "presenting");
+
+    /* Fills damage their area, offset by the viewport */
+    SDL_SetRenderViewport(sw_renderer, &viewport);
+    SDL_RenderFillRect(sw_renderer, &rect);
+    SDL_FlushRenderer(sw_renderer);
+    expected.x = viewport.x + 5;
+    expected.y = viewport.y + 5;
+    expected.w = 20;
+    expected.h = 10;
+    CheckSoftwareDamage(damage_window, &expected, "filling a rectangle");
+    SDL_RenderPresent(sw_renderer);
+
+    /* Copies are clipped to the viewport */
+    texture = SDL_CreateTexture(sw_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+    if (texture) {
+        rect.x = 190.0f;
+        rect.y = 90.0f;
+        rect.w = 16.0f;
+        rect.h = 16.0f;
+        SDL_RenderTexture(sw_renderer, texture, NULL, &rect);
+        SDL_FlushRenderer(sw_renderer);
+        expected.x = viewport.x + 190;
+        expected.y = viewport.y + 90;
+        expected.w = 10;
+        expected.h = 10;
+        CheckSoftwareDamage(damage_window, &expected, "copying a texture");
+        SDL_RenderPresent(sw_renderer);
+        SDL_DestroyTexture(texture);
+    }
+
+    /* Clearing damages the whole window */
+    SDL_RenderClear(sw_renderer);
+    SDL_FlushRenderer(sw_renderer);
+    CheckSoftwareDamage(damage_window, &full, "clearing");
+
+    SDL_DestroyRenderer(sw_renderer);
+    SDL_DestroyWindow(damage_window);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Draws random triangles, flat, shaded and textured with each blend mode, to a surface.
+ */
+static bool DrawRandomTriangles(SDL_Surface *target, SDL_PixelFormat texture_format)
+{
+    const SDL_BlendMode blend_modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD };
+    SDL_Renderer *sw_renderer;
+    SDL_Texture *texture;
+    SDL_Surface *pattern;
+    SDL_Vertex verts[3];
+    Uint64 seed = 42;
+    int i, j, x, y;
+
+    sw_renderer = SDL_CreateSoftwareRenderer(target);
+    if (!sw_renderer) {
+        return false;
+    }
+
+    pattern = SDL_CreateSurface(37, 29, texture_format);
+    if (!pattern) {
+        SDL_DestroyRenderer(sw_renderer);
+        return false;
+    }
+    for (y = 0; y < pattern->h; ++y) {
+        for (x = 0; x < pattern->w; ++x) {
+            SDL_WriteSurfacePixel(pattern, x, y, (Uint8)(x * 7), (Uint8)(y * 9), (Uint8)((x ^ y) * 5), (Uint8)((x * y) & 0xFF));
+        }
+    }
+    texture = SDL_CreateTextureFromSurface(sw_renderer, pattern);
+    SDL_DestroySurface(pattern);
+    if (!texture) {
+        SDL_DestroyRenderer(sw_renderer);
+        return false;
+    }
+
+    SDL_SetRenderDrawColor(sw_renderer, 90, 60, 30, 128);
+    SDL_RenderClear(sw_renderer);
+
+    for (i = 0; i < 400; ++i) {
+        const bool textured = (i % 3) != 0;
+        const bool shaded = (i % 4) == 0;
+
+        for (j = 0; j < SDL_arraysize(verts); ++j) {
+            verts[j].position.x = (float)SDL_rand_r(&seed, target->w + 40) - 20.0f;
+            verts[j].position.y = (float)SDL_rand_r(&seed, target->h + 40) - 20.0f;
+            verts[j].tex_coord.x = (float)SDL_rand_r(&seed, 300) / 100.0f - 1.0f;
+            verts[j].tex_coord.y = (float)SDL_rand_r(&seed, 300) / 100.0f - 1.0f;
+            if (shaded || j == 0) {
+                verts[j].color.r = (float)SDL_rand_r(&seed, 256) / 255.0f;
+                verts[j].color.g = (float)SDL_rand_r(&seed, 256) / 255.0f;
+                verts[j].color.b = (float)SDL_rand_r(&seed, 256) / 255.0f;
+                verts[j].color.a = (float)SDL_rand_r(&seed, 256) / 255.0f;
+            } else {
+                verts[j].color = verts[0].color;
+            }
+        }
+        if ((i % 5) == 0) {
+            /* Textured triangles without modulation are copied */
+            verts[0].color.r = verts[0].color.g = verts[0].color.b = verts[0].color.a = 1.0f;
+            verts[1].color = verts[2].color = verts[0].color;
+        }
+
+        if (textured) {
+            SDL_SetTextureBlendMode(texture, blend_modes[SDL_rand_r(&seed, SDL_arraysize(blend_modes))]);
+            SDL_SetRenderTextureAddressMode(sw_renderer, (i & 1) ? SDL_TEXTURE_ADDRESS_WRAP : SDL_TEXTURE_ADDRESS_CLAMP, (i & 2) ? SDL_TEXTURE_ADDRESS_WRAP : SDL_TEXTURE_ADDRESS_CLAMP);
+            SDL_RenderGeometry(sw_renderer, texture, verts, 3, NULL, 0);
+        } else {
+            SDL_SetRenderDrawBlendMode(sw_renderer, blend_modes[SDL_rand_r(&seed, SDL_arraysize(blend_modes))]);
+            SDL_RenderGeometry(sw_renderer, NULL, verts, 3, NULL, 0);
+        }
+    }
+
+    SDL_FlushRenderer(sw_renderer);
+    SDL_DestroyRenderer(sw_renderer);
+    return true;
+}
+
+/**
+ * Tests that triangles drawn to ARGB8888 and XRGB8888 targets match the same triangles drawn to ABGR8888 and XBGR8888 targets.
+ *
+ * \sa SDL_RenderGeometry
+ * \sa SDL_CreateSoftwareRenderer
+ */
+static int SDLCALL render_testTriangleRasterizer(void *arg)
+{
+    const SDL_PixelFormat formats[][2] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888 }
+    };
+    int i, x, y, mismatches;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        SDL_Surface *expected = SDL_CreateSurface(173, 131, formats[i][1]);
+        SDL_Surface *actual = SDL_CreateSurface(173, 131, formats[i][0]);
+        SDL_Surface *converted = NULL;
+        bool drawn;
+
+        SDLTest_AssertCheck(expected && actual, "Verify %s target surfaces were created", SDL_GetPixelFormatName(formats[i][0]));
+        if (!expected || !actual) {
+            SDL_DestroySurface(expected);
+            SDL_DestroySurface(actual);
+            continue;
+        }
+
+        drawn = DrawRandomTriangles(expected, formats[i][1]);
+        drawn = DrawRandomTriangles(actual, formats[i][0]) && drawn;
+        SDLTest_AssertCheck(drawn, "Verify the triangles were drawn to %s and %s targets", SDL_GetPixelFormatName(formats[i][0]), SDL_GetPixelFormatName(formats[i][1]));
+        if (drawn) {
+            converted = SDL_ConvertSurface(expected, formats[i][0]);
+        }
+
+        if (converted) {
+            /* The unused byte isn't preserved by the conversion */
+            const Uint32 mask = SDL_ISPIXELFORMAT_ALPHA(formats[i][0]) ? 0xFFFFFFFF : 0x00FFFFFF;
+
+            mismatches = 0;
+            for (y = 0; y < converted->h; ++y) {
+                const Uint32 *a = (const Uint32 *)((const Uint8 *)converted->pixels + y * converted->pitch);
+                const Uint32 *b = (const Uint32 *)((const Uint8 *)actual->pixels + y * actual->pitch);
+                for (x = 0; x < converted->w; ++x) {
+                    if ((a[x] & mask) != (b[x] & mask)) {
+                        ++mismatches;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Verify %s triangles match %s triangles, expected 0 mismatched pixels, got %d", SDL_GetPixelFormatName(formats[i][0]), SDL_GetPixelFormatName(formats[i][1]), mismatches);
+        }
+
+        SDL_DestroySurface(converted);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests the frame statistics published by SDL_RenderPresent().
+ *
+ * \sa SDL_RenderPresent
+ * \sa SDL_GetRendererProperties
+ * \sa SDL_HINT_RENDER_STATS_OVERLAY
+ */
+static int SDLCALL render_testFrameStats(void *arg)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    SDL_Renderer *sw_renderer;
+    SDL_Texture *texture;
+    SDL_Surface *surface;
+    SDL_FRect rect;
+    Uint32 pixels[8 * 8];
+    Sint64 count;
+    void *locked;
+    int pitch, i, lit;
+
+    /* Start a new frame */
+    SDL_RenderPresent(renderer);
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 8, 8);
+    SDLTest_AssertCheck(texture != NULL, "Verify streaming texture was created");
+    if (!texture) {
+        return TEST_ABORTED;
+    }
+    SDL_memset(pixels, 0xFF, sizeof(pixels));
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, SDL_ALPHA_OPAQUE);
+    for (i = 0; i < 10; ++i) {
+        rect.x = (float)(i * 2);
+        rect.y = 0.0f;
+        rect.w = 1.0f;
+        rect.h = 1.0f;
+        SDL_RenderFillRect(renderer, &rect);
+    }
+    SDL_FlushRenderer(renderer);
+
+    SDL_UpdateTexture(texture, NULL, pixels, sizeof(pixels[0]) * 8);
+    if (SDL_LockTexture(texture, NULL, &locked, &pitch)) {
+        SDL_UnlockTexture(texture);
+    }
+    SDL_RenderTexture(renderer, texture, NULL, NULL);
+
+    /* Updating a texture that queued rendering depends on flushes the queue */
+    SDL_UpdateTexture(texture, NULL, pixels, sizeof(pixels[0]) * 8);
+    SDL_RenderTexture(renderer, texture, NULL, NULL);
+    SDL_RenderPresent(renderer);
+
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_FLUSH_COUNT_NUMBER, -1);
+    SDLTest_AssertCheck(count == 3, "Verify the flushes were counted, expected 3, got %" SDL_PRIs64, count);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_COMMAND_COUNT_NUMBER, -1);
+    SDLTest_AssertCheck(count >= 4, "Verify the render commands were counted, expected at least 4, got %" SDL_PRIs64, count);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER, -1);
+    SDLTest_AssertCheck(count > 0, "Verify the vertex bytes were counted, expected more than 0, got %" SDL_PRIs64, count);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_TEXTURE_UPDATE_COUNT_NUMBER, -1);
+    SDLTest_AssertCheck(count == 2, "Verify the texture updates were counted, expected 2, got %" SDL_PRIs64, count);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_TEXTURE_LOCK_COUNT_NUMBER, -1);
+    SDLTest_AssertCheck(count == 1, "Verify the texture locks were counted, expected 1, got %" SDL_PRIs64, count);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_UPLOAD_BYTES_NUMBER, -1);
+    if (SDL_strcmp(SDL_GetRendererName(renderer), "gpu") == 0) {
+        SDLTest_AssertCheck(count >= (Sint64)(2 * sizeof(pixels)), "Verify the upload bytes were counted, expected at least %d, got %" SDL_PRIs64, (int)(2 * sizeof(pixels)), count);
+    } else {
+        SDLTest_AssertCheck(count == 0, "Verify upload bytes are only reported by the GPU renderer, expected 0, got %" SDL_PRIs64, count);
+    }
+
+    /* The statistics are reset for each frame */
+    SDL_RenderPresent(renderer);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_FLUSH_COUNT_NUMBER, -1);
+    SDLTest_AssertCheck(count == 0, "Verify an empty frame has no flushes, expected 0, got %" SDL_PRIs64, count);
+    count = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_TEXTURE_UPDATE_COUNT_NUMBER, -1);
+    SDLTest_AssertCheck(count == 0, "Verify an empty frame has no texture updates, expected 0, got %" SDL_PRIs64, count);
+
+    SDL_DestroyTexture(texture);
+
+    /* The overlay is drawn in the top left corner */
+    surface = SDL_CreateSurface(320, 240, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(surface != NULL, "Verify target surface was created");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+    SDL_SetHint(SDL_HINT_RENDER_STATS_OVERLAY, "1");
+    sw_renderer = SDL_CreateSoftwareRenderer(surface);
+    SDL_ResetHint(SDL_HINT_RENDER_STATS_OVERLAY);
+    SDLTest_AssertCheck(sw_renderer != NULL, "Verify software renderer was created");
+    if (sw_renderer) {
+        SDL_SetRenderDrawColor(sw_renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(sw_renderer);
+        SDL_RenderPresent(sw_renderer);
+
+        lit = 0;
+        for (i = 0; i < 64; ++i) {
+            Uint8 r, g, b;
+            SDL_ReadSurfacePixel(surface, 8 + i, 8, &r, &g, &b, NULL);
+            if (r == 255 && g == 255 && b == 255) {
+                ++lit;
+            }
+        }
+        SDLTest_AssertCheck(lit > 0, "Verify the overlay text was drawn, expected more than 0 white pixels, got %d", lit);
+        SDL_DestroyRenderer(sw_renderer);
+    }
+    SDL_DestroySurface(surface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests packing surfaces into a texture atlas and drawing them.
+ *
+ * \sa SDL_CreateTextureAtlas
+ * \sa SDL_AddSurfaceToTextureAtlas
+ * \sa SDL_GetTextureAtlasEntry
+ * \sa SDL_RemoveFromTextureAtlas
+ * \sa SDL_GetTextureAtlasUsage
+ */
+static int SDLCALL render_testTextureAtlas(void *arg)
+{
+    const int NUM_SPRITES = 40;
+    const int SPRITE_SIZE = 10;
+    SDL_TextureAtlasEntryID entries[40], removed;
+    SDL_TextureAtlas *atlas;
+    SDL_Texture *texture, *first_texture = NULL;
+    SDL_Surface *sprite, *result;
+    SDL_FRect src, dst;
+    float occupancy;
+    int i, num_textures, mismatches;
+
+    atlas = SDL_CreateTextureAtlas(renderer, SDL_PIXELFORMAT_ARGB8888, 128, 128);
+    SDLTest_AssertCheck(atlas != NULL, "Verify texture atlas was created");
+    if (!atlas) {
+        return TEST_ABORTED;
+    }
+
+    /* Sprites in a different format are converted */
+    for (i = 0; i < NUM_SPRITES; ++i) {
+        sprite = SDL_CreateSurface(SPRITE_SIZE, SPRITE_SIZE, (i & 1) ? SDL_PIXELFORMAT_XRGB8888 : SDL_PIXELFORMAT_ARGB8888);
+        SDL_FillSurfaceRect(sprite, NULL, SDL_MapSurfaceRGB(sprite, (Uint8)(i * 6), (Uint8)(255 - i * 6), (Uint8)(i * 3)));
+        entries[i] = SDL_AddSurfaceToTextureAtlas(atlas, sprite);
+        SDL_DestroySurface(sprite);
+    }
+    SDLTest_AssertCheck(entries[0] != 0 && entries[NUM_SPRITES - 1] != 0, "Verify surfaces were added to the atlas");
+    SDL_GetTextureAtlasUsage(atlas, &num_textures, &occupancy);
+    SDLTest_AssertCheck(num_textures == 1, "Verify the sprites share one texture, expected 1, got %d", num_textures);
+    SDLTest_AssertCheck(SDL_fabsf(occupancy - (float)(NUM_SPRITES * SPRITE_SIZE * SPRITE_SIZE) / (128 * 128)) < 0.001f, "Verify the atlas occupancy, got %f", occupancy);
+
+    /* Draw all the sprites */
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_FlushRenderer(renderer);
+    for (i = 0; i < NUM_SPRITES; ++i) {
+        SDLTest_AssertCheck(SDL_GetTextureAtlasEntry(atlas, entries[i], &texture, &src), "Verify atlas entry %d can be looked up", i);
+        if (i == 0) {
+            first_texture = texture;
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+            SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+        }
+        dst.x = (float)((i % 10) * 20);
+        dst.y = (float)((i / 10) * 20);
+        dst.w = src.w;
+        dst.h = src.h;
+        SDL_RenderTexture(renderer, texture, &src, &dst);
+    }
+    SDLTest_AssertCheck(texture == first_texture, "Verify all entries are on the same texture");
+
+    result = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(result != NULL, "Verify result from SDL_RenderReadPixels is not NULL");
+    if (result) {
+        mismatches = 0;
+        for (i = 0; i < NUM_SPRITES; ++i) {
+            const int x = (i % 10) * 20;
+            const int y = (i / 10) * 20;
+            const int corners[4][2] = { { 0, 0 }, { SPRITE_SIZE - 1, 0 }, { 0, SPRITE_SIZE - 1 }, { SPRITE_SIZE - 1, SPRITE_SIZE - 1 } };
+            int j;
+
+            for (j = 0; j < SDL_arraysize(corners); ++j) {
+                Uint8 r, g, b;
+                SDL_ReadSurfacePixel(result, x + corners[j][0], y + corners[j][1], &r, &g, &b, NULL);
+                if (r != (Uint8)(i * 6) || g != (Uint8)(255 - i * 6) || b != (Uint8)(i * 3)) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify the sprites were drawn from the atlas, expected 0 mismatched pixels, got %d", mismatches);
+        SDL_DestroySurface(result);
+    }
+
+    /* Removed entries make room for new ones */
+    for (i = 0; i < NUM_SPRITES; i += 2) {
+        SDLTest_AssertCheck(SDL_RemoveFromTextureAtlas(atlas, entries[i]), "Verify atlas entry %d was removed", i);
+    }
+    SDLTest_AssertCheck(!SDL_GetTextureAtlasEntry(atlas, entries[0], NULL, NULL), "Verify a removed entry can't be looked up");
+    removed = entries[0];
+    SDL_GetTextureAtlasUsage(atlas, NULL, &occupancy);
+    SDLTest_AssertCheck(SDL_fabsf(occupancy - (float)(NUM_SPRITES / 2 * SPRITE_SIZE * SPRITE_SIZE) / (128 * 128)) < 0.001f, "Verify the atlas occupancy after removing half the sprites, got %f", occupancy);
+
+    sprite = SDL_CreateSurface(SPRITE_SIZE, SPRITE_SIZE, SDL_PIXELFORMAT_ARGB8888);
+    for (i = 0; i < NUM_SPRITES; i += 2) {
+        entries[i] = SDL_AddSurfaceToTextureAtlas(atlas, sprite);
+    }
+    SDL_DestroySurface(sprite);
+    SDL_GetTextureAtlasUsage(atlas, &num_textures, NULL);
+    SDLTest_AssertCheck(entries[0] != 0 && num_textures == 1, "Verify the free space was reused, expected 1 texture, got %d", num_textures);
+    SDLTest_AssertCheck(entries[0] != removed, "Verify a reused entry has a new ID, got 0x%" SDL_PRIx32 " twice", removed);
+    SDLTest_AssertCheck(!SDL_GetTextureAtlasEntry(atlas, removed, NULL, NULL), "Verify a stale ID can't be looked up after its entry is reused");
+    SDLTest_AssertCheck(!SDL_RemoveFromTextureAtlas(atlas, removed), "Verify a stale ID can't remove the entry that reused it");
+    SDLTest_AssertCheck(SDL_GetTextureAtlasEntry(atlas, entries[0], NULL, NULL), "Verify the new entry is still valid");
+
+    /* Images that don't fit start a new texture, and images larger than the atlas are rejected */
+    sprite = SDL_CreateSurface(100, 100, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(SDL_AddSurfaceToTextureAtlas(atlas, sprite) != 0, "Verify a large surface was added to the atlas");
+    SDL_GetTextureAtlasUsage(atlas, &num_textures, NULL);
+    SDLTest_AssertCheck(num_textures == 2, "Verify a second texture was added, expected 2, got %d", num_textures);
+    SDL_DestroySurface(sprite);
+
+    sprite = SDL_CreateSurface(128, 128, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(SDL_AddSurfaceToTextureAtlas(atlas, sprite) == 0, "Verify a surface larger than the atlas was rejected");
+    SDL_DestroySurface(sprite);
+
+    SDL_DestroyTextureAtlas(atlas);
+
+    /* With a texture limit, the least recently used sprites are evicted, four sprites fit on each texture */
+    atlas = SDL_CreateTextureAtlas(renderer, SDL_PIXELFORMAT_ARGB8888, 2 * (SPRITE_SIZE + 2), 2 * (SPRITE_SIZE + 2));
+    SDLTest_AssertCheck(atlas != NULL, "Verify small texture atlas was created");
+    if (!atlas) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(!SDL_SetTextureAtlasMaxTextures(atlas, -1), "Verify a negative texture limit is rejected");
+    SDLTest_AssertCheck(SDL_SetTextureAtlasMaxTextures(atlas, 1), "Verify SDL_SetTextureAtlasMaxTextures()");
+    sprite = SDL_CreateSurface(SPRITE_SIZE, SPRITE_SIZE, SDL_PIXELFORMAT_ARGB8888);
+    for (i = 0; i < 4; ++i) {
+        entries[i] = SDL_AddSurfaceToTextureAtlas(atlas, sprite);
+    }
+    SDLTest_AssertCheck(SDL_GetTextureAtlasEntry(atlas, entries[0], NULL, NULL), "Verify the first sprite can be looked up");
+    entries[4] = SDL_AddSurfaceToTextureAtlas(atlas, sprite);
+    SDLTest_AssertCheck(entries[4] != 0, "Verify a sprite was added to the full atlas");
+    SDLTest_AssertCheck(!SDL_GetTextureAtlasEntry(atlas, entries[1], NULL, NULL), "Verify the least recently used sprite was evicted");
+    for (i = 0; i < 5; ++i) {
+        if (i != 1) {
+            SDLTest_AssertCheck(SDL_GetTextureAtlasEntry(atlas, entries[i], NULL, NULL), "Verify sprite %d wasn't evicted", i);
+        }
+    }
+    SDL_GetTextureAtlasUsage(atlas, &num_textures, NULL);
+    SDLTest_AssertCheck(num_textures == 1, "Verify the texture limit was kept, expected 1, got %d", num_textures);
+    SDL_DestroySurface(sprite);
+
+    /* An image as large as the atlas evicts everything, and emptied textures are destroyed */
+    sprite = SDL_CreateSurface(2 * SPRITE_SIZE + 2, 2 * SPRITE_SIZE + 2, SDL_PIXELFORMAT_ARGB8888);
+    removed = SDL_AddSurfaceToTextureAtlas(atlas, sprite);
+    SDLTest_AssertCheck(removed != 0, "Verify a large sprite was added to the full atlas");
+    mismatches = 0;
+    for (i = 0; i < 5; ++i) {
+        if (SDL_GetTextureAtlasEntry(atlas, entries[i], NULL, NULL)) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify all the sprites were evicted, expected 0 valid entries, got %d", mismatches);
+    SDL_DestroySurface(sprite);
+    SDLTest_AssertCheck(SDL_RemoveFromTextureAtlas(atlas, removed), "Verify the large sprite was removed");
+    SDL_GetTextureAtlasUsage(atlas, &num_textures, &occupancy);
+    SDLTest_AssertCheck(num_textures == 0 && occupancy == 0.0f, "Verify the empty texture was destroyed, expected 0, got %d", num_textures);
+
+    SDL_DestroyTextureAtlas(atlas);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests recording render commands and replaying them.
+ *
+ * \sa SDL_StartRenderRecording
+ * \sa SDL_EndRenderRecording
+ * \sa SDL_ReplayRenderList
+ */
+static int SDLCALL render_testRenderList(void *arg)
+{
+    const SDL_Vertex triangle[3] = {
+        { { 150.0f, 10.0f }, { 1.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f } },
+        { { 250.0f, 110.0f }, { 0.0f, 1.0f, 0.0f, 1.0f }, { 0.0f, 0.0f } },
+        { { 100.0f, 150.0f }, { 0.0f, 0.0f, 1.0f, 1.0f }, { 0.0f, 0.0f } }
+    };
+    SDL_FRect rect = { 10.0f, 10.0f, 50.0f, 40.0f };
+    SDL_FRect dst = { 20.0f, 100.0f, 64.0f, 64.0f };
+    SDL_RenderList *list;
+    SDL_Surface *surface, *expected, *result;
+    SDL_Texture *texture;
+    Uint8 r, g, b, a;
+    int i;
+
+    surface = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_ARGB8888);
+    SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGB(surface, 200, 100, 50));
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    SDLTest_AssertCheck(texture != NULL, "Verify texture was created");
+    if (!texture) {
+        return TEST_ABORTED;
+    }
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+
+    SDLTest_AssertCheck(SDL_EndRenderRecording(renderer) == NULL, "Verify SDL_EndRenderRecording() fails when not recording");
+
+    /* Record a scene, with commands flushed in the middle of it */
+    SDLTest_AssertCheck(SDL_StartRenderRecording(renderer), "Verify SDL_StartRenderRecording()");
+    SDLTest_AssertCheck(!SDL_StartRenderRecording(renderer), "Verify recording can't be started twice");
+    SDL_SetRenderDrawColor(renderer, 20, 40, 60, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderFillRect(renderer, &rect);
+    SDL_RenderLine(renderer, 0.0f, 199.0f, 299.0f, 180.0f);
+    SDL_FlushRenderer(renderer);
+    SDL_RenderTexture(renderer, texture, NULL, &dst);
+    SDL_RenderGeometry(renderer, NULL, triangle, SDL_arraysize(triangle), NULL, 0);
+    list = SDL_EndRenderRecording(renderer);
+    SDLTest_AssertCheck(list != NULL, "Verify SDL_EndRenderRecording() returned a render list");
+    if (!list) {
+        SDL_DestroyTexture(texture);
+        return TEST_ABORTED;
+    }
+    expected = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(expected != NULL, "Verify result from SDL_RenderReadPixels is not NULL");
+
+    /* Replaying doesn't depend on the current rendering state */
+    for (i = 0; i < 2; ++i) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(renderer);
+        SDL_SetRenderDrawColor(renderer, 1, 2, 3, 4);
+        SDL_SetRenderScale(renderer, 2.0f, 2.0f);
+        SDLTest_AssertCheck(SDL_ReplayRenderList(renderer, list), "Verify SDL_ReplayRenderList()");
+        SDL_SetRenderScale(renderer, 1.0f, 1.0f);
+        result = SDL_RenderReadPixels(renderer, NULL);
+        SDLTest_AssertCheck(result != NULL, "Verify result from SDL_RenderReadPixels is not NULL");
+        if (expected && result) {
+            SDLTest_AssertCheck(SDLTest_CompareSurfaces(result, expected, 0) == 0, "Verify the replayed scene matches the recorded one");
+        }
+        SDL_DestroySurface(result);
+    }
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 1 && g == 2 && b == 3 && a == 4, "Verify the draw color is unchanged by the replay");
+
+    /* Destroying a texture used by the list invalidates it */
+    SDL_DestroyTexture(texture);
+    SDLTest_AssertCheck(!SDL_ReplayRenderList(renderer, list), "Verify SDL_ReplayRenderList() fails after the texture is destroyed");
+    SDL_DestroyRenderList(list);
+    SDL_DestroySurface(expected);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct ReadPixelsAsyncResult
+{
+    int order;
+    SDL_Surface *surface;
+} ReadPixelsAsyncResult;
+
+static int read_pixels_async_count;
+
+static void SDLCALL ReadPixelsAsyncCallback(void *userdata, SDL_Renderer *callback_renderer, SDL_Surface *surface)
+{
+    ReadPixelsAsyncResult *result = (ReadPixelsAsyncResult *)userdata;
+
+    result->order = read_pixels_async_count++;
+    if (surface) {
+        result->surface = SDL_DuplicateSurface(surface);
+    }
+}
+
+/**
+ * Tests reading pixels asynchronously.
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ */
+static int SDLCALL render_testReadPixelsAsync(void *arg)
+{
+    ReadPixelsAsyncResult results[2];
+    SDL_Surface *expected[2];
+    SDL_FRect rect = { 20.0f, 20.0f, 40.0f, 30.0f };
+    int i;
+
+    SDL_zeroa(results);
+    read_pixels_async_count = 0;
+
+    SDLTest_AssertCheck(!SDL_RenderReadPixelsAsync(renderer, NULL, NULL, NULL), "Verify SDL_RenderReadPixelsAsync() fails without a callback");
+
+    /* Read the target at two points in the rendering */
+    SDL_SetRenderDrawColor(renderer, 10, 20, 30, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, 200, 100, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderFillRect(renderer, &rect);
+    expected[0] = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(SDL_RenderReadPixelsAsync(renderer, NULL, ReadPixelsAsyncCallback, &results[0]), "Verify SDL_RenderReadPixelsAsync()");
+
+    rect.x += 50.0f;
+    SDL_SetRenderDrawColor(renderer, 0, 100, 200, SDL_ALPHA_OPAQUE);
+    SDL_RenderFillRect(renderer, &rect);
+    expected[1] = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(SDL_RenderReadPixelsAsync(renderer, NULL, ReadPixelsAsyncCallback, &results[1]), "Verify SDL_RenderReadPixelsAsync()");
+    SDLTest_AssertCheck(read_pixels_async_count == 0, "Verify the callbacks aren't called before SDL_RenderPresent(), expected 0, got %d", read_pixels_async_count);
+
+    /* The results are delivered within a few frames */
+    for (i = 0; i < 3 && read_pixels_async_count < 2; ++i) {
+        SDL_RenderPresent(renderer);
+    }
+    SDLTest_AssertCheck(read_pixels_async_count == 2, "Verify the callbacks were called, expected 2, got %d", read_pixels_async_count);
+    SDLTest_AssertCheck(results[0].order == 0 && results[1].order == 1, "Verify the callbacks were called in order");
+
+    for (i = 0; i < 2; ++i) {
+        SDLTest_AssertCheck(results[i].surface != NULL, "Verify read %d returned a surface", i);
+        if (results[i].surface && expected[i]) {
+            SDLTest_AssertCheck(SDLTest_CompareSurfaces(results[i].surface, expected[i], 0) == 0, "Verify read %d matches SDL_RenderReadPixels()", i);
+        }
+        SDL_DestroySurface(results[i].surface);
+        SDL_DestroySurface(expected[i]);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests rendering a batch of sprites.
+ *
+ * \sa SDL_RenderSprites
+ */
+static int SDLCALL render_testRenderSprites(void *arg)
+{
+    const SDL_FColor colors[4] = {
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 1.0f, 0.0f, 1.0f, 1.0f },
+        { 0.0f, 1.0f, 1.0f, 1.0f },
+        { 1.0f, 1.0f, 0.0f, 1.0f }
+    };
+    SDL_RenderSprite sprites[100];
+    SDL_RenderSprite rotated;
+    SDL_Surface *surface, *expected, *result;
+    SDL_Texture *texture;
+    SDL_Rect quadrant;
+    int i;
+
+    /* Each quadrant of the texture is a different color */
+    surface = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "Verify surface was created");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < 4; ++i) {
+        quadrant.x = (i % 2) * 8;
+        quadrant.y = (i / 2) * 8;
+        quadrant.w = 8;
+        quadrant.h = 8;
+        SDL_FillSurfaceRect(surface, &quadrant, SDL_MapSurfaceRGB(surface, (Uint8)(64 * (i + 1)), 128, (Uint8)(255 - 64 * i)));
+    }
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    SDLTest_AssertCheck(texture != NULL, "Verify texture was created");
+    if (!texture) {
+        return TEST_ABORTED;
+    }
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+
+    SDLTest_AssertCheck(SDL_RenderSprites(renderer, texture, NULL, 0), "Verify SDL_RenderSprites() succeeds with no sprites");
+    SDLTest_AssertCheck(!SDL_RenderSprites(renderer, texture, NULL, 1), "Verify SDL_RenderSprites() fails without sprites");
+    SDLTest_AssertCheck(!SDL_RenderSprites(renderer, texture, sprites, -1), "Verify SDL_RenderSprites() fails with a negative count");
+
+    /* More sprites than fit in one batch, with varying source areas and colors */
+    for (i = 0; i < SDL_arraysize(sprites); ++i) {
+        sprites[i].srcrect.x = (float)((i % 2) * 8);
+        sprites[i].srcrect.y = (float)(((i / 2) % 2) * 8);
+        sprites[i].srcrect.w = 8.0f;
+        sprites[i].srcrect.h = 8.0f;
+        sprites[i].dstrect.x = (float)((i % 10) * 30);
+        sprites[i].dstrect.y = (float)((i / 10) * 24);
+        sprites[i].dstrect.w = 24.0f;
+        sprites[i].dstrect.h = 16.0f;
+        sprites[i].angle = 0.0f;
+        sprites[i].color = colors[(i / 3) % SDL_arraysize(colors)];
+    }
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    for (i = 0; i < SDL_arraysize(sprites); ++i) {
+        SDL_SetTextureColorModFloat(texture, sprites[i].color.r, sprites[i].color.g, sprites[i].color.b);
+        SDL_RenderTexture(renderer, texture, &sprites[i].srcrect, &sprites[i].dstrect);
+    }
+    SDL_SetTextureColorModFloat(texture, 1.0f, 1.0f, 1.0f);
+    expected = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(expected != NULL, "Verify result from SDL_RenderReadPixels is not NULL");
+
+    SDL_RenderClear(renderer);
+    SDLTest_AssertCheck(SDL_RenderSprites(renderer, texture, sprites, SDL_arraysize(sprites)), "Verify SDL_RenderSprites()");
+    result = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(result != NULL, "Verify result from SDL_RenderReadPixels is not NULL");
+    if (expected && result) {
+        SDLTest_AssertCheck(SDLTest_CompareSurfaces(result, expected, 0) == 0, "Verify the sprites match individually rendered textures");
+    }
+    SDL_DestroySurface(result);
+    SDL_DestroySurface(expected);
+
+    /* A rotated sprite still covers the center of its destination */
+    rotated.srcrect.x = 0.0f;
+    rotated.srcrect.y = 0.0f;
+    rotated.srcrect.w = 8.0f;
+    rotated.srcrect.h = 8.0f;
+    rotated.dstrect.x = 100.0f;
+    rotated.dstrect.y = 100.0f;
+    rotated.dstrect.w = 40.0f;
+    rotated.dstrect.h = 40.0f;
+    rotated.angle = 45.0f;
+    rotated.color = colors[0];
+    SDL_RenderClear(renderer);
+    SDLTest_AssertCheck(SDL_RenderSprites(renderer, texture, &rotated, 1), "Verify SDL_RenderSprites() with a rotated sprite");
+    result = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(result != NULL, "Verify result from SDL_RenderReadPixels is not NULL");
+    if (result) {
+        Uint8 r, g, b, a;
+
+        SDL_ReadSurfacePixel(result, 120, 120, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 64 && g == 128 && b == 255, "Verify the rotated sprite was drawn, expected 64,128,255, got %d,%d,%d", r, g, b);
+        SDL_ReadSurfacePixel(result, 101, 101, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 0 && g == 0 && b == 0, "Verify the rotated sprite doesn't cover its corners, expected 0,0,0, got %d,%d,%d", r, g, b);
+    }
+    SDL_DestroySurface(result);
+
+    /* A source area past the edge of the texture repeats it with the default address mode */
+    rotated.srcrect.w = 32.0f;
+    rotated.srcrect.h = 16.0f;
+    rotated.dstrect.x = 0.0f;
+    rotated.dstrect.y = 0.0f;
+    rotated.dstrect.w = 64.0f;
+    rotated.dstrect.h = 32.0f;
+    rotated.angle = 0.0f;
+    SDL_RenderClear(renderer);
+    SDLTest_AssertCheck(SDL_RenderSprites(renderer, texture, &rotated, 1), "Verify SDL_RenderSprites() with a repeating sprite");
+    result = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(result != NULL, "Verify result from SDL_RenderReadPixels is not NULL");
+    if (result) {
+        Uint8 r, g, b, a;
+
+        SDL_ReadSurfacePixel(result, 36, 4, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 64 && g == 128 && b == 255, "Verify the sprite repeats the texture, expected 64,128,255, got %d,%d,%d", r, g, b);
+    }
+    SDL_DestroySurface(result);
+
+    SDL_DestroyTexture(texture);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -2173,6 +3310,42 @@ static const SDLTest_TestCaseReference renderTestRGBSurfaceNoAlpha = {
     render_testRGBSurfaceNoAlpha, "render_testRGBSurfaceNoAlpha", "Tests RGB surface with no alpha using software renderer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTestCommandCoalescing = {
+    render_testCommandCoalescing, "render_testCommandCoalescing", "Tests merging consecutive draws into a single render command", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestSoftwareThreads = {
+    render_testSoftwareThreads, "render_testSoftwareThreads", "Tests drawing with several software renderer threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestSoftwareDamage = {
+    render_testSoftwareDamage, "render_testSoftwareDamage", "Tests that the software renderer only damages the areas it draws to", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestTriangleRasterizer = {
+    render_testTriangleRasterizer, "render_testTriangleRasterizer", "Tests drawing triangles to 32-bit RGB and BGR targets", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestFrameStats = {
+    render_testFrameStats, "render_testFrameStats", "Tests the frame statistics in the renderer properties", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestTextureAtlas = {
+    render_testTextureAtlas, "render_testTextureAtlas", "Tests packing surfaces into a texture atlas", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestRenderList = {
+    render_testRenderList, "render_testRenderList", "Tests recording and replaying render commands", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestReadPixelsAsync = {
+    render_testReadPixelsAsync, "render_testReadPixelsAsync", "Tests reading pixels asynchronously", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestRenderSprites = {
+    render_testRenderSprites, "render_testRenderSprites", "Tests rendering a batch of sprites", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestGetNumRenderDrivers,
@@ -2192,6 +3365,15 @@ static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestTextureState,
     &renderTestGetSetTextureScaleMode,
     &renderTestRGBSurfaceNoAlpha,
+    &renderTestCommandCoalescing,
+    &renderTestSoftwareThreads,
+    &renderTestSoftwareDamage,
+    &renderTestTriangleRasterizer,
+    &renderTestFrameStats,
+    &renderTestTextureAtlas,
+    &renderTestRenderList,
+    &renderTestReadPixelsAsync,
+    &renderTestRenderSprites,
     NULL
 };
 
@@ -477,6 +477,266 @@ static int SDLCALL surface_testSaveLoad(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Write an uncompressed BMP file, top-down if height is negative */
+static bool WriteTestBMP(const char *file, int width, int height, Uint16 bitcount, Uint32 compression, Uint32 offset, Uint32 pitch, const Uint32 *masks, Uint8 pixel_seed)
+{
+    Uint32 size = offset + pitch * (Uint32)SDL_abs(height);
+    SDL_IOStream *stream = SDL_IOFromFile(file, "wb");
+    bool result = true;
+    Uint32 i;
+
+    if (!stream) {
+        return false;
+    }
+    result &= SDL_WriteU8(stream, 'B');
+    result &= SDL_WriteU8(stream, 'M');
+    result &= SDL_WriteU32LE(stream, size);
+    result &= SDL_WriteU16LE(stream, 0);
+    result &= SDL_WriteU16LE(stream, 0);
+    result &= SDL_WriteU32LE(stream, offset);
+    result &= SDL_WriteU32LE(stream, 40);
+    result &= SDL_WriteS32LE(stream, width);
+    result &= SDL_WriteS32LE(stream, height);
+    result &= SDL_WriteU16LE(stream, 1);
+    result &= SDL_WriteU16LE(stream, bitcount);
+    result &= SDL_WriteU32LE(stream, compression);
+    result &= SDL_WriteU32LE(stream, pitch * (Uint32)SDL_abs(height));
+    result &= SDL_WriteU32LE(stream, 0);
+    result &= SDL_WriteU32LE(stream, 0);
+    result &= SDL_WriteU32LE(stream, 0);
+    result &= SDL_WriteU32LE(stream, 0);
+    if (masks) {
+        result &= SDL_WriteU32LE(stream, masks[0]);
+        result &= SDL_WriteU32LE(stream, masks[1]);
+        result &= SDL_WriteU32LE(stream, masks[2]);
+    }
+    while (result && SDL_TellIO(stream) < offset) {
+        result &= SDL_WriteU8(stream, 0);
+    }
+    for (i = 0; result && i < pitch * (Uint32)SDL_abs(height); ++i) {
+        result &= SDL_WriteU8(stream, (Uint8)(i * 7 + pixel_seed));
+    }
+    result &= SDL_CloseIO(stream);
+    return result;
+}
+
+/**
+ * Tests loading BMP files with their pixels mapped from the file
+ */
+static int SDLCALL surface_testLoadBMPMapped(void *arg)
+{
+    static const Uint32 masks[] = { 0x00FF0000, 0x0000FF00, 0x000000FF };
+    static const struct
+    {
+        int height;
+        Uint16 bitcount;
+        Uint32 compression;
+        Uint32 offset;
+        const Uint32 *masks;
+        bool mapped;
+    } cases[] = {
+        { -20, 24, 0 /* BI_RGB */, 54, NULL, true },
+        { -20, 32, 3 /* BI_BITFIELDS */, 68, masks, true },
+        { -20, 32, 3 /* BI_BITFIELDS */, 66, masks, false },   /* Misaligned pixels */
+        { 20, 24, 0 /* BI_RGB */, 54, NULL, false },            /* Bottom-up */
+    };
+    const char *sampleFilename = "testLoadBMPMapped.tmp";
+    const int width = 33;
+    SDL_Surface *reference;
+    SDL_Surface *mapped;
+    SDL_Surface *reloaded;
+    Uint32 pitch;
+    int i, ret;
+
+    for (i = 0; i < (int)SDL_arraysize(cases); ++i) {
+        pitch = ((width * cases[i].bitcount + 31) / 32) * 4;
+        ret = WriteTestBMP(sampleFilename, width, cases[i].height, cases[i].bitcount, cases[i].compression, cases[i].offset, pitch, cases[i].masks, (Uint8)i);
+        SDLTest_AssertCheck(ret, "Verify BMP file %d was written", i);
+        if (!ret) {
+            continue;
+        }
+
+        SDL_SetHint(SDL_HINT_BMP_LOAD_MEMORY_MAPPED, "0");
+        reference = SDL_LoadBMP(sampleFilename);
+        SDLTest_AssertCheck(reference != NULL, "Verify reference surface %d is not NULL", i);
+
+        SDL_SetHint(SDL_HINT_BMP_LOAD_MEMORY_MAPPED, "1");
+        mapped = SDL_LoadBMP(sampleFilename);
+        SDLTest_AssertCheck(mapped != NULL, "Verify mapped surface %d is not NULL", i);
+
+        if (reference && mapped) {
+            SDLTest_AssertCheck(((mapped->flags & SDL_SURFACE_PREALLOCATED) != 0) == cases[i].mapped,
+                                "Verify surface %d is %s", i, cases[i].mapped ? "mapped" : "not mapped");
+            SDLTest_AssertCheck(mapped->format == reference->format, "Verify format, expected: %s, got: %s",
+                                SDL_GetPixelFormatName(reference->format), SDL_GetPixelFormatName(mapped->format));
+            ret = SDLTest_CompareSurfaces(mapped, reference, 0);
+            SDLTest_AssertCheck(ret == 0, "Verify mapped pixels match, expected 0, got %d", ret);
+
+            /* Writing to the surface must not change the file */
+            ret = SDL_FillSurfaceRect(mapped, NULL, 0);
+            SDLTest_AssertCheck(ret, "Verify SDL_FillSurfaceRect() on the mapped surface succeeded");
+            reloaded = SDL_LoadBMP(sampleFilename);
+            SDLTest_AssertCheck(reloaded != NULL, "Verify reloaded surface is not NULL");
+            if (reloaded) {
+                ret = SDLTest_CompareSurfaces(reloaded, reference, 0);
+                SDLTest_AssertCheck(ret == 0, "Verify the file was not modified, expected 0, got %d", ret);
+                SDL_DestroySurface(reloaded);
+            }
+        }
+        SDL_DestroySurface(mapped);
+        SDL_DestroySurface(reference);
+    }
+
+    /* Pixel data past the end of the file is an error, not a crash */
+    ret = WriteTestBMP(sampleFilename, width, -20, 24, 0 /* BI_RGB */, 54, 100, NULL, 0);
+    if (ret) {
+        SDL_IOStream *stream = SDL_IOFromFile(sampleFilename, "r+b");
+        if (stream) {
+            SDL_SeekIO(stream, 14 + 8, SDL_IO_SEEK_SET);
+            SDL_WriteS32LE(stream, -40);
+            SDL_CloseIO(stream);
+        }
+        mapped = SDL_LoadBMP(sampleFilename);
+        SDLTest_AssertCheck(mapped == NULL, "Verify truncated BMP file fails to load");
+        SDL_DestroySurface(mapped);
+    }
+
+    SDL_ResetHint(SDL_HINT_BMP_LOAD_MEMORY_MAPPED);
+    SDL_RemovePath(sampleFilename);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests loading images with SDL_LoadSurface_IO() and a surface load queue
+ */
+static int SDLCALL surface_testLoadSurfaceAsync(void *arg)
+{
+#define NUM_LOAD_IMAGES 6
+    const char *files[NUM_LOAD_IMAGES + 1];
+    char filenames[NUM_LOAD_IMAGES][32];
+    SDL_IOStream *streams[NUM_LOAD_IMAGES];
+    SDL_Surface *images[NUM_LOAD_IMAGES];
+    bool seen[NUM_LOAD_IMAGES + 1];
+    SDL_SurfaceLoadQueue *queue;
+    SDL_SurfaceLoadOutcome outcome;
+    SDL_Surface *surface;
+    SDL_IOStream *stream;
+    int userdata = 42;
+    int i, ret, count;
+
+    SDL_zeroa(images);
+    SDL_zeroa(streams);
+    SDL_zeroa(filenames);
+
+    /* Create a set of images, alternating between BMP and PNG files */
+    for (i = 0; i < NUM_LOAD_IMAGES; ++i) {
+        images[i] = SDL_CreateSurface(17 + i * 31, 9 + i * 13, SDL_PIXELFORMAT_XRGB8888);
+        SDLTest_AssertCheck(images[i] != NULL, "Verify image %d is not NULL", i);
+        if (!images[i]) {
+            goto done;
+        }
+        SDL_FillSurfaceRect(images[i], NULL, SDL_MapSurfaceRGB(images[i], (Uint8)(i * 40), 128, (Uint8)(255 - i * 40)));
+
+        SDL_snprintf(filenames[i], sizeof(filenames[i]), "testLoadSurfaceAsync%d.tmp", i);
+        if (i % 2) {
+            ret = SDL_SavePNG(images[i], filenames[i]);
+        } else {
+            ret = SDL_SaveBMP(images[i], filenames[i]);
+        }
+        SDLTest_AssertCheck(ret, "Verify image %d was saved", i);
+        files[i] = filenames[i];
+    }
+    files[NUM_LOAD_IMAGES] = "nonexistent.bmp";
+
+    /* Load them synchronously, detecting the format */
+    for (i = 0; i < NUM_LOAD_IMAGES; ++i) {
+        surface = SDL_LoadSurface(files[i]);
+        SDLTest_AssertCheck(surface != NULL, "Verify SDL_LoadSurface(\"%s\") succeeded", files[i]);
+        if (surface) {
+            ret = SDLTest_CompareSurfaces(surface, images[i], 0);
+            SDLTest_AssertCheck(ret == 0, "Verify loaded image matches, expected 0, got %d", ret);
+            SDL_DestroySurface(surface);
+        }
+    }
+    stream = SDL_IOFromConstMem("not an image", 12);
+    surface = SDL_LoadSurface_IO(stream, true);
+    SDLTest_AssertCheck(surface == NULL, "Verify SDL_LoadSurface_IO() fails on unknown data");
+
+    queue = SDL_CreateSurfaceLoadQueue(3);
+    SDLTest_AssertCheck(queue != NULL, "Verify SDL_CreateSurfaceLoadQueue() succeeded");
+    if (!queue) {
+        goto done;
+    }
+
+    /* Load the files as a batch, including one that doesn't exist */
+    ret = SDL_LoadSurfacesAsync(files, NUM_LOAD_IMAGES + 1, queue, &userdata);
+    SDLTest_AssertCheck(ret, "Verify SDL_LoadSurfacesAsync() succeeded");
+    SDL_zeroa(seen);
+    for (count = 0; count < NUM_LOAD_IMAGES + 1; ++count) {
+        if (!SDL_WaitSurfaceLoadResult(queue, &outcome, 10000)) {
+            break;
+        }
+        SDLTest_AssertCheck(outcome.index >= 0 && outcome.index <= NUM_LOAD_IMAGES && !seen[outcome.index], "Verify outcome index %d is valid", outcome.index);
+        SDLTest_AssertCheck(outcome.userdata == &userdata, "Verify outcome userdata");
+        if (outcome.index < 0 || outcome.index > NUM_LOAD_IMAGES) {
+            SDL_DestroySurface(outcome.surface);
+            continue;
+        }
+        seen[outcome.index] = true;
+        if (outcome.index == NUM_LOAD_IMAGES) {
+            SDLTest_AssertCheck(outcome.surface == NULL, "Verify nonexistent file failed to load");
+            SDLTest_AssertCheck(*SDL_GetError() != '\0', "Verify an error was set: %s", SDL_GetError());
+        } else {
+            SDLTest_AssertCheck(outcome.surface != NULL, "Verify file %d loaded", outcome.index);
+            if (outcome.surface) {
+                ret = SDLTest_CompareSurfaces(outcome.surface, images[outcome.index], 0);
+                SDLTest_AssertCheck(ret == 0, "Verify loaded image matches, expected 0, got %d", ret);
+            }
+        }
+        SDL_DestroySurface(outcome.surface);
+    }
+    SDLTest_AssertCheck(count == NUM_LOAD_IMAGES + 1, "Verify all files were loaded, expected %d, got %d", NUM_LOAD_IMAGES + 1, count);
+    SDLTest_AssertCheck(!SDL_GetSurfaceLoadResult(queue, &outcome), "Verify there are no more results");
+
+    /* Load the same images from streams */
+    for (i = 0; i < NUM_LOAD_IMAGES; ++i) {
+        streams[i] = SDL_IOFromFile(files[i], "rb");
+        SDLTest_AssertCheck(streams[i] != NULL, "Verify stream %d is not NULL", i);
+    }
+    ret = SDL_LoadSurfacesAsync_IO(streams, NUM_LOAD_IMAGES, true, queue, NULL);
+    SDLTest_AssertCheck(ret, "Verify SDL_LoadSurfacesAsync_IO() succeeded");
+    for (count = 0; count < NUM_LOAD_IMAGES; ++count) {
+        if (!SDL_WaitSurfaceLoadResult(queue, &outcome, -1)) {
+            break;
+        }
+        SDLTest_AssertCheck(outcome.surface != NULL, "Verify stream %d loaded", outcome.index);
+        if (outcome.surface && outcome.index >= 0 && outcome.index < NUM_LOAD_IMAGES) {
+            ret = SDLTest_CompareSurfaces(outcome.surface, images[outcome.index], 0);
+            SDLTest_AssertCheck(ret == 0, "Verify loaded image matches, expected 0, got %d", ret);
+        }
+        SDL_DestroySurface(outcome.surface);
+    }
+    SDLTest_AssertCheck(count == NUM_LOAD_IMAGES, "Verify all streams were loaded, expected %d, got %d", NUM_LOAD_IMAGES, count);
+
+    /* Destroying the queue with loads in flight is safe */
+    for (i = 0; i < NUM_LOAD_IMAGES; ++i) {
+        SDL_LoadSurfaceAsync(files[i], queue, NULL);
+    }
+    SDL_DestroySurfaceLoadQueue(queue);
+    SDLTest_AssertPass("Call to SDL_DestroySurfaceLoadQueue() with pending loads");
+
+done:
+    for (i = 0; i < NUM_LOAD_IMAGES; ++i) {
+        SDL_DestroySurface(images[i]);
+        if (filenames[i][0]) {
+            SDL_RemovePath(filenames[i]);
+        }
+    }
+    return TEST_COMPLETED;
+#undef NUM_LOAD_IMAGES
+}
+
 /**
  *  Tests tiled blitting.
  */
@@ -1095,6 +1355,162 @@ static int SDLCALL surface_testLoadFailure(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests filling rectangles of all pixel sizes, including fills large enough to use streaming stores.
+ */
+static int SDLCALL surface_testFillRects(void *arg)
+{
+    const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_INDEX8,
+        SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_XRGB8888
+    };
+    const int sizes[][2] = { { 61, 37 }, { 2100, 600 } };
+    int f, s, i, x, y, b;
+
+    for (f = 0; f < SDL_arraysize(formats); ++f) {
+        for (s = 0; s < SDL_arraysize(sizes); ++s) {
+            const int w = sizes[s][0];
+            const int h = sizes[s][1];
+            const SDL_Rect rects[] = {
+                { 3, 1, w - 7, h / 2 },
+                { 1, h / 2, 17, h / 3 },
+                { w / 2, h - 5, w, 10 }
+            };
+            SDL_Surface *surface = SDL_CreateSurface(w, h, formats[f]);
+            SDL_Surface *sample = SDL_CreateSurface(1, 1, formats[f]);
+            Uint8 *expected = NULL;
+            Uint32 color;
+            int bpp, mismatches = 0;
+
+            SDLTest_AssertCheck(surface && sample, "Create %dx%d %s surface", w, h, SDL_GetPixelFormatName(formats[f]));
+            if (!surface || !sample) {
+                SDL_DestroySurface(surface);
+                SDL_DestroySurface(sample);
+                continue;
+            }
+            bpp = SDL_BYTESPERPIXEL(formats[f]);
+            color = SDL_MapSurfaceRGB(surface, 0x12, 0x9C, 0xE5);
+
+            /* Get the bytes of a single pixel in this color to build the expected result */
+            SDL_FillSurfaceRect(sample, NULL, color);
+
+            expected = (Uint8 *)SDL_malloc((size_t)h * surface->pitch);
+            SDLTest_AssertCheck(expected != NULL, "Allocate expected pixels");
+            if (!expected) {
+                SDL_DestroySurface(surface);
+                SDL_DestroySurface(sample);
+                continue;
+            }
+            SDL_memset(surface->pixels, 0xA5, (size_t)h * surface->pitch);
+            SDL_memset(expected, 0xA5, (size_t)h * surface->pitch);
+
+            for (i = 0; i < SDL_arraysize(rects); ++i) {
+                SDL_Rect clip_rect, clipped;
+
+                SDL_FillSurfaceRect(surface, &rects[i], color);
+
+                SDL_GetSurfaceClipRect(surface, &clip_rect);
+                SDL_GetRectIntersection(&rects[i], &clip_rect, &clipped);
+                for (y = clipped.y; y < clipped.y + clipped.h; ++y) {
+                    for (x = clipped.x; x < clipped.x + clipped.w; ++x) {
+                        SDL_memcpy(expected + y * surface->pitch + x * bpp, sample->pixels, bpp);
+                    }
+                }
+            }
+
+            for (y = 0; y < h; ++y) {
+                const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+                for (b = 0; b < surface->pitch; ++b) {
+                    if (row[b] != expected[y * surface->pitch + b]) {
+                        ++mismatches;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Verify %dx%d %s fill, expected 0 mismatched bytes, got %d", w, h, SDL_GetPixelFormatName(formats[f]), mismatches);
+
+            SDL_free(expected);
+            SDL_DestroySurface(surface);
+            SDL_DestroySurface(sample);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests clearing surfaces, including bitmap formats and surfaces with padding between rows.
+ */
+static int SDLCALL surface_testClearSurfaceBytes(void *arg)
+{
+    const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_INDEX1MSB,
+        SDL_PIXELFORMAT_INDEX2LSB,
+        SDL_PIXELFORMAT_INDEX4MSB,
+        SDL_PIXELFORMAT_INDEX8
+    };
+    Uint8 pixels[4 * 16];
+    SDL_Surface *surface;
+    SDL_Palette *palette;
+    Uint8 expected;
+    int i, x, y, mismatches;
+    bool result;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        mismatches = 0;
+        surface = SDL_CreateSurface(13, 5, formats[i]);
+        SDLTest_AssertCheck(surface != NULL, "Create %s surface", SDL_GetPixelFormatName(formats[i]));
+        if (!surface) {
+            continue;
+        }
+        palette = SDL_CreateSurfacePalette(surface);
+        SDLTest_AssertCheck(palette != NULL, "Create surface palette");
+        if (palette) {
+            SDL_Color colors[2] = { { 0, 0, 0, 255 }, { 255, 255, 255, 255 } };
+            SDL_SetPaletteColors(palette, colors, 0, 2);
+        }
+
+        result = SDL_ClearSurface(surface, 1.0f, 1.0f, 1.0f, 1.0f);
+        SDLTest_AssertCheck(result, "SDL_ClearSurface(%s), expected: true, got: %s", SDL_GetPixelFormatName(formats[i]), result ? "true" : "false");
+
+        /* Every pixel should be index 1, packed into whole bytes */
+        expected = (Uint8)(0xFF / ((1 << SDL_BITSPERPIXEL(formats[i])) - 1));
+        for (y = 0; y < surface->h; ++y) {
+            const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+            for (x = 0; x < (surface->w * SDL_BITSPERPIXEL(formats[i]) + 7) / 8; ++x) {
+                if (row[x] != expected) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify %s surface is cleared to index 1, expected 0 mismatched bytes, got %d", SDL_GetPixelFormatName(formats[i]), mismatches);
+        SDL_DestroySurface(surface);
+    }
+
+    /* A surface with padding between rows must not have the padding cleared */
+    SDL_memset(pixels, 0xA5, sizeof(pixels));
+    surface = SDL_CreateSurfaceFrom(3, 4, SDL_PIXELFORMAT_ARGB8888, pixels, 16);
+    SDLTest_AssertCheck(surface != NULL, "Create preallocated surface with padding");
+    if (surface) {
+        mismatches = 0;
+        result = SDL_ClearSurface(surface, 0.0f, 0.0f, 0.0f, 0.0f);
+        SDLTest_AssertCheck(result, "SDL_ClearSurface(), expected: true, got: %s", result ? "true" : "false");
+        for (y = 0; y < 4; ++y) {
+            for (x = 0; x < 16; ++x) {
+                Uint8 value = (x < 12) ? 0x00 : 0xA5;
+                if (pixels[y * 16 + x] != value) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify pixels are cleared and padding is preserved, expected 0 mismatched bytes, got %d", mismatches);
+        SDL_DestroySurface(surface);
+    }
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests blitting from a zero sized source rectangle
  */
@@ -1822,6 +2238,298 @@ static int SDLCALL surface_testPremultiplyAlpha(void *arg)
 }
 
 
+static int SDLCALL surface_testUnpremultiplyAlpha(void *arg)
+{
+    SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA8888,
+    };
+    SDL_Surface *surface;
+    SDL_PixelFormat format;
+    Uint8 r, g, b, a;
+    Uint8 expectedR, expectedG, expectedB;
+    int i, x, y, ret;
+    int mismatches;
+
+    /* Every alpha value, every color value, on a row wide enough to hit both the SIMD and scalar code */
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        format = formats[i];
+
+        surface = SDL_CreateSurface(256, 256, format);
+        SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+        for (y = 0; y < 256; ++y) {
+            for (x = 0; x < 256; ++x) {
+                SDL_WriteSurfacePixel(surface, x, y, (Uint8)x, (Uint8)(255 - x), (Uint8)(x / 2), (Uint8)y);
+            }
+        }
+
+        ret = SDL_PremultiplySurfaceAlpha(surface, false);
+        SDLTest_AssertCheck(ret == true, "SDL_PremultiplySurfaceAlpha()");
+        mismatches = 0;
+        for (y = 0; y < 256; ++y) {
+            for (x = 0; x < 256; ++x) {
+                SDL_ReadSurfacePixel(surface, x, y, &r, &g, &b, &a);
+                if (r != (x * y) / 255 || g != ((255 - x) * y) / 255 || b != ((x / 2) * y) / 255 || a != y) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Checking %s alpha premultiply results, expected 0 mismatches, got %d", SDL_GetPixelFormatName(format), mismatches);
+
+        for (y = 0; y < 256; ++y) {
+            for (x = 0; x < 256; ++x) {
+                SDL_WriteSurfacePixel(surface, x, y, (Uint8)SDL_min(x, y), (Uint8)(y - SDL_min(x, y)), (Uint8)(y / 2), (Uint8)y);
+            }
+        }
+        ret = SDL_UnpremultiplySurfaceAlpha(surface, false);
+        SDLTest_AssertCheck(ret == true, "SDL_UnpremultiplySurfaceAlpha()");
+        mismatches = 0;
+        for (y = 0; y < 256; ++y) {
+            for (x = 0; x < 256; ++x) {
+                SDL_ReadSurfacePixel(surface, x, y, &r, &g, &b, &a);
+                if (y == 0) {
+                    expectedR = expectedG = expectedB = 0;
+                } else {
+                    expectedR = (Uint8)SDL_lroundf(SDL_min(x, y) * 255.0f / y);
+                    expectedG = (Uint8)SDL_lroundf((y - SDL_min(x, y)) * 255.0f / y);
+                    expectedB = (Uint8)SDL_lroundf((y / 2) * 255.0f / y);
+                }
+                if (SDL_abs(r - expectedR) > 1 || SDL_abs(g - expectedG) > 1 || SDL_abs(b - expectedB) > 1 || a != y) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Checking %s alpha unpremultiply results, expected 0 mismatches, got %d", SDL_GetPixelFormatName(format), mismatches);
+
+        SDL_DestroySurface(surface);
+    }
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testSurfacePool(void *arg)
+{
+    SDL_Surface *surface;
+    Uint64 hits, misses, cached_bytes;
+    Uint64 start_hits, start_misses;
+    void *pixels;
+    int i;
+
+    SDL_SetHint(SDL_HINT_SURFACE_POOL_SIZE, "16777216");
+
+    SDL_GetSurfacePoolStats(&start_hits, &start_misses, NULL);
+
+    /* The first surface misses, every surface after that reuses its buffer */
+    surface = SDL_CreateSurface(640, 480, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    SDLTest_AssertCheck((surface->flags & SDL_SURFACE_SIMD_ALIGNED) != 0, "Verify pooled pixels are SIMD aligned");
+    pixels = surface->pixels;
+    SDL_DestroySurface(surface);
+    for (i = 0; i < 10; ++i) {
+        surface = SDL_CreateSurface(640, 480, SDL_PIXELFORMAT_XRGB8888);
+        SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+        SDLTest_AssertCheck(surface->pixels == pixels, "Verify pixel buffer was reused");
+        SDLTest_AssertCheck(SDL_ReadSurfacePixel(surface, 639, 479, NULL, NULL, NULL, NULL), "SDL_ReadSurfacePixel()");
+        SDL_FillSurfaceRect(surface, NULL, 0xFFFFFFFF);
+        SDL_DestroySurface(surface);
+    }
+
+    SDL_GetSurfacePoolStats(&hits, &misses, &cached_bytes);
+    SDLTest_AssertCheck(hits - start_hits == 10, "Verify pool hits, expected 10, got %" SDL_PRIu64, hits - start_hits);
+    SDLTest_AssertCheck(misses - start_misses == 1, "Verify pool misses, expected 1, got %" SDL_PRIu64, misses - start_misses);
+    SDLTest_AssertCheck(cached_bytes == 640 * 480 * 4, "Verify pool size, expected %d, got %" SDL_PRIu64, 640 * 480 * 4, cached_bytes);
+
+    /* Buffers that don't fit are freed instead of cached */
+    surface = SDL_CreateSurface(4096, 4096, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    SDL_DestroySurface(surface);
+    SDL_GetSurfacePoolStats(NULL, NULL, &cached_bytes);
+    SDLTest_AssertCheck(cached_bytes == 640 * 480 * 4, "Verify pool size, expected %d, got %" SDL_PRIu64, 640 * 480 * 4, cached_bytes);
+
+    /* Large buffers can be backed by huge pages */
+    SDL_SetHint(SDL_HINT_SURFACE_POOL_HUGEPAGES, "1");
+    for (i = 0; i < 2; ++i) {
+        Uint8 r, g, b, a;
+
+        surface = SDL_CreateSurface(1500, 1500, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+        if (surface) {
+            SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, 10, 20, 30, 40));
+            SDL_ReadSurfacePixel(surface, 1499, 1499, &r, &g, &b, &a);
+            SDLTest_AssertCheck(r == 10 && g == 20 && b == 30 && a == 40, "Verify huge page backed pixels, expected 10,20,30,40, got %d,%d,%d,%d", r, g, b, a);
+            SDL_DestroySurface(surface);
+        }
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_POOL_HUGEPAGES);
+
+    /* Disabling the pool releases everything */
+    SDL_ResetHint(SDL_HINT_SURFACE_POOL_SIZE);
+    SDL_GetSurfacePoolStats(NULL, NULL, &cached_bytes);
+    SDLTest_AssertCheck(cached_bytes == 0, "Verify pool size, expected 0, got %" SDL_PRIu64, cached_bytes);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testDuplicateCopyOnWrite(void *arg)
+{
+    SDL_Surface *surface, *duplicate, *duplicate2;
+    void *pixels;
+    Uint8 r, g, b, a;
+    int ret;
+
+    SDL_SetHint(SDL_HINT_SURFACE_DUPLICATE_COPY_ON_WRITE, "1");
+
+    surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    SDL_FillSurfaceRect(surface, NULL, 0xFF112233);
+    pixels = surface->pixels;
+
+    /* Duplicates share the pixels until written */
+    duplicate = SDL_DuplicateSurface(surface);
+    SDLTest_AssertCheck(duplicate != NULL, "SDL_DuplicateSurface()");
+    SDLTest_AssertCheck(duplicate->pixels == pixels, "Verify duplicate shares pixels");
+    duplicate2 = SDL_DuplicateSurface(duplicate);
+    SDLTest_AssertCheck(duplicate2 != NULL, "SDL_DuplicateSurface()");
+    SDLTest_AssertCheck(duplicate2->pixels == pixels, "Verify second duplicate shares pixels");
+    SDLTest_AssertCheck(SDL_GetSurfaceBlendMode(duplicate, NULL), "SDL_GetSurfaceBlendMode()");
+
+    /* Reading and saving don't need a copy */
+    {
+        SDL_IOStream *io = SDL_IOFromDynamicMem();
+        SDL_Surface *target = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+
+        ret = SDL_SaveBMP_IO(duplicate, io, true);
+        SDLTest_AssertCheck(ret == true, "SDL_SaveBMP_IO()");
+        ret = SDL_BlitSurface(duplicate, NULL, target, NULL);
+        SDLTest_AssertCheck(ret == true, "SDL_BlitSurface()");
+        SDL_ReadSurfacePixel(duplicate, 10, 10, &r, &g, &b, &a);
+        SDLTest_AssertCheck(duplicate->pixels == pixels, "Verify duplicate still shares pixels after reading");
+        SDL_DestroySurface(target);
+    }
+
+    ret = SDL_FillSurfaceRect(duplicate, NULL, 0xFF445566);
+    SDLTest_AssertCheck(ret == true, "SDL_FillSurfaceRect()");
+    SDLTest_AssertCheck(duplicate->pixels != pixels, "Verify written duplicate has its own pixels");
+    SDL_ReadSurfacePixel(surface, 10, 10, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 0x11 && g == 0x22 && b == 0x33, "Verify original is unchanged, expected 0x11,0x22,0x33, got 0x%.2x,0x%.2x,0x%.2x", r, g, b);
+    SDL_ReadSurfacePixel(duplicate2, 10, 10, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 0x11 && g == 0x22 && b == 0x33, "Verify second duplicate is unchanged, expected 0x11,0x22,0x33, got 0x%.2x,0x%.2x,0x%.2x", r, g, b);
+    SDL_ReadSurfacePixel(duplicate, 10, 10, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 0x44 && g == 0x55 && b == 0x66, "Verify duplicate was written, expected 0x44,0x55,0x66, got 0x%.2x,0x%.2x,0x%.2x", r, g, b);
+
+    /* Writing the original copies too, while another surface holds the pixels */
+    ret = SDL_WriteSurfacePixel(surface, 0, 0, 1, 2, 3, 4);
+    SDLTest_AssertCheck(ret == true, "SDL_WriteSurfacePixel()");
+    SDLTest_AssertCheck(surface->pixels != pixels, "Verify written original has its own pixels");
+    SDLTest_AssertCheck(duplicate2->pixels == pixels, "Verify second duplicate kept the shared pixels");
+
+    /* The last surface holding the pixels takes them back without copying */
+    ret = SDL_LockSurface(duplicate2);
+    SDLTest_AssertCheck(ret == true, "SDL_LockSurface()");
+    SDLTest_AssertCheck(duplicate2->pixels == pixels, "Verify last user owns the shared pixels");
+    SDL_UnlockSurface(duplicate2);
+
+    SDL_DestroySurface(duplicate2);
+    SDL_DestroySurface(duplicate);
+    SDL_DestroySurface(surface);
+
+    SDL_ResetHint(SDL_HINT_SURFACE_DUPLICATE_COPY_ON_WRITE);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testSurfaceView(void *arg)
+{
+    SDL_Surface *surface, *view, *view2, *converted, *duplicate;
+    SDL_Palette *palette;
+    SDL_Rect rect;
+    Uint8 r, g, b, a;
+    int ret;
+
+    surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    SDL_FillSurfaceRect(surface, NULL, 0xFF112233);
+    SDL_SetSurfaceColorspace(surface, SDL_COLORSPACE_SRGB_LINEAR);
+
+    /* Invalid rectangles are rejected */
+    rect.x = 60;
+    rect.y = 0;
+    rect.w = 8;
+    rect.h = 8;
+    view = SDL_CreateSurfaceView(surface, &rect);
+    SDLTest_AssertCheck(view == NULL, "Verify SDL_CreateSurfaceView() fails with a rectangle outside the surface");
+
+    /* The view refers to the parent pixels */
+    rect.x = 16;
+    rect.y = 8;
+    rect.w = 16;
+    rect.h = 16;
+    view = SDL_CreateSurfaceView(surface, &rect);
+    SDLTest_AssertCheck(view != NULL, "SDL_CreateSurfaceView()");
+    SDLTest_AssertCheck(view->w == 16 && view->h == 16, "Verify view size, expected 16x16, got %dx%d", view->w, view->h);
+    SDLTest_AssertCheck(view->pitch == surface->pitch, "Verify view pitch, expected %d, got %d", surface->pitch, view->pitch);
+    SDLTest_AssertCheck(view->pixels == (Uint8 *)surface->pixels + 8 * surface->pitch + 16 * 4, "Verify view pixels");
+    SDLTest_AssertCheck(SDL_GetSurfaceColorspace(view) == SDL_COLORSPACE_SRGB_LINEAR, "Verify view inherited colorspace");
+
+    ret = SDL_FillSurfaceRect(view, NULL, 0xFF445566);
+    SDLTest_AssertCheck(ret == true, "SDL_FillSurfaceRect()");
+    SDL_ReadSurfacePixel(surface, 16, 8, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 0x44 && g == 0x55 && b == 0x66, "Verify parent was written through the view, expected 0x44,0x55,0x66, got 0x%.2x,0x%.2x,0x%.2x", r, g, b);
+    SDL_ReadSurfacePixel(surface, 15, 8, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 0x11 && g == 0x22 && b == 0x33, "Verify parent outside the view is unchanged, expected 0x11,0x22,0x33, got 0x%.2x,0x%.2x,0x%.2x", r, g, b);
+
+    /* Views can be converted and nested */
+    converted = SDL_ConvertSurfaceAndColorspace(view, SDL_PIXELFORMAT_RGB24, NULL, SDL_COLORSPACE_SRGB_LINEAR, 0);
+    SDLTest_AssertCheck(converted != NULL, "SDL_ConvertSurfaceAndColorspace()");
+    SDL_ReadSurfacePixel(converted, 15, 15, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 0x44 && g == 0x55 && b == 0x66, "Verify converted view, expected 0x44,0x55,0x66, got 0x%.2x,0x%.2x,0x%.2x", r, g, b);
+    SDL_DestroySurface(converted);
+
+    rect.x = 4;
+    rect.y = 4;
+    rect.w = 4;
+    rect.h = 4;
+    view2 = SDL_CreateSurfaceView(view, &rect);
+    SDLTest_AssertCheck(view2 != NULL, "SDL_CreateSurfaceView()");
+    SDLTest_AssertCheck(view2->pixels == (Uint8 *)surface->pixels + 12 * surface->pitch + 20 * 4, "Verify nested view pixels");
+
+    /* Duplicating the parent copies the pixels even with copy-on-write enabled */
+    SDL_SetHint(SDL_HINT_SURFACE_DUPLICATE_COPY_ON_WRITE, "1");
+    duplicate = SDL_DuplicateSurface(surface);
+    SDLTest_AssertCheck(duplicate != NULL, "SDL_DuplicateSurface()");
+    SDLTest_AssertCheck(duplicate->pixels != surface->pixels, "Verify duplicate of a surface with views has its own pixels");
+    SDL_DestroySurface(duplicate);
+    SDL_ResetHint(SDL_HINT_SURFACE_DUPLICATE_COPY_ON_WRITE);
+
+    /* Views keep the parent alive */
+    SDL_DestroySurface(surface);
+    SDL_DestroySurface(view);
+    ret = SDL_BlitSurface(surface, NULL, view2, NULL);
+    SDLTest_AssertCheck(ret == true, "SDL_BlitSurface() between a surface and its view");
+    SDL_ReadSurfacePixel(view2, 0, 0, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 0x11 && g == 0x22 && b == 0x33, "Verify blit to view, expected 0x11,0x22,0x33, got 0x%.2x,0x%.2x,0x%.2x", r, g, b);
+    SDL_DestroySurface(view2);
+
+    /* Indexed views share the palette and start on a byte boundary */
+    surface = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_INDEX4MSB);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    palette = SDL_CreateSurfacePalette(surface);
+    SDLTest_AssertCheck(palette != NULL, "SDL_CreateSurfacePalette()");
+    rect.x = 3;
+    rect.y = 0;
+    rect.w = 4;
+    rect.h = 4;
+    view = SDL_CreateSurfaceView(surface, &rect);
+    SDLTest_AssertCheck(view == NULL, "Verify SDL_CreateSurfaceView() fails when not starting on a byte boundary");
+    rect.x = 4;
+    view = SDL_CreateSurfaceView(surface, &rect);
+    SDLTest_AssertCheck(view != NULL, "SDL_CreateSurfaceView()");
+    SDLTest_AssertCheck(SDL_GetSurfacePalette(view) == palette, "Verify view shares the parent palette");
+    SDL_DestroySurface(view);
+    SDL_DestroySurface(surface);
+
+    return TEST_COMPLETED;
+}
+
 static int SDLCALL surface_testScale(void *arg)
 {
     SDL_PixelFormat formats[] = {
@@ -1982,6 +2690,22 @@ static const SDLTest_TestCaseReference surfaceTestSaveLoad = {
     surface_testSaveLoad, "surface_testSaveLoad", "Tests sprite saving and loading.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestLoadBMPMapped = {
+    surface_testLoadBMPMapped, "surface_testLoadBMPMapped", "Tests loading BMP files with their pixels mapped from the file.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestLoadSurfaceAsync = {
+    surface_testLoadSurfaceAsync, "surface_testLoadSurfaceAsync", "Tests loading images with SDL_LoadSurface_IO() and a surface load queue.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestFillRects = {
+    surface_testFillRects, "surface_testFillRects", "Tests filling rectangles of all pixel sizes.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestClearSurfaceBytes = {
+    surface_testClearSurfaceBytes, "surface_testClearSurfaceBytes", "Tests clearing bitmap surfaces and surfaces with padding.", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference surfaceTestBlitZeroSource = {
     surface_testBlitZeroSource, "surface_testBlitZeroSource", "Tests blitting from a zero sized source rectangle", TEST_ENABLED
 };
@@ -2086,6 +2810,22 @@ static const SDLTest_TestCaseReference surfaceTestPremultiplyAlpha = {
     surface_testPremultiplyAlpha, "surface_testPremultiplyAlpha", "Test alpha premultiply operations.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestUnpremultiplyAlpha = {
+    surface_testUnpremultiplyAlpha, "surface_testUnpremultiplyAlpha", "Test alpha unpremultiply operations.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestSurfacePool = {
+    surface_testSurfacePool, "surface_testSurfacePool", "Test surface pixel pool.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestDuplicateCopyOnWrite = {
+    surface_testDuplicateCopyOnWrite, "surface_testDuplicateCopyOnWrite", "Test copy-on-write surface duplication.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestSurfaceView = {
+    surface_testSurfaceView, "surface_testSurfaceView", "Test surface views into other surfaces.", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference surfaceTestScale = {
     surface_testScale, "surface_testScale", "Test scaling operations.", TEST_ENABLED
 };
@@ -2098,6 +2838,10 @@ static const SDLTest_TestCaseReference surfaceTest16BitTo32Bit = {
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestInvalidFormat,
     &surfaceTestSaveLoad,
+    &surfaceTestLoadBMPMapped,
+    &surfaceTestLoadSurfaceAsync,
+    &surfaceTestFillRects,
+    &surfaceTestClearSurfaceBytes,
     &surfaceTestBlitZeroSource,
     &surfaceTestBlit,
     &surfaceTestBlitTiled,
@@ -2124,6 +2868,10 @@ static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestPalettization,
     &surfaceTestClearSurface,
     &surfaceTestPremultiplyAlpha,
+    &surfaceTestUnpremultiplyAlpha,
+    &surfaceTestSurfacePool,
+    &surfaceTestDuplicateCopyOnWrite,
+    &surfaceTestSurfaceView,
     &surfaceTestScale,
     &surfaceTest16BitTo32Bit,
     NULL
@@ -2493,6 +2493,279 @@ static int SDLCALL video_getWindowSurface(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests window surface damage tracking
+ */
+static int SDLCALL video_getWindowSurfaceDamage(void *arg)
+{
+    const char *title = "video_getWindowSurfaceDamage Test Window";
+    SDL_Window *window;
+    SDL_Surface *surface;
+    SDL_Rect *damage;
+    SDL_Rect rect;
+    int count;
+    int result;
+
+    window = SDL_CreateWindow(title, 320, 320, 0);
+    SDLTest_AssertPass("Call to SDL_CreateWindow('Title',320,320,0)");
+    SDLTest_AssertCheck(window != NULL, "Validate that returned window is not NULL");
+
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertPass("Call to SDL_GetWindowSurfaceDamage(window, &count)");
+    SDLTest_AssertCheck(damage == NULL, "Validate that damage is not available before tracking is enabled");
+
+    result = SDL_SetWindowSurfaceDamageTracking(window, true);
+    SDLTest_AssertPass("Call to SDL_SetWindowSurfaceDamageTracking(window, true)");
+    SDLTest_AssertCheck(result == true, "Verify return value; expected: true, got: %d", result);
+
+    surface = SDL_GetWindowSurface(window);
+    SDLTest_AssertPass("Call to SDL_GetWindowSurface(window)");
+    SDLTest_AssertCheck(surface != NULL, "Validate that returned surface is not NULL");
+
+    /* A new surface is entirely damaged */
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertCheck(damage != NULL && count == 1, "Validate that a new surface has one damaged area, got %d", count);
+    if (damage && count == 1) {
+        SDLTest_AssertCheck(damage[0].x == 0 && damage[0].y == 0 && damage[0].w == surface->w && damage[0].h == surface->h,
+                            "Validate damage covers the surface, got %d,%d %dx%d", damage[0].x, damage[0].y, damage[0].w, damage[0].h);
+    }
+    SDL_free(damage);
+
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertPass("Call to SDL_UpdateWindowSurface(window)");
+    SDLTest_AssertCheck(result == true, "Verify return value; expected: true, got: %d", result);
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertCheck(damage != NULL && count == 0, "Validate that updating clears the damage, got %d areas", count);
+    SDL_free(damage);
+
+    /* Overlapping fills are merged, separate writes are kept apart */
+    rect.x = 10;
+    rect.y = 10;
+    rect.w = 20;
+    rect.h = 20;
+    SDL_FillSurfaceRect(surface, &rect, 0);
+    rect.x = 20;
+    SDL_FillSurfaceRect(surface, &rect, 0);
+    SDL_WriteSurfacePixel(surface, 200, 200, 255, 255, 255, 255);
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertCheck(damage != NULL && count == 2, "Validate number of damaged areas, expected 2, got %d", count);
+    if (damage && count == 2) {
+        SDLTest_AssertCheck(damage[0].x == 10 && damage[0].y == 10 && damage[0].w == 30 && damage[0].h == 20,
+                            "Validate merged fill damage, expected 10,10 30x20, got %d,%d %dx%d", damage[0].x, damage[0].y, damage[0].w, damage[0].h);
+        SDLTest_AssertCheck(damage[1].x == 200 && damage[1].y == 200 && damage[1].w == 1 && damage[1].h == 1,
+                            "Validate pixel damage, expected 200,200 1x1, got %d,%d %dx%d", damage[1].x, damage[1].y, damage[1].w, damage[1].h);
+    }
+    SDL_free(damage);
+
+    /* Direct writes are reported by the application */
+    rect.x = 100;
+    rect.y = 0;
+    rect.w = 50;
+    rect.h = 50;
+    result = SDL_AddWindowSurfaceDamage(window, &rect);
+    SDLTest_AssertPass("Call to SDL_AddWindowSurfaceDamage(window, &rect)");
+    SDLTest_AssertCheck(result == true, "Verify return value; expected: true, got: %d", result);
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertCheck(damage != NULL && count == 3, "Validate number of damaged areas, expected 3, got %d", count);
+    SDL_free(damage);
+
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertCheck(result == true, "Verify return value; expected: true, got: %d", result);
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertCheck(damage != NULL && count == 0, "Validate that updating clears the damage, got %d areas", count);
+    SDL_free(damage);
+
+    result = SDL_SetWindowSurfaceDamageTracking(window, false);
+    SDLTest_AssertPass("Call to SDL_SetWindowSurfaceDamageTracking(window, false)");
+    SDLTest_AssertCheck(result == true, "Verify return value; expected: true, got: %d", result);
+
+    /* Clean up */
+    SDL_DestroyWindow(window);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests presenting a window surface with multiple shared memory buffers
+ */
+static int SDLCALL video_updateWindowSurfaceBuffers(void *arg)
+{
+    const char *buffer_counts[] = { "1", "2", "3" };
+    SDL_Window *window;
+    SDL_Surface *surface;
+    SDL_Rect rect;
+    int i, frame;
+    int result;
+
+    for (i = 0; i < SDL_arraysize(buffer_counts); ++i) {
+        SDL_SetHint(SDL_HINT_VIDEO_X11_SHM_BUFFERS, buffer_counts[i]);
+        SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_VIDEO_X11_SHM_BUFFERS, \"%s\")", buffer_counts[i]);
+
+        window = SDL_CreateWindow("video_updateWindowSurfaceBuffers Test Window", 320, 240, 0);
+        SDLTest_AssertCheck(window != NULL, "Validate that returned window is not NULL");
+        if (!window) {
+            break;
+        }
+
+        surface = SDL_GetWindowSurface(window);
+        SDLTest_AssertCheck(surface != NULL, "Validate that returned surface is not NULL");
+        if (!surface) {
+            SDL_DestroyWindow(window);
+            break;
+        }
+
+        /* Cycle through the buffers several times, with full and partial updates */
+        for (frame = 0; frame < 16; ++frame) {
+            rect.x = (frame * 16) % (surface->w - 32);
+            rect.y = (frame * 8) % (surface->h - 32);
+            rect.w = 32;
+            rect.h = 32;
+            SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGB(surface, 0, 0, 0));
+            SDL_FillSurfaceRect(surface, &rect, SDL_MapSurfaceRGB(surface, 255, frame * 16, 0));
+            if (frame % 4 == 0) {
+                result = SDL_UpdateWindowSurface(window);
+            } else {
+                result = SDL_UpdateWindowSurfaceRects(window, &rect, 1);
+            }
+            SDLTest_AssertCheck(result == true, "Verify update with %s buffer(s), frame %d; expected: true, got: %d", buffer_counts[i], frame, result);
+        }
+
+        /* Resizing recreates the buffers */
+        SDL_SetWindowSize(window, 200, 100);
+        SDL_SyncWindow(window);
+        surface = SDL_GetWindowSurface(window);
+        SDLTest_AssertCheck(surface != NULL, "Validate that resized surface is not NULL");
+        if (surface) {
+            SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGB(surface, 0, 0, 255));
+            result = SDL_UpdateWindowSurface(window);
+            SDLTest_AssertCheck(result == true, "Verify update after resize; expected: true, got: %d", result);
+        }
+
+        SDL_DestroyWindow(window);
+    }
+
+    SDL_ResetHint(SDL_HINT_VIDEO_X11_SHM_BUFFERS);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests saving frames from the offscreen video driver as a YUV4MPEG2 stream
+ */
+static int SDLCALL video_offscreenSaveFrames(void *arg)
+{
+    const int num_frames = 3;
+    const int w = 64, h = 48;
+    const char *expected_header = "YUV4MPEG2 W64 H48 F60:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+    const size_t header_size = SDL_strlen(expected_header);
+    const size_t frame_size = SDL_strlen("FRAME\n") + (size_t)(w * h) + 2 * (size_t)((w / 2) * (h / 2));
+    char *old_driver = NULL;
+    char filename[128];
+    bool created_file = false;
+    SDL_Window *window = NULL;
+    SDL_Surface *surface;
+    Uint8 *data = NULL;
+    size_t size = 0;
+    Sint64 saved_frames;
+    int video_refcount = 0;
+    int i;
+    int result;
+
+    /* This needs the offscreen driver, so restart video with it */
+    if (SDL_GetHint(SDL_HINT_VIDEO_DRIVER)) {
+        old_driver = SDL_strdup(SDL_GetHint(SDL_HINT_VIDEO_DRIVER));
+    }
+    while (SDL_WasInit(SDL_INIT_VIDEO)) {
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        ++video_refcount;
+    }
+    SDL_SetHintWithPriority(SDL_HINT_VIDEO_DRIVER, "offscreen", SDL_HINT_OVERRIDE);
+    if (!SDL_InitSubSystem(SDL_INIT_VIDEO)) {
+        SDLTest_Log("Offscreen video driver isn't available: %s", SDL_GetError());
+        SDL_SetHintWithPriority(SDL_HINT_VIDEO_DRIVER, old_driver, SDL_HINT_OVERRIDE);
+        SDL_free(old_driver);
+        for (i = 0; i < video_refcount; ++i) {
+            SDL_InitSubSystem(SDL_INIT_VIDEO);
+        }
+        return TEST_SKIPPED;
+    }
+    SDLTest_AssertCheck(SDL_strcmp(SDL_GetCurrentVideoDriver(), "offscreen") == 0,
+                        "Verify video driver; expected: offscreen, got: %s", SDL_GetCurrentVideoDriver());
+
+    /* Frames are only saved from the driver framebuffer */
+    SDL_SetHint(SDL_HINT_FRAMEBUFFER_ACCELERATION, "0");
+    SDL_SetHint(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES, "1");
+    SDL_SetHint(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_FORMAT, "y4m");
+    SDL_SetHint(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_BUFFERS, "2");
+
+    window = SDL_CreateWindow("video_offscreenSaveFrames Test Window", w, h, 0);
+    SDLTest_AssertCheck(window != NULL, "Validate that returned window is not NULL");
+    if (!window) {
+        goto done;
+    }
+    (void)SDL_snprintf(filename, sizeof(filename), "SDL_window%" SDL_PRIu32 "-%8.8d.y4m", SDL_GetWindowID(window), 1);
+
+    surface = SDL_GetWindowSurface(window);
+    SDLTest_AssertCheck(surface != NULL, "Validate that returned surface is not NULL");
+    if (!surface) {
+        goto done;
+    }
+
+    for (i = 0; i < num_frames; ++i) {
+        SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGB(surface, 255, 255, 255));
+        result = SDL_UpdateWindowSurface(window);
+        SDLTest_AssertCheck(result == true, "Verify SDL_UpdateWindowSurface() for frame %d; expected: true, got: %d", i + 1, result);
+        created_file = true;
+    }
+
+    saved_frames = SDL_GetNumberProperty(SDL_GetWindowProperties(window), SDL_PROP_WINDOW_OFFSCREEN_SAVED_FRAMES_NUMBER, 0);
+    SDLTest_AssertCheck(saved_frames == num_frames, "Verify saved frames; expected: %d, got: %" SDL_PRIs64, num_frames, saved_frames);
+
+    /* Destroying the window waits for the queued frames to be written */
+    SDL_DestroyWindow(window);
+    window = NULL;
+
+    data = (Uint8 *)SDL_LoadFile(filename, &size);
+    SDLTest_AssertCheck(data != NULL, "Validate that %s was written", filename);
+    if (!data) {
+        goto done;
+    }
+    SDLTest_AssertCheck(size >= header_size && SDL_memcmp(data, expected_header, header_size) == 0,
+                        "Verify stream header, expected: %s", expected_header);
+    SDLTest_AssertCheck(size == header_size + num_frames * frame_size,
+                        "Verify stream size; expected: %d frames, got: %d bytes", num_frames, (int)size);
+    if (size == header_size + num_frames * frame_size) {
+        for (i = 0; i < num_frames; ++i) {
+            const Uint8 *frame = data + header_size + i * frame_size;
+            SDLTest_AssertCheck(SDL_memcmp(frame, "FRAME\n", 6) == 0, "Verify header of frame %d", i + 1);
+            /* White is full range */
+            SDLTest_AssertCheck(frame[6] == 255, "Verify luma of frame %d; expected: 255, got: %d", i + 1, frame[6]);
+        }
+    }
+
+done:
+    SDL_free(data);
+    if (window) {
+        SDL_DestroyWindow(window);
+    }
+    if (created_file) {
+        SDL_RemovePath(filename);
+    }
+    SDL_ResetHint(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES);
+    SDL_ResetHint(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_FORMAT);
+    SDL_ResetHint(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES_BUFFERS);
+    SDL_ResetHint(SDL_HINT_FRAMEBUFFER_ACCELERATION);
+
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    SDL_SetHintWithPriority(SDL_HINT_VIDEO_DRIVER, old_driver, SDL_HINT_OVERRIDE);
+    SDL_free(old_driver);
+    for (i = 0; i < video_refcount; ++i) {
+        SDL_InitSubSystem(SDL_INIT_VIDEO);
+    }
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests SDL_RaiseWindow
  */
@@ -2610,6 +2883,15 @@ static const SDLTest_TestCaseReference videoTestCreateMaximized = {
 static const SDLTest_TestCaseReference videoTestGetWindowSurface = {
     video_getWindowSurface, "video_getWindowSurface", "Checks window surface functionality", TEST_ENABLED
 };
+static const SDLTest_TestCaseReference videoTestGetWindowSurfaceDamage = {
+    video_getWindowSurfaceDamage, "video_getWindowSurfaceDamage", "Checks window surface damage tracking", TEST_ENABLED
+};
+static const SDLTest_TestCaseReference videoTestUpdateWindowSurfaceBuffers = {
+    video_updateWindowSurfaceBuffers, "video_updateWindowSurfaceBuffers", "Checks window surface updates with multiple shared memory buffers", TEST_ENABLED
+};
+static const SDLTest_TestCaseReference videoTestOffscreenSaveFrames = {
+    video_offscreenSaveFrames, "video_offscreenSaveFrames", "Checks saving offscreen frames as a YUV4MPEG2 stream", TEST_ENABLED
+};
 static const SDLTest_TestCaseReference videoTestRaiseWindow = {
     video_raiseWindow, "video_raiseWindow", "Checks window focus", TEST_ENABLED
 };
@@ -2638,6 +2920,9 @@ static const SDLTest_TestCaseReference *videoTests[] = {
     &videoTestCreateMinimized,
     &videoTestCreateMaximized,
     &videoTestGetWindowSurface,
+    &videoTestGetWindowSurfaceDamage,
+    &videoTestUpdateWindowSurfaceBuffers,
+    &videoTestOffscreenSaveFrames,
     &videoTestRaiseWindow,
     NULL
 };
@@ -0,0 +1,359 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure blit throughput over a matrix of formats and blit options, and show which blitter handles each one */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef enum
+{
+    BLIT_COPY,
+    BLIT_BLEND,
+    BLIT_BLEND_ALPHAMOD,
+    BLIT_COLORMOD,
+    BLIT_COLORKEY,
+    BLIT_COLORKEY_RLE,
+    BLIT_BLEND_RLE,
+    BLIT_SCALE_NEAREST,
+    BLIT_SCALE_LINEAR,
+    NUM_BLIT_VARIANTS
+} BlitVariant;
+
+static const char *variant_names[NUM_BLIT_VARIANTS] = {
+    "copy",
+    "blend",
+    "blend+alphamod",
+    "colormod",
+    "colorkey",
+    "colorkey+RLE",
+    "blend+RLE",
+    "scale nearest",
+    "scale linear"
+};
+
+static const SDL_PixelFormat src_formats[] = {
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_XRGB8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_ARGB1555,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_INDEX8,
+    SDL_PIXELFORMAT_ARGB2101010,
+    SDL_PIXELFORMAT_RGBA64
+};
+
+static const SDL_PixelFormat dst_formats[] = {
+    SDL_PIXELFORMAT_XRGB8888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_RGB24
+};
+
+static char blitter[128] = "?";
+static char scaler[128] = "?";
+
+static const char *FormatName(SDL_PixelFormat format)
+{
+    const char *name = SDL_GetPixelFormatName(format);
+
+    if (SDL_strncmp(name, "SDL_PIXELFORMAT_", 16) == 0) {
+        name += 16;
+    }
+    return name;
+}
+
+static bool ParseFormat(const char *name, SDL_PixelFormat *format)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(src_formats); ++i) {
+        if (SDL_strcasecmp(name, FormatName(src_formats[i])) == 0) {
+            *format = src_formats[i];
+            return true;
+        }
+    }
+    for (i = 0; i < SDL_arraysize(dst_formats); ++i) {
+        if (SDL_strcasecmp(name, FormatName(dst_formats[i])) == 0) {
+            *format = dst_formats[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/* SDL only logs a blit or scale path when it changes, so these always hold the
+   last ones chosen, which are the ones used if nothing new was logged */
+static void SDLCALL CaptureBlitter(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    const char *with = SDL_strstr(message, " with ");
+
+    if (category == SDL_LOG_CATEGORY_VIDEO && SDL_strncmp(message, "Blitting ", 9) == 0 && with) {
+        /* Keep the last blitter chosen, scaled blits may go through intermediate surfaces first */
+        SDL_strlcpy(blitter, with + 6, sizeof(blitter));
+    } else if (category == SDL_LOG_CATEGORY_VIDEO && SDL_strncmp(message, "Scaling ", 8) == 0 && with) {
+        SDL_strlcpy(scaler, with + 6, sizeof(scaler));
+    } else {
+        SDL_GetDefaultLogOutputFunction()(userdata, category, priority, message);
+    }
+}
+
+static SDL_Surface *CreateSource(SDL_PixelFormat format, int w, int h)
+{
+    SDL_Surface *surface = SDL_CreateSurface(w, h, format);
+    Uint64 seed = 0;
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
+        SDL_Color colors[256];
+        int i;
+
+        for (i = 0; i < SDL_arraysize(colors); ++i) {
+            colors[i].r = (Uint8)i;
+            colors[i].g = (Uint8)(255 - i);
+            colors[i].b = (Uint8)(i * 7);
+            colors[i].a = (Uint8)(i * 3);
+        }
+        SDL_SetPaletteColors(palette, colors, 0, SDL_arraysize(colors));
+    }
+
+    /* Noise with transparent runs, so colorkey and alpha blits have something to skip */
+    for (y = 0; y < h; ++y) {
+        for (x = 0; x < w; ++x) {
+            if (((x / 16) + (y / 16)) % 3 == 0) {
+                SDL_WriteSurfacePixel(surface, x, y, 0, 0, 0, 0);
+            } else {
+                SDL_WriteSurfacePixel(surface, x, y, (Uint8)SDL_rand_r(&seed, 256), (Uint8)SDL_rand_r(&seed, 256), (Uint8)SDL_rand_r(&seed, 256), (Uint8)SDL_rand_r(&seed, 256));
+            }
+        }
+    }
+    return surface;
+}
+
+static bool SetupVariant(SDL_Surface *src, BlitVariant variant)
+{
+    switch (variant) {
+    case BLIT_COPY:
+    case BLIT_SCALE_NEAREST:
+    case BLIT_SCALE_LINEAR:
+        return SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+    case BLIT_BLEND:
+        return SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+    case BLIT_BLEND_ALPHAMOD:
+        return SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND) &&
+               SDL_SetSurfaceAlphaMod(src, 128);
+    case BLIT_COLORMOD:
+        return SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE) &&
+               SDL_SetSurfaceColorMod(src, 255, 128, 64);
+    case BLIT_COLORKEY:
+        return SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE) &&
+               SDL_SetSurfaceColorKey(src, true, SDL_MapSurfaceRGBA(src, 0, 0, 0, 0));
+    case BLIT_COLORKEY_RLE:
+        return SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE) &&
+               SDL_SetSurfaceColorKey(src, true, SDL_MapSurfaceRGBA(src, 0, 0, 0, 0)) &&
+               SDL_SetSurfaceRLE(src, true);
+    case BLIT_BLEND_RLE:
+        return SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND) &&
+               SDL_SetSurfaceRLE(src, true);
+    default:
+        return false;
+    }
+}
+
+static bool Blit(SDL_Surface *src, SDL_Surface *dst, BlitVariant variant)
+{
+    SDL_Rect dstrect;
+
+    switch (variant) {
+    case BLIT_SCALE_NEAREST:
+    case BLIT_SCALE_LINEAR:
+        /* Scale up by 1.5x, clipped to the destination */
+        dstrect.x = 0;
+        dstrect.y = 0;
+        dstrect.w = src->w + src->w / 2;
+        dstrect.h = src->h + src->h / 2;
+        return SDL_BlitSurfaceScaled(src, NULL, dst, &dstrect, variant == BLIT_SCALE_NEAREST ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR);
+    default:
+        return SDL_BlitSurface(src, NULL, dst, NULL);
+    }
+}
+
+static void RunBenchmark(SDL_PixelFormat src_format, SDL_PixelFormat dst_format, BlitVariant variant, int size, double min_time)
+{
+    SDL_Surface *src = CreateSource(src_format, size, size);
+    SDL_Surface *dst = SDL_CreateSurface(size, size, dst_format);
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 start, elapsed;
+    Uint64 pixels = 0;
+    int iterations = 0;
+    const bool scaled = (variant == BLIT_SCALE_NEAREST || variant == BLIT_SCALE_LINEAR);
+    char path[256];
+
+    if (!src || !dst) {
+        SDL_Log("Couldn't create %dx%d surfaces: %s", size, size, SDL_GetError());
+        goto done;
+    }
+    SDL_FillSurfaceRect(dst, NULL, SDL_MapSurfaceRGB(dst, 32, 64, 96));
+
+    if (!SetupVariant(src, variant)) {
+        SDL_Log("%-12s %-12s %-16s %5d  unsupported: %s", FormatName(src_format), FormatName(dst_format), variant_names[variant], size, SDL_GetError());
+        goto done;
+    }
+
+    /* The first blit chooses the blitter, and warms up the caches */
+    if (!Blit(src, dst, variant)) {
+        SDL_Log("%-12s %-12s %-16s %5d  failed: %s", FormatName(src_format), FormatName(dst_format), variant_names[variant], size, SDL_GetError());
+        goto done;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        Blit(src, dst, variant);
+        ++iterations;
+        elapsed = SDL_GetPerformanceCounter() - start;
+    } while ((double)elapsed / frequency < min_time);
+
+    /* Scaled blits are clipped to the destination, so every variant writes size x size pixels */
+    pixels = (Uint64)size * size * iterations;
+
+    /* Scaled blits report the scaling stage, and the blitter used by it, if any */
+    if (scaled && (SDL_strcmp(scaler, "nearest stretch") == 0 || SDL_strcmp(scaler, "linear stretch") == 0)) {
+        (void)SDL_snprintf(path, sizeof(path), "scale: %s", scaler);
+    } else if (scaled) {
+        (void)SDL_snprintf(path, sizeof(path), "scale: %s, blit: %s", scaler, blitter);
+    } else {
+        (void)SDL_snprintf(path, sizeof(path), "blit: %s", blitter);
+    }
+    SDL_Log("%-12s %-12s %-16s %5d %9.3f ns/px  %s", FormatName(src_format), FormatName(dst_format), variant_names[variant], size, (double)elapsed * 1e9 / frequency / (double)pixels, path);
+
+done:
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_PixelFormat only_src = SDL_PIXELFORMAT_UNKNOWN;
+    SDL_PixelFormat only_dst = SDL_PIXELFORMAT_UNKNOWN;
+    int only_variant = -1;
+    int sizes[8] = { 64, 512 };
+    int num_sizes = 0;
+    double min_time = 0.05;
+    int i, s, d, v, n;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--src") == 0 && argv[i + 1]) {
+                if (ParseFormat(argv[i + 1], &only_src)) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--dst") == 0 && argv[i + 1]) {
+                if (ParseFormat(argv[i + 1], &only_dst)) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--variant") == 0 && argv[i + 1]) {
+                for (v = 0; v < NUM_BLIT_VARIANTS; ++v) {
+                    if (SDL_strcasecmp(argv[i + 1], variant_names[v]) == 0) {
+                        only_variant = v;
+                        consumed = 2;
+                    }
+                }
+            } else if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1] && num_sizes < SDL_arraysize(sizes)) {
+                sizes[num_sizes] = SDL_atoi(argv[i + 1]);
+                if (sizes[num_sizes] > 0) {
+                    ++num_sizes;
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--time") == 0 && argv[i + 1]) {
+                min_time = SDL_atof(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--cpu-features") == 0 && argv[i + 1]) {
+                /* This needs to be set before anything asks for CPU features */
+                SDL_SetHint(SDL_HINT_CPU_FEATURE_MASK, argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--src FORMAT (e.g. ARGB8888)]",
+                "[--dst FORMAT]",
+                "[--variant copy|blend|blend+alphamod|colormod|colorkey|colorkey+RLE|blend+RLE|\"scale nearest\"|\"scale linear\"]",
+                "[--size N (may be repeated)]",
+                "[--time SECONDS]",
+                "[--cpu-features MASK (e.g. -avx2,-sse41)]",
+                NULL
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+    if (num_sizes == 0) {
+        num_sizes = 2;
+    }
+
+    /* The chosen blitters are reported as debug messages */
+    SDL_SetLogPriority(SDL_LOG_CATEGORY_VIDEO, SDL_LOG_PRIORITY_DEBUG);
+    SDL_SetLogOutputFunction(CaptureBlitter, NULL);
+
+    n = 0;
+    for (s = 0; s < SDL_arraysize(src_formats) || only_src != SDL_PIXELFORMAT_UNKNOWN; ++s) {
+        SDL_PixelFormat src_format = (only_src != SDL_PIXELFORMAT_UNKNOWN) ? only_src : src_formats[s];
+
+        for (d = 0; d < SDL_arraysize(dst_formats) || only_dst != SDL_PIXELFORMAT_UNKNOWN; ++d) {
+            SDL_PixelFormat dst_format = (only_dst != SDL_PIXELFORMAT_UNKNOWN) ? only_dst : dst_formats[d];
+
+            for (v = 0; v < NUM_BLIT_VARIANTS; ++v) {
+                if (only_variant >= 0 && v != only_variant) {
+                    continue;
+                }
+                for (i = 0; i < num_sizes; ++i) {
+                    if (n++ == 0) {
+                        SDL_Log("%-12s %-12s %-16s %5s %15s  %s", "source", "destination", "blit", "size", "time", "path");
+                    }
+                    RunBenchmark(src_format, dst_format, (BlitVariant)v, sizes[i], min_time);
+                }
+            }
+            if (only_dst != SDL_PIXELFORMAT_UNKNOWN) {
+                break;
+            }
+        }
+        if (only_src != SDL_PIXELFORMAT_UNKNOWN) {
+            break;
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
@@ -0,0 +1,328 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how long it takes to create a set of graphics pipelines with a
+   cold Vulkan pipeline cache and again with the cache saved by the first run.
+
+   This doesn't need a display, so it can run headless on a software Vulkan
+   implementation like lavapipe with SDL_VIDEO_DRIVER=offscreen. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#include "testgpu/overlay.frag.spv.h"
+#include "testgpu/overlay.vert.spv.h"
+
+/* Pipeline cache data starts with a VkPipelineCacheHeaderVersionOne: the
+   header size and version, the vendor and device IDs, and the cache UUID */
+#define CACHE_HEADER_SIZE           32
+#define CACHE_HEADER_VERSION_ONE    1
+
+static const SDL_GPUTextureFormat formats[] = {
+    SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM,
+    SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM,
+    SDL_GPU_TEXTUREFORMAT_R16G16B16A16_FLOAT,
+    SDL_GPU_TEXTUREFORMAT_R10G10B10A2_UNORM
+};
+
+static const SDL_GPUCullMode cull_modes[] = {
+    SDL_GPU_CULLMODE_NONE,
+    SDL_GPU_CULLMODE_FRONT,
+    SDL_GPU_CULLMODE_BACK
+};
+
+static SDL_GPUDevice *CreateDevice(const char *cache_file, const void *cache_data, size_t cache_size)
+{
+    SDL_GPUDevice *device;
+    SDL_PropertiesID props = SDL_CreateProperties();
+
+    SDL_SetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_SHADERS_SPIRV_BOOLEAN, true);
+    SDL_SetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_DEBUGMODE_BOOLEAN, false);
+    SDL_SetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VERBOSE_BOOLEAN, false);
+    SDL_SetStringProperty(props, SDL_PROP_GPU_DEVICE_CREATE_NAME_STRING, "vulkan");
+    if (cache_file) {
+        SDL_SetStringProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_FILE_STRING, cache_file);
+    }
+    if (cache_data) {
+        SDL_SetPointerProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER, (void *)cache_data);
+        SDL_SetNumberProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_SIZE_NUMBER, (Sint64)cache_size);
+    }
+    device = SDL_CreateGPUDeviceWithProperties(props);
+    SDL_DestroyProperties(props);
+    return device;
+}
+
+static SDL_GPUShader *LoadShader(SDL_GPUDevice *device, bool is_vertex)
+{
+    SDL_GPUShaderCreateInfo createinfo;
+
+    SDL_zero(createinfo);
+    createinfo.num_samplers = is_vertex ? 0 : 1;
+    createinfo.format = SDL_GPU_SHADERFORMAT_SPIRV;
+    createinfo.code = is_vertex ? overlay_vert_spv : overlay_frag_spv;
+    createinfo.code_size = is_vertex ? overlay_vert_spv_len : overlay_frag_spv_len;
+    createinfo.entrypoint = "main";
+    createinfo.stage = is_vertex ? SDL_GPU_SHADERSTAGE_VERTEX : SDL_GPU_SHADERSTAGE_FRAGMENT;
+    return SDL_CreateGPUShader(device, &createinfo);
+}
+
+/* Creates every pipeline variation and measures how long it took */
+static bool CreatePipelines(SDL_GPUDevice *device, Uint64 *elapsed)
+{
+    SDL_GPUGraphicsPipeline *pipelines[SDL_arraysize(formats) * SDL_arraysize(cull_modes) * 2];
+    SDL_GPUShader *vertex_shader, *fragment_shader;
+    SDL_GPUGraphicsPipelineCreateInfo pci;
+    SDL_GPUColorTargetDescription ctd;
+    Uint64 start;
+    int num_pipelines = 0;
+    bool result = false;
+    int i, j, k;
+
+    vertex_shader = LoadShader(device, true);
+    fragment_shader = LoadShader(device, false);
+    if (!vertex_shader || !fragment_shader) {
+        SDL_Log("Couldn't create shaders: %s", SDL_GetError());
+        goto done;
+    }
+
+    SDL_zero(ctd);
+    ctd.blend_state.color_write_mask = 0xF;
+    ctd.blend_state.color_blend_op = SDL_GPU_BLENDOP_ADD;
+    ctd.blend_state.alpha_blend_op = SDL_GPU_BLENDOP_ADD;
+    ctd.blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+    ctd.blend_state.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+    ctd.blend_state.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+    ctd.blend_state.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+
+    SDL_zero(pci);
+    pci.target_info.num_color_targets = 1;
+    pci.target_info.color_target_descriptions = &ctd;
+    pci.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+    pci.vertex_shader = vertex_shader;
+    pci.fragment_shader = fragment_shader;
+    pci.rasterizer_state.enable_depth_clip = true;
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(cull_modes); ++j) {
+            for (k = 0; k < 2; ++k) {
+                ctd.format = formats[i];
+                ctd.blend_state.enable_blend = (k != 0);
+                pci.rasterizer_state.cull_mode = cull_modes[j];
+                pipelines[num_pipelines] = SDL_CreateGPUGraphicsPipeline(device, &pci);
+                if (!pipelines[num_pipelines]) {
+                    SDL_Log("Couldn't create pipeline: %s", SDL_GetError());
+                    goto done;
+                }
+                ++num_pipelines;
+            }
+        }
+    }
+    *elapsed = SDL_GetTicksNS() - start;
+    result = true;
+
+done:
+    for (i = 0; i < num_pipelines; ++i) {
+        SDL_ReleaseGPUGraphicsPipeline(device, pipelines[i]);
+    }
+    if (vertex_shader) {
+        SDL_ReleaseGPUShader(device, vertex_shader);
+    }
+    if (fragment_shader) {
+        SDL_ReleaseGPUShader(device, fragment_shader);
+    }
+    return result;
+}
+
+/* Creates the pipelines on a new device, optionally returning the pipeline cache afterwards */
+static bool RunPass(const char *name, const char *cache_file, const void *cache_data, size_t cache_size, Uint64 *elapsed, void **saved_data, size_t *saved_size)
+{
+    SDL_GPUDevice *device;
+    bool result;
+
+    device = CreateDevice(cache_file, cache_data, cache_size);
+    if (!device) {
+        SDL_Log("%s: couldn't create GPU device: %s", name, SDL_GetError());
+        return false;
+    }
+    result = CreatePipelines(device, elapsed);
+    if (result && saved_data) {
+        *saved_data = SDL_GetGPUPipelineCacheData(device, saved_size);
+        if (!*saved_data) {
+            SDL_Log("%s: couldn't get pipeline cache data: %s", name, SDL_GetError());
+            result = false;
+        }
+    }
+    SDL_DestroyGPUDevice(device);
+
+    if (result) {
+        SDL_Log("%s: created %d pipelines in %.3f ms", name,
+                (int)(SDL_arraysize(formats) * SDL_arraysize(cull_modes) * 2), (double)*elapsed / SDL_NS_PER_MS);
+    }
+    return result;
+}
+
+/* Checks that pipeline cache data has a valid header, and that it matches the expected one if given */
+static bool CheckCacheHeader(const char *name, const void *data, size_t size, const Uint8 *expected)
+{
+    Uint32 header_size, header_version;
+
+    if (!data || size < CACHE_HEADER_SIZE) {
+        SDL_Log("%s: pipeline cache is too small, %u bytes", name, (unsigned int)size);
+        return false;
+    }
+    SDL_memcpy(&header_size, data, sizeof(header_size));
+    SDL_memcpy(&header_version, (const Uint8 *)data + sizeof(header_size), sizeof(header_version));
+    if (header_size < CACHE_HEADER_SIZE || header_size > size) {
+        SDL_Log("%s: invalid pipeline cache header size %" SDL_PRIu32 " for %u bytes", name, header_size, (unsigned int)size);
+        return false;
+    }
+    if (header_version != CACHE_HEADER_VERSION_ONE) {
+        SDL_Log("%s: invalid pipeline cache header version %" SDL_PRIu32, name, header_version);
+        return false;
+    }
+    if (expected && SDL_memcmp(data, expected, CACHE_HEADER_SIZE) != 0) {
+        SDL_Log("%s: pipeline cache header doesn't match the first pass", name);
+        return false;
+    }
+    return true;
+}
+
+/* Runs a pass seeded with data that should be ignored, the device's cache must be built from scratch */
+static bool RunIgnoredPass(const char *name, const void *cache_data, size_t cache_size, const Uint8 *expected)
+{
+    void *saved_data = NULL;
+    size_t saved_size = 0;
+    Uint64 elapsed;
+    bool result;
+
+    result = RunPass(name, NULL, cache_data, cache_size, &elapsed, &saved_data, &saved_size) &&
+             CheckCacheHeader(name, saved_data, saved_size, expected);
+    SDL_free(saved_data);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const char *cache_file = "testgpu_pipeline_cache.bin";
+    bool remove_cache_file = true;
+    Uint8 garbage[64];
+    Uint8 header[CACHE_HEADER_SIZE];
+    SDLTest_CommonState *state;
+    Uint64 cold, warm, elapsed;
+    void *cache_data = NULL;
+    size_t cache_size = 0;
+    void *file_data;
+    size_t file_size = 0;
+    int result = 1;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, SDL_INIT_VIDEO);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--cache-file") == 0 && argv[i + 1]) {
+                cache_file = argv[i + 1];
+                remove_cache_file = false;
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--cache-file FILE]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(state->flags)) {
+        SDL_Log("SDL_Init failed: %s", SDL_GetError());
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    if (!SDL_GPUSupportsShaderFormats(SDL_GPU_SHADERFORMAT_SPIRV, "vulkan")) {
+        SDL_Log("Vulkan GPU driver isn't available, skipping");
+        result = 0;
+        goto done;
+    }
+
+    /* Start out with no cache at all, unless the file was given on the command line */
+    if (remove_cache_file) {
+        SDL_RemovePath(cache_file);
+    }
+
+    if (!RunPass("Cold cache", cache_file, NULL, 0, &cold, &cache_data, &cache_size)) {
+        goto done;
+    }
+    if (!CheckCacheHeader("Cold cache", cache_data, cache_size, NULL)) {
+        goto done;
+    }
+    SDL_memcpy(header, cache_data, sizeof(header));
+
+    file_data = SDL_LoadFile(cache_file, &file_size);
+    if (!file_data) {
+        SDL_Log("Pipeline cache wasn't saved to %s: %s", cache_file, SDL_GetError());
+        goto done;
+    }
+    if (!CheckCacheHeader(cache_file, file_data, file_size, header)) {
+        SDL_free(file_data);
+        goto done;
+    }
+    SDL_free(file_data);
+
+    if (!RunPass("Warm cache (file)", cache_file, NULL, 0, &warm, NULL, NULL)) {
+        goto done;
+    }
+    SDL_Log("Warm cache speedup: %.2fx", (double)cold / (double)SDL_max(warm, 1));
+
+    /* The cache can also be seeded from memory, here with the data retrieved after the first pass */
+    if (!RunPass("Warm cache (memory)", NULL, cache_data, cache_size, &elapsed, NULL, NULL)) {
+        goto done;
+    }
+
+    /* Data from another device or driver is ignored */
+    SDL_memset(garbage, 0xFF, sizeof(garbage));
+    if (!RunIgnoredPass("Invalid cache", garbage, sizeof(garbage), header)) {
+        goto done;
+    }
+
+    /* So is a header claiming to be bigger than the data */
+    {
+        const Uint32 header_size = (Uint32)cache_size + 1;
+        SDL_memcpy(cache_data, &header_size, sizeof(header_size));
+        if (!RunIgnoredPass("Truncated cache", cache_data, cache_size, header)) {
+            goto done;
+        }
+    }
+
+    result = 0;
+
+done:
+    SDL_free(cache_data);
+    if (remove_cache_file) {
+        SDL_RemovePath(cache_file);
+    }
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
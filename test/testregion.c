@@ -0,0 +1,288 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Compare SDL_Region against a naive list of rectangles */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define AREA_W 1920
+#define AREA_H 1080
+
+typedef struct RectList
+{
+    SDL_Rect *rects;
+    int count;
+    int capacity;
+} RectList;
+
+static bool AddRect(RectList *list, const SDL_Rect *rect)
+{
+    if (list->count == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 64;
+        SDL_Rect *rects = (SDL_Rect *)SDL_realloc(list->rects, capacity * sizeof(*rects));
+        if (!rects) {
+            return false;
+        }
+        list->rects = rects;
+        list->capacity = capacity;
+    }
+    list->rects[list->count++] = *rect;
+    return true;
+}
+
+/* Subtract a rectangle by splitting every rectangle it overlaps into up to four pieces */
+static void SubtractRect(RectList *list, const SDL_Rect *hole)
+{
+    RectList result;
+    SDL_Rect overlap, piece;
+    int i;
+
+    SDL_zero(result);
+    for (i = 0; i < list->count; i++) {
+        const SDL_Rect *r = &list->rects[i];
+
+        if (!SDL_GetRectIntersection(r, hole, &overlap)) {
+            AddRect(&result, r);
+            continue;
+        }
+        if (overlap.y > r->y) {
+            piece.x = r->x;
+            piece.y = r->y;
+            piece.w = r->w;
+            piece.h = overlap.y - r->y;
+            AddRect(&result, &piece);
+        }
+        if (overlap.y + overlap.h < r->y + r->h) {
+            piece.x = r->x;
+            piece.y = overlap.y + overlap.h;
+            piece.w = r->w;
+            piece.h = (r->y + r->h) - piece.y;
+            AddRect(&result, &piece);
+        }
+        if (overlap.x > r->x) {
+            piece.x = r->x;
+            piece.y = overlap.y;
+            piece.w = overlap.x - r->x;
+            piece.h = overlap.h;
+            AddRect(&result, &piece);
+        }
+        if (overlap.x + overlap.w < r->x + r->w) {
+            piece.x = overlap.x + overlap.w;
+            piece.y = overlap.y;
+            piece.w = (r->x + r->w) - piece.x;
+            piece.h = overlap.h;
+            AddRect(&result, &piece);
+        }
+    }
+    SDL_free(list->rects);
+    *list = result;
+}
+
+static bool PointInList(const SDL_Point *p, const RectList *list)
+{
+    int i;
+
+    for (i = 0; i < list->count; i++) {
+        if (SDL_PointInRect(p, &list->rects[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static Sint64 ListArea(const RectList *list)
+{
+    Sint64 area = 0;
+    int i;
+
+    for (i = 0; i < list->count; i++) {
+        area += (Sint64)list->rects[i].w * list->rects[i].h;
+    }
+    return area;
+}
+
+static Sint64 RegionArea(SDL_Region *region, int *count)
+{
+    const SDL_Rect *rects = SDL_GetRegionRects(region, count);
+    Sint64 area = 0;
+    int i;
+
+    for (i = 0; rects && i < *count; i++) {
+        area += (Sint64)rects[i].w * rects[i].h;
+    }
+    return area;
+}
+
+static void RandomRects(SDL_Rect *rects, int count, int max_size, Uint64 *seed)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        rects[i].w = 1 + SDL_rand_r(seed, max_size);
+        rects[i].h = 1 + SDL_rand_r(seed, max_size);
+        rects[i].x = SDL_rand_r(seed, AREA_W - rects[i].w);
+        rects[i].y = SDL_rand_r(seed, AREA_H - rects[i].h);
+    }
+}
+
+static double Elapsed(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static void RunBenchmark(int num_rects, int max_size, int num_holes, int num_points, Uint64 seed)
+{
+    SDL_Rect *rects = (SDL_Rect *)SDL_malloc(num_rects * sizeof(*rects));
+    SDL_Rect *holes = (SDL_Rect *)SDL_malloc(num_holes * sizeof(*holes));
+    SDL_Point *points = (SDL_Point *)SDL_malloc(num_points * sizeof(*points));
+    SDL_Region *region = SDL_CreateRegion();
+    SDL_Region *bulk = SDL_CreateRegion();
+    RectList list;
+    Uint64 start;
+    double list_build, list_subtract, list_query;
+    double region_build, region_bulk, region_subtract, region_query;
+    Sint64 region_area;
+    int region_count = 0, bulk_count = 0;
+    int list_hits = 0, region_hits = 0;
+    int i;
+
+    if (!rects || !holes || !points || !region || !bulk) {
+        SDL_Log("Out of memory");
+        goto done;
+    }
+
+    RandomRects(rects, num_rects, max_size, &seed);
+    RandomRects(holes, num_holes, max_size, &seed);
+    for (i = 0; i < num_points; i++) {
+        points[i].x = SDL_rand_r(&seed, AREA_W);
+        points[i].y = SDL_rand_r(&seed, AREA_H);
+    }
+
+    /* Naive rectangle list */
+    SDL_zero(list);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_rects; i++) {
+        AddRect(&list, &rects[i]);
+    }
+    list_build = Elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_holes; i++) {
+        SubtractRect(&list, &holes[i]);
+    }
+    list_subtract = Elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_points; i++) {
+        list_hits += PointInList(&points[i], &list);
+    }
+    list_query = Elapsed(start);
+
+    /* SDL_Region, one rectangle at a time and all at once */
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_rects; i++) {
+        SDL_UnionRegionRect(region, &rects[i]);
+    }
+    region_build = Elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    SDL_UnionRegionRects(bulk, rects, num_rects);
+    region_bulk = Elapsed(start);
+    SDL_GetRegionRects(bulk, &bulk_count);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_holes; i++) {
+        SDL_SubtractRegionRect(region, &holes[i]);
+    }
+    region_subtract = Elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_points; i++) {
+        region_hits += SDL_PointInRegion(&points[i], region);
+    }
+    region_query = Elapsed(start);
+
+    region_area = RegionArea(region, &region_count);
+
+    SDL_Log("%d rects up to %dx%d, %d holes, %d points:", num_rects, max_size, max_size, num_holes, num_points);
+    SDL_Log("  list:   build %8.3f ms, subtract %8.3f ms, query %8.3f ms, %6d rects, area %" SDL_PRIs64 " (with overlap)",
+            list_build, list_subtract, list_query, list.count, ListArea(&list));
+    SDL_Log("  region: build %8.3f ms (bulk %8.3f ms, %d rects), subtract %8.3f ms, query %8.3f ms, %6d rects, area %" SDL_PRIs64,
+            region_build, region_bulk, bulk_count, region_subtract, region_query, region_count, region_area);
+    if (list_hits != region_hits) {
+        SDL_Log("  MISMATCH: list found %d points, region found %d points", list_hits, region_hits);
+    }
+
+    SDL_free(list.rects);
+
+done:
+    SDL_DestroyRegion(region);
+    SDL_DestroyRegion(bulk);
+    SDL_free(rects);
+    SDL_free(holes);
+    SDL_free(points);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    Uint64 seed = 0;
+    bool seed_seen = false;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (!seed_seen) {
+                char *endptr = NULL;
+
+                seed = (Uint64)SDL_strtoull(argv[i], &endptr, 0);
+                if (endptr != argv[i] && *endptr == '\0') {
+                    seed_seen = true;
+                    consumed = 1;
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[seed]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!seed_seen) {
+        seed = SDL_GetPerformanceCounter();
+    }
+    SDL_Log("Using random seed 0x%" SDL_PRIx64, seed);
+
+    RunBenchmark(100, 64, 10, 100000, seed);
+    RunBenchmark(1000, 64, 100, 100000, seed);
+    RunBenchmark(1000, 256, 100, 100000, seed);
+    RunBenchmark(5000, 32, 500, 100000, seed);
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
@@ -37,6 +37,7 @@ static Uint64 next_fps_check;
 static Uint32 frames;
 static const int fps_check_delay = 5000;
 static int use_rendergeometry = 0;
+static Uint64 sprites_time;
 static bool suspend_when_occluded;
 
 /* Number of iterations to move sprites - used for visual tests. */
@@ -389,6 +390,30 @@ static void MoveSprites(SDL_Renderer *renderer, SDL_Texture *sprite)
         SDL_RenderGeometry(renderer, sprite, verts2, num_sprites * 5, indices2, num_sprites * 4 * 3);
         SDL_free(verts2);
         SDL_free(indices2);
+    } else if (use_rendergeometry == 3) {
+        /* Draw all the sprites with a single call */
+        SDL_RenderSprite *batch = (SDL_RenderSprite *)SDL_malloc(num_sprites * sizeof(*batch));
+        if (batch) {
+            SDL_FColor color;
+            Uint64 start;
+
+            SDL_GetTextureColorModFloat(sprite, &color.r, &color.g, &color.b);
+            SDL_GetTextureAlphaModFloat(sprite, &color.a);
+            for (i = 0; i < num_sprites; ++i) {
+                batch[i].srcrect.x = 0.0f;
+                batch[i].srcrect.y = 0.0f;
+                batch[i].srcrect.w = sprite_w;
+                batch[i].srcrect.h = sprite_h;
+                batch[i].dstrect = positions[i];
+                batch[i].angle = 0.0f;
+                batch[i].color = color;
+            }
+
+            start = SDL_GetTicksNS();
+            SDL_RenderSprites(renderer, sprite, batch, num_sprites);
+            sprites_time += SDL_GetTicksNS() - start;
+            SDL_free(batch);
+        }
     }
 
     /* Update the screen! */
@@ -470,6 +495,9 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
                         /* Draw sprite2 as triangles that can *not* be recombined as rect by software renderer
                          * Use an 'indices' array */
                         use_rendergeometry = 2;
+                    } else if (SDL_strcasecmp(argv[i + 1], "sprites") == 0) {
+                        /* Draw the sprites with SDL_RenderSprites() */
+                        use_rendergeometry = 3;
                     } else {
                         return SDL_APP_FAILURE;
                     }
@@ -490,7 +518,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
                 "[--cyclealpha]",
                 "[--suspend-when-occluded]",
                 "[--iterations N]",
-                "[--use-rendergeometry mode1|mode2]",
+                "[--use-rendergeometry mode1|mode2|sprites]",
                 "[num_sprites]",
                 "[icon.png]",
                 NULL
@@ -595,6 +623,10 @@ SDL_AppResult SDL_AppIterate(void *appstate)
         const Uint64 then = next_fps_check - fps_check_delay;
         const double fps = ((double)frames * 1000) / (now - then);
         SDL_Log("%2.2f frames per second", fps);
+        if (use_rendergeometry == 3) {
+            SDL_Log("%.3f ms per frame in SDL_RenderSprites()", ((double)sprites_time / SDL_NS_PER_MS) / frames);
+            sprites_time = 0;
+        }
         next_fps_check = now + fps_check_delay;
         frames = 0;
     }
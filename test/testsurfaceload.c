@@ -0,0 +1,182 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how long it takes to load a batch of images, serially and on a surface load queue */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static double Elapsed(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static bool CreateImages(char **files, int count, int size)
+{
+    SDL_Surface *surface = SDL_CreateSurface(size, size, SDL_PIXELFORMAT_RGBA32);
+    Uint64 seed = 0;
+    int i, x, y;
+    bool result = true;
+
+    if (!surface) {
+        return false;
+    }
+
+    for (i = 0; result && i < count; ++i) {
+        /* Gradients with some noise, so the images don't compress to nothing */
+        for (y = 0; y < size; ++y) {
+            Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+            for (x = 0; x < size * 4; ++x) {
+                row[x] = (Uint8)(x + y + i + SDL_rand_r(&seed, 16));
+            }
+        }
+        if (i % 4 == 3) {
+            result = SDL_SaveBMP(surface, files[i]);
+        } else {
+            result = SDL_SavePNG(surface, files[i]);
+        }
+    }
+    SDL_DestroySurface(surface);
+    return result;
+}
+
+static double LoadSerially(char **files, int count, int *loaded)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    int i;
+
+    *loaded = 0;
+    for (i = 0; i < count; ++i) {
+        SDL_Surface *surface = SDL_LoadSurface(files[i]);
+        if (surface) {
+            ++*loaded;
+            SDL_DestroySurface(surface);
+        }
+    }
+    return Elapsed(start);
+}
+
+static double LoadOnQueue(char **files, int count, int num_threads, int *loaded)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    SDL_SurfaceLoadQueue *queue = SDL_CreateSurfaceLoadQueue(num_threads);
+    SDL_SurfaceLoadOutcome outcome;
+    double elapsed;
+    int i;
+
+    *loaded = 0;
+    if (!queue) {
+        SDL_Log("Couldn't create surface load queue: %s", SDL_GetError());
+        return 0.0;
+    }
+
+    SDL_LoadSurfacesAsync((const char * const *)files, count, queue, NULL);
+    for (i = 0; i < count; ++i) {
+        if (!SDL_WaitSurfaceLoadResult(queue, &outcome, -1)) {
+            break;
+        }
+        if (outcome.surface) {
+            ++*loaded;
+            SDL_DestroySurface(outcome.surface);
+        }
+    }
+    elapsed = Elapsed(start);
+
+    SDL_DestroySurfaceLoadQueue(queue);
+    return elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    char **files = NULL;
+    int count = 500;
+    int size = 256;
+    int num_cores, num_threads, loaded;
+    double serial, elapsed;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--count") == 0 && argv[i + 1]) {
+                count = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1]) {
+                size = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0 || count <= 0 || size <= 0) {
+            static const char *options[] = { "[--count N]", "[--size N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    files = (char **)SDL_calloc(count, sizeof(*files));
+    if (!files) {
+        goto done;
+    }
+    for (i = 0; i < count; ++i) {
+        if (SDL_asprintf(&files[i], "testsurfaceload%d.tmp", i) < 0) {
+            goto done;
+        }
+    }
+
+    SDL_Log("Creating %d %dx%d images...", count, size, size);
+    if (!CreateImages(files, count, size)) {
+        SDL_Log("Couldn't create images: %s", SDL_GetError());
+        goto done;
+    }
+
+    serial = LoadSerially(files, count, &loaded);
+    SDL_Log("serial:     %8.2f ms, %d images loaded", serial, loaded);
+
+    num_cores = SDL_GetNumLogicalCPUCores();
+    for (num_threads = 1; ; num_threads *= 2) {
+        if (num_threads > num_cores) {
+            num_threads = num_cores;
+        }
+        elapsed = LoadOnQueue(files, count, num_threads, &loaded);
+        SDL_Log("%2d threads: %8.2f ms, %d images loaded, %.2fx", num_threads, elapsed, loaded, elapsed > 0.0 ? serial / elapsed : 0.0);
+        if (num_threads == num_cores) {
+            break;
+        }
+    }
+
+done:
+    if (files) {
+        for (i = 0; i < count; ++i) {
+            if (files[i]) {
+                SDL_RemovePath(files[i]);
+                SDL_free(files[i]);
+            }
+        }
+        SDL_free(files);
+    }
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}